@@ -20,11 +20,13 @@
  *
  */
 
+#include "common/atomic.h"
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/queue.h"
+#include "common/ringbuffer.h"
 #include "common/util.h"
 
 #include "audio/audiostream.h"
@@ -402,6 +404,200 @@ QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo) {
 	return new QueuingAudioStreamImpl(rate, stereo);
 }
 
+#ifdef SCUMMVM_ATOMICS
+
+/**
+ * A QueuingAudioStream which hands the queued streams over to the reading
+ * (audio) thread through lock-free ring buffers, so the audio thread never
+ * has to wait for the queuing thread.
+ *
+ * The ring buffers have a fixed capacity. When one is full, the queuing
+ * thread links a new one after it, which the reading thread switches to
+ * once it has emptied the old one. Thus queuing never fails and, as long as
+ * the reading thread keeps up, no allocations are needed.
+ *
+ * queueAudioStream() and finish() must not be called by several threads at
+ * once, and only the reading thread may call readBuffer(). endOfData(),
+ * endOfStream() and numQueuedStreams() may be called by any thread.
+ */
+class LockFreeQueuingAudioStream : public QueuingAudioStream {
+private:
+	struct StreamHolder {
+		AudioStream *_stream;
+		DisposeAfterUse::Flag _disposeAfterUse;
+		StreamHolder() : _stream(0), _disposeAfterUse(DisposeAfterUse::NO) {}
+		StreamHolder(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse)
+		    : _stream(stream),
+		      _disposeAfterUse(disposeAfterUse) {}
+	};
+
+	struct Segment {
+		Common::RingBuffer<StreamHolder> _queue;
+		Segment *volatile _next;
+		Segment(uint32 capacity) : _queue(capacity), _next(0) {}
+	};
+
+	const int _rate;
+	const int _stereo;
+	const uint32 _capacity;
+
+	/**
+	 * The segment the reading thread takes streams from; only used by the
+	 * reading thread.
+	 */
+	Segment *_readSegment;
+
+	/**
+	 * The segment new streams are queued to; only used by the queuing thread.
+	 */
+	Segment *_writeSegment;
+
+	/**
+	 * Number of streams in all segments.
+	 */
+	volatile uint32 _numQueued;
+
+	/**
+	 * This flag is set by the finish() method only.
+	 */
+	volatile uint32 _finished;
+
+	StreamHolder *front();
+	void pop();
+
+	static void disposeStream(const StreamHolder &holder) {
+		if (holder._disposeAfterUse == DisposeAfterUse::YES)
+			delete holder._stream;
+	}
+
+public:
+	LockFreeQueuingAudioStream(int rate, bool stereo, uint32 capacity)
+	    : _rate(rate), _stereo(stereo), _capacity(capacity), _numQueued(0), _finished(0) {
+		_readSegment = _writeSegment = new Segment(_capacity);
+	}
+	~LockFreeQueuingAudioStream();
+
+	// Implement the AudioStream API
+	virtual int readBuffer(int16 *buffer, const int numSamples);
+	virtual bool isStereo() const { return _stereo; }
+	virtual int getRate() const { return _rate; }
+
+	/**
+	 * Unlike QueuingAudioStream, only checks if any streams are queued, so
+	 * the queuing thread can call it too. Queued streams which have no data
+	 * at the moment, but have not ended, still count as data.
+	 */
+	virtual bool endOfData() const {
+		return Common::atomicLoad(&_numQueued) == 0;
+	}
+
+	virtual bool endOfStream() const {
+		return Common::atomicLoad(&_finished) && Common::atomicLoad(&_numQueued) == 0;
+	}
+
+	// Implement the QueuingAudioStream API
+	virtual void queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+	virtual void finish() {
+		Common::atomicStore(&_finished, 1);
+	}
+
+	uint32 numQueuedStreams() const {
+		return Common::atomicLoad(&_numQueued);
+	}
+};
+
+LockFreeQueuingAudioStream::~LockFreeQueuingAudioStream() {
+	// No other thread may access the stream anymore at this point
+	while (_readSegment) {
+		while (!_readSegment->_queue.empty()) {
+			disposeStream(_readSegment->_queue.front());
+			_readSegment->_queue.pop();
+		}
+
+		Segment *next = _readSegment->_next;
+		delete _readSegment;
+		_readSegment = next;
+	}
+}
+
+LockFreeQueuingAudioStream::StreamHolder *LockFreeQueuingAudioStream::front() {
+	while (true) {
+		if (!_readSegment->_queue.empty())
+			return &_readSegment->_queue.front();
+
+		Segment *next = Common::atomicLoad(&_readSegment->_next);
+		if (!next)
+			return 0;
+
+		// The queuing thread fills a segment completely before linking the
+		// next one, so once the link is visible, so is all of its content.
+		if (!_readSegment->_queue.empty())
+			continue;
+
+		delete _readSegment;
+		_readSegment = next;
+	}
+}
+
+void LockFreeQueuingAudioStream::pop() {
+	disposeStream(_readSegment->_queue.front());
+	_readSegment->_queue.pop();
+	Common::atomicAdd(&_numQueued, (uint32)-1);
+}
+
+void LockFreeQueuingAudioStream::queueAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	assert(!_finished);
+	if ((stream->getRate() != getRate()) || (stream->isStereo() != isStereo()))
+		error("LockFreeQueuingAudioStream::queueAudioStream: stream has mismatched parameters");
+
+	// Count the stream first, so endOfStream() can never miss it
+	Common::atomicAdd(&_numQueued, 1);
+
+	const StreamHolder holder(stream, disposeAfterUse);
+	if (!_writeSegment->_queue.push(holder)) {
+		Segment *segment = new Segment(_capacity);
+		segment->_queue.push(holder);
+		Common::atomicStore(&_writeSegment->_next, segment);
+		_writeSegment = segment;
+	}
+}
+
+int LockFreeQueuingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samplesDecoded = 0;
+
+	while (samplesDecoded < numSamples) {
+		const StreamHolder *holder = front();
+		if (!holder)
+			break;
+
+		AudioStream *stream = holder->_stream;
+		samplesDecoded += stream->readBuffer(buffer + samplesDecoded, numSamples - samplesDecoded);
+
+		// Done with the stream completely
+		if (stream->endOfStream()) {
+			pop();
+			continue;
+		}
+
+		// Done with data but not the stream, bail out
+		if (stream->endOfData())
+			break;
+	}
+
+	return samplesDecoded;
+}
+
+#endif
+
+QueuingAudioStream *makeLockFreeQueuingAudioStream(int rate, bool stereo, uint32 capacity) {
+#ifdef SCUMMVM_ATOMICS
+	return new LockFreeQueuingAudioStream(rate, stereo, capacity);
+#else
+	return makeQueuingAudioStream(rate, stereo);
+#endif
+}
+
 Timestamp convertTimeToStreamPos(const Timestamp &where, int rate, bool isStereo) {
 	Timestamp result(where.convertToFramerate(rate * (isStereo ? 2 : 1)));
 
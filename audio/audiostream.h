@@ -351,6 +351,22 @@ public:
  */
 QueuingAudioStream *makeQueuingAudioStream(int rate, bool stereo);
 
+/**
+ * Factory function for a QueuingAudioStream which never blocks the thread
+ * reading from it (usually the audio thread).
+ *
+ * Unlike with the stream returned by makeQueuingAudioStream, queueAudioStream,
+ * queueBuffer and finish must never run on several threads at once: call them
+ * from a single thread, or under a mutex. Where the platform lacks the atomic
+ * operations needed for this, a regular QueuingAudioStream is returned.
+ *
+ * @param rate     Rate of the stream
+ * @param stereo   Whether the stream is stereo
+ * @param capacity Number of queued streams which can be handed over without
+ *                 any allocation
+ */
+QueuingAudioStream *makeLockFreeQueuingAudioStream(int rate, bool stereo, uint32 capacity = 64);
+
 /**
  * Converts a point in time to a precise sample offset
  * with the given parameters.
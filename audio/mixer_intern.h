@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -70,6 +71,8 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	RateConverterQuality _rateConverterQuality;
+
 
 public:
 
@@ -139,6 +142,13 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Set the resampling method used for sounds started from now on.
+	 * The initial value is taken from the "audio_resampler" config key.
+	 */
+	void setRateConverterQuality(RateConverterQuality quality);
+	RateConverterQuality getRateConverterQuality() const { return _rateConverterQuality; }
 };
 
 
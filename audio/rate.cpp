@@ -31,10 +31,23 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "common/algorithm.h"
+#include "common/array.h"
 #include "common/frac.h"
+#include "common/simd.h"
+#include "common/singleton.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
+namespace Audio {
+class PolyphaseFilterCache;
+}
+
+namespace Common {
+DECLARE_SINGLETON(Audio::PolyphaseFilterCache);
+}
+
 namespace Audio {
 
 
@@ -57,6 +70,110 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Scale a block of interleaved stereo samples by the given volumes and add
+ * them to the output buffer, clipping the result. Samples at even positions
+ * are scaled by volEven, samples at odd positions by volOdd.
+ *
+ * This produces exactly the same output as calling clampedAdd on every
+ * sample with (sample * vol) / Audio::Mixer::kMaxMixerVolume, but makes use
+ * of SSE2 or NEON when available.
+ */
+static void mixScaledBlock(st_sample_t *obuf, const st_sample_t *ibuf, st_size_t numPairs, st_volume_t volEven, st_volume_t volOdd) {
+	st_size_t i = 0;
+
+#if !defined(OUTPUT_UNSIGNED_AUDIO) && (defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON))
+	// The vector paths divide by shifting, so they rely on this
+	assert(Audio::Mixer::kMaxMixerVolume == 256);
+
+#if defined(SCUMMVM_SSE2)
+	const __m128i vol = _mm_set_epi16(volOdd, volEven, volOdd, volEven, volOdd, volEven, volOdd, volEven);
+
+	for (; i + 4 <= numPairs; i += 4) {
+		const __m128i in = _mm_loadu_si128((const __m128i *)(ibuf + i * 2));
+		const __m128i lo = _mm_mullo_epi16(in, vol);
+		const __m128i hi = _mm_mulhi_epi16(in, vol);
+		__m128i prod0 = _mm_unpacklo_epi16(lo, hi);
+		__m128i prod1 = _mm_unpackhi_epi16(lo, hi);
+
+		// Round towards zero like the integer division in the scalar path
+		prod0 = _mm_srai_epi32(_mm_add_epi32(prod0, _mm_srli_epi32(_mm_srai_epi32(prod0, 31), 24)), 8);
+		prod1 = _mm_srai_epi32(_mm_add_epi32(prod1, _mm_srli_epi32(_mm_srai_epi32(prod1, 31), 24)), 8);
+
+		const __m128i out = _mm_loadu_si128((const __m128i *)(obuf + i * 2));
+		_mm_storeu_si128((__m128i *)(obuf + i * 2), _mm_adds_epi16(out, _mm_packs_epi32(prod0, prod1)));
+	}
+#else
+	const int16 volArray[4] = { (int16)volEven, (int16)volOdd, (int16)volEven, (int16)volOdd };
+	const int16x4_t vol = vld1_s16(volArray);
+
+	for (; i + 4 <= numPairs; i += 4) {
+		const int16x8_t in = vld1q_s16(ibuf + i * 2);
+		int32x4_t prod0 = vmull_s16(vget_low_s16(in), vol);
+		int32x4_t prod1 = vmull_s16(vget_high_s16(in), vol);
+
+		// Round towards zero like the integer division in the scalar path
+		prod0 = vshrq_n_s32(vaddq_s32(prod0, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(prod0, 31)), 24))), 8);
+		prod1 = vshrq_n_s32(vaddq_s32(prod1, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(prod1, 31)), 24))), 8);
+
+		const int16x8_t out = vld1q_s16(obuf + i * 2);
+		vst1q_s16(obuf + i * 2, vqaddq_s16(out, vcombine_s16(vqmovn_s32(prod0), vqmovn_s32(prod1))));
+	}
+#endif
+#endif
+
+	for (; i < numPairs; ++i) {
+		clampedAdd(obuf[i * 2    ], (ibuf[i * 2    ] * (int)volEven) / Audio::Mixer::kMaxMixerVolume);
+		clampedAdd(obuf[i * 2 + 1], (ibuf[i * 2 + 1] * (int)volOdd ) / Audio::Mixer::kMaxMixerVolume);
+	}
+}
+
+/**
+ * Base class for rate converters which produce their output in blocks.
+ *
+ * Subclasses only resample into an intermediate stereo block, which is then
+ * scaled and mixed into the output buffer in one go. This keeps the per
+ * sample work in the subclasses minimal and allows the volume scaling and
+ * clipping to be vectorized.
+ */
+template<bool reverseStereo>
+class BlockRateConverter : public RateConverter {
+protected:
+	/**
+	 * Resample up to numPairs sample pairs into the given block. When
+	 * reverseStereo is set, the left input channel must be stored at the odd
+	 * and the right input channel at the even positions.
+	 *
+	 * @return Number of sample pairs written into the block. If this is less
+	 *         than numPairs, the input stream ran out of data.
+	 */
+	virtual int fillBlock(AudioStream &input, st_sample_t *block, int numPairs) = 0;
+
+public:
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+		st_sample_t block[INTERMEDIATE_BUFFER_SIZE];
+		st_size_t done = 0;
+
+		while (done < osamp) {
+			const int numPairs = MIN<st_size_t>(osamp - done, ARRAYSIZE(block) / 2);
+			const int len = fillBlock(input, block, numPairs);
+
+			if (len > 0)
+				mixScaledBlock(obuf + done * 2, block, len, reverseStereo ? vol_r : vol_l, reverseStereo ? vol_l : vol_r);
+
+			done += len;
+			if (len < numPairs)
+				break;
+		}
+
+		return done;
+	}
+
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
+		return ST_SUCCESS;
+	}
+};
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -64,7 +181,7 @@ enum {
  * Limited to sampling frequency <= 65535 Hz.
  */
 template<bool stereo, bool reverseStereo>
-class SimpleRateConverter : public RateConverter {
+class SimpleRateConverter : public BlockRateConverter<reverseStereo> {
 protected:
 	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
 	const st_sample_t *inPtr;
@@ -77,12 +194,10 @@ protected:
 	/** fractional position increment in the output stream */
 	long opos_inc;
 
+	int fillBlock(AudioStream &input, st_sample_t *block, int numPairs);
+
 public:
 	SimpleRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
-	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
-		return ST_SUCCESS;
-	}
 };
 
 
@@ -108,17 +223,17 @@ SimpleRateConverter<stereo, reverseStereo>::SimpleRateConverter(st_rate_t inrate
 }
 
 /*
- * Processed signed long samples from ibuf to obuf.
+ * Processed signed long samples from ibuf to the block.
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+int SimpleRateConverter<stereo, reverseStereo>::fillBlock(AudioStream &input, st_sample_t *block, int numPairs) {
+	st_sample_t *bstart, *bend;
 
-	ostart = obuf;
-	oend = obuf + osamp * 2;
+	bstart = block;
+	bend = block + numPairs * 2;
 
-	while (obuf < oend) {
+	while (block < bend) {
 
 		// read enough input samples so that opos >= 0
 		do {
@@ -127,7 +242,7 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 				inPtr = inBuf;
 				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
 				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+					return (block - bstart) / 2;
 			}
 			inLen -= (stereo ? 2 : 1);
 			opos--;
@@ -143,15 +258,12 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		// Increment output position
 		opos += opos_inc;
 
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+		block[reverseStereo    ] = out0;
+		block[reverseStereo ^ 1] = out1;
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-		obuf += 2;
+		block += 2;
 	}
-	return (obuf - ostart) / 2;
+	return (block - bstart) / 2;
 }
 
 /**
@@ -166,7 +278,7 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
  */
 
 template<bool stereo, bool reverseStereo>
-class LinearRateConverter : public RateConverter {
+class LinearRateConverter : public BlockRateConverter<reverseStereo> {
 protected:
 	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
 	const st_sample_t *inPtr;
@@ -183,12 +295,10 @@ protected:
 	/** current sample(s) in the input stream (left/right channel) */
 	st_sample_t icur0, icur1;
 
+	int fillBlock(AudioStream &input, st_sample_t *block, int numPairs);
+
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
-	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r);
-	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
-		return ST_SUCCESS;
-	}
 };
 
 
@@ -217,17 +327,17 @@ LinearRateConverter<stereo, reverseStereo>::LinearRateConverter(st_rate_t inrate
 }
 
 /*
- * Processed signed long samples from ibuf to obuf.
+ * Processed signed long samples from ibuf to the block.
  * Return number of sample pairs processed.
  */
 template<bool stereo, bool reverseStereo>
-int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-	st_sample_t *ostart, *oend;
+int LinearRateConverter<stereo, reverseStereo>::fillBlock(AudioStream &input, st_sample_t *block, int numPairs) {
+	st_sample_t *bstart, *bend;
 
-	ostart = obuf;
-	oend = obuf + osamp * 2;
+	bstart = block;
+	bend = block + numPairs * 2;
 
-	while (obuf < oend) {
+	while (block < bend) {
 
 		// read enough input samples so that opos < 0
 		while ((frac_t)FRAC_ONE_LOW <= opos) {
@@ -236,7 +346,7 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 				inPtr = inBuf;
 				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
 				if (inLen <= 0)
-					return (obuf - ostart) / 2;
+					return (block - bstart) / 2;
 			}
 			inLen -= (stereo ? 2 : 1);
 			ilast0 = icur0;
@@ -249,8 +359,8 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 		}
 
 		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
+		// still space in the block.
+		while (opos < (frac_t)FRAC_ONE_LOW && block < bend) {
 			// interpolate
 			st_sample_t out0, out1;
 			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
@@ -258,19 +368,16 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
 						  out0);
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			block[reverseStereo    ] = out0;
+			block[reverseStereo ^ 1] = out1;
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
-
-			obuf += 2;
+			block += 2;
 
 			// Increment output position
 			opos += opos_inc;
 		}
 	}
-	return (obuf - ostart) / 2;
+	return (block - bstart) / 2;
 }
 
 
@@ -281,69 +388,371 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
  * Simple audio rate converter for the case that the inrate equals the outrate.
  */
 template<bool stereo, bool reverseStereo>
-class CopyRateConverter : public RateConverter {
-	st_sample_t *_buffer;
-	st_size_t _bufferSize;
-public:
-	CopyRateConverter() : _buffer(0), _bufferSize(0) {}
-	~CopyRateConverter() {
-		free(_buffer);
+class CopyRateConverter : public BlockRateConverter<reverseStereo> {
+protected:
+	int fillBlock(AudioStream &input, st_sample_t *block, int numPairs) {
+		assert(input.isStereo() == stereo);
+
+		if (stereo) {
+			const int len = input.readBuffer(block, numPairs * 2);
+			if (len <= 0)
+				return 0;
+
+			if (reverseStereo) {
+				for (int i = 0; i < len; i += 2)
+					SWAP(block[i], block[i + 1]);
+			}
+
+			return len / 2;
+		} else {
+			// Read into the upper half of the block and spread the samples
+			// out from there. Each sample is read before it gets overwritten.
+			st_sample_t *in = block + numPairs;
+			const int len = input.readBuffer(in, numPairs);
+			if (len <= 0)
+				return 0;
+
+			for (int i = 0; i < len; ++i)
+				block[i * 2] = block[i * 2 + 1] = in[i];
+
+			return len;
+		}
 	}
+};
 
-	virtual int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
-		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
-		st_size_t len;
+#pragma mark -
 
-		st_sample_t *ostart = obuf;
 
-		if (stereo)
-			osamp *= 2;
+/**
+ * Coefficient table of a polyphase windowed-sinc filter for one specific
+ * pair of input and output rates.
+ *
+ * The rates are reduced to outRate / inRate = numPhases / phaseStep. Output
+ * sample n then lies at input position n * phaseStep / numPhases, and the
+ * fractional part of that position selects one of numPhases filter rows.
+ */
+struct PolyphaseFilter {
+	enum {
+		/** Precision of the coefficients. */
+		COEF_BITS = 14,
+		/** Number of input samples on each side of the output sample when upsampling. */
+		HALF_TAPS = 8,
+		/** Tables with more phases than this are not built. */
+		MAX_PHASES = 4096,
+		/** Downsampling by more than this factor is not supported. */
+		MAX_DOWNSAMPLE_RATIO = 8
+	};
+
+	st_rate_t inRate, outRate;
+
+	int numPhases;
+	int phaseStep;
+
+	/** Number of input samples per row, a multiple of 8 for the vector code. */
+	int numTaps;
+	/** Offset from the first input sample of a row to the output position. */
+	int center;
+
+	int16 *coefs;
+
+	PolyphaseFilter(st_rate_t inrate, st_rate_t outrate);
+	~PolyphaseFilter() { delete[] coefs; }
+
+	static bool isSupported(st_rate_t inrate, st_rate_t outrate);
+};
 
-		// Reallocate temp buffer, if necessary
-		if (osamp > _bufferSize) {
-			free(_buffer);
-			_buffer = (st_sample_t *)malloc(osamp * 2);
-			_bufferSize = osamp;
+/** Zeroth order modified Bessel function of the first kind, as used by the Kaiser window. */
+static double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; ++k) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+		if (term < sum * 1e-12)
+			break;
+	}
+	return sum;
+}
+
+bool PolyphaseFilter::isSupported(st_rate_t inrate, st_rate_t outrate) {
+	const st_rate_t divisor = Common::gcd(inrate, outrate);
+	return (outrate / divisor) <= MAX_PHASES && inrate <= outrate * MAX_DOWNSAMPLE_RATIO;
+}
+
+PolyphaseFilter::PolyphaseFilter(st_rate_t inrate, st_rate_t outrate) : inRate(inrate), outRate(outrate) {
+	assert(isSupported(inrate, outrate));
+
+	const st_rate_t divisor = Common::gcd(inrate, outrate);
+	numPhases = outrate / divisor;
+	phaseStep = inrate / divisor;
+
+	// When downsampling the cutoff has to move down to the output Nyquist
+	// frequency, which widens the filter accordingly.
+	const double cutoff = MIN<double>(1.0, (double)outrate / inrate);
+	const int halfTaps = ((int)ceil(HALF_TAPS / cutoff) + 3) & ~3;
+	numTaps = halfTaps * 2;
+	center = halfTaps - 1;
+
+	const double beta = 7.0;
+	const double windowScale = 1.0 / besselI0(beta);
+
+	coefs = new int16[numPhases * numTaps];
+	double *row = new double[numTaps];
+
+	// The floating point math here only runs once per rate pair, the actual
+	// resampling is done in fixed point.
+	for (int phase = 0; phase < numPhases; ++phase) {
+		double sum = 0.0;
+		for (int tap = 0; tap < numTaps; ++tap) {
+			const double dist = tap - center - (double)phase / numPhases;
+			const double x = dist / halfTaps;
+			const double window = (x * x < 1.0) ? besselI0(beta * sqrt(1.0 - x * x)) * windowScale : 0.0;
+			const double arg = M_PI * cutoff * dist;
+			const double sinc = (dist == 0.0) ? 1.0 : sin(arg) / arg;
+			row[tap] = cutoff * sinc * window;
+			sum += row[tap];
 		}
 
-		if (!_buffer)
-			error("[CopyRateConverter::flow] Cannot allocate memory for temp buffer");
+		// Normalize every row to unity gain, and put the rounding error of
+		// the quantization into the largest coefficient.
+		int16 *dst = coefs + phase * numTaps;
+		int total = 0, largest = 0;
+		for (int tap = 0; tap < numTaps; ++tap) {
+			dst[tap] = (int16)floor(row[tap] / sum * (1 << COEF_BITS) + 0.5);
+			total += dst[tap];
+			if (dst[tap] > dst[largest])
+				largest = tap;
+		}
+		dst[largest] += (1 << COEF_BITS) - total;
+	}
 
-		// Read up to 'osamp' samples into our temporary buffer
-		len = input.readBuffer(_buffer, osamp);
+	delete[] row;
+}
 
-		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
+/**
+ * Cache of all polyphase filter tables built so far. The tables only depend
+ * on the rates, so every converter for the same pair of rates shares them.
+ */
+class PolyphaseFilterCache : public Common::Singleton<PolyphaseFilterCache> {
+public:
+	PolyphaseFilterCache() : _mutex(g_system ? g_system->createMutex() : 0) {}
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+	~PolyphaseFilterCache() {
+		for (Common::Array<PolyphaseFilter *>::iterator i = _filters.begin(); i != _filters.end(); ++i)
+			delete *i;
+		if (_mutex)
+			g_system->deleteMutex(_mutex);
+	}
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+	const PolyphaseFilter *getFilter(st_rate_t inrate, st_rate_t outrate) {
+		if (_mutex)
+			g_system->lockMutex(_mutex);
 
-			obuf += 2;
+		PolyphaseFilter *filter = 0;
+		for (Common::Array<PolyphaseFilter *>::iterator i = _filters.begin(); i != _filters.end(); ++i) {
+			if ((*i)->inRate == inrate && (*i)->outRate == outrate) {
+				filter = *i;
+				break;
+			}
 		}
-		return (obuf - ostart) / 2;
+
+		if (!filter) {
+			filter = new PolyphaseFilter(inrate, outrate);
+			_filters.push_back(filter);
+		}
+
+		if (_mutex)
+			g_system->unlockMutex(_mutex);
+
+		return filter;
 	}
 
-	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) {
-		return ST_SUCCESS;
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+
+	// The cache may be used before the backend is fully set up (and by the
+	// unit tests, which have no backend at all), so the mutex is optional.
+	OSystem::MutexRef _mutex;
+	Common::Array<PolyphaseFilter *> _filters;
+};
+
+/**
+ * Compute the dot product of two arrays of 16 bit values. The length must
+ * be a multiple of 8.
+ */
+static inline int32 dotProduct(const int16 *a, const int16 *b, int len) {
+#if defined(SCUMMVM_SSE2)
+	__m128i acc = _mm_setzero_si128();
+	for (int i = 0; i < len; i += 8)
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(a + i)), _mm_loadu_si128((const __m128i *)(b + i))));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(acc);
+#elif defined(SCUMMVM_NEON)
+	int32x4_t acc = vdupq_n_s32(0);
+	for (int i = 0; i < len; i += 8) {
+		acc = vmlal_s16(acc, vld1_s16(a + i), vld1_s16(b + i));
+		acc = vmlal_s16(acc, vld1_s16(a + i + 4), vld1_s16(b + i + 4));
 	}
+	const int32x2_t sum = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	return vget_lane_s32(vpadd_s32(sum, sum), 0);
+#else
+	int32 acc = 0;
+	for (int i = 0; i < len; ++i)
+		acc += a[i] * b[i];
+	return acc;
+#endif
+}
+
+/**
+ * Audio rate converter based on a polyphase windowed-sinc filter.
+ *
+ * This gives a much better quality than the linear interpolation, at the
+ * cost of filtering every output sample with numTaps input samples. The
+ * input is kept in one history buffer per channel so the filter rows can be
+ * applied with vector instructions.
+ */
+template<bool stereo, bool reverseStereo>
+class PolyphaseRateConverter : public BlockRateConverter<reverseStereo> {
+protected:
+	st_sample_t _inBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	const PolyphaseFilter *_filter;
+
+	/** Per channel input history; _history[1] is only used for stereo input. */
+	int16 *_history[2];
+	int _historySize;
+
+	/** Index of the first input sample of the current filter window. */
+	int _pos;
+	/** Number of valid samples in the history buffers. */
+	int _end;
+	/** Current filter row. */
+	int _phase;
+
+	/** Input samples and filter rows to advance per output sample. */
+	int _posInc, _phaseInc;
+
+	bool refill(AudioStream &input);
+	int fillBlock(AudioStream &input, st_sample_t *block, int numPairs);
+
+public:
+	PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate);
+	~PolyphaseRateConverter();
 };
 
+template<bool stereo, bool reverseStereo>
+PolyphaseRateConverter<stereo, reverseStereo>::PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate) {
+	_filter = PolyphaseFilterCache::instance().getFilter(inrate, outrate);
+
+	_historySize = _filter->numTaps + INTERMEDIATE_BUFFER_SIZE;
+	_history[0] = new int16[_historySize];
+	_history[1] = stereo ? new int16[_historySize] : 0;
+
+	// Prime the history with silence, so that the first output sample is
+	// centered on the first input sample.
+	_pos = 0;
+	_end = _filter->center;
+	_phase = 0;
+	memset(_history[0], 0, sizeof(int16) * _end);
+	if (stereo)
+		memset(_history[1], 0, sizeof(int16) * _end);
+
+	_posInc = _filter->phaseStep / _filter->numPhases;
+	_phaseInc = _filter->phaseStep % _filter->numPhases;
+}
+
+template<bool stereo, bool reverseStereo>
+PolyphaseRateConverter<stereo, reverseStereo>::~PolyphaseRateConverter() {
+	delete[] _history[0];
+	delete[] _history[1];
+}
+
+/*
+ * Read more input into the history buffers.
+ * Return false when the input stream has no more data.
+ */
+template<bool stereo, bool reverseStereo>
+bool PolyphaseRateConverter<stereo, reverseStereo>::refill(AudioStream &input) {
+	if (_end == _historySize) {
+		// Move the still needed samples to the start of the buffers
+		memmove(_history[0], _history[0] + _pos, sizeof(int16) * (_end - _pos));
+		if (stereo)
+			memmove(_history[1], _history[1] + _pos, sizeof(int16) * (_end - _pos));
+		_end -= _pos;
+		_pos = 0;
+	}
+
+	const int space = (_historySize - _end) * (stereo ? 2 : 1);
+	const int len = input.readBuffer(_inBuf, MIN<int>(space, ARRAYSIZE(_inBuf)));
+	if (len <= 0)
+		return false;
+
+	if (stereo) {
+		for (int i = 0; i < len / 2; ++i) {
+			_history[0][_end + i] = _inBuf[i * 2];
+			_history[1][_end + i] = _inBuf[i * 2 + 1];
+		}
+		_end += len / 2;
+	} else {
+		memcpy(_history[0] + _end, _inBuf, sizeof(int16) * len);
+		_end += len;
+	}
+
+	return true;
+}
+
+template<bool stereo, bool reverseStereo>
+int PolyphaseRateConverter<stereo, reverseStereo>::fillBlock(AudioStream &input, st_sample_t *block, int numPairs) {
+	st_sample_t *bstart, *bend;
+
+	bstart = block;
+	bend = block + numPairs * 2;
+
+	const int numTaps = _filter->numTaps;
+	const int numPhases = _filter->numPhases;
+	const int round = 1 << (PolyphaseFilter::COEF_BITS - 1);
+
+	while (block < bend) {
+		// Make sure the whole filter window is available
+		while (_pos + numTaps > _end) {
+			if (!refill(input))
+				return (block - bstart) / 2;
+		}
+
+		const int16 *coefs = _filter->coefs + _phase * numTaps;
+
+		st_sample_t out0, out1;
+		out0 = (st_sample_t)CLIP<int32>((dotProduct(coefs, _history[0] + _pos, numTaps) + round) >> PolyphaseFilter::COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+		out1 = (stereo ?
+					(st_sample_t)CLIP<int32>((dotProduct(coefs, _history[1] + _pos, numTaps) + round) >> PolyphaseFilter::COEF_BITS, ST_SAMPLE_MIN, ST_SAMPLE_MAX) :
+					out0);
+
+		block[reverseStereo    ] = out0;
+		block[reverseStereo ^ 1] = out1;
+
+		block += 2;
+
+		// Increment input position
+		_pos += _posInc;
+		_phase += _phaseInc;
+		if (_phase >= numPhases) {
+			_phase -= numPhases;
+			_pos++;
+		}
+	}
+	return (block - bstart) / 2;
+}
+
 
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality == kRateConverterPolyphase && PolyphaseFilter::isSupported(inrate, outrate)) {
+			return new PolyphaseRateConverter<stereo, reverseStereo>(inrate, outrate);
+		} else if ((inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -356,14 +765,14 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
 }
 
 } // End of namespace Audio
@@ -78,7 +78,24 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+/**
+ * The resampling methods a RateConverter can use.
+ */
+enum RateConverterQuality {
+	/**
+	 * Pick samples directly when the input rate is a multiple of the output
+	 * rate, otherwise interpolate linearly. Cheap, but of low quality.
+	 */
+	kRateConverterLinear,
+	/**
+	 * Filter with a polyphase windowed-sinc filter. Noticeably better
+	 * quality at a higher CPU cost. Rate pairs which would need unreasonably
+	 * large filter tables fall back to kRateConverterLinear.
+	 */
+	kRateConverterPolyphase
+};
+
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterLinear);
 
 } // End of namespace Audio
 
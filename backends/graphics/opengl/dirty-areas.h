@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_OPENGL_DIRTY_AREAS_H
+#define BACKENDS_GRAPHICS_OPENGL_DIRTY_AREAS_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace OpenGL {
+
+/**
+ * The areas of a surface which changed since its last upload. Each area is
+ * uploaded with its own call, so the areas never overlap.
+ *
+ * This does not use any OpenGL functions.
+ */
+class DirtyAreas {
+public:
+	enum {
+		/**
+		 * Maximum number of separate dirty areas. Further areas are merged
+		 * with the area which grows the least by it.
+		 */
+		kMaxAreas = 8
+	};
+
+	/**
+	 * Add an area to the dirty areas. Areas overlapping it, or which can be
+	 * merged with it without adding pixels which are not dirty, are merged
+	 * with it.
+	 */
+	void add(const Common::Rect &area);
+
+	void clear() { _areas.clear(); }
+	bool empty() const { return _areas.empty(); }
+
+	const Common::Array<Common::Rect> &getAreas() const { return _areas; }
+
+private:
+	static uint getArea(const Common::Rect &rect) { return rect.width() * rect.height(); }
+
+	Common::Array<Common::Rect> _areas;
+};
+
+inline void DirtyAreas::add(const Common::Rect &area) {
+	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
+	// parameters is an empty rect. Thus, we never store empty areas.
+	if (area.isEmpty()) {
+		return;
+	}
+
+	// Merge all areas which overlap the new one, or which can be merged
+	// without uploading anything which is not dirty. Everything merged so
+	// far is checked again with the grown area.
+	Common::Rect merged = area;
+	for (uint i = 0; i < _areas.size();) {
+		Common::Rect bounds = merged;
+		bounds.extend(_areas[i]);
+
+		if (merged.intersects(_areas[i]) || getArea(bounds) <= getArea(merged) + getArea(_areas[i])) {
+			merged = bounds;
+			_areas.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_areas.size() < kMaxAreas) {
+		_areas.push_back(merged);
+		return;
+	}
+
+	// Too many separate areas. Merge with the area which results in the
+	// least additional pixels.
+	uint best = 0;
+	uint bestWaste = 0xFFFFFFFF;
+	for (uint i = 0; i < _areas.size(); ++i) {
+		Common::Rect bounds = merged;
+		bounds.extend(_areas[i]);
+
+		const uint waste = getArea(bounds) - getArea(merged) - getArea(_areas[i]);
+		if (waste < bestWaste) {
+			best = i;
+			bestWaste = waste;
+		}
+	}
+
+	merged.extend(_areas[best]);
+	_areas.remove_at(best);
+	add(merged);
+}
+
+} // End of namespace OpenGL
+
+#endif
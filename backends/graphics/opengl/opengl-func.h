@@ -105,6 +105,11 @@ GL_FUNC_DEF(void, glTexSubImage2D, (GLenum target, GLint level, GLint xoffset, G
 GL_FUNC_DEF(const GLubyte *, glGetString, (GLenum name));
 GL_FUNC_DEF(GLenum, glGetError, ());
 
+GL_FUNC_2_DEF(void, glGenBuffers, glGenBuffersARB, (GLsizei n, GLuint *buffers));
+GL_FUNC_2_DEF(void, glDeleteBuffers, glDeleteBuffersARB, (GLsizei n, const GLuint *buffers));
+GL_FUNC_2_DEF(void, glBindBuffer, glBindBufferARB, (GLenum target, GLuint buffer));
+GL_FUNC_2_DEF(void, glBufferData, glBufferDataARB, (GLenum target, GLsizeiptr size, const void *data, GLenum usage));
+
 #if !USE_FORCED_GLES
 GL_FUNC_2_DEF(void, glEnableVertexAttribArray, glEnableVertexAttribArrayARB, (GLuint index));
 GL_FUNC_2_DEF(void, glDisableVertexAttribArray, glDisableVertexAttribArrayARB, (GLuint index));
@@ -29,6 +29,7 @@
 #include "backends/graphics/opengl/shader.h"
 
 #include "common/array.h"
+#include "common/debug.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 #include "common/algorithm.h"
@@ -404,12 +405,16 @@ void OpenGLGraphicsManager::updateScreen() {
 	}
 
 	// Update changes to textures.
+	GLTexture::resetUploadStatistics();
 	_gameScreen->updateGLTexture();
 	if (_cursorVisible && _cursor) {
 		_cursor->updateGLTexture();
 	}
 	_overlay->updateGLTexture();
 
+	const GLTexture::UploadStatistics &uploadStatistics = GLTexture::getUploadStatistics();
+	debug(9, "OpenGL: %u texture uploads, %u bytes", uploadStatistics.uploads, uploadStatistics.bytes);
+
 	// Clear the screen buffer.
 	GL_CALL(glClear(GL_COLOR_BUFFER_BIT));
 
@@ -126,6 +126,12 @@ struct Context {
 	/** Whether FBO support is available or not. */
 	bool framebufferObjectSupported;
 
+	/** Whether GL_UNPACK_ROW_LENGTH is available or not. */
+	bool unpackSubImageSupported;
+
+	/** Whether PBO support is available or not. */
+	bool pixelBufferObjectSupported;
+
 #define GL_FUNC_DEF(ret, name, param) ret (GL_CALL_CONV *name)param
 #include "backends/graphics/opengl/opengl-func.h"
 #undef GL_FUNC_DEF
@@ -48,12 +48,22 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
     : _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
       _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
       _texCoords(), _glFilter(GL_NEAREST),
-      _glTexture(0) {
+      _glTexture(0), _usePixelBuffers(false), _pixelBuffers(), _nextPixelBuffer(0) {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+	if (_pixelBuffers[0]) {
+		GL_CALL_SAFE(glDeleteBuffers, (ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+	}
+}
+
+GLTexture::UploadStatistics GLTexture::_uploadStatistics = { 0, 0 };
+
+void GLTexture::resetUploadStatistics() {
+	_uploadStatistics.uploads = 0;
+	_uploadStatistics.bytes = 0;
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -69,15 +79,41 @@ void GLTexture::enableLinearFiltering(bool enable) {
 	GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, _glFilter));
 }
 
+void GLTexture::enablePixelBuffers(bool enable) {
+	_usePixelBuffers = enable;
+
+	destroyPixelBuffers();
+	createPixelBuffers();
+}
+
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+	destroyPixelBuffers();
+}
+
+void GLTexture::createPixelBuffers() {
+	if (_usePixelBuffers && g_context.pixelBufferObjectSupported) {
+		GL_CALL(glGenBuffers(ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+		_nextPixelBuffer = 0;
+	}
+}
+
+void GLTexture::destroyPixelBuffers() {
+	if (_pixelBuffers[0]) {
+		GL_CALL(glDeleteBuffers(ARRAYSIZE(_pixelBuffers), _pixelBuffers));
+		memset(_pixelBuffers, 0, sizeof(_pixelBuffers));
+	}
 }
 
 void GLTexture::create() {
 	// Release old texture name in case it exists.
 	destroy();
 
+	// Get new pixel buffers in case they are used.
+	createPixelBuffers();
+
 	// Get a new texture name.
 	GL_CALL(glGenTextures(1, &_glTexture));
 
@@ -143,29 +179,97 @@ void GLTexture::setSize(uint width, uint height) {
 }
 
 void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &src) {
+	if (area.isEmpty()) {
+		return;
+	}
+
 	// Set the texture on the active texture unit.
 	bind();
 
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+	// It is not possible to specify a pitch to glTexSubImage2D. With plain
+	// OpenGL (and GLES2 with GL_EXT_unpack_subimage) we set
+	// GL_UNPACK_ROW_LENGTH to upload exactly the area. However, OpenGL ES
+	// does not support GL_UNPACK_ROW_LENGTH otherwise. Thus, we are left with
+	// the following options:
 	//
-	// 1) (As we do right now) Simply always update the whole texture lines of
-	//    rect changed. This is simplest to implement. In case performance is
-	//    really an issue we can think of switching to another method.
+	// 1) (As we do right now) Simply update the whole texture lines of the
+	//    area changed. This is simplest to implement.
 	//
-	// 2) Copy the dirty rect to a temporary buffer and upload that by using
+	// 2) Copy the area to a temporary buffer and upload that by using
 	//    glTexSubImage2D. This is what the Android backend does. It is more
 	//    complicated though.
 	//
 	// 3) Use glTexSubImage2D per line changed. This is what the old OpenGL
 	//    graphics manager did but it is much slower! Thus, we do not use it.
-	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, area.top, src.w, area.height(),
-	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
+	const uint bytesPerPixel = src.format.bytesPerPixel;
+	Common::Rect uploadArea = area;
+	bool setRowLength = false;
+
+	if (area.width() * bytesPerPixel != src.pitch) {
+		if (g_context.unpackSubImageSupported) {
+			setRowLength = true;
+		} else {
+			uploadArea.left = 0;
+			uploadArea.right = src.w;
+		}
+	}
+
+	const void *pixels = src.getBasePtr(uploadArea.left, uploadArea.top);
+
+	if (setRowLength) {
+		assert(src.pitch % bytesPerPixel == 0);
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / bytesPerPixel));
+	}
+
+	if (_pixelBuffers[0]) {
+		// Copy the data into the buffer which was not used for the previous
+		// upload. The texture is filled from it without waiting for the
+		// previous upload to finish.
+		const uint size = (uploadArea.height() - 1) * src.pitch + uploadArea.width() * bytesPerPixel;
+
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_nextPixelBuffer]));
+		GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, pixels, GL_STREAM_DRAW));
+		_nextPixelBuffer = (_nextPixelBuffer + 1) % ARRAYSIZE(_pixelBuffers);
+
+		// The pixels are now given as offset into the buffer.
+		pixels = nullptr;
+	}
+
+	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, uploadArea.left, uploadArea.top,
+	                        uploadArea.width(), uploadArea.height(),
+	                        _glFormat, _glType, pixels));
+
+	if (_pixelBuffers[0]) {
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	}
+
+	if (setRowLength) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+	}
+
+	++_uploadStatistics.uploads;
+	_uploadStatistics.bytes += uploadArea.width() * uploadArea.height() * bytesPerPixel;
+}
+
+void GLTexture::updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src) {
+	if (g_context.unpackSubImageSupported) {
+		for (uint i = 0; i < areas.size(); ++i) {
+			updateArea(areas[i], src);
+		}
+		return;
+	}
+
+	// updateArea uploads the whole texture lines of each area. Merge the
+	// areas sharing lines first.
+	DirtyAreas lines;
+	for (uint i = 0; i < areas.size(); ++i) {
+		lines.add(Common::Rect(0, areas[i].top, src.w, areas[i].bottom));
+	}
+
+	for (uint i = 0; i < lines.getAreas().size(); ++i) {
+		updateArea(lines.getAreas()[i], src);
+	}
 }
 
 //
@@ -173,7 +277,7 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 //
 
 Surface::Surface()
-    : _allDirty(false), _dirtyArea() {
+    : _allDirty(false), _dirtyAreas() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -181,14 +285,8 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	assert(x + w <= dstSurf->w);
 	assert(y + h <= dstSurf->h);
 
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = Common::Rect(x, y, x + w, y + h);
-	} else {
-		_dirtyArea.extend(Common::Rect(x, y, x + w, y + h));
+	if (!_allDirty) {
+		_dirtyAreas.add(Common::Rect(x, y, x + w, y + h));
 	}
 
 	const byte *src = (const byte *)srcPtr;
@@ -214,12 +312,13 @@ void Surface::fill(uint32 color) {
 	flagDirty();
 }
 
-Common::Rect Surface::getDirtyArea() const {
+const Common::Array<Common::Rect> &Surface::getDirtyAreas() {
 	if (_allDirty) {
-		return Common::Rect(getWidth(), getHeight());
-	} else {
-		return _dirtyArea;
+		_dirtyAreas.clear();
+		_dirtyAreas.add(Common::Rect(getWidth(), getHeight()));
 	}
+
+	return _dirtyAreas.getAreas();
 }
 
 //
@@ -279,38 +378,42 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
 
-	// In case we use linear filtering we might need to duplicate the last
-	// pixel row/column to avoid glitches with filtering.
-	if (_glTexture.isLinearFilteringEnabled()) {
-		if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
-			uint height = dirtyArea.height();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		Common::Rect &dirtyArea = dirtyAreas[i];
 
-			const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
-			byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
+		// In case we use linear filtering we might need to duplicate the last
+		// pixel row/column to avoid glitches with filtering.
+		if (_glTexture.isLinearFilteringEnabled()) {
+			if (dirtyArea.right == _userPixelData.w && _userPixelData.w != _textureData.w) {
+				uint height = dirtyArea.height();
 
-			while (height-- > 0) {
-				memcpy(dst, src, _textureData.format.bytesPerPixel);
-				dst += _textureData.pitch;
-				src += _textureData.pitch;
-			}
+				const byte *src = (const byte *)_textureData.getBasePtr(_userPixelData.w - 1, dirtyArea.top);
+				byte *dst = (byte *)_textureData.getBasePtr(_userPixelData.w, dirtyArea.top);
 
-			// Extend the dirty area.
-			++dirtyArea.right;
-		}
+				while (height-- > 0) {
+					memcpy(dst, src, _textureData.format.bytesPerPixel);
+					dst += _textureData.pitch;
+					src += _textureData.pitch;
+				}
 
-		if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
-			const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
-			byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
-			memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
+				// Extend the dirty area.
+				++dirtyArea.right;
+			}
+
+			if (dirtyArea.bottom == _userPixelData.h && _userPixelData.h != _textureData.h) {
+				const byte *src = (const byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h - 1);
+				byte *dst = (byte *)_textureData.getBasePtr(dirtyArea.left, _userPixelData.h);
+				memcpy(dst, src, dirtyArea.width() * _textureData.format.bytesPerPixel);
 
-			// Extend the dirty area.
-			++dirtyArea.bottom;
+				// Extend the dirty area.
+				++dirtyArea.bottom;
+			}
 		}
 	}
 
-	_glTexture.updateArea(dirtyArea, _textureData);
+	_glTexture.updateAreas(dirtyAreas, _textureData);
 
 	// We should have handled everything, thus not dirty anymore.
 	clearDirty();
@@ -410,20 +513,24 @@ void TextureCLUT8::updateGLTexture() {
 	// Do the palette look up
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
-	if (outSurf->format.bytesPerPixel == 2) {
-		doPaletteLookUp<uint16>((uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint16 *)_palette);
-	} else if (outSurf->format.bytesPerPixel == 4) {
-		doPaletteLookUp<uint32>((uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
-		                        dirtyArea.width(), dirtyArea.height(),
-		                        outSurf->pitch, _clut8Data.pitch, (const uint32 *)_palette);
-	} else {
-		warning("TextureCLUT8::updateTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
+
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
+
+		if (outSurf->format.bytesPerPixel == 2) {
+			doPaletteLookUp<uint16>((uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        dirtyArea.width(), dirtyArea.height(),
+			                        outSurf->pitch, _clut8Data.pitch, (const uint16 *)_palette);
+		} else if (outSurf->format.bytesPerPixel == 4) {
+			doPaletteLookUp<uint32>((uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        (const byte *)_clut8Data.getBasePtr(dirtyArea.left, dirtyArea.top),
+			                        dirtyArea.width(), dirtyArea.height(),
+			                        outSurf->pitch, _clut8Data.pitch, (const uint32 *)_palette);
+		} else {
+			warning("TextureCLUT8::updateTexture: Unsupported pixel depth: %d", outSurf->format.bytesPerPixel);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -464,25 +571,29 @@ void TextureRGB555::updateTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> &dirtyAreas = getDirtyAreas();
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+	for (uint i = 0; i < dirtyAreas.size(); ++i) {
+		const Common::Rect &dirtyArea = dirtyAreas[i];
 
-	const uint16 *src = (const uint16 *)_rgb555Data.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgb555Data.pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		const uint16 *src = (const uint16 *)_rgb555Data.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgb555Data.pitch - 2 * dirtyArea.width();
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
+
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -510,6 +621,10 @@ TextureCLUT8GPU::TextureCLUT8GPU()
 	_clut8Pipeline->setFramebuffer(_target);
 	_clut8Pipeline->setPaletteTexture(&_paletteTexture);
 	_clut8Pipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+	// The CLUT8 data is uploaded every frame the game draws something, so
+	// do not let the look up wait for the previous upload.
+	_clut8Texture.enablePixelBuffers(true);
 }
 
 TextureCLUT8GPU::~TextureCLUT8GPU() {
@@ -616,14 +731,14 @@ void TextureCLUT8GPU::updateGLTexture() {
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		_clut8Texture.updateAreas(getDirtyAreas(), _clut8Data);
 		clearDirty();
 	}
 
 	// Update palette if necessary.
 	if (_paletteDirty) {
 		Graphics::Surface palSurface;
-		palSurface.init(256, 1, 256, _palette,
+		palSurface.init(256, 1, 256 * 4, _palette,
 #ifdef SCUMM_LITTLE_ENDIAN
 		                Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24) // ABGR8888
 #else
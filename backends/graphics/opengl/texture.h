@@ -24,10 +24,12 @@
 #define BACKENDS_GRAPHICS_OPENGL_TEXTURE_H
 
 #include "backends/graphics/opengl/opengl-sys.h"
+#include "backends/graphics/opengl/dirty-areas.h"
 
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 namespace OpenGL {
@@ -89,6 +91,18 @@ public:
 	 */
 	void setSize(uint width, uint height);
 
+	/**
+	 * Enable or disable uploading the texture data through pixel buffer
+	 * objects.
+	 *
+	 * Two buffers are used in turns, so that a new upload does not need to
+	 * wait until the driver finished the previous one. This has no effect
+	 * when the context does not support PBOs.
+	 *
+	 * @param enable true to enable and false to disable.
+	 */
+	void enablePixelBuffers(bool enable);
+
 	/**
 	 * Copy image data to the texture.
 	 *
@@ -99,6 +113,38 @@ public:
 	 */
 	void updateArea(const Common::Rect &area, const Graphics::Surface &src);
 
+	/**
+	 * Copy several areas of image data to the texture.
+	 *
+	 * When only whole texture lines can be uploaded, the areas sharing lines
+	 * are uploaded together, so that no line is uploaded twice.
+	 *
+	 * @param areas    The areas to update.
+	 * @param src      Surface for the whole texture containing the pixel data
+	 *                 to upload.
+	 */
+	void updateAreas(const Common::Array<Common::Rect> &areas, const Graphics::Surface &src);
+
+	/**
+	 * Statistics about the texture uploads of all textures.
+	 */
+	struct UploadStatistics {
+		/** Number of glTexSubImage2D calls. */
+		uint32 uploads;
+		/** Number of bytes passed to glTexSubImage2D. */
+		uint32 bytes;
+	};
+
+	/**
+	 * Query the upload statistics since the last reset.
+	 */
+	static const UploadStatistics &getUploadStatistics() { return _uploadStatistics; }
+
+	/**
+	 * Reset the upload statistics.
+	 */
+	static void resetUploadStatistics();
+
 	/**
 	 * Query the GL texture's width.
 	 */
@@ -143,6 +189,15 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+
+	bool _usePixelBuffers;
+	GLuint _pixelBuffers[2];
+	uint _nextPixelBuffer;
+
+	void createPixelBuffers();
+	void destroyPixelBuffers();
+
+	static UploadStatistics _uploadStatistics;
 };
 
 /**
@@ -201,7 +256,7 @@ public:
 	void fill(uint32 color);
 
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyAreas.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -239,12 +294,17 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyAreas.clear(); }
 
-	Common::Rect getDirtyArea() const;
+	/**
+	 * Query the dirty areas, which do not overlap each other.
+	 *
+	 * When the whole surface is dirty this is a single area covering it.
+	 */
+	const Common::Array<Common::Rect> &getDirtyAreas();
 private:
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	DirtyAreas _dirtyAreas;
 };
 
 /**
@@ -26,6 +26,7 @@
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/mutex.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
@@ -151,7 +152,8 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_screenFormat(Graphics::PixelFormat::createFormatCLUT8()),
 	_cursorFormat(Graphics::PixelFormat::createFormatCLUT8()),
 	_overlayscreen(0), _tmpscreen2(0),
-	_scalerProc(0), _screenChangeCount(0),
+	_scalerProc(0), _scalerTime(0), _scalerTimeFrames(0), _scalerTimeAverage(0),
+	_screenChangeCount(0),
 	_mouseData(nullptr), _mouseSurface(nullptr),
 	_mouseOrigSurface(nullptr), _cursorDontScale(false), _cursorPaletteDisabled(true),
 	_currentShakePos(0), _newShakePos(0),
@@ -197,6 +199,9 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 #endif
 	_scalerType = 0;
 
+	if (ConfMan.hasKey("scaler_threads"))
+		_bandedScaler.setThreads(ConfMan.getInt("scaler_threads"));
+
 #if !defined(_WIN32_WCE) && !defined(__SYMBIAN32__)
 	_videoMode.fullscreen = ConfMan.getBool("fullscreen");
 #else
@@ -1191,6 +1196,30 @@ void SurfaceSdlGraphicsManager::updateShader() {
 	// hardware-based up-scaling (sharp-bilinear-simple, etc.)
 }
 
+/** Get the current time in microseconds, for timing the scalers. */
+static uint64 getMicroseconds() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	const Uint64 counter = SDL_GetPerformanceCounter();
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+void SurfaceSdlGraphicsManager::updateScalerTiming(uint64 time) {
+	_scalerTime += time;
+	if (++_scalerTimeFrames < kScalerTimingFrames)
+		return;
+
+	_scalerTimeAverage = (uint32)(_scalerTime / _scalerTimeFrames);
+	debug(2, "Scaling took %u us per frame on average, using %u thread(s)",
+		_scalerTimeAverage, _bandedScaler.getThreads());
+
+	_scalerTime = 0;
+	_scalerTimeFrames = 0;
+}
+
 void SurfaceSdlGraphicsManager::internUpdateScreen() {
 	SDL_Surface *srcSurf, *origSurf;
 	int height, width;
@@ -1283,6 +1312,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwScreen->pitch;
 
+		const uint64 scaleStart = getMicroseconds();
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			int dst_y = r->y + _currentShakePos;
 			int dst_h = 0;
@@ -1305,8 +1336,8 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_y = real2Aspect(dst_y);
 
 				assert(scalerProc != NULL);
-				scalerProc((byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h);
+				_bandedScaler.add(scalerProc, (byte *)srcSurf->pixels + (r->x * 2 + 2) + (r->y + 1) * srcPitch, srcPitch,
+					(byte *)_hwScreen->pixels + rx1 * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, scale1);
 			}
 
 			r->x = rx1;
@@ -1315,10 +1346,20 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			r->h = dst_h * scale1;
 
 #ifdef USE_SCALERS
-			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible)
-				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);		
+			// The stretched rows may be overwritten by overlapping rects,
+			// so each rect needs to be scaled right before it is stretched.
+			if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayVisible) {
+				_bandedScaler.run();
+				r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering);
+			}
 #endif
 		}
+
+		// Scale the queued rects at once, sharing them between the threads
+		_bandedScaler.run();
+
+		updateScalerTiming(getMicroseconds() - scaleStart);
+
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
@@ -2541,6 +2582,30 @@ bool SurfaceSdlGraphicsManager::handleScalerHotkeys(Common::KeyCode key) {
 		return true;
 	}
 
+	// Ctrl-Alt-t toggles running the scaler on several threads
+	if (key == 't') {
+		const uint oldThreads = _bandedScaler.getThreads();
+		const uint oldTimeAverage = _scalerTimeFrames ? (uint)(_scalerTime / _scalerTimeFrames) : _scalerTimeAverage;
+
+		_bandedScaler.setThreads(oldThreads > 1 ? 1 : (uint)BandedScaler::kMaxThreads);
+		_scalerTime = 0;
+		_scalerTimeFrames = 0;
+		_scalerTimeAverage = 0;
+
+#ifdef USE_OSD
+		const Common::String message = Common::String::format("%s: %u\n%s: %u us",
+			_("Scaler threads"), _bandedScaler.getThreads(),
+			_("Previous scaling time per frame"), oldTimeAverage);
+		displayMessageOnOSD(message.c_str());
+#endif
+		debug(2, "Scaling took %u us per frame on average with %u thread(s), now using %u thread(s)",
+			oldTimeAverage, oldThreads, _bandedScaler.getThreads());
+
+		_forceRedraw = true;
+		internUpdateScreen();
+		return true;
+	}
+
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 	// Ctrl+Alt+s cycles through scaling mode (0 to 3)
 	if (key == 's') {
@@ -2660,7 +2725,7 @@ bool SurfaceSdlGraphicsManager::isScalerHotkey(const Common::Event &event) {
 			if (keyValue >= ARRAYSIZE(s_gfxModeSwitchTable))
 				return false;
 		}
-		if (event.kbd.keycode == 'f')
+		if (event.kbd.keycode == 'f' || event.kbd.keycode == 't')
 			return true;
 #if SDL_VERSION_ATLEAST(2, 0, 0)
 		if (event.kbd.keycode == 's')
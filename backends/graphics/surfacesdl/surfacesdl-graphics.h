@@ -286,7 +286,23 @@ protected:
 #endif
 
 	ScalerProc *_scalerProc;
+	/** Runs _scalerProc on the dirty rects, in parallel bands if enabled */
+	BandedScaler _bandedScaler;
 	int _scalerType;
+
+	enum {
+		/** Number of frames the time spent scaling is averaged over */
+		kScalerTimingFrames = 256
+	};
+
+	/** Time spent scaling since the last average was taken, in microseconds */
+	uint64 _scalerTime;
+	uint32 _scalerTimeFrames;
+	/** Average time spent scaling a frame, in microseconds */
+	uint32 _scalerTimeAverage;
+
+	/** Add the time spent scaling a frame to the average */
+	void updateScalerTiming(uint64 time);
 	int _transactionMode;
 
 	// Indicates whether it is needed to free _hwSurface in destructor
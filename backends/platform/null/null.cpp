@@ -27,6 +27,8 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_stdout
 #define FORBIDDEN_SYMBOL_EXCEPTION_stderr
 #define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
 
 #include "backends/modular-backend.h"
 #include "base/main.h"
@@ -40,6 +42,11 @@
 #include "audio/mixer_intern.h"
 #include "common/scummsys.h"
 
+#if defined(POSIX)
+	#include <sys/time.h>
+	#include <unistd.h>
+#endif
+
 /*
  * Include header files needed for the getFilesystemFactory() method.
  */
@@ -68,6 +75,11 @@ public:
 	virtual void getTimeAndDate(TimeDate &t) const {}
 
 	virtual void logMessage(LogMessageType::Type type, const char *message);
+
+private:
+#if defined(POSIX)
+	timeval _startTime;
+#endif
 };
 
 OSystem_NULL::OSystem_NULL() {
@@ -82,9 +94,17 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+	#if defined(POSIX)
+		gettimeofday(&_startTime, 0);
+	#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
+	// The timer manager uses a mutex, so it has to go before the mutex
+	// manager deleted by ModularBackend
+	delete _timerManager;
+	_timerManager = 0;
 }
 
 void OSystem_NULL::initBackend() {
@@ -109,10 +129,21 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
+#if defined(POSIX)
+	// Engines wait for the time to pass, e.g. for the splash screen
+	timeval curTime;
+	gettimeofday(&curTime, 0);
+	return (uint32)(((curTime.tv_sec - _startTime.tv_sec) * 1000) +
+			((curTime.tv_usec - _startTime.tv_usec) / 1000));
+#else
 	return 0;
+#endif
 }
 
 void OSystem_NULL::delayMillis(uint msecs) {
+#if defined(POSIX)
+	usleep(msecs * 1000);
+#endif
 }
 
 void OSystem_NULL::logMessage(LogMessageType::Type type, const char *message) {
@@ -21,6 +21,7 @@
  */
 
 #include "common/archive.h"
+#include "common/atomic.h"
 #include "common/fs.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -92,6 +93,8 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	addChildSet(node._arc);
+	invalidateLookupCache();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -170,9 +173,11 @@ void SearchSet::addSubDirectoriesMatching(const FSNode &directory, String origPa
 void SearchSet::remove(const String &name) {
 	ArchiveNodeList::iterator it = find(name);
 	if (it != _list.end()) {
+		removeChildSet(it->_arc);
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateLookupCache();
 	}
 }
 
@@ -187,6 +192,8 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_childSets.clear();
+	invalidateLookupCache();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -200,22 +207,86 @@ void SearchSet::setPriority(const String &name, int priority) {
 		return;
 
 	Node node(*it);
+	removeChildSet(it->_arc);
 	_list.erase(it);
 	node._priority = priority;
 	insert(node);
 }
 
-bool SearchSet::hasFile(const String &name) const {
-	if (name.empty())
-		return false;
+void SearchSet::addChildSet(const Archive *archive) {
+	const SearchSet *set = dynamic_cast<const SearchSet *>(archive);
+	if (set)
+		_childSets.push_back(set);
+}
+
+void SearchSet::removeChildSet(const Archive *archive) {
+	const SearchSet *set = dynamic_cast<const SearchSet *>(archive);
+	if (set)
+		_childSets.remove(set);
+}
+
+// The last generation given to any SearchSet. Sets may be changed from
+// different threads, as long as each one is only used by one at a time.
+static volatile uint32 s_lastGeneration = 0;
 
+void SearchSet::invalidateLookupCache() {
+	_generation = atomicAdd(&s_lastGeneration, 1);
+}
+
+uint32 SearchSet::getGeneration() const {
+	uint32 generation = _generation;
+	for (List<const SearchSet *>::const_iterator it = _childSets.begin(); it != _childSets.end(); ++it)
+		generation = MAX(generation, (*it)->getGeneration());
+	return generation;
+}
+
+Archive *SearchSet::search(const String &name) const {
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(name))
-			return true;
+			return it->_arc;
+	}
+
+	return nullptr;
+}
+
+Archive *SearchSet::lookup(const String &name) const {
+	_lookups++;
+
+	const uint32 generation = getGeneration();
+	if (generation != _lookupCacheGeneration) {
+		if (!_lookupCache.empty()) {
+			_lookupCache.clear();
+			_lookupCacheInvalidations++;
+		}
+		_lookupCacheGeneration = generation;
+	}
+
+	LookupCache::const_iterator cached = _lookupCache.find(name);
+	if (cached != _lookupCache.end()) {
+		_lookupCacheHits++;
+		return cached->_value;
 	}
 
-	return false;
+	Archive *archive = search(name);
+	_lookupCache[name] = archive;
+	return archive;
+}
+
+SearchSet::LookupStatistics SearchSet::getLookupStatistics() const {
+	LookupStatistics stats;
+	stats.lookups = _lookups;
+	stats.cacheHits = _lookupCacheHits;
+	stats.cacheSize = _lookupCache.size();
+	stats.invalidations = _lookupCacheInvalidations;
+	return stats;
+}
+
+bool SearchSet::hasFile(const String &name) const {
+	if (name.empty())
+		return false;
+
+	return lookup(name) != nullptr;
 }
 
 int SearchSet::listMatchingMembers(ArchiveMemberList &list, const String &pattern) const {
@@ -242,21 +313,32 @@ const ArchiveMemberPtr SearchSet::getMember(const String &name) const {
 	if (name.empty())
 		return ArchiveMemberPtr();
 
-	ArchiveNodeList::const_iterator it = _list.begin();
-	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(name))
-			return it->_arc->getMember(name);
-	}
+	Archive *archive = lookup(name);
+	if (!archive)
+		return ArchiveMemberPtr();
 
-	return ArchiveMemberPtr();
+	return archive->getMember(name);
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMember(const String &name) const {
 	if (name.empty())
 		return nullptr;
 
+	Archive *archive = lookup(name);
+	if (archive) {
+		SeekableReadStream *stream = archive->createReadStreamForMember(name);
+		if (stream)
+			return stream;
+	}
+
+	// Either no archive reported having the member, or it could not be
+	// opened. Some archives open members they do not report, so ask all the
+	// others.
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
+		if (it->_arc == archive)
+			continue;
+
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(name);
 		if (stream)
 			return stream;
@@ -24,6 +24,8 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -152,7 +154,47 @@ class SearchSet : public Archive {
 	// Add an archive keeping the list sorted by descending priority.
 	void insert(const Node& node);
 
+	/**
+	 * Member names looked up so far, mapped to the archive with the highest
+	 * priority containing them, or to nullptr if none does. Names are
+	 * compared case-insensitively, like the archives themselves do.
+	 */
+	typedef HashMap<String, Archive *, IgnoreCase_Hash, IgnoreCase_EqualTo> LookupCache;
+	mutable LookupCache _lookupCache;
+
+	mutable uint32 _lookups;
+	mutable uint32 _lookupCacheHits;
+	mutable uint32 _lookupCacheInvalidations;
+
+	// Set to a new value of a counter shared by all SearchSets whenever
+	// archives are added, removed or reprioritized.
+	uint32 _generation;
+	// The value of getGeneration() _lookupCache was filled with.
+	mutable uint32 _lookupCacheGeneration;
+	// SearchSets among the archives, whose changes affect our lookups too.
+	List<const SearchSet *> _childSets;
+
+	// The highest generation of this set and all nested sets. As the shared
+	// counter only ever increases, this changes whenever any of them
+	// changes.
+	uint32 getGeneration() const;
+
+	// Find the archive with the highest priority containing a member.
+	Archive *lookup(const String &name) const;
+
+	// Search the archives for a member, ignoring _lookupCache.
+	Archive *search(const String &name) const;
+
+	// Note that the set of archives changed, so that looked up names are
+	// forgotten.
+	void invalidateLookupCache();
+
+	// Keep track of archives which are SearchSets themselves.
+	void addChildSet(const Archive *archive);
+	void removeChildSet(const Archive *archive);
+
 public:
+	SearchSet() : _lookups(0), _lookupCacheHits(0), _lookupCacheInvalidations(0), _generation(0), _lookupCacheGeneration(0) {}
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -247,6 +289,27 @@ public:
 	 * opening the first file encountered that matches the name.
 	 */
 	virtual SeekableReadStream *createReadStreamForMember(const String &name) const;
+
+	/**
+	 * Statistics about the member lookups, for debugging purposes.
+	 *
+	 * The archive containing a member is only searched for the first time the
+	 * member is looked up. The result is remembered until archives are added
+	 * to, removed from or reprioritized in the set, or in a SearchSet nested
+	 * in it.
+	 */
+	struct LookupStatistics {
+		/** Number of member lookups. */
+		uint32 lookups;
+		/** Number of lookups that did not need to search the archives. */
+		uint32 cacheHits;
+		/** Number of names currently remembered. */
+		uint32 cacheSize;
+		/** Number of times the remembered names were discarded. */
+		uint32 invalidations;
+	};
+
+	LookupStatistics getLookupStatistics() const;
 };
 
 
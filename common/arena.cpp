@@ -0,0 +1,235 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use pthread.h
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/arena.h"
+#include "common/atomic.h"
+#include "common/memory.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#ifdef USE_PTHREADS
+#include <pthread.h>
+#endif
+
+namespace Common {
+
+volatile uint32 g_heapAllocations = 0;
+
+namespace {
+
+// The frame allocator of each thread.
+#ifdef USE_PTHREADS
+
+pthread_once_t s_keysOnce = PTHREAD_ONCE_INIT;
+pthread_key_t s_frameAllocatorKey;
+
+void deleteFrameAllocator(void *allocator) {
+	delete (FrameAllocator *)allocator;
+}
+
+void createKeys() {
+	pthread_key_create(&s_frameAllocatorKey, deleteFrameAllocator);
+}
+
+FrameAllocator *getFrameAllocator() {
+	pthread_once(&s_keysOnce, createKeys);
+	return (FrameAllocator *)pthread_getspecific(s_frameAllocatorKey);
+}
+
+void setFrameAllocator(FrameAllocator *allocator) {
+	pthread_once(&s_keysOnce, createKeys);
+	pthread_setspecific(s_frameAllocatorKey, allocator);
+}
+
+#else
+
+FrameAllocator *s_frameAllocator = nullptr;
+
+FrameAllocator *getFrameAllocator() {
+	return s_frameAllocator;
+}
+
+void setFrameAllocator(FrameAllocator *allocator) {
+	s_frameAllocator = allocator;
+}
+
+#endif
+
+} // End of anonymous namespace
+
+Arena::Arena(size_t blockSize)
+	: _blockSize(blockSize), _first(nullptr), _current(nullptr), _used(0), _allocations(0), _reserved(0) {
+}
+
+Arena::~Arena() {
+	while (_first) {
+		Block *next = _first->next;
+		::free(_first);
+		_first = next;
+	}
+}
+
+void *Arena::allocate(size_t size) {
+	size = (size + kAlignment - 1) & ~(size_t)(kAlignment - 1);
+
+	if (!_current || _used + size > _current->size)
+		nextBlock(size);
+
+	void *ptr = (byte *)_current + kHeaderSize + _used;
+	_used += size;
+	_allocations++;
+	return ptr;
+}
+
+void Arena::nextBlock(size_t size) {
+	Block *next = _current ? _current->next : _first;
+
+	// Allocate a new block, unless the next one is large enough. Blocks
+	// which are too small stay behind it for later reuse.
+	if (!next || next->size < size) {
+		const size_t blockSize = MAX(_blockSize, size);
+
+		Block *block = (Block *)::malloc(kHeaderSize + blockSize);
+		if (!block)
+			::error("Common::Arena: failure to allocate %u bytes", (uint)blockSize);
+		block->next = next;
+		block->size = blockSize;
+
+		if (_current)
+			_current->next = block;
+		else
+			_first = block;
+
+		_reserved += kHeaderSize + blockSize;
+		next = block;
+	}
+
+	_current = next;
+	_used = 0;
+}
+
+char *Arena::copyString(const char *str, size_t length) {
+	char *copy = (char *)allocate(length + 1);
+	memcpy(copy, str, length);
+	copy[length] = 0;
+	return copy;
+}
+
+Arena::Mark Arena::getMark() const {
+	Mark mark;
+	mark._block = _current;
+	mark._used = _used;
+	mark._allocations = _allocations;
+	return mark;
+}
+
+void Arena::release(const Mark &mark) {
+	_current = mark._block;
+	_used = mark._used;
+	_allocations = mark._allocations;
+}
+
+void Arena::reset() {
+	_current = nullptr;
+	_used = 0;
+	_allocations = 0;
+}
+
+void Arena::freeUnusedBlocks() {
+	Block *&unused = _current ? _current->next : _first;
+
+	while (unused) {
+		Block *next = unused->next;
+		_reserved -= kHeaderSize + unused->size;
+		::free(unused);
+		unused = next;
+	}
+}
+
+void *SharedArena::allocate(size_t size) {
+	_lock.wait();
+	void *ptr = _arena.allocate(size);
+	_lock.post();
+	return ptr;
+}
+
+char *SharedArena::copyString(const char *str, size_t length) {
+	char *copy = (char *)allocate(length + 1);
+	memcpy(copy, str, length);
+	copy[length] = 0;
+	return copy;
+}
+
+void SharedArena::reset() {
+	_lock.wait();
+	_arena.reset();
+	_lock.post();
+}
+
+uint32 SharedArena::getAllocationCount() const {
+	_lock.wait();
+	const uint32 count = _arena.getAllocationCount();
+	_lock.post();
+	return count;
+}
+
+size_t SharedArena::getReservedSize() const {
+	_lock.wait();
+	const size_t size = _arena.getReservedSize();
+	_lock.post();
+	return size;
+}
+
+FrameAllocator::FrameAllocator() : _frameStartHeapAllocations(atomicLoad(&g_heapAllocations)) {
+	_lastFrame.arenaAllocations = 0;
+	_lastFrame.heapAllocations = 0;
+	_lastFrame.arenaSize = 0;
+}
+
+FrameAllocator &FrameAllocator::forCurrentThread() {
+	FrameAllocator *allocator = getFrameAllocator();
+	if (!allocator) {
+		allocator = new FrameAllocator;
+		setFrameAllocator(allocator);
+	}
+	return *allocator;
+}
+
+FrameAllocator *FrameAllocator::getForCurrentThread() {
+	return getFrameAllocator();
+}
+
+void FrameAllocator::endFrame() {
+	const uint32 heapAllocations = atomicLoad(&g_heapAllocations);
+
+	_lastFrame.arenaAllocations = getAllocationCount();
+	_lastFrame.heapAllocations = heapAllocations - _frameStartHeapAllocations;
+	_lastFrame.arenaSize = getReservedSize();
+
+	_frameStartHeapAllocations = heapAllocations;
+	reset();
+}
+
+} // End of namespace Common
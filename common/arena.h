@@ -0,0 +1,248 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * An arena hands out memory by advancing a pointer in large blocks, which is
+ * much cheaper than allocating every piece on the heap. The memory is not
+ * freed piece by piece, but all at once, either completely with reset(), or
+ * back to a previously taken Mark with release() or an ArenaScope.
+ *
+ * Blocks are kept for reuse after being released, so an arena which is
+ * reset regularly stops allocating heap memory once it reached its peak size.
+ *
+ * Destructors are not called for objects in the arena, so it is meant for
+ * plain data like temporary pixel buffers, arrays and strings.
+ *
+ * An arena is not synchronized: every thread needs to use its own one, like
+ * the FrameAllocator, or a SharedArena.
+ */
+class Arena : NonCopyable {
+	struct Block {
+		Block *next;
+		size_t size;
+	};
+
+public:
+	/**
+	 * A position in the arena, to release everything allocated after it.
+	 */
+	class Mark {
+		friend class Arena;
+
+		Block *_block;
+		size_t _used;
+		uint32 _allocations;
+	};
+
+	/**
+	 * @param blockSize Size of the blocks the memory is taken from.
+	 *                  Larger allocations get a block of their own.
+	 */
+	explicit Arena(size_t blockSize = 64 * 1024);
+	~Arena();
+
+	/**
+	 * Allocate memory, aligned for any type, which stays valid until it is
+	 * released.
+	 */
+	void *allocate(size_t size);
+
+	/**
+	 * Allocate an uninitialized array of the given number of elements.
+	 */
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T));
+	}
+
+	/**
+	 * Copy a string into the arena.
+	 *
+	 * @return the zero terminated copy
+	 */
+	char *copyString(const char *str, size_t length);
+	char *copyString(const String &str) { return copyString(str.c_str(), str.size()); }
+
+	/**
+	 * Get the current position in the arena.
+	 */
+	Mark getMark() const;
+
+	/**
+	 * Release all memory allocated after the given position was taken.
+	 */
+	void release(const Mark &mark);
+
+	/**
+	 * Release all allocated memory, keeping the blocks for reuse.
+	 */
+	void reset();
+
+	/**
+	 * Free the blocks which are not in use at the moment.
+	 */
+	void freeUnusedBlocks();
+
+	/**
+	 * Number of allocations since the last reset.
+	 */
+	uint32 getAllocationCount() const { return _allocations; }
+
+	/**
+	 * Total size of the blocks allocated from the heap.
+	 */
+	size_t getReservedSize() const { return _reserved; }
+
+private:
+	enum {
+		/** Alignment of all allocations, enough for any type including vectors. */
+		kAlignment = 16,
+		kHeaderSize = (sizeof(Block) + kAlignment - 1) & ~(kAlignment - 1)
+	};
+
+	const size_t _blockSize;
+
+	Block *_first;
+	Block *_current;
+	/** Bytes used in the current block. */
+	size_t _used;
+
+	uint32 _allocations;
+	size_t _reserved;
+
+	/** Make the next block the current one, ensuring it can hold size bytes. */
+	void nextBlock(size_t size);
+};
+
+/**
+ * Releases all memory allocated from an arena while the scope existed, when
+ * it goes out of scope.
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena &arena) : _arena(arena), _mark(arena.getMark()) {}
+	~ArenaScope() { _arena.release(_mark); }
+
+private:
+	Arena &_arena;
+	const Arena::Mark _mark;
+};
+
+/**
+ * An arena which several threads can allocate from at the same time. Marks
+ * are not offered, since the allocations of the threads are interleaved.
+ */
+class SharedArena : NonCopyable {
+public:
+	explicit SharedArena(size_t blockSize = 64 * 1024) : _arena(blockSize), _lock(1) {}
+
+	void *allocate(size_t size);
+
+	template<class T>
+	T *allocateArray(size_t count) {
+		return (T *)allocate(count * sizeof(T));
+	}
+
+	char *copyString(const char *str, size_t length);
+	char *copyString(const String &str) { return copyString(str.c_str(), str.size()); }
+
+	/**
+	 * Release all allocated memory. No other thread may use memory from the
+	 * arena any more.
+	 */
+	void reset();
+
+	uint32 getAllocationCount() const;
+	size_t getReservedSize() const;
+
+private:
+	Arena _arena;
+	// A semaphore with a count of 1 serves as the lock, because
+	// Common::Mutex needs OSystem, which is not available everywhere an
+	// arena might be used.
+	mutable Semaphore _lock;
+};
+
+/**
+ * Arena for the temporary memory which the engine needs while it prepares a
+ * frame. Every thread has its own frame allocator, created the first time
+ * the thread asks for it.
+ *
+ * Engines using it call endFrame() after OSystem::updateScreen(), which
+ * releases the memory of the frame and updates the per frame statistics.
+ * Nothing allocated from the frame allocator may be used after that.
+ */
+class FrameAllocator : public Arena {
+public:
+	struct FrameStatistics {
+		/** Number of allocations from the frame arena. */
+		uint32 arenaAllocations;
+		/** Number of heap allocations counted in g_heapAllocations, by all threads. */
+		uint32 heapAllocations;
+		/** Size of the frame arena. */
+		size_t arenaSize;
+	};
+
+	/**
+	 * Get the frame allocator of the calling thread, creating it if needed.
+	 */
+	static FrameAllocator &forCurrentThread();
+
+	/**
+	 * Get the frame allocator of the calling thread, or nullptr if it did
+	 * not use one so far.
+	 */
+	static FrameAllocator *getForCurrentThread();
+
+	/**
+	 * Release the memory of the current frame, and record its statistics.
+	 */
+	void endFrame();
+
+	/**
+	 * Get the statistics of the last frame ended with endFrame().
+	 */
+	const FrameStatistics &getLastFrameStatistics() const { return _lastFrame; }
+
+private:
+	FrameAllocator();
+
+	uint32 _frameStartHeapAllocations;
+	FrameStatistics _lastFrame;
+};
+
+} // End of namespace Common
+
+/** Shortcut for accessing the frame allocator of the calling thread. */
+#define FrameArena		Common::FrameAllocator::forCurrentThread()
+
+#endif
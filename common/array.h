@@ -309,6 +309,7 @@ protected:
 			_storage = (T *)malloc(sizeof(T) * capacity);
 			if (!_storage)
 				::error("Common::Array: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
+			countHeapAllocation();
 		} else {
 			_storage = nullptr;
 		}
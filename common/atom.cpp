@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include "common/atom.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/system.h"
+
+namespace Common {
+
+namespace {
+
+struct CString_EqualTo {
+	bool operator()(const char *x, const char *y) const { return strcmp(x, y) == 0; }
+};
+
+/** Maps the strings of the atoms, stored in their entries, to the entries. */
+typedef HashMap<const char *, const void *, Hash<const char *>, CString_EqualTo> InternTable;
+
+InternTable *g_internTable = nullptr;
+MutexRef g_internTableMutex = nullptr;
+
+void lockInternTable() {
+	// Like for the reference counts of String, the mutex can only be used
+	// once the backend is initialized. Before that, there is only one thread.
+	if (!g_system || !g_system->backendInitialized())
+		return;
+	if (!g_internTableMutex)
+		g_internTableMutex = g_system->createMutex();
+	g_system->lockMutex(g_internTableMutex);
+}
+
+void unlockInternTable() {
+	if (g_internTableMutex)
+		g_system->unlockMutex(g_internTableMutex);
+}
+
+} // End of anonymous namespace
+
+const Atom::Entry *Atom::intern(const char *str) {
+	assert(str);
+	if (!*str)
+		return nullptr;
+
+	lockInternTable();
+
+	if (!g_internTable)
+		g_internTable = new InternTable();
+
+	const Entry *entry = (const Entry *)g_internTable->getVal(str, nullptr);
+	if (!entry) {
+		Entry *newEntry = new Entry();
+		newEntry->string = str;
+		newEntry->hash = hashit(str);
+		g_internTable->setVal(newEntry->string.c_str(), newEntry);
+		entry = newEntry;
+	}
+
+	unlockInternTable();
+	return entry;
+}
+
+const String &Atom::toString() const {
+	static const String empty;
+	return _entry ? _entry->string : empty;
+}
+
+void Atom::releaseMutex() {
+	if (g_internTableMutex) {
+		g_system->deleteMutex(g_internTableMutex);
+		g_internTableMutex = nullptr;
+	}
+}
+
+} // End of namespace Common
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOM_H
+#define COMMON_ATOM_H
+
+#include "common/scummsys.h"
+#include "common/func.h"
+#include "common/str.h"
+
+namespace Common {
+
+/**
+ * An immutable, interned string, for names which are compared or looked up
+ * often, like symbol or property names.
+ *
+ * All atoms with the same content share one entry in a global table, which
+ * also holds the hash of the string. Therefore comparing two atoms only
+ * compares pointers, and hashing them does not look at the string at all.
+ * Creating an atom however needs a lookup in the table, so code should keep
+ * atoms around instead of creating them from strings over and over.
+ *
+ * Entries are never removed from the table, so atoms should only be created
+ * for names from a limited set, not for arbitrary text.
+ *
+ * Atoms can be created and used from any thread.
+ */
+class Atom {
+public:
+	/** Create an atom for the empty string. */
+	Atom() : _entry(nullptr) {}
+
+	explicit Atom(const char *str) : _entry(intern(str)) {}
+	explicit Atom(const String &str) : _entry(intern(str.c_str())) {}
+
+	bool operator==(const Atom &atom) const { return _entry == atom._entry; }
+	bool operator!=(const Atom &atom) const { return _entry != atom._entry; }
+
+	bool empty() const { return _entry == nullptr; }
+
+	const String &toString() const;
+	const char *c_str() const { return toString().c_str(); }
+
+	/** The hash of the string, as computed by hashit(). */
+	uint hash() const { return _entry ? _entry->hash : 0; }
+
+	/**
+	 * Free the resources used for synchronizing the access to the global
+	 * table, when the backend is destroyed.
+	 */
+	static void releaseMutex();
+
+private:
+	struct Entry {
+		String string;
+		uint hash;
+	};
+
+	const Entry *_entry;
+
+	static const Entry *intern(const char *str);
+};
+
+template<>
+struct Hash<Atom> {
+	uint operator()(const Atom &atom) const {
+		return atom.hash();
+	}
+};
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+
+/**
+ * @file
+ * Minimal set of atomic operations on 32 bit values, for data shared between
+ * threads without a mutex.
+ *
+ * SCUMMVM_ATOMICS is defined when the compiler provides them. Otherwise the
+ * functions are still available but are plain memory accesses, so code
+ * depending on them being atomic must check for SCUMMVM_ATOMICS and fall
+ * back to using a Common::Mutex.
+ */
+
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	#define SCUMMVM_ATOMICS
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	// On x86 MSVC gives volatile accesses acquire/release semantics
+	#define SCUMMVM_ATOMICS
+	extern "C" long _InterlockedExchangeAdd(long volatile *addend, long value);
+	#pragma intrinsic(_InterlockedExchangeAdd)
+#endif
+
+namespace Common {
+
+/**
+ * Read a value written by another thread. No memory access following this
+ * call can be reordered before it.
+ */
+inline uint32 atomicLoad(const volatile uint32 *ptr) {
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+	return *ptr;
+#endif
+}
+
+/**
+ * Write a value to be read by another thread. No memory access preceding
+ * this call can be reordered after it.
+ */
+inline void atomicStore(volatile uint32 *ptr, uint32 value) {
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#else
+	*ptr = value;
+#endif
+}
+
+/**
+ * Add a value to a variable shared between threads.
+ *
+ * @return The new value of the variable.
+ */
+inline uint32 atomicAdd(volatile uint32 *ptr, uint32 value) {
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	return __atomic_add_fetch(ptr, value, __ATOMIC_ACQ_REL);
+#elif defined(SCUMMVM_ATOMICS)
+	return (uint32)_InterlockedExchangeAdd((long volatile *)ptr, (long)value) + value;
+#else
+	return *ptr += value;
+#endif
+}
+
+/**
+ * Read a pointer written by another thread, see atomicLoad() above.
+ */
+template<class T>
+inline T *atomicLoad(T *const volatile *ptr) {
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+	return *ptr;
+#endif
+}
+
+/**
+ * Write a pointer to be read by another thread, see atomicStore() above.
+ */
+template<class T>
+inline void atomicStore(T *volatile *ptr, T *value) {
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#else
+	*ptr = value;
+#endif
+}
+
+} // End of namespace Common
+
+#endif
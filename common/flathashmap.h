@@ -0,0 +1,623 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/func.h"
+#include "common/simd.h"
+
+namespace Common {
+
+// The sgi IRIX MIPSpro Compiler has difficulties with nested templates.
+// This and the other __sgi conditionals below work around these problems.
+// The Intel C++ Compiler suffers from the same problems.
+#if (defined(__sgi) && !defined(__GNUC__)) || defined(__INTEL_COMPILER)
+template<class T> class IteratorImpl;
+#endif
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val, like
+ * HashMap, and provides the same interface.
+ *
+ * Unlike HashMap, it stores the keys and values in a single array instead of
+ * allocating a node for each of them. Next to that array, one control byte
+ * per slot tells whether the slot is empty, and otherwise holds 7 bits of the
+ * hash of its key. Lookups check a whole group of control bytes at once (with
+ * SSE2 if available), and only compare the keys whose hash bits match.
+ * Therefore a lookup usually touches just two cache lines, and inserting does
+ * not allocate memory.
+ *
+ * The price for this is that growing the map copies all keys and values.
+ * Adding a key to the map thus invalidates all references to values in it,
+ * not only the iterators. Erasing keys does not affect other entries.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+private:
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	struct Node {
+		const Key _key;
+		Val _value;
+		explicit Node(const Key &key) : _key(key), _value() {}
+		Node(const Node &node) : _key(node._key), _value(node._value) {}
+	};
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage may fill up, erased entries included, before
+		// it is rebuilt. Must be below 1, so that lookups terminate.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 3,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 4
+	};
+
+	/** Control byte values; slots in use hold 7 bits of their hash instead. */
+	enum {
+		kControlEmpty = 0x80,
+		kControlErased = 0xFE
+	};
+
+#ifdef SCUMMVM_SSE2
+	enum { kGroupWidth = 16 };
+
+	/** Bit i of the result is set if control byte i of the group equals value. */
+	static uint32 matchGroup(const byte *group, byte value) {
+		const __m128i controls = _mm_loadu_si128((const __m128i *)group);
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8((char)value)));
+	}
+
+	/** Bit i of the result is set if slot i of the group is in use. */
+	static uint32 usedInGroup(const byte *group) {
+		return ~_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group)) & 0xFFFF;
+	}
+#else
+	enum { kGroupWidth = 8 };
+
+	static uint32 matchGroup(const byte *group, byte value) {
+		uint32 result = 0;
+		for (int i = 0; i < kGroupWidth; i++)
+			result |= (uint32)(group[i] == value) << i;
+		return result;
+	}
+
+	static uint32 usedInGroup(const byte *group) {
+		uint32 result = 0;
+		for (int i = 0; i < kGroupWidth; i++)
+			result |= (uint32)!(group[i] & 0x80) << i;
+		return result;
+	}
+#endif
+
+	/** Index of the highest bit set in a non-zero mask. */
+	static uint highestBit(uint32 mask) {
+#ifdef __GNUC__
+		return 31 - __builtin_clz(mask);
+#else
+		uint bit = 0;
+		while (mask >>= 1)
+			bit++;
+		return bit;
+#endif
+	}
+
+	/** Index of the lowest bit set in a non-zero mask. */
+	static uint lowestBit(uint32 mask) {
+#ifdef __GNUC__
+		return __builtin_ctz(mask);
+#else
+		uint bit = 0;
+		for (; !(mask & 1); mask >>= 1)
+			bit++;
+		return bit;
+#endif
+	}
+
+	static const size_type kNotFound = (size_type)-1;
+
+	/**
+	 * Control bytes of the slots. The first kGroupWidth bytes are repeated
+	 * after the last one, so that groups can be read across the end.
+	 */
+	byte *_control;
+	Node *_nodes;	///< Slots, only constructed where in use.
+	size_type _mask;	///< Capacity minus one; the capacity is a power of two.
+	size_type _size;
+	size_type _erased;	///< Number of erased slots, which lookups step over.
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	/** Default value, returned by the const getVal. */
+	const Val _defaultVal;
+
+	/**
+	 * Mix the bits of the hash, since many hash functions (like the one for
+	 * integers) leave the higher bits unused.
+	 */
+	size_type hashOf(const Key &key) const {
+		const size_type hash = (size_type)_hash(key) * 0x9E3779B1;
+		return hash ^ (hash >> 16);
+	}
+
+	static byte controlOf(size_type hash) {
+		return (hash >> 25) & 0x7F;
+	}
+
+	static bool isUsed(byte control) {
+		return !(control & 0x80);
+	}
+
+	void setControl(size_type idx, byte control) {
+		_control[idx] = control;
+		if (idx < kGroupWidth)
+			_control[idx + _mask + 1] = control;
+	}
+
+	void allocStorage(size_type capacity);
+	void freeStorage();
+	void assign(const FHM_t &map);
+	void rehash(size_type newCapacity);
+	size_type lookup(const Key &key) const;
+	size_type findFree(size_type hash) const;
+	size_type lookupAndCreateIfMissing(const Key &key);
+	void eraseSlot(size_type idx);
+
+#if !defined(__sgi) || defined(__GNUC__)
+	template<class T> friend class IteratorImpl;
+#endif
+
+	/**
+	 * Simple FlatHashMap iterator implementation.
+	 */
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+#if (defined(__sgi) && !defined(__GNUC__)) || defined(__INTEL_COMPILER)
+		template<class T> friend class Common::IteratorImpl;
+#else
+		template<class T> friend class IteratorImpl;
+#endif
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(isUsed(_hashmap->_control[_idx]));
+			return &_hashmap->_nodes[_idx];
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			_idx = _hashmap->nextUsed(_idx + 1);
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+	/** Index of the first slot in use starting at idx, or kNotFound. */
+	size_type nextUsed(size_type idx) const {
+		for (; idx <= _mask; idx += kGroupWidth) {
+			const uint32 used = usedInGroup(_control + idx);
+			if (used) {
+				// Ignore the repeated control bytes past the end
+				idx += lowestBit(used);
+				return idx <= _mask ? idx : kNotFound;
+			}
+		}
+		return kNotFound;
+	}
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		freeStorage();
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	bool contains(const Key &key) const;
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+	const Val &getVal(const Key &key, const Val &defaultVal) const;
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	/**
+	 * Make room for the given number of keys, so that adding them does not
+	 * need to grow the map again.
+	 */
+	void reserve(size_type count);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		return iterator(nextUsed(0), this);
+	}
+	iterator	end() {
+		return iterator(kNotFound, this);
+	}
+
+	const_iterator	begin() const {
+		return const_iterator(nextUsed(0), this);
+	}
+	const_iterator	end() const {
+		return const_iterator(kNotFound, this);
+	}
+
+	iterator	find(const Key &key) {
+		return iterator(lookup(key), this);
+	}
+
+	const_iterator	find(const Key &key) const {
+		return const_iterator(lookup(key), this);
+	}
+
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	freeStorage();
+}
+
+/**
+ * Allocate empty storage with the given capacity, without freeing the
+ * previous storage.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_size = 0;
+	_erased = 0;
+
+	_control = (byte *)malloc(capacity + kGroupWidth);
+	_nodes = (Node *)malloc(capacity * sizeof(Node));
+	assert(_control != nullptr && _nodes != nullptr);
+	memset(_control, kControlEmpty, capacity + kGroupWidth);
+}
+
+/**
+ * Destroy all entries and free the storage.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::freeStorage() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_control[ctr]))
+			_nodes[ctr].~Node();
+	}
+
+	free(_control);
+	free(_nodes);
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note We do *not* deallocate the previous storage here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The slots stay the same, so there is no need to rehash
+	memcpy(_control, map._control, _mask + 1 + kGroupWidth);
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_control[ctr]))
+			new ((void *)&_nodes[ctr]) Node(map._nodes[ctr]);
+	}
+
+	_size = map._size;
+	_erased = map._erased;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (isUsed(_control[ctr]))
+			_nodes[ctr].~Node();
+	}
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		free(_control);
+		free(_nodes);
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	} else {
+		memset(_control, kControlEmpty, _mask + 1 + kGroupWidth);
+		_size = 0;
+		_erased = 0;
+	}
+}
+
+/**
+ * Move all entries to new storage of the given capacity, which also gets rid
+ * of the erased slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity > _size);
+
+	const size_type oldMask = _mask;
+	const size_type oldSize = _size;
+	byte *oldControl = _control;
+	Node *oldNodes = _nodes;
+
+	allocStorage(newCapacity);
+
+	for (size_type ctr = 0; ctr <= oldMask; ++ctr) {
+		if (!isUsed(oldControl[ctr]))
+			continue;
+
+		// Since we know that no key exists twice in the old storage, we
+		// only need to find an empty slot, without calling _equal().
+		const size_type hash = hashOf(oldNodes[ctr]._key);
+		const size_type idx = findFree(hash);
+
+		new ((void *)&_nodes[idx]) Node(oldNodes[ctr]);
+		setControl(idx, controlOf(hash));
+		oldNodes[ctr].~Node();
+	}
+
+	_size = oldSize;
+
+	free(oldControl);
+	free(oldNodes);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::reserve(size_type count) {
+	size_type capacity = _mask + 1;
+	while ((count + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+		capacity *= 2;
+
+	if (capacity > _mask + 1)
+		rehash(capacity);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const Key &key) const {
+	const size_type hash = hashOf(key);
+	const byte control = controlOf(hash);
+
+	// Check the groups of slots starting at the hash position, until one of
+	// them contains an empty slot
+	for (size_type pos = hash & _mask; ; pos = (pos + kGroupWidth) & _mask) {
+		const byte *group = _control + pos;
+
+		for (uint32 matches = matchGroup(group, control); matches; matches &= matches - 1) {
+			const size_type idx = (pos + lowestBit(matches)) & _mask;
+			if (_equal(_nodes[idx]._key, key))
+				return idx;
+		}
+
+		if (matchGroup(group, kControlEmpty))
+			return kNotFound;
+	}
+}
+
+/**
+ * Find the first empty slot for a key with the given hash, assuming there
+ * are no erased slots.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::findFree(size_type hash) const {
+	for (size_type pos = hash & _mask; ; pos = (pos + kGroupWidth) & _mask) {
+		const uint32 empty = matchGroup(_control + pos, kControlEmpty);
+		if (empty)
+			return (pos + lowestBit(empty)) & _mask;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+	const size_type hash = hashOf(key);
+	const byte control = controlOf(hash);
+	size_type idx = kNotFound;
+
+	for (size_type pos = hash & _mask; ; pos = (pos + kGroupWidth) & _mask) {
+		const byte *group = _control + pos;
+
+		for (uint32 matches = matchGroup(group, control); matches; matches &= matches - 1) {
+			const size_type ctr = (pos + lowestBit(matches)) & _mask;
+			if (_equal(_nodes[ctr]._key, key))
+				return ctr;
+		}
+
+		// Remember the first free slot, preferring to reuse erased ones
+		const uint32 empty = matchGroup(group, kControlEmpty);
+		if (idx == kNotFound) {
+			const uint32 free = empty | matchGroup(group, kControlErased);
+			if (free)
+				idx = (pos + lowestBit(free)) & _mask;
+		}
+
+		if (empty)
+			break;
+	}
+
+	if (_control[idx] == kControlErased) {
+		// Reusing an erased slot does not increase the load
+		_erased--;
+	} else if ((_size + _erased + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR > (_mask + 1) * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		// Keep the load factor below the threshold. If many slots are
+		// only erased, rebuilding at the same capacity is enough.
+		size_type capacity = _mask + 1;
+		if ((_size + 1) * 2 * FLATHASHMAP_LOADFACTOR_DENOMINATOR > capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
+		rehash(capacity);
+
+		idx = findFree(hash);
+	}
+
+	new ((void *)&_nodes[idx]) Node(key);
+	setControl(idx, control);
+	_size++;
+
+	return idx;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::eraseSlot(size_type idx) {
+	_nodes[idx].~Node();
+	_size--;
+
+	// Lookups only go past a group if all of its slots are in use. If that
+	// was never the case for any group containing this slot, no lookup
+	// needs to step over it, so it can become empty again.
+	const uint32 emptyBefore = matchGroup(_control + ((idx - kGroupWidth) & _mask), kControlEmpty);
+	const uint32 emptyAfter = matchGroup(_control + idx, kControlEmpty);
+	const size_type usedBefore = emptyBefore ? kGroupWidth - 1 - highestBit(emptyBefore) : kGroupWidth;
+	const size_type usedAfter = emptyAfter ? lowestBit(emptyAfter) - 1 : kGroupWidth;
+
+	if (usedBefore + usedAfter + 1 < kGroupWidth) {
+		setControl(idx, kControlEmpty);
+	} else {
+		setControl(idx, kControlErased);
+		_erased++;
+	}
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+bool FlatHashMap<Key, Val, HashFunc, EqualFunc>::contains(const Key &key) const {
+	return lookup(key) != kNotFound;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	return _nodes[ctr]._value;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	return getVal(key, _defaultVal);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key, const Val &defaultVal) const {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		return _nodes[ctr]._value;
+	else
+		return defaultVal;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	_nodes[ctr]._value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	assert(entry._idx <= _mask);
+	assert(isUsed(_control[entry._idx]));
+
+	eraseSlot(entry._idx);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (ctr != kNotFound)
+		eraseSlot(ctr);
+}
+
+} // End of namespace Common
+
+#endif
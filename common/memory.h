@@ -24,6 +24,7 @@
 #define COMMON_MEMORY_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 
 namespace Common {
 
@@ -61,6 +62,24 @@ void uninitialized_fill_n(Type *dst, size_t n, const Value &x) {
 		new ((void *)dst++) Type(x);
 }
 
+/**
+ * Number of memory blocks allocated on the heap for the storage of
+ * Common::Array and Common::String so far, by all threads. Together with the
+ * statistics of the FrameAllocator, this shows how many heap allocations
+ * code does per frame. It is only counted in development builds, and stays
+ * zero in release builds.
+ */
+extern volatile uint32 g_heapAllocations;
+
+/**
+ * Count a heap allocation of container storage in g_heapAllocations.
+ */
+inline void countHeapAllocation() {
+#ifndef RELEASE_BUILD
+	atomicAdd(&g_heapAllocations, 1);
+#endif
+}
+
 } // End of namespace Common
 
 #endif
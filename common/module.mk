@@ -1,7 +1,9 @@
 MODULE := common
 
 MODULE_OBJS := \
+	arena.o \
 	archive.o \
+	atom.o \
 	config-manager.o \
 	coroutines.o \
 	dcl.o \
@@ -33,6 +35,7 @@ MODULE_OBJS := \
 	stream.o \
 	system.o \
 	textconsole.o \
+	thread.o \
 	tokenizer.o \
 	translation.o \
 	unarj.o \
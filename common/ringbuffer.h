@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_RINGBUFFER_H
+#define COMMON_RINGBUFFER_H
+
+#include "common/scummsys.h"
+#include "common/atomic.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * Fixed capacity FIFO queue for passing values from exactly one producer
+ * thread to exactly one consumer thread without locking.
+ *
+ * Only the producer may call push() and isFull(), only the consumer may
+ * call front() and pop(). size() and empty() may be called from any thread,
+ * but only give a snapshot of the state.
+ *
+ * This is only lock-free when SCUMMVM_ATOMICS is defined; without it, the
+ * queue must not be shared between threads.
+ */
+template<class T>
+class RingBuffer : NonCopyable {
+public:
+	/**
+	 * @param capacity Maximal number of queued values, rounded up to a power of two
+	 */
+	explicit RingBuffer(uint32 capacity) : _head(0), _tail(0) {
+		_capacity = 1;
+		while (_capacity < capacity)
+			_capacity <<= 1;
+		_storage = new T[_capacity];
+	}
+
+	~RingBuffer() {
+		delete[] _storage;
+	}
+
+	uint32 capacity() const { return _capacity; }
+
+	uint32 size() const { return atomicLoad(&_head) - atomicLoad(&_tail); }
+	bool empty() const { return size() == 0; }
+	bool isFull() const { return size() == _capacity; }
+
+	/**
+	 * Append a value to the queue.
+	 *
+	 * @return false if the queue is full
+	 */
+	bool push(const T &value) {
+		const uint32 head = _head;
+		if (head - atomicLoad(&_tail) == _capacity)
+			return false;
+
+		_storage[head & (_capacity - 1)] = value;
+		atomicStore(&_head, head + 1);
+		return true;
+	}
+
+	/**
+	 * Access the oldest value in the queue, which must not be empty.
+	 */
+	T &front() {
+		assert(atomicLoad(&_head) != _tail);
+		return _storage[_tail & (_capacity - 1)];
+	}
+
+	const T &front() const {
+		assert(atomicLoad(&_head) != _tail);
+		return _storage[_tail & (_capacity - 1)];
+	}
+
+	/**
+	 * Remove the oldest value from the queue, which must not be empty.
+	 */
+	void pop() {
+		const uint32 tail = _tail;
+		assert(atomicLoad(&_head) != tail);
+		atomicStore(&_tail, tail + 1);
+	}
+
+private:
+	T *_storage;
+	uint32 _capacity;
+
+	/** Number of values pushed so far; only written by the producer. */
+	volatile uint32 _head;
+	/** Number of values popped so far; only written by the consumer. */
+	volatile uint32 _tail;
+};
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,54 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_SIMD_H
+#define COMMON_SIMD_H
+
+#include "common/scummsys.h"
+
+/**
+ * @file
+ * Compile time detection of the vector instruction sets which code in
+ * ScummVM may use through compiler intrinsics.
+ *
+ * Depending on the target, one of the following is defined:
+ *  - SCUMMVM_SSE2: SSE2 is available (always the case on x86-64).
+ *  - SCUMMVM_NEON: ARM Advanced SIMD is available (always the case on ARM64).
+ *
+ * Code using these must always provide a plain C++ fallback, since neither
+ * may be available. Define DISABLE_SIMD to force the fallback paths, e.g.
+ * to compare their output against the vectorized ones.
+ */
+
+#ifndef DISABLE_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define SCUMMVM_SSE2
+	#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+	#define SCUMMVM_NEON
+	#include <arm_neon.h>
+#endif
+
+#endif // DISABLE_SIMD
+
+#endif
@@ -22,6 +22,7 @@
 
 #include "common/hash-str.h"
 #include "common/list.h"
+#include "common/memory.h"
 #include "common/memorypool.h"
 #include "common/str.h"
 #include "common/util.h"
@@ -93,6 +94,7 @@ void String::initWithCStr(const char *str, uint32 len) {
 		_extern._refCount = nullptr;
 		_str = new char[_extern._capacity];
 		assert(_str != nullptr);
+		countHeapAllocation();
 	}
 
 	// Copy the string into the storage area
@@ -170,6 +172,7 @@ void String::ensureCapacity(uint32 new_size, bool keep_old) {
 	// Allocate new storage
 	newStorage = new char[newCapacity];
 	assert(newStorage);
+	countHeapAllocation();
 
 
 	// Copy old data if needed, elsewise reset the new storage.
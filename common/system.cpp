@@ -23,6 +23,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_exit
 
 #include "common/system.h"
+#include "common/atom.h"
 #include "common/events.h"
 #include "common/fs.h"
 #include "common/savefile.h"
@@ -115,6 +116,7 @@ void OSystem::initBackend() {
 void OSystem::destroy() {
 	_backendInitialized = false;
 	Common::String::releaseMemoryPoolMutex();
+	Common::Atom::releaseMutex();
 	delete this;
 }
 
@@ -0,0 +1,277 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Disable symbol overrides so that we can use pthread.h
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "common/thread.h"
+#include "common/atomic.h"
+#include "common/util.h"
+
+#ifdef USE_PTHREADS
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Common {
+
+#ifdef USE_PTHREADS
+
+namespace {
+
+struct ThreadStart {
+	Thread::Proc proc;
+	void *arg;
+};
+
+void *runThread(void *arg) {
+	const ThreadStart *start = (const ThreadStart *)arg;
+	start->proc(start->arg);
+	return 0;
+}
+
+} // End of anonymous namespace
+
+struct Thread::Handle {
+	pthread_t thread;
+	// Must stay alive until the thread is joined
+	ThreadStart start;
+};
+
+#else
+
+struct Thread::Handle {
+};
+
+#endif
+
+Thread::Thread() : _handle(0), _running(false) {
+}
+
+Thread::~Thread() {
+	join();
+	delete _handle;
+}
+
+bool Thread::isSupported() {
+#ifdef USE_PTHREADS
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool Thread::start(Proc proc, void *arg) {
+	assert(!_running);
+
+#ifdef USE_PTHREADS
+	if (!_handle)
+		_handle = new Handle;
+
+	_handle->start.proc = proc;
+	_handle->start.arg = arg;
+
+	if (pthread_create(&_handle->thread, 0, runThread, &_handle->start) != 0)
+		return false;
+
+	_running = true;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void Thread::join() {
+	if (!_running)
+		return;
+
+#ifdef USE_PTHREADS
+	pthread_join(_handle->thread, 0);
+#endif
+
+	_running = false;
+}
+
+void Thread::yield() {
+#ifdef USE_PTHREADS
+	sched_yield();
+#endif
+}
+
+#pragma mark -
+
+#ifdef USE_PTHREADS
+
+struct Semaphore::Handle {
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+};
+
+Semaphore::Semaphore(uint32 count) : _handle(new Handle), _count(count) {
+	pthread_mutex_init(&_handle->mutex, 0);
+	pthread_cond_init(&_handle->cond, 0);
+}
+
+Semaphore::~Semaphore() {
+	pthread_cond_destroy(&_handle->cond);
+	pthread_mutex_destroy(&_handle->mutex);
+	delete _handle;
+}
+
+void Semaphore::post(uint32 count) {
+	pthread_mutex_lock(&_handle->mutex);
+	_count += count;
+	if (count == 1)
+		pthread_cond_signal(&_handle->cond);
+	else
+		pthread_cond_broadcast(&_handle->cond);
+	pthread_mutex_unlock(&_handle->mutex);
+}
+
+void Semaphore::wait() {
+	pthread_mutex_lock(&_handle->mutex);
+	while (_count == 0)
+		pthread_cond_wait(&_handle->cond, &_handle->mutex);
+	--_count;
+	pthread_mutex_unlock(&_handle->mutex);
+}
+
+bool Semaphore::tryWait() {
+	pthread_mutex_lock(&_handle->mutex);
+	const bool success = (_count != 0);
+	if (success)
+		--_count;
+	pthread_mutex_unlock(&_handle->mutex);
+	return success;
+}
+
+#else
+
+Semaphore::Semaphore(uint32 count) : _handle(0), _count(count) {
+}
+
+Semaphore::~Semaphore() {
+}
+
+void Semaphore::post(uint32 count) {
+	_count += count;
+}
+
+void Semaphore::wait() {
+	// No other thread could ever post
+	assert(_count != 0);
+	--_count;
+}
+
+bool Semaphore::tryWait() {
+	if (_count == 0)
+		return false;
+	--_count;
+	return true;
+}
+
+#endif
+
+#pragma mark -
+
+WorkerPool::WorkerPool() : _workers(0), _workerCount(0), _proc(0), _arg(0), _taskCount(0), _nextTask(0), _quit(false) {
+}
+
+WorkerPool::~WorkerPool() {
+	stopWorkers();
+}
+
+uint WorkerPool::setThreads(uint count) {
+#ifndef SCUMMVM_ATOMICS
+	// Tasks are handed out with atomicAdd()
+	count = 1;
+#endif
+	if (count < 1 || !Thread::isSupported())
+		count = 1;
+
+	if (count == _workerCount + 1)
+		return count;
+
+	stopWorkers();
+
+	_workers = new Thread[count - 1];
+	for (uint i = 0; i < count - 1; ++i) {
+		if (!_workers[i].start(workerMain, this))
+			break;
+		++_workerCount;
+	}
+
+	return _workerCount + 1;
+}
+
+void WorkerPool::stopWorkers() {
+	if (_workers) {
+		_quit = true;
+		_start.post(_workerCount);
+		for (uint i = 0; i < _workerCount; ++i)
+			_workers[i].join();
+		delete[] _workers;
+	}
+
+	_workers = 0;
+	_workerCount = 0;
+	_quit = false;
+}
+
+void WorkerPool::run(Proc proc, void *arg, uint tasks) {
+	if (_workerCount == 0 || tasks < 2) {
+		for (uint task = 0; task < tasks; ++task)
+			proc(arg, task);
+		return;
+	}
+
+	_proc = proc;
+	_arg = arg;
+	_taskCount = tasks;
+	_nextTask = 0;
+
+	// Only wake up as many workers as there are tasks left for them
+	const uint workers = MIN<uint>(_workerCount, tasks - 1);
+	_start.post(workers);
+	runTasks();
+	for (uint i = 0; i < workers; ++i)
+		_done.wait();
+}
+
+void WorkerPool::runTasks() {
+	uint32 task;
+	while ((task = atomicAdd(&_nextTask, 1) - 1) < _taskCount)
+		_proc(_arg, task);
+}
+
+void WorkerPool::workerMain(void *arg) {
+	WorkerPool *pool = (WorkerPool *)arg;
+	for (;;) {
+		pool->_start.wait();
+		if (pool->_quit)
+			return;
+		pool->runTasks();
+		pool->_done.post();
+	}
+}
+
+} // End of namespace Common
@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * A thread running a single function, for doing work in the background.
+ *
+ * Threads are an optional feature: they are only available when ScummVM is
+ * built with POSIX threads support. Code using this class must check
+ * isSupported() and do the work synchronously otherwise.
+ */
+class Thread : NonCopyable {
+public:
+	typedef void (*Proc)(void *arg);
+
+	Thread();
+
+	/**
+	 * Waits for the thread to finish, if it is still running.
+	 */
+	~Thread();
+
+	/**
+	 * Whether threads can be started on this platform.
+	 */
+	static bool isSupported();
+
+	/**
+	 * Start running proc(arg) in a new thread.
+	 *
+	 * @return true on success, false if the thread could not be started
+	 */
+	bool start(Proc proc, void *arg);
+
+	/**
+	 * Wait until the thread has finished.
+	 */
+	void join();
+
+	/**
+	 * Whether the thread has been started and not been joined yet.
+	 */
+	bool isRunning() const { return _running; }
+
+	/**
+	 * Give up the remainder of the time slice of the calling thread.
+	 */
+	static void yield();
+
+private:
+	struct Handle;
+
+	Handle *_handle;
+	bool _running;
+};
+
+/**
+ * A counting semaphore, for a thread to sleep until other threads have
+ * finished some work instead of polling a flag.
+ *
+ * Without threads support, wait() may only be called when the count is
+ * known to be non-zero.
+ */
+class Semaphore : NonCopyable {
+public:
+	explicit Semaphore(uint32 count = 0);
+	~Semaphore();
+
+	/**
+	 * Increase the count, waking up as many waiting threads.
+	 */
+	void post(uint32 count = 1);
+
+	/**
+	 * Wait until the count is non-zero, then decrease it.
+	 */
+	void wait();
+
+	/**
+	 * Decrease the count if it is non-zero, without waiting.
+	 *
+	 * @return true if the count was decreased
+	 */
+	bool tryWait();
+
+private:
+	struct Handle;
+
+	Handle *_handle;
+	uint32 _count;
+};
+
+/**
+ * A fixed set of worker threads which run the tasks of a job together with
+ * the calling thread. The threads are started once by setThreads() and then
+ * sleep between jobs, so running a job is cheap enough to do per frame.
+ */
+class WorkerPool : NonCopyable {
+public:
+	typedef void (*Proc)(void *arg, uint task);
+
+	WorkerPool();
+
+	/**
+	 * Stops the worker threads.
+	 */
+	~WorkerPool();
+
+	/**
+	 * Set how many threads may work on a job at the same time, counting the
+	 * thread calling run(). Threads are started or stopped as needed.
+	 *
+	 * @return the number of threads actually available, which is 1 when
+	 *         threads are not supported
+	 */
+	uint setThreads(uint count);
+
+	/**
+	 * The number of threads working on a job, counting the calling thread.
+	 */
+	uint getThreads() const { return _workerCount + 1; }
+
+	/**
+	 * Call proc(arg, task) for each task in [0, tasks), spread over the
+	 * worker threads and the calling thread, and return once all of them
+	 * have finished. Tasks must not depend on each other.
+	 */
+	void run(Proc proc, void *arg, uint tasks);
+
+private:
+	static void workerMain(void *arg);
+	void runTasks();
+	void stopWorkers();
+
+	Thread *_workers;
+	uint _workerCount;
+
+	Semaphore _start;
+	Semaphore _done;
+
+	Proc _proc;
+	void *_arg;
+	uint32 _taskCount;
+	volatile uint32 _nextTask;
+	bool _quit;
+};
+
+} // End of namespace Common
+
+#endif
@@ -106,6 +106,9 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
+#include "common/textconsole.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -382,6 +385,7 @@ typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_H
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _streamOwner; /* shared with the member streams */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -544,6 +548,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_streamOwner = Common::SharedPtr<Common::SeekableReadStream>(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -595,7 +600,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -644,7 +648,6 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != nullptr)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -1419,6 +1422,241 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+namespace {
+
+/**
+ * Data of a member in the archive file. Any number of these can be used at
+ * the same time, and they keep the archive file open after the archive
+ * itself has been deleted.
+ */
+class ZipMemberDataStream : public SafeSeekableSubReadStream {
+public:
+	ZipMemberDataStream(const SharedPtr<SeekableReadStream> &archiveStream, uint32 begin, uint32 end)
+		: SafeSeekableSubReadStream(archiveStream.get(), begin, end), _archiveStream(archiveStream) {
+	}
+
+private:
+	SharedPtr<SeekableReadStream> _archiveStream;
+};
+
+#ifdef USE_ZLIB
+
+/**
+ * Inflates a deflated member while it is being read.
+ *
+ * While decompressing, the state of the inflater is saved at regular
+ * intervals, so that seeking backwards only has to decompress the data from
+ * the preceding checkpoint on, instead of starting over at the beginning.
+ */
+class ZipInflateReadStream : public SeekableReadStream {
+public:
+	ZipInflateReadStream(SeekableReadStream *compressed, uint32 size, uint32 crc);
+	~ZipInflateReadStream();
+
+	bool err() const { return _zlibErr != Z_OK && _zlibErr != Z_STREAM_END; }
+	void clearErr() { _eos = false; }
+	bool eos() const { return _eos; }
+
+	uint32 read(void *dataPtr, uint32 dataSize);
+
+	int32 pos() const { return _pos; }
+	int32 size() const { return _size; }
+	bool seek(int32 offset, int whence = SEEK_SET);
+
+private:
+	enum {
+		kBufferSize = 16384,
+		/** Minimal distance of two checkpoints. */
+		kMinCheckpointInterval = 256 * 1024,
+		/** Maximal number of checkpoints of a member, each takes ~40 KB. */
+		kMaxCheckpoints = 32
+	};
+
+	/** A saved inflater state, which must not be moved in memory. */
+	struct Checkpoint {
+		uint32 outPos;
+		uint32 inPos;
+		z_stream stream;
+	};
+
+	ScopedPtr<SeekableReadStream> _compressed;
+	z_stream _stream;
+	int _zlibErr;
+	byte _buffer[kBufferSize];
+
+	uint32 _pos;
+	uint32 _size;
+	bool _eos;
+
+	/** Checkpoint i is at (i + 1) * _checkpointInterval bytes. */
+	Array<Checkpoint *> _checkpoints;
+	uint32 _checkpointInterval;
+
+	/** The CRC of the data up to _crcPos, as long as it was read in order. */
+	uint32 _crc;
+	uint32 _crcPos;
+	uint32 _expectedCrc;
+
+	/** Continue inflating into the given buffer. */
+	uint32 inflateData(byte *dst, uint32 size);
+	/** Continue inflating from the last checkpoint before the given position. */
+	bool rewind(uint32 target);
+};
+
+ZipInflateReadStream::ZipInflateReadStream(SeekableReadStream *compressed, uint32 size, uint32 crc)
+		: _compressed(compressed), _stream(), _pos(0), _size(size), _eos(false),
+		  _crc(crc32(0, nullptr, 0)), _crcPos(0), _expectedCrc(crc) {
+	_checkpointInterval = MAX<uint32>(kMinCheckpointInterval, size / kMaxCheckpoints + 1);
+
+	// windowBits is passed < 0 to tell that there is no zlib header
+	_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+	_stream.next_in = _buffer;
+	_stream.avail_in = 0;
+}
+
+ZipInflateReadStream::~ZipInflateReadStream() {
+	for (uint i = 0; i < _checkpoints.size(); i++) {
+		inflateEnd(&_checkpoints[i]->stream);
+		delete _checkpoints[i];
+	}
+
+	inflateEnd(&_stream);
+}
+
+uint32 ZipInflateReadStream::inflateData(byte *dst, uint32 size) {
+	_stream.next_out = dst;
+	_stream.avail_out = size;
+
+	while (_zlibErr == Z_OK && _stream.avail_out) {
+		if (_stream.avail_in == 0 && !_compressed->eos()) {
+			_stream.next_in = _buffer;
+			_stream.avail_in = _compressed->read(_buffer, kBufferSize);
+		}
+
+		_zlibErr = inflate(&_stream, Z_NO_FLUSH);
+	}
+
+	const uint32 produced = size - _stream.avail_out;
+
+	if (_crcPos == _pos) {
+		_crc = crc32(_crc, dst, produced);
+		_crcPos += produced;
+
+		if (_crcPos == _size && _crc != _expectedCrc) {
+			warning("ZipInflateReadStream: CRC mismatch");
+			_zlibErr = Z_DATA_ERROR;
+		}
+	}
+
+	_pos += produced;
+	return produced;
+}
+
+uint32 ZipInflateReadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	const uint32 wanted = MIN(dataSize, _size - _pos);
+	uint32 done = 0;
+
+	while (done < wanted && _zlibErr == Z_OK) {
+		uint32 checkpointPos = (_checkpoints.size() + 1) * _checkpointInterval;
+
+		if (_pos == checkpointPos && _checkpoints.size() < kMaxCheckpoints) {
+			Checkpoint *checkpoint = new Checkpoint();
+			if (inflateCopy(&checkpoint->stream, &_stream) == Z_OK) {
+				checkpoint->outPos = _pos;
+				checkpoint->inPos = _compressed->pos() - _stream.avail_in;
+				_checkpoints.push_back(checkpoint);
+				checkpointPos += _checkpointInterval;
+			} else {
+				delete checkpoint;
+			}
+		}
+
+		// Stop at the next checkpoint, so that it can be saved
+		uint32 chunk = wanted - done;
+		if (checkpointPos > _pos && _checkpoints.size() < kMaxCheckpoints)
+			chunk = MIN(chunk, checkpointPos - _pos);
+
+		const uint32 produced = inflateData(dst + done, chunk);
+		done += produced;
+		if (produced < chunk)
+			break;
+	}
+
+	if (done < dataSize)
+		_eos = true;
+
+	return done;
+}
+
+bool ZipInflateReadStream::rewind(uint32 target) {
+	uint index = MIN<uint32>(target / _checkpointInterval, _checkpoints.size());
+
+	inflateEnd(&_stream);
+
+	if (index == 0) {
+		_zlibErr = inflateInit2(&_stream, -MAX_WBITS);
+		_compressed->seek(0);
+		_pos = 0;
+	} else {
+		Checkpoint *checkpoint = _checkpoints[index - 1];
+		_zlibErr = inflateCopy(&_stream, &checkpoint->stream);
+		_compressed->seek(checkpoint->inPos);
+		_pos = checkpoint->outPos;
+	}
+
+	_stream.next_in = _buffer;
+	_stream.avail_in = 0;
+
+	return _zlibErr == Z_OK;
+}
+
+bool ZipInflateReadStream::seek(int32 offset, int whence) {
+	int32 newPos = 0;
+	switch (whence) {
+	case SEEK_SET:
+		newPos = offset;
+		break;
+	case SEEK_CUR:
+		newPos = _pos + offset;
+		break;
+	case SEEK_END:
+		newPos = _size + offset;
+		break;
+	}
+
+	if (newPos < 0 || (uint32)newPos > _size)
+		return false;
+
+	const uint32 target = newPos;
+
+	// Go back to the last checkpoint before the target, unless the target
+	// is ahead and closer than that
+	const uint32 checkpointPos = MIN<uint32>(target / _checkpointInterval, _checkpoints.size()) * _checkpointInterval;
+	if (target < _pos || checkpointPos > _pos) {
+		if (!rewind(target))
+			return false;
+	}
+
+	_eos = false;
+
+	// Skip the data up to the target
+	byte skipBuffer[4096];
+	while (_pos < target) {
+		const uint32 chunk = MIN<uint32>(sizeof(skipBuffer), target - _pos);
+		if (read(skipBuffer, chunk) != chunk)
+			return false;
+	}
+
+	return true;
+}
+
+#endif // USE_ZLIB
+
+/** Members up to this size are inflated into memory at once. */
+const uint32 kInflateInMemorySize = 64 * 1024;
+
+} // End of anonymous namespace
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
@@ -1496,6 +1734,25 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
 		return nullptr;
 
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	const file_in_zip_read_info_s *const member = archive->pfile_in_zip_read;
+	const uint32 dataStart = member->pos_in_zipfile + member->byte_before_the_zipfile;
+
+	// Stored members are read directly from the archive file, deflated ones
+	// are inflated while reading, unless they are small
+	if (fileInfo.compression_method == 0) {
+		unzCloseCurrentFile(_zipFile);
+		return new ZipMemberDataStream(archive->_streamOwner, dataStart, dataStart + fileInfo.uncompressed_size);
+	}
+
+#ifdef USE_ZLIB
+	if (fileInfo.uncompressed_size > kInflateInMemorySize) {
+		unzCloseCurrentFile(_zipFile);
+		return new ZipInflateReadStream(new ZipMemberDataStream(archive->_streamOwner, dataStart, dataStart + fileInfo.compressed_size),
+		                                fileInfo.uncompressed_size, fileInfo.crc);
+	}
+#endif
+
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
@@ -1510,11 +1767,6 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const String &name) co
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
 }
 
 Archive *makeZipArchive(const String &name) {
@@ -147,7 +147,8 @@ void Header::loadHeader(Common::SeekableReadStream &f) {
 
 UserOptions::UserOptions() : _undo_slots(MAX_UNDO_SLOTS), _sound(true), _quetzal(true), _color_enabled(false),
 	_err_report_mode(ERR_REPORT_ONCE), _ignore_errors(false), _expand_abbreviations(false), _tandyBit(false),
-	_piracy(false), _script_cols(0), _left_margin(0), _right_margin(0), _defaultBackground(0), _defaultForeground(0) {
+	_piracy(false), _script_cols(0), _left_margin(0), _right_margin(0), _defaultBackground(0), _defaultForeground(0),
+	_headless(false) {
 }
 
 void UserOptions::initialize(uint hVersion, uint storyId) {
@@ -166,6 +167,11 @@ void UserOptions::initialize(uint hVersion, uint storyId) {
 	_object_locating = getConfigBool("object_locating");
 	_object_movement = getConfigBool("object_movement");
 
+	// Scripted input and benchmarking
+	if (ConfMan.hasKey("replay_file"))
+		_replay_file = ConfMan.get("replay_file");
+	_headless = getConfigBool("headless");
+
 	int defaultFg = hVersion == V6 ? 0 : 0xffffff;
 	int defaultBg = hVersion == V6 ? 0xffffff : 0x80;
 	if (storyId == BEYOND_ZORK)
@@ -152,6 +152,18 @@ struct UserOptions {
 	uint _defaultBackground;
 	bool _color_enabled;
 
+	/**
+	 * Command file to read the player's input from, as written by output stream 4
+	 */
+	Common::String _replay_file;
+
+	/**
+	 * Run without any Glk windows: the Z-machine windows only keep their properties, and the
+	 * screen output is discarded. The game quits when the input from the command file ends.
+	 * Together with the profile debug channel, this runs a walkthrough as a benchmark
+	 */
+	bool _headless;
+
 	/**
 	 * Constructor
 	 */
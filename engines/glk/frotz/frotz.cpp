@@ -75,6 +75,7 @@ void Frotz::runGame() {
 
 	// Game loop
 	interpret();
+	profile_report();
 
 	if (!shouldQuit()) {
 		flush_buffer();
@@ -123,12 +123,18 @@ void GlkInterface::initialize() {
 	 * Get the screen size
 	 */
 
-	_wp._lower = glk_window_open(0, 0, 0, wintype_TextGrid, 0);
-	if (!_wp._lower)
-		_wp._lower = glk_window_open(0, 0, 0, wintype_TextBuffer, 0);
-	glk_window_get_size(_wp._lower, &width, &height);
-	glk_window_close(_wp._lower, nullptr);
-	_wp._lower = nullptr;
+	if (_headless) {
+		// There is no screen, so tell the game it has a standard terminal
+		width = 80;
+		height = 25;
+	} else {
+		_wp._lower = glk_window_open(0, 0, 0, wintype_TextGrid, 0);
+		if (!_wp._lower)
+			_wp._lower = glk_window_open(0, 0, 0, wintype_TextBuffer, 0);
+		glk_window_get_size(_wp._lower, &width, &height);
+		glk_window_close(_wp._lower, nullptr);
+		_wp._lower = nullptr;
+	}
 
 	gos_channel = nullptr;
 
@@ -142,7 +148,7 @@ void GlkInterface::initialize() {
 	h_font_height = 1;
 
 	// Must be after screen dimensions are computed
-	if (g_conf->_graphics) {
+	if (g_conf->_graphics && !_headless) {
 		if (_blorb)
 			// Blorb file containers allow graphics
 			h_flags |= GRAPHICS_FLAG;
@@ -183,7 +189,7 @@ void GlkInterface::initialize() {
 	/*
 	 * Open the windows
 	 */
-	if (_storyId == BEYOND_ZORK)
+	if (_storyId == BEYOND_ZORK && !_headless)
 		showBeyondZorkTitle();
 
 	_wp.setup(h_version == 6);
@@ -234,7 +240,7 @@ void GlkInterface::initialize() {
 
 	// For Beyond Zork the Page Up/Down keys are remapped to scroll the description area,
 	// since the arrow keys the original used are in use now for cycling prior commands
-	if (_storyId == BEYOND_ZORK) {
+	if (_storyId == BEYOND_ZORK && !_headless) {
 		uint32 KEYCODES[2] = { keycode_PageUp, keycode_PageDown };
 		glk_set_terminators_line_event(_wp._lower, KEYCODES, 2);
 	}
@@ -542,6 +548,9 @@ void GlkInterface::showBeyondZorkTitle() {
 
 void GlkInterface::os_draw_picture(int picture, const Common::Point &pos) {
 	assert(pos.x != 0 && pos.y != 0);
+	if (_headless)
+		return;
+
 	if (_wp._cwin == 0) {
 		// Picture embedded within the lower text area
 		glk_image_draw(_wp._lower, picture, imagealign_MarginLeft, 0);
@@ -553,6 +562,9 @@ void GlkInterface::os_draw_picture(int picture, const Common::Point &pos) {
 }
 
 void GlkInterface::os_draw_picture(int picture, const Common::Rect &r) {
+	if (_headless)
+		return;
+
 	Point cell(g_conf->_monoInfo._cellW, g_conf->_monoInfo._cellH);
 	glk_image_draw_scaled(_wp._background, picture, (r.left - 1) * cell.x, (r.top - 1) * cell.y,
 		r.width() * cell.x, r.height() * cell.y);
@@ -585,6 +597,13 @@ int GlkInterface::os_peek_color() {
 
 zchar GlkInterface::os_read_key(int timeout, bool show_cursor) {
 	event_t ev;
+
+	// Without a screen the input can only come from the command file, which has ended
+	if (_headless) {
+		os_quit_headless();
+		return 0;
+	}
+
 	winid_t win = _wp.currWin() ? _wp.currWin() : _wp._lower;
 
 	if (gos_linepending)
@@ -631,8 +650,22 @@ zchar GlkInterface::os_read_key(int timeout, bool show_cursor) {
 	}
 }
 
+void GlkInterface::os_quit_headless() {
+	Common::Event e;
+
+	quitGame();
+	while (g_system->getEventManager()->pollEvent(e))
+		;
+}
+
 zchar GlkInterface::os_read_line(int max, zchar *buf, int timeout, int width, int continued) {
 	event_t ev;
+
+	if (_headless) {
+		os_quit_headless();
+		return 0;
+	}
+
 	winid_t win = _wp.currWin() ? _wp.currWin() : _wp._lower;
 
 	if (!continued && gos_linepending)
@@ -242,6 +242,12 @@ protected:
 	 * Waits for the user to type an input line
 	 */
 	zchar os_read_line(int max, zchar *buf, int timeout, int width, int continued);
+
+	/**
+	 * Ends a game played without a screen. Nothing polls for events then, so
+	 * the quit event is fetched here for shouldQuit() to see it
+	 */
+	void os_quit_headless();
 public:
 	/**
 	 * Constructor
@@ -23,6 +23,8 @@
 #include "glk/frotz/processor.h"
 #include "glk/frotz/frotz.h"
 #include "glk/conf.h"
+#include "common/algorithm.h"
+#include "common/debug-channels.h"
 
 namespace Glk {
 namespace Frotz {
@@ -139,7 +141,8 @@ Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 		_randomInterval(0), _randomCtr(0), first_restart(true), script_valid(false),
 		_bufPos(0), _locked(false), _prevC('\0'), script_width(0),
 		sfp(nullptr), rfp(nullptr), pfp(nullptr), ostream_screen(true), ostream_script(false),
-		ostream_memory(false), ostream_record(false), istream_replay(false), message(false) {
+		ostream_memory(false), ostream_record(false), istream_replay(false), message(false),
+		_profiling(false), _profileStartTime(0) {
 	static const Opcode OP0_OPCODES[16] = {
 		&Processor::z_rtrue,
 		&Processor::z_rfalse,
@@ -185,6 +188,7 @@ Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 	Common::fill(&zargs[0], &zargs[8], 0);
 	Common::fill(&_buffer[0], &_buffer[TEXT_BUFFER_SIZE], '\0');
 	Common::fill(&_errorCount[0], &_errorCount[ERR_NUM_ERRORS], 0);
+	Common::fill(&_opcodeCounts[0], &_opcodeCounts[PROFILE_OPCODES], 0);
 }
 
 void Processor::initialize() {
@@ -198,6 +202,14 @@ void Processor::initialize() {
 		op0_opcodes[9] = &Processor::z_catch;
 		op1_opcodes[15] = &Processor::z_call_n;
 	}
+
+	if (_headless)
+		ostream_screen = false;
+	if (!_replay_file.empty())
+		replay_open_file(_replay_file);
+
+	_profiling = DebugMan.isDebugChannelEnabled(kDebugProfile);
+	_profileStartTime = g_system->getMillis();
 }
 
 void Processor::load_operand(zbyte type) {
@@ -249,6 +261,9 @@ void Processor::interpret() {
 		CODE_BYTE(opcode);
 		zargc = 0;
 
+		if (_profiling)
+			profile_opcode(opcode);
+
 		if (opcode < 0x80) {
 			// 2OP opcodes
 			load_operand((zbyte)(opcode & 0x40) ? 2 : 1);
@@ -331,6 +346,9 @@ void Processor::call(zword routine, int argc, zword *args, int ct) {
 	if ((uint)pc >= story_size)
 		runtimeError(ERR_ILL_CALL_ADDR);
 
+	if (_profiling)
+		_routineCounts[pc]++;
+
 	SET_PC(pc);
 
 	// Initialise local variables
@@ -358,6 +376,78 @@ void Processor::call(zword routine, int argc, zword *args, int ct) {
 		interpret();
 }
 
+void Processor::profile_opcode(zbyte opcode) {
+	if (opcode < 0x80)
+		_opcodeCounts[opcode & 0x1f]++;
+	else if (opcode < 0xb0)
+		_opcodeCounts[32 + (opcode & 0x0f)]++;
+	else if (opcode == 0xbe)
+		return;		// extended opcode, counted in __extended__()
+	else if (opcode < 0xc0)
+		_opcodeCounts[48 + opcode - 0xb0]++;
+	else if (opcode < 0xe0)
+		_opcodeCounts[opcode & 0x1f]++;
+	else
+		_opcodeCounts[64 + opcode - 0xe0]++;
+}
+
+void Processor::profile_ext_opcode(zbyte opcode) {
+	if (opcode < 0x20)
+		_opcodeCounts[96 + opcode]++;
+}
+
+struct ProfileCount {
+	uint32 id;
+	uint count;
+};
+
+static bool compareProfileCounts(const ProfileCount &a, const ProfileCount &b) {
+	return a.count > b.count;
+}
+
+void Processor::profile_report() {
+	if (!_profiling)
+		return;
+
+	static const char *const OPCODE_TYPES[] = { "2OP", "1OP", "0OP", "VAR", "EXT" };
+	static const int OPCODE_STARTS[] = { 0, 32, 48, 64, 96 };
+
+	Common::Array<ProfileCount> opcodes;
+	uint64 instructions = 0;
+	for (uint i = 0; i < PROFILE_OPCODES; i++) {
+		instructions += _opcodeCounts[i];
+		if (_opcodeCounts[i]) {
+			ProfileCount entry = { i, _opcodeCounts[i] };
+			opcodes.push_back(entry);
+		}
+	}
+	Common::sort(opcodes.begin(), opcodes.end(), compareProfileCounts);
+
+	const uint32 elapsed = g_system->getMillis() - _profileStartTime;
+	debugC(kDebugProfile, "Executed %u thousand instructions in %u ms, %u thousand per second",
+		(uint)(instructions / 1000), elapsed, elapsed ? (uint)(instructions / elapsed) : 0);
+
+	debugC(kDebugProfile, "Most used opcodes:");
+	for (uint i = 0; i < opcodes.size() && i < 20; i++) {
+		int type = 4;
+		while (opcodes[i].id < (uint32)OPCODE_STARTS[type])
+			type--;
+		debugC(kDebugProfile, "  %s:%u: %u", OPCODE_TYPES[type], opcodes[i].id - OPCODE_STARTS[type], opcodes[i].count);
+	}
+
+	Common::Array<ProfileCount> routines;
+	routines.reserve(_routineCounts.size());
+	for (Common::HashMap<uint32, uint>::const_iterator i = _routineCounts.begin(); i != _routineCounts.end(); ++i) {
+		ProfileCount entry = { i->_key, i->_value };
+		routines.push_back(entry);
+	}
+	Common::sort(routines.begin(), routines.end(), compareProfileCounts);
+
+	debugC(kDebugProfile, "Most called of %u routines:", routines.size());
+	for (uint i = 0; i < routines.size() && i < 20; i++)
+		debugC(kDebugProfile, "  %05x: %u calls", routines[i].id, routines[i].count);
+}
+
 void Processor::ret(zword value) {
 	offset_t pc;
 	int ct;
@@ -489,6 +579,9 @@ void Processor::__extended__() {
 	CODE_BYTE(opcode);
 	CODE_BYTE(specifier);
 
+	if (_profiling)
+		profile_ext_opcode(opcode);
+
 	load_all_operands(specifier);
 
 	if (opcode < 0x1e)					// extended opcodes from 0x1e on
@@ -26,6 +26,7 @@
 #include "glk/frotz/mem.h"
 #include "glk/frotz/glk_interface.h"
 #include "glk/frotz/frotz_types.h"
+#include "common/hashmap.h"
 #include "common/stack.h"
 
 namespace Glk {
@@ -39,6 +40,11 @@ namespace Frotz {
 #define GET_PC(v)          v = getPC()
 #define SET_PC(v)          setPC(v)
 
+/**
+ * Number of opcodes counted by the profile: 32 2OP, 16 1OP, 16 0OP, 32 VAR and 32 EXT opcodes
+ */
+#define PROFILE_OPCODES 128
+
 enum string_type {
 	LOW_STRING, ABBREVIATION, HIGH_STRING, EMBEDDED_STRING, VOCABULARY
 };
@@ -95,6 +101,13 @@ private:
 	bool istream_replay;
 	bool message;
 	Common::FixedStack<Redirect, MAX_NESTING> _redirect;
+	Common::Array<char> _replayData;
+
+	// Profiling fields
+	bool _profiling;
+	uint32 _profileStartTime;
+	uint32 _opcodeCounts[PROFILE_OPCODES];
+	Common::HashMap<uint32, uint> _routineCounts;
 protected:
 	/**
 	 * \defgroup General support methods
@@ -162,6 +175,23 @@ protected:
 	 */
 	void seed_random(int value);
 
+	/**
+	 * Count an executed opcode for the profile. Extended opcodes are counted by
+	 * profile_ext_opcode() instead, once their opcode byte is read.
+	 */
+	void profile_opcode(zbyte opcode);
+
+	/**
+	 * Count an executed extended opcode for the profile.
+	 */
+	void profile_ext_opcode(zbyte opcode);
+
+	/**
+	 * Write the instructions per second and the most used opcodes and routines
+	 * to the profile debug channel, if it is enabled.
+	 */
+	void profile_report();
+
 	/**@}*/
 
 	/**
@@ -302,6 +332,14 @@ protected:
 	 */
 	zword next_property(zword prop_addr);
 
+	/**
+	 * Find a property in the property list of an object. The list is sorted by
+	 * descending property id, so this returns the address of the first property
+	 * whose id is not greater than the one searched for, and its id and size byte
+	 * in value.
+	 */
+	zword find_property(zword obj, zword prop, zbyte &value);
+
 	/**
 	 * Unlink an object from its parent and siblings.
 	 */
@@ -520,6 +558,11 @@ protected:
 	 */
 	void replay_open();
 
+	/**
+	 * Open the command file given in the replay_file option for playback.
+	 */
+	void replay_open_file(const Common::String &filename);
+
 	/**
 	 * Stop playback of commands.
 	 */
@@ -116,6 +116,40 @@ zword Processor::next_property(zword prop_addr) {
 	return prop_addr + value + 1;
 }
 
+zword Processor::find_property(zword obj, zword prop, zbyte &value) {
+	zword prop_addr = first_property(obj);
+
+	// The property sizes are decoded here rather than with next_property(),
+	// saving the version checks for every property passed
+	if (h_version <= V3) {
+		for (;;) {
+			LOW_BYTE(prop_addr, value);
+			if ((value & 0x1f) <= prop)
+				return prop_addr;
+
+			prop_addr += (value >> 5) + 2;
+		}
+	} else {
+		for (;;) {
+			LOW_BYTE(prop_addr, value);
+			if ((value & 0x3f) <= prop)
+				return prop_addr;
+
+			if (!(value & 0x80)) {
+				prop_addr += (value >> 6) + 2;
+			} else {
+				zword size_addr = prop_addr + 1;
+				zbyte size;
+				LOW_BYTE(size_addr, size);
+				size &= 0x3f;
+
+				// demanded by Spec 1.0
+				prop_addr += (size ? size : 64) + 2;
+			}
+		}
+	}
+}
+
 void Processor::unlink_object(zword object) {
 	zword obj_addr;
 	zword parent_addr;
@@ -408,16 +442,8 @@ void Processor::z_get_prop() {
 	// Property id is in bottom five (six) bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
 	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-		prop_addr = next_property(prop_addr);
-	}
+	prop_addr = find_property(zargs[0], zargs[1], value);
 
 	if ((value & mask) == zargs[1]) {
 		// property found
@@ -461,16 +487,8 @@ void Processor::z_get_prop_addr() {
 	// Property id is in bottom five (six) bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
 	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-		prop_addr = next_property(prop_addr);
-	}
+	prop_addr = find_property(zargs[0], zargs[1], value);
 
 	// Calculate the property address or return zero
 	if ((value & mask) == zargs[1]) {
@@ -604,7 +622,7 @@ void Processor::z_insert_obj() {
 
 void Processor::z_put_prop() {
 	zword prop_addr;
-	zword value;
+	zbyte value;
 	zbyte mask;
 
 	if (zargs[0] == 0) {
@@ -615,17 +633,8 @@ void Processor::z_put_prop() {
 	// Property id is in bottom five or six bits
 	mask = (h_version <= V3) ? 0x1f : 0x3f;
 
-	// Load address of first property
-	prop_addr = first_property(zargs[0]);
-
 	// Scan down the property list
-	for (;;) {
-		LOW_BYTE(prop_addr, value);
-		if ((value & mask) <= zargs[1])
-			break;
-
-		prop_addr = next_property(prop_addr);
-	}
+	prop_addr = find_property(zargs[0], zargs[1], value);
 
 	// Exit if the property does not exist
 	if ((value & mask) != zargs[1])
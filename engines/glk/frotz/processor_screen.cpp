@@ -29,6 +29,10 @@ namespace Glk {
 namespace Frotz {
 
 void Processor::screen_mssg_on() {
+	// Interpreter messages have nowhere to go without a screen
+	if (_headless)
+		return;
+
 	Window &w = _wp.currWin();
 
 	if (w == _wp._lower) {
@@ -39,6 +43,9 @@ void Processor::screen_mssg_on() {
 }
 
 void Processor::screen_mssg_off() {
+	if (_headless)
+		return;
+
 	Window &w = _wp.currWin();
 
 	if (w == _wp._lower) {
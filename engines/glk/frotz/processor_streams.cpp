@@ -22,6 +22,8 @@
 
 #include "glk/frotz/processor.h"
 #include "glk/frotz/quetzal.h"
+#include "common/file.h"
+#include "common/fs.h"
 
 namespace Glk {
 namespace Frotz {
@@ -393,9 +395,27 @@ void Processor::replay_open() {
 		print_string("Cannot open file\n");
 }
 
+void Processor::replay_open_file(const Common::String &filename) {
+	Common::File f;
+	if (!f.open(Common::FSNode(filename)) || f.size() == 0) {
+		warning("Could not read command file %s", filename.c_str());
+		return;
+	}
+
+	// The stream reads from memory, so the data stays around until the game ends
+	_replayData.resize(f.size());
+	f.read(&_replayData[0], _replayData.size());
+	pfp = glk_stream_open_memory(&_replayData[0], _replayData.size(), filemode_Read);
+	istream_replay = true;
+}
+
 void Processor::replay_close() {
 	glk_stream_close(pfp);
 	istream_replay = false;
+
+	// Without a screen, the game is over when its commands are
+	if (_headless)
+		os_quit_headless();
 }
 
 int Processor::replay_code() {
@@ -435,7 +455,9 @@ zchar Processor::replay_char() {
 			}
 		}
 
-		pfp->unputBuffer("\n", 1);
+		// Leave the newline for the caller to check, as ungetc() did in Frotz.
+		// Streams only support unputting on windows
+		pfp->setPosition(-1, seekmode_Current);
 		return ZC_RETURN;
 
 	} else {
@@ -490,7 +512,7 @@ void Processor::z_output_stream() {
 	flush_buffer();
 
 	switch ((short) zargs[0]) {
-	case  1: ostream_screen = true;
+	case  1: ostream_screen = !_headless;
 		 break;
 	case -1: ostream_screen = false;
 		 break;
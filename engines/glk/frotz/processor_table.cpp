@@ -78,6 +78,38 @@ void Processor::z_scan_table() {
 	if (zargc < 4)
 	zargs[3] = 0x82;
 
+	const zword step = zargs[3] & 0x7f;
+
+	// Scan the memory directly if the table doesn't wrap around the
+	// end of the 64K address space, which is the common case
+	if ((uint32)addr + (uint32)zargs[2] * step + 1 < 0x10000) {
+		const zbyte *p = &zmp[addr];
+
+		if (zargs[3] & 0x80) {
+			// scan word array
+			for (i = 0; i < zargs[2]; i++, p += step) {
+				if (READ_BE_UINT16(p) == zargs[0])
+					break;
+			}
+		} else if (step == 1 && zargs[0] < 0x100) {
+			// scan byte string
+			const zbyte *found = (const zbyte *)memchr(p, zargs[0], zargs[2]);
+			i = found ? found - p : zargs[2];
+			p += i;
+		} else {
+			// scan byte array
+			for (i = 0; i < zargs[2]; i++, p += step) {
+				if (*p == zargs[0])
+					break;
+			}
+		}
+
+		addr = (i < zargs[2]) ? (zword)(p - zmp) : 0;
+		store(addr);
+		branch(addr);
+		return;
+	}
+
 	// Scan byte or word array
 	for (i = 0; i < zargs[2]; i++) {
 		if (zargs[3] & 0x80) {
@@ -98,7 +130,7 @@ void Processor::z_scan_table() {
 				goto finished;
 		}
 
-		addr += zargs[3] & 0x7f;
+		addr += step;
 	}
 
 	addr = 0;
@@ -43,7 +43,13 @@ Window &Windows::operator[](uint idx) {
 }
 
 void Windows::setup(bool isVersion6) {
-	if (isVersion6) {
+	if (g_vm->_headless) {
+		// No Glk windows at all: the windows only keep their properties, and
+		// everything drawn in them is discarded
+		_lower[X_SIZE] = g_vm->h_screen_cols;
+		_lower[Y_SIZE] = g_vm->h_screen_rows;
+
+	} else if (isVersion6) {
 		// For graphic games we have a background window covering the entire screen for greater
 		// flexibility of wher we draw pictures, and the lower and upper areas sit on top of them
 		_background = g_vm->glk_window_open(0, 0, 0, wintype_Graphics, 0);
@@ -93,7 +99,11 @@ Window::Window() : _windows(nullptr), _win(nullptr), _quotes(0), _dashes(0), _sp
 }
 
 void Window::update() {
-	assert(_win);
+	// Without a screen the properties set up by Windows::setup() are kept
+	if (!_win) {
+		assert(g_vm->_headless);
+		return;
+	}
 
 	_properties[X_POS] = _win->_bbox.left / g_conf->_monoInfo._cellW + 1;
 	_properties[Y_POS] = _win->_bbox.top / g_conf->_monoInfo._cellH + 1;
@@ -159,7 +169,8 @@ void Window::setCursor(const Point &newPos) {
 	}
 
 	if (!x || !y) {
-		update();
+		if (_win)
+			update();
 
 		if (!x)
 			x = _properties[X_CURSOR];
@@ -167,7 +178,12 @@ void Window::setCursor(const Point &newPos) {
 			y = _properties[Y_CURSOR];
 	}
 
-	g_vm->glk_window_move_cursor(_win, x - 1, y - 1);
+	if (_win) {
+		g_vm->glk_window_move_cursor(_win, x - 1, y - 1);
+	} else {
+		_properties[X_CURSOR] = x;
+		_properties[Y_CURSOR] = y;
+	}
 }
 
 void Window::clear() {
@@ -254,6 +270,8 @@ void Window::updateStyle() {
 	uint style = _currStyle;
 
 	ensureGlkWindow();
+	if (!_win)
+		return;
 
 	if (style & REVERSE_STYLE)
 		setReverseVideo(true);
@@ -291,10 +309,14 @@ void Window::updateStyle() {
 }
 
 void Window::setReverseVideo(bool reverse) {
-	_win->_stream->setReverseVideo(reverse);
+	if (_win)
+		_win->_stream->setReverseVideo(reverse);
 }
 
 void Window::ensureGlkWindow() {
+	if (g_vm->_headless)
+		return;
+
 	// Create a new window	
 	if (_win && (dynamic_cast<TextGridWindow *>(_win) != nullptr) != ((_currStyle & FIXED_WIDTH_STYLE) != 0)) {
 		g_vm->glk_window_close(_win);
@@ -338,7 +360,7 @@ void Window::setProperty(WindowProperty propType, uint value) {
 }
 
 void Window::checkRepositionLower() {
-	if (&_windows->_lower == this) {
+	if (&_windows->_lower == this && _win) {
 		PairWindow *parent = dynamic_cast<PairWindow *>(_win->_parent);
 		if (!parent)
 			error("Parent was not a pair window");
@@ -51,6 +51,14 @@ GlkEngine::GlkEngine(OSystem *syst, const GlkGameDescription &gameDesc) :
 		gli_register_obj(nullptr), gli_unregister_obj(nullptr), gli_register_arr(nullptr),
 		gli_unregister_arr(nullptr) {
 	g_vm = this;
+
+	// Set up debug channels. This has to happen before run(), so that the
+	// channels given with --debugflags can be enabled
+	DebugMan.addDebugChannel(kDebugCore, "core", "Core engine debug level");
+	DebugMan.addDebugChannel(kDebugScripts, "scripts", "Game scripts");
+	DebugMan.addDebugChannel(kDebugGraphics, "graphics", "Graphics handling");
+	DebugMan.addDebugChannel(kDebugSound, "sound", "Sound and Music handling");
+	DebugMan.addDebugChannel(kDebugProfile, "profile", "Interpreter statistics and most called routines");
 }
 
 GlkEngine::~GlkEngine() {
@@ -68,12 +76,6 @@ GlkEngine::~GlkEngine() {
 }
 
 void GlkEngine::initialize() {
-	// Set up debug channels
-	DebugMan.addDebugChannel(kDebugCore, "core", "Core engine debug level");
-	DebugMan.addDebugChannel(kDebugScripts, "scripts", "Game scripts");
-	DebugMan.addDebugChannel(kDebugGraphics, "graphics", "Graphics handling");
-	DebugMan.addDebugChannel(kDebugSound, "sound", "Sound and Music handling");
-
 	initGraphicsMode();
 
 	_conf = new Conf(getInterpreterType());
@@ -81,7 +83,8 @@ void GlkEngine::initialize() {
 	_screen->initialize();
 	_clipboard = new Clipboard();
 	_events = new Events();
-	_pcSpeaker = new PCSpeaker(_mixer);
+	if (_mixer->isReady())
+		_pcSpeaker = new PCSpeaker(_mixer);
 	_pictures = new Pictures();
 	_selection = new Selection();
 	_sounds = new Sounds();
@@ -203,7 +206,8 @@ Common::Error GlkEngine::saveGameState(int slot, const Common::String &desc) {
 }
 
 void GlkEngine::beep() {
-	_pcSpeaker->speakerOn(50, 50);
+	if (_pcSpeaker)
+		_pcSpeaker->speakerOn(50, 50);
 }
 
 } // End of namespace Glk
@@ -49,7 +49,8 @@ enum GlkDebugChannels {
 	kDebugCore      = 1 << 0,
 	kDebugScripts   = 1 << 1,
 	kDebugGraphics  = 1 << 2,
-	kDebugSound     = 1 << 3
+	kDebugSound     = 1 << 3,
+	kDebugProfile   = 1 << 4
 };
 
 
@@ -30,6 +30,7 @@ void Glulxe::execute_loop() {
 	int ix;
 	uint opcode;
 	const operandlist_t *oplist;
+	const decodedinst_t *decoded;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
@@ -49,44 +50,103 @@ void Glulxe::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
-		/* Fetch the opcode number. */
-		opcode = Mem1(pc);
-		pc++;
-		if (opcode & 0x80) {
-			/* More than one-byte opcode. */
-			if (opcode & 0x40) {
-				/* Four-byte opcode */
-				opcode &= 0x3F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
-			} else {
-				/* Two-byte opcode */
-				opcode &= 0x7F;
-				opcode = (opcode << 8) | Mem1(pc);
-				pc++;
+		/* Instructions in ROM are taken from the decoded instruction cache,
+		   which saves decoding the opcode and operand modes again. */
+		decoded = fetch_decoded_instruction(pc);
+		if (decoded) {
+			opcode = decoded->opcode;
+			pc = decoded->addr + decoded->size;
+
+			if (decoded->branch) {
+				/* Jumps and branches with a constant offset load their operands, compare them and
+				   branch in one go. jz and jnz compare their one value with zero. */
+				val0 = (decoded->num_ops > 1) ? load_decoded_operand(decoded, 0) : 0;
+				val1 = (decoded->num_ops > 2) ? load_decoded_operand(decoded, 1) : 0;
+				bool taken;
+				switch (opcode) {
+				case op_jz:
+				case op_jeq:
+					taken = (val0 == val1);
+					break;
+				case op_jnz:
+				case op_jne:
+					taken = (val0 != val1);
+					break;
+				case op_jlt:
+					taken = ((int)val0 < (int)val1);
+					break;
+				case op_jge:
+					taken = ((int)val0 >= (int)val1);
+					break;
+				case op_jgt:
+					taken = ((int)val0 > (int)val1);
+					break;
+				case op_jle:
+					taken = ((int)val0 <= (int)val1);
+					break;
+				case op_jltu:
+					taken = (val0 < val1);
+					break;
+				case op_jgeu:
+					taken = (val0 >= val1);
+					break;
+				case op_jgtu:
+					taken = (val0 > val1);
+					break;
+				case op_jleu:
+					taken = (val0 <= val1);
+					break;
+				default:
+					/* op_jump */
+					taken = true;
+					break;
+				}
+				if (taken)
+					pc = decoded->operands[decoded->num_ops - 1];
+				continue;
+			}
+
+			load_decoded_operands(inst, decoded);
+		} else {
+			/* Fetch the opcode number. */
+			opcode = Mem1(pc);
+			pc++;
+			if (opcode & 0x80) {
+				/* More than one-byte opcode. */
+				if (opcode & 0x40) {
+					/* Four-byte opcode */
+					opcode &= 0x3F;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+				} else {
+					/* Two-byte opcode */
+					opcode &= 0x7F;
+					opcode = (opcode << 8) | Mem1(pc);
+					pc++;
+				}
 			}
-		}
 
-		/* Now we have an opcode number. */
+			/* Now we have an opcode number. */
 
-		/* Fetch the structure that describes how the operands for this
-		   opcode are arranged. This is a pointer to an immutable,
-		   static object. */
-		if (opcode < 0x80)
-			oplist = fast_operandlist[opcode];
-		else
-			oplist = lookup_operandlist(opcode);
+			/* Fetch the structure that describes how the operands for this
+			   opcode are arranged. This is a pointer to an immutable,
+			   static object. */
+			if (opcode < 0x80)
+				oplist = fast_operandlist[opcode];
+			else
+				oplist = lookup_operandlist(opcode);
 
-		if (!oplist)
-			fatal_error_i("Encountered unknown opcode.", opcode);
+			if (!oplist)
+				fatal_error_i("Encountered unknown opcode.", opcode);
 
-		/* Based on the oplist structure, load the actual operand values
-		   into inst. This moves the PC up to the end of the instruction. */
-		parse_operands(inst, oplist);
+			/* Based on the oplist structure, load the actual operand values
+			   into inst. This moves the PC up to the end of the instruction. */
+			parse_operands(inst, oplist);
+		}
 
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
@@ -328,8 +388,7 @@ PerformJump: /* goto label for successful jumping... ironic, no? */
 			case op_call:
 				value = inst[1].value;
 				arglist = pop_arguments(value, 0);
-				push_callstub(inst[2].desttype, inst[2].value);
-				enter_function(inst[0].value, value, arglist);
+				call_function(inst[0].value, value, arglist, inst[2].desttype, inst[2].value);
 				break;
 			case op_return:
 				leave_function();
@@ -584,26 +643,22 @@ PerformJump: /* goto label for successful jumping... ironic, no? */
 				break;
 
 			case op_callf:
-				push_callstub(inst[1].desttype, inst[1].value);
-				enter_function(inst[0].value, 0, arglistfix);
+				call_function(inst[0].value, 0, arglistfix, inst[1].desttype, inst[1].value);
 				break;
 			case op_callfi:
 				arglistfix[0] = inst[1].value;
-				push_callstub(inst[2].desttype, inst[2].value);
-				enter_function(inst[0].value, 1, arglistfix);
+				call_function(inst[0].value, 1, arglistfix, inst[2].desttype, inst[2].value);
 				break;
 			case op_callfii:
 				arglistfix[0] = inst[1].value;
 				arglistfix[1] = inst[2].value;
-				push_callstub(inst[3].desttype, inst[3].value);
-				enter_function(inst[0].value, 2, arglistfix);
+				call_function(inst[0].value, 2, arglistfix, inst[3].desttype, inst[3].value);
 				break;
 			case op_callfiii:
 				arglistfix[0] = inst[1].value;
 				arglistfix[1] = inst[2].value;
 				arglistfix[2] = inst[3].value;
-				push_callstub(inst[4].desttype, inst[4].value);
-				enter_function(inst[0].value, 3, arglistfix);
+				call_function(inst[0].value, 3, arglistfix, inst[4].desttype, inst[4].value);
 				break;
 
 			case op_getmemsize:
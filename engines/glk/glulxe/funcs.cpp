@@ -21,27 +21,57 @@
  */
 
 #include "glk/glulxe/glulxe.h"
+#include "common/algorithm.h"
+#include "common/debug.h"
 
 namespace Glk {
 namespace Glulxe {
 
 void Glulxe::enter_function(uint funcaddr, uint argc, uint *argv) {
+	acceleration_func accelFunc = accel_get_func(funcaddr);
+	if (accelFunc) {
+		pop_callstub(call_accelerated(accelFunc, funcaddr, argc, argv));
+		return;
+	}
+
+	enter_function_frame(funcaddr, argc, argv);
+}
+
+void Glulxe::call_function(uint funcaddr, uint argc, uint *argv, uint desttype, uint destaddr) {
+	/* Accelerated functions return straight into the store operand, which saves pushing and
+	   popping a call stub. */
+	acceleration_func accelFunc = accel_get_func(funcaddr);
+	if (accelFunc) {
+		store_operand(desttype, destaddr, call_accelerated(accelFunc, funcaddr, argc, argv));
+		return;
+	}
+
+	push_callstub(desttype, destaddr);
+	enter_function_frame(funcaddr, argc, argv);
+}
+
+uint Glulxe::call_accelerated(acceleration_func accelFunc, uint funcaddr, uint argc, uint *argv) {
+	uint val;
+
+	if (profile_calls)
+		call_counts[funcaddr]++;
+
+	profile_in(funcaddr, stackptr, true);
+	val = (this->*accelFunc)(argc, argv);
+	profile_out(stackptr);
+	return val;
+}
+
+void Glulxe::enter_function_frame(uint funcaddr, uint argc, uint *argv) {
 	uint ix, jx;
-	acceleration_func accelFunc;
 	int locallen;
 	int functype;
 	uint modeaddr, opaddr, val;
 	int loctype, locnum;
 	uint addr = funcaddr;
 
-	accelFunc = accel_get_func(addr);
-	if (accelFunc) {
-		profile_in(addr, stackptr, true);
-		val = (this->*accelFunc)(argc, argv);
-		profile_out(stackptr);
-		pop_callstub(val);
-		return;
-	}
+	if (profile_calls)
+		call_counts[funcaddr]++;
 
 	profile_in(addr, stackptr, false);
 
@@ -196,6 +226,43 @@ void Glulxe::enter_function(uint funcaddr, uint argc, uint *argv) {
 	debugger_check_func_breakpoint(funcaddr);
 }
 
+struct CallCount {
+	uint addr;
+	uint calls;
+};
+
+static bool compareCallCounts(const CallCount &a, const CallCount &b) {
+	return a.calls > b.calls;
+}
+
+void Glulxe::profile_calls_report() {
+	if (!profile_calls)
+		return;
+
+	const uint32 elapsed = g_system->getMillis() - profile_start_time;
+	const uint64 instructions = decoded_hits + decoded_misses + uncached_instructions;
+	debugC(kDebugProfile, "Executed %u thousand instructions in %u ms, %u thousand per second",
+		(uint)(instructions / 1000), elapsed, elapsed ? (uint)(instructions / elapsed) : 0);
+	if (instructions)
+		debugC(kDebugProfile, "Decoded instruction cache: %u%% hits, %u thousand decoded, %u thousand not cached",
+			(uint)(decoded_hits * 100 / instructions), (uint)(decoded_misses / 1000), (uint)(uncached_instructions / 1000));
+
+	// The most called functions, which are the candidates for acceleration
+	Common::Array<CallCount> functions;
+	functions.reserve(call_counts.size());
+	for (Common::HashMap<uint, uint>::const_iterator i = call_counts.begin(); i != call_counts.end(); ++i) {
+		CallCount entry = { i->_key, i->_value };
+		functions.push_back(entry);
+	}
+	Common::sort(functions.begin(), functions.end(), compareCallCounts);
+
+	debugC(kDebugProfile, "Most called of %u functions:", functions.size());
+	for (uint ix = 0; ix < functions.size() && ix < 20; ix++) {
+		debugC(kDebugProfile, "  %08x: %u calls%s", functions[ix].addr, functions[ix].calls,
+			accel_get_func(functions[ix].addr) ? ", accelerated" : "");
+	}
+}
+
 void Glulxe::leave_function() {
 	profile_out(stackptr);
 	stackptr = frameptr;
@@ -22,6 +22,7 @@
 
 #include "glk/glulxe/glulxe.h"
 #include "common/config-manager.h"
+#include "common/debug-channels.h"
 #include "common/translation.h"
 
 namespace Glk {
@@ -35,6 +36,10 @@ Glulxe::Glulxe(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst,
 		stackptr(0), frameptr(0), pc(0), prevpc(0), origstringtable(0), stringtable(0), valstackbase(0),
 		localsbase(0), endmem(0), protectstart(0), protectend(0),
 		stream_char_handler(nullptr), stream_unichar_handler(nullptr),
+		// operand
+		decoded_cache(nullptr), decoded_hits(0), decoded_misses(0), uncached_instructions(0),
+		// call profile
+		profile_calls(false), profile_start_time(0),
 		// main
 		library_autorestore_hook(nullptr),
 		// accel
@@ -63,7 +68,11 @@ void Glulxe::runGame() {
 	if (library_autorestore_hook)
 		library_autorestore_hook();
 
+	profile_calls = DebugMan.isDebugChannelEnabled(kDebugProfile);
+	profile_start_time = g_system->getMillis();
+
 	execute_loop();
+	profile_calls_report();
 	finalize_vm();
 
 	gamefile_start = 0;
@@ -24,6 +24,7 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulxe/glulxe_types.h"
@@ -142,6 +143,40 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Instructions in ROM which were executed, with their opcode and operand modes decoded,
+	 * indexed by the low bits of their address.
+	 */
+	decodedinst_t *decoded_cache;
+
+	/**
+	 * Number of instructions taken from the decoded instruction cache, which were decoded
+	 * into it, and which couldn't be cached.
+	 */
+	uint64 decoded_hits, decoded_misses, uncached_instructions;
+
+	/**@}*/
+
+	/**
+	 * \defgroup call profile fields
+	 * @{
+	 */
+
+	/**
+	 * Set if the profile debug channel is enabled, which counts the calls of every function.
+	 */
+	bool profile_calls;
+
+	/**
+	 * Number of calls of every function, by address.
+	 */
+	Common::HashMap<uint, uint> call_counts;
+
+	/**
+	 * Time in milliseconds when execution started.
+	 */
+	uint32 profile_start_time;
+
 	/**@}*/
 
 	/**
@@ -542,6 +577,77 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Get the instruction at the given address from the decoded instruction cache, decoding it
+	 * if it isn't there yet. Returns nullptr for instructions which can't be cached, as they're
+	 * not entirely in ROM, or are invalid. These have to be read with parse_operands().
+	 */
+	inline const decodedinst_t *fetch_decoded_instruction(uint addr) {
+		decodedinst_t *inst = &decoded_cache[addr & (DECODED_CACHE_SIZE - 1)];
+		if (inst->size && inst->addr == addr) {
+			if (profile_calls)
+				decoded_hits++;
+			return inst;
+		}
+		return fill_decoded_instruction(addr, inst);
+	}
+
+	/**
+	 * Decode the instruction at the given address into a cache entry, for fetch_decoded_instruction().
+	 */
+	const decodedinst_t *fill_decoded_instruction(uint addr, decodedinst_t *inst);
+
+	/**
+	 * Decode the opcode and operand modes of the instruction at the given address, without
+	 * loading any operand values. Returns false if the instruction can't be cached.
+	 */
+	bool decode_instruction(uint addr, decodedinst_t *inst);
+
+	/**
+	 * Load the value of a load operand of a decoded instruction, like parse_operands() does.
+	 */
+	inline uint load_decoded_operand(const decodedinst_t *inst, int ix) {
+		uint value = inst->operands[ix];
+
+		switch (inst->modes[ix]) {
+		case decodedload_Stack:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			return Stk4(stackptr);
+
+		case decodedload_Memory:
+			if (inst->arg_size == 4)
+				return Mem4(value);
+			else if (inst->arg_size == 2)
+				return Mem2(value);
+			return Mem1(value);
+
+		case decodedload_Locals:
+			value += localsbase;
+			if (inst->arg_size == 4)
+				return Stk4(value);
+			else if (inst->arg_size == 2)
+				return Stk2(value);
+			return Stk1(value);
+
+		default:
+			return value;
+		}
+	}
+
+	/**
+	 * Load the operand values of a decoded instruction into args, like parse_operands()
+	 * does. This doesn't change the PC.
+	 */
+	void load_decoded_operands(oparg_t *opargs, const decodedinst_t *inst);
+
+	/**
+	 * Empty the decoded instruction cache.
+	 */
+	void clear_decoded_instructions();
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -565,6 +671,23 @@ public:
 	 */
 	void enter_function(uint addr, uint argc, uint *argv);
 
+	/**
+	 * Call a function for a call opcode, which stores the result in the given destination. Unlike
+	 * enter_function(), this pushes the call stub itself, and only for functions which aren't
+	 * accelerated.
+	 */
+	void call_function(uint addr, uint argc, uint *argv, uint desttype, uint destaddr);
+
+	/**
+	 * Run an accelerated function, returning its result.
+	 */
+	uint call_accelerated(acceleration_func accelFunc, uint addr, uint argc, uint *argv);
+
+	/**
+	 * Write the call frame of a function which isn't accelerated, see enter_function().
+	 */
+	void enter_function_frame(uint addr, uint argc, uint *argv);
+
 	/**
 	 * Pop the current call frame off the stack. This is very simple.
 	*/
@@ -810,6 +933,12 @@ public:
 	int init_profile();
 	void profile_set_call_counts(int flag);
 
+	/**
+	 * Write the instructions per second, the use of the decoded instruction cache, and the most
+	 * called functions to the profile debug channel, if it is enabled.
+	 */
+	void profile_calls_report();
+
 	#if VM_PROFILING
 	uint profile_opcount;
 	#define profile_tick() (profile_opcount++)
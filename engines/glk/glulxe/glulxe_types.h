@@ -352,6 +352,61 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * Maximum number of operands of instructions in the decoded instruction cache. Instructions with
+ * more operands, like the search opcodes, are not cached.
+ */
+#define DECODED_MAX_OPERANDS (5)
+
+/**
+ * Maximum size of a cached instruction: a four-byte opcode, the operand modes, and four bytes per operand.
+ */
+#define MAX_INSTRUCTION_SIZE (4 + (DECODED_MAX_OPERANDS + 1) / 2 + 4 * DECODED_MAX_OPERANDS)
+
+/**
+ * Where a load operand of a decoded instruction comes from.
+ */
+enum decodedload {
+	decodedload_Constant = 0,
+	decodedload_Stack = 1,
+	decodedload_Memory = 2,
+	decodedload_Locals = 3
+};
+
+/**
+ * An instruction in ROM with its opcode and operand modes decoded, see Glulxe::fetch_decoded_instruction().
+ * ROM can't be written to, so the decoded instructions never get out of date. The fields are packed
+ * into 36 bytes, to keep the cache small.
+ */
+struct decodedinst_struct {
+	uint addr;                      ///< Address of the instruction
+	uint16 opcode;
+	byte size;                      ///< Size of the instruction in bytes, or 0 if the entry is unused
+	byte num_ops;
+	byte arg_size;
+	byte storemask;                 ///< Bit n is set if operand n is a store operand
+	/**
+	 * Set for jumps and conditional branches with a constant offset, which execute_loop() performs
+	 * without going through the opcode switch. Their last operand holds the address of the target
+	 * instead of the offset.
+	 */
+	byte branch;
+	/**
+	 * A decodedload value for load operands, and the desttype for store operands
+	 */
+	byte modes[DECODED_MAX_OPERANDS];
+	/**
+	 * The constant value or the address of load operands, and the destination address of store operands
+	 */
+	uint operands[DECODED_MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+/**
+ * Number of instructions in the decoded instruction cache, 144 KB in all. Must be a power of two.
+ */
+#define DECODED_CACHE_SIZE (4096)
+
 typedef uint(Glulxe::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
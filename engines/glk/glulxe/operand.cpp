@@ -516,6 +516,156 @@ WrLocalsAddr:
 	}
 }
 
+const decodedinst_t *Glulxe::fill_decoded_instruction(uint addr, decodedinst_t *inst) {
+	if (!decode_instruction(addr, inst)) {
+		inst->size = 0;
+		if (profile_calls)
+			uncached_instructions++;
+		return nullptr;
+	}
+
+	if (profile_calls)
+		decoded_misses++;
+	return inst;
+}
+
+bool Glulxe::decode_instruction(uint addr, decodedinst_t *inst) {
+	/* Only instructions entirely in ROM are cached, as RAM may change. This also keeps
+	   the reads below within main memory. */
+	if (addr >= ramstart || ramstart - addr < MAX_INSTRUCTION_SIZE)
+		return false;
+
+	const uint startaddr = addr;
+
+	/* Fetch the opcode number, like execute_loop() does. */
+	uint opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode = ((opcode & 0x3F) << 24) | (Mem1(addr) << 16) | (Mem1(addr + 1) << 8) | Mem1(addr + 2);
+			addr += 3;
+		} else {
+			opcode = ((opcode & 0x7F) << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+	if (opcode > 0xFFFF)
+		return false;
+
+	const operandlist_t *oplist = (opcode < 0x80) ? fast_operandlist[opcode] : lookup_operandlist(opcode);
+	if (!oplist || oplist->num_ops > DECODED_MAX_OPERANDS)
+		return false;
+
+	inst->addr = startaddr;
+	inst->opcode = opcode;
+	inst->num_ops = oplist->num_ops;
+	inst->arg_size = oplist->arg_size;
+	inst->storemask = 0;
+
+	/* Decode the operand modes, like parse_operands() does. */
+	uint modeaddr = addr;
+	addr += (oplist->num_ops + 1) / 2;
+
+	int mode = 0;
+	for (int ix = 0; ix < oplist->num_ops; ix++) {
+		if ((ix & 1) == 0) {
+			mode = (Mem1(modeaddr) & 0x0F);
+		} else {
+			mode = ((Mem1(modeaddr) >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		uint value = 0;
+		switch (mode) {
+		case 0:
+		case 8:
+			break;
+		case 1:
+		case 5:
+		case 9:
+		case 13:
+			value = (mode == 1) ? (uint)(int)(signed char)(Mem1(addr)) : (uint)Mem1(addr);
+			addr++;
+			break;
+		case 2:
+		case 6:
+		case 10:
+		case 14:
+			value = (mode == 2) ? (uint)(int)(int16)Mem2(addr) : (uint)Mem2(addr);
+			addr += 2;
+			break;
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(addr);
+			addr += 4;
+			break;
+		default:
+			return false;
+		}
+		if (mode >= 13)
+			value += ramstart;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			if (mode < 4)
+				inst->modes[ix] = decodedload_Constant;
+			else if (mode == 8)
+				inst->modes[ix] = decodedload_Stack;
+			else if (mode >= 9 && mode <= 11)
+				inst->modes[ix] = decodedload_Locals;
+			else
+				inst->modes[ix] = decodedload_Memory;
+		} else {
+			inst->storemask |= 1 << ix;
+			/* Constants are illegal as store operands, parse_operands() reports them. */
+			if (mode >= 1 && mode <= 3)
+				return false;
+			else if (mode == 0)
+				inst->modes[ix] = 0;
+			else if (mode == 8)
+				inst->modes[ix] = 3;
+			else if (mode >= 9 && mode <= 11)
+				inst->modes[ix] = 2;
+			else
+				inst->modes[ix] = 1;
+		}
+		inst->operands[ix] = value;
+	}
+
+	inst->size = addr - startaddr;
+
+	/* Jumps and branches with a constant offset get their target now. Offsets 0 and 1 return
+	   from the function instead, which is left to the opcode switch. */
+	inst->branch = 0;
+	if ((opcode == op_jump || (opcode >= op_jz && opcode <= op_jleu)) && oplist->num_ops && mode >= 1 && mode <= 3) {
+		const int last = oplist->num_ops - 1;
+		if (inst->operands[last] != 0 && inst->operands[last] != 1) {
+			inst->operands[last] = addr + inst->operands[last] - 2;
+			inst->branch = 1;
+		}
+	}
+
+	return true;
+}
+
+void Glulxe::load_decoded_operands(oparg_t *args, const decodedinst_t *inst) {
+	for (int ix = 0; ix < inst->num_ops; ix++) {
+		if (inst->storemask & (1 << ix)) {
+			args[ix].desttype = inst->modes[ix];
+			args[ix].value = inst->operands[ix];
+		} else {
+			args[ix].desttype = 0;
+			args[ix].value = load_decoded_operand(inst, ix);
+		}
+	}
+}
+
+void Glulxe::clear_decoded_instructions() {
+	if (decoded_cache)
+		memset(decoded_cache, 0, DECODED_CACHE_SIZE * sizeof(decodedinst_t));
+}
+
 void Glulxe::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
@@ -88,6 +88,12 @@ void Glulxe::setup_vm() {
 	}
 	stringtable = 0;
 
+	decoded_cache = (decodedinst_t *)glulx_malloc(DECODED_CACHE_SIZE * sizeof(decodedinst_t));
+	if (!decoded_cache) {
+		fatal_error("Unable to allocate the decoded instruction cache.");
+	}
+	clear_decoded_instructions();
+
 	// Initialize various other things in the terp.
 	init_operands();
 	init_serial();
@@ -115,6 +121,10 @@ void Glulxe::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decoded_cache) {
+		glulx_free(decoded_cache);
+		decoded_cache = nullptr;
+	}
 
 	final_serial();
 }
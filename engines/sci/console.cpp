@@ -76,11 +76,14 @@ bool g_debug_track_mouse_clicks = false;
 static int parse_reg_t(EngineState *s, const char *str, reg_t *dest);
 
 Console::Console(SciEngine *engine) : GUI::Debugger(),
-	_engine(engine), _debugState(engine->_debugState) {
+	_engine(engine), _debugState(engine->_debugState),
+	_scriptStepsStart(0) {
 
 	assert(_engine);
 	assert(_engine->_gamestate);
 
+	_scriptStepsStartTime = _selectorLookupsStartTime = _vmCallsStartTime = g_system->getMillis();
+
 	// Variables
 	registerVar("sleeptime_factor",	&g_debug_sleeptime_factor);
 	registerVar("gc_interval",		&engine->_gamestate->scriptGCInterval);
@@ -117,6 +120,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
 	registerCmd("verify_scripts",		WRAP_METHOD(Console, cmdVerifyScripts));
 	registerCmd("integrity_dump",	WRAP_METHOD(Console, cmdResourceIntegrityDump));
@@ -142,6 +146,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("wl",                 WRAP_METHOD(Console, cmdWindowList));	// alias
 	registerCmd("plane_list",         WRAP_METHOD(Console, cmdPlaneList));
 	registerCmd("pl",                 WRAP_METHOD(Console, cmdPlaneList));	// alias
+	registerCmd("plane_timing",       WRAP_METHOD(Console, cmdPlaneTiming));
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	registerCmd("visible_plane_list", WRAP_METHOD(Console, cmdVisiblePlaneList));
 	registerCmd("vpl",                WRAP_METHOD(Console, cmdVisiblePlaneList));	// alias
 	registerCmd("plane_items",        WRAP_METHOD(Console, cmdPlaneItemList));
@@ -225,6 +231,10 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("selector_lookups",	WRAP_METHOD(Console, cmdSelectorLookups));
+	registerCmd("selector_benchmark",	WRAP_METHOD(Console, cmdSelectorBenchmark));
+	registerCmd("vm_calls",			WRAP_METHOD(Console, cmdVMCalls));
+	registerCmd("vm_benchmark",		WRAP_METHOD(Console, cmdVMBenchmark));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -338,6 +348,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_types - Shows the valid resource types\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
+	debugPrintf(" resource_cache - Shows resource cache statistics, or sets the cache size\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
 	debugPrintf(" verify_scripts - Performs sanity checks on SCI1.1-SCI2.1 game scripts (e.g. if they're up to 64KB in total)\n");
 	debugPrintf(" integrity_dump - Dumps integrity data about resources in the current game to disk\n");
@@ -363,6 +374,8 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" window_list / wl - Shows a list of all the windows (ports) in the draw list (SCI0 - SCI1.1)\n");
 	debugPrintf(" plane_list / pl - Shows a list of all the planes in the draw list (SCI2+)\n");
 	debugPrintf(" visible_plane_list / vpl - Shows a list of all the planes in the visible draw list (SCI2+)\n");
+	debugPrintf(" plane_timing - Measures how long drawing each plane takes (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows or changes the cache of decompressed cels (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
@@ -423,7 +436,11 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" bp_function / bpe - Sets a breakpoint on the execution of the specified exported function\n");
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
-	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" script_steps - Shows the number of executed SCI operations and their throughput\n");
+	debugPrintf(" selector_lookups - Shows the throughput of selector lookups and the hit rate of their cache\n");
+	debugPrintf(" selector_benchmark - Measures how fast selectors are looked up, with and without their cache\n");
+	debugPrintf(" vm_calls - Shows the throughput of calls and the depth of the execution stack\n");
+	debugPrintf(" vm_benchmark - Measures how fast the VM fetches and executes instructions\n");
 	debugPrintf(" vm_varlist / vmvarlist / vl - Shows the addresses of variables in the VM\n");
 	debugPrintf(" vm_vars / vmvars / vv - Displays or changes variables in the VM\n");
 	debugPrintf(" stack - Lists the specified number of stack elements\n");
@@ -1028,6 +1045,39 @@ bool Console::cmdAllocList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc > 2) {
+		debugPrintf("Shows resource cache statistics, or changes the cache size\n");
+		debugPrintf("Usage: %s [<size in KiB> | reset]\n", argv[0]);
+		debugPrintf("The size can be preset with the sci_resource_cache_size config key\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			resMan->resetCacheStatistics();
+		} else {
+			const int size = atoi(argv[1]);
+			if (size <= 0) {
+				debugPrintf("Invalid cache size %s\n", argv[1]);
+				return true;
+			}
+			resMan->setCacheMemoryLimit(MIN<uint32>(size, 0x3FFFFF) * 1024);
+		}
+	}
+
+	const ResourceManager::CacheStatistics &stats = resMan->getCacheStatistics();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Cache: %u entries, %u of %u KiB used\n", resMan->getCacheEntries(), resMan->getCacheMemory() / 1024, resMan->getCacheMemoryLimit() / 1024);
+	debugPrintf("Locked: %u KiB\n", resMan->getLockedMemory() / 1024);
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate), evictions: %u\n", stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0, stats.evictions);
+	debugPrintf("Prefetched: %u, used: %u\n", stats.prefetches, stats.prefetchHits);
+	return true;
+}
+
 bool Console::cmdDissectScript(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Examines a script\n");
@@ -2063,6 +2113,75 @@ bool Console::cmdPlaneList(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdPlaneTiming(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not have a list of planes\n");
+		return true;
+	}
+
+	if (argc > 2 || (argc == 2 && scumm_stricmp(argv[1], "on") && scumm_stricmp(argv[1], "off"))) {
+		debugPrintf("Shows how long drawing each plane takes, averaged over the rendered frames\n");
+		debugPrintf("Usage: %s [on | off]\n", argv[0]);
+		debugPrintf("Turning it on again restarts the measurement\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		_engine->_gfxFrameout->setRenderStatsEnabled(!scumm_stricmp(argv[1], "on"));
+		return true;
+	}
+
+	if (_engine->_gfxFrameout->getRenderStatsEnabled()) {
+		_engine->_gfxFrameout->printRenderStats(this);
+	} else {
+		debugPrintf("Plane timing is off\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	CelPixelCache *cache = CelObj::_pixelCache.get();
+	if (!cache) {
+		debugPrintf("This SCI version does not have a cel cache\n");
+		return true;
+	}
+
+	if (argc > 2) {
+		debugPrintf("Shows statistics of the cache of decompressed cels, or changes its size\n");
+		debugPrintf("Usage: %s [<size in KiB> | reset]\n", argv[0]);
+		debugPrintf("The size can be preset with the sci_cel_cache_size config key\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (!scumm_stricmp(argv[1], "reset")) {
+			cache->resetStatistics();
+		} else {
+			const int size = atoi(argv[1]);
+			if (size < 0 || (size == 0 && strcmp(argv[1], "0"))) {
+				debugPrintf("Invalid cache size %s\n", argv[1]);
+				return true;
+			}
+			cache->setMemoryLimit(MIN<uint32>(size, 0x3FFFFF) * 1024);
+		}
+	}
+
+	const CelPixelCache::Statistics &stats = cache->getStatistics();
+	const uint32 requests = stats.hits + stats.misses;
+
+	debugPrintf("Cache: %u cels, %u of %u KiB used\n", cache->getEntries(), cache->getMemory() / 1024, cache->getMemoryLimit() / 1024);
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate), evictions: %u\n", stats.hits, stats.misses, requests ? stats.hits * 100 / requests : 0, stats.evictions);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 #ifdef ENABLE_SCI32
 	if (_engine->_gfxFrameout) {
@@ -3145,7 +3264,7 @@ bool Console::cmdDumpReference(int argc, const char **argv) {
 #endif
 
 	default: {
-		const SegmentRef block = _engine->_gamestate->_segMan->dereference(reg);
+		const SegmentRef block = _engine->_gamestate->_segMan->dereferenceReadOnly(reg);
 		uint32 size = block.maxSize;
 
 		if (size == 0) {
@@ -3253,8 +3372,410 @@ bool Console::cmdViewAccumulatorObject(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::resetThroughput(int argc, const char **argv, uint32 &startTime) {
+	if (argc < 2 || strcmp(argv[1], "reset"))
+		return false;
+
+	startTime = g_system->getMillis();
+	debugPrintf("Statistics reset\n");
+	return true;
+}
+
+void Console::printThroughput(const char *command, const char *what, uint32 count, uint32 startTime) {
+	const uint32 elapsed = g_system->getMillis() - startTime;
+	debugPrintf("%s since the last \"%s reset\": %u in %u ms, %u per second\n",
+	            what, command, count, elapsed, elapsed ? (uint32)((uint64)count * 1000 / elapsed) : 0);
+}
+
 bool Console::cmdScriptSteps(int argc, const char **argv) {
-	debugPrintf("Number of executed SCI operations: %d\n", _engine->_gamestate->scriptStepCounter);
+	const int steps = _engine->_gamestate->scriptStepCounter;
+
+	if (resetThroughput(argc, argv, _scriptStepsStartTime)) {
+		_scriptStepsStart = steps;
+		return true;
+	}
+
+	debugPrintf("Number of executed SCI operations: %d\n", steps);
+	printThroughput(argv[0], "SCI operations", steps - _scriptStepsStart, _scriptStepsStartTime);
+
+	uint scripts = 0, decodedPages = 0;
+	const Common::Array<SegmentObj *> &segments = _engine->_gamestate->_segMan->getSegments();
+	for (uint i = 0; i < segments.size(); i++) {
+		if (segments[i] && segments[i]->getType() == SEG_TYPE_SCRIPT) {
+			scripts++;
+			decodedPages += static_cast<Script *>(segments[i])->getDecodedPageCount();
+		}
+	}
+	debugPrintf("Decoded instructions: %u pages in %u loaded scripts\n", decodedPages, scripts);
+	return true;
+}
+
+bool Console::cmdSelectorLookups(int argc, const char **argv) {
+	SelectorLookupCache &cache = _engine->_gamestate->_segMan->getSelectorLookupCache();
+
+	if (resetThroughput(argc, argv, _selectorLookupsStartTime)) {
+		cache.resetStatistics();
+		return true;
+	}
+
+	const uint32 lookups = cache.getLookups();
+	printThroughput(argv[0], "Selector lookups (sends and selector accesses)", lookups, _selectorLookupsStartTime);
+	debugPrintf("Found in the lookup cache: %u (%u%%)\n",
+	            cache.getHits(), lookups ? (uint32)((uint64)cache.getHits() * 100 / lookups) : 0);
+	return true;
+}
+
+/**
+ * Look up a selector with lookupSelector(), and return its variable index
+ * or method address in value.
+ */
+static SelectorType lookupSelectorValue(SegManager *segMan, reg_t obj, Selector selectorId, reg_t &value) {
+	ObjVarRef varp;
+	reg_t fptr = NULL_REG;
+	const SelectorType type = lookupSelector(segMan, obj, selectorId, &varp, &fptr);
+	value = type == kSelectorVariable ? make_reg(0, varp.varindex) : fptr;
+	return type;
+}
+
+bool Console::cmdSelectorBenchmark(int argc, const char **argv) {
+	int rounds = 100;
+	if (argc > 2 || (argc == 2 && (rounds = atoi(argv[1])) <= 0)) {
+		debugPrintf("Measures how fast lookupSelector() finds the variables and methods of\n");
+		debugPrintf("the objects of the loaded scripts, when every lookup misses the cache\n");
+		debugPrintf("and through the cache. Then reloads the script with the most objects\n");
+		debugPrintf("and checks that the cache does not return the lookups made before.\n");
+		debugPrintf("The scripts are loaded again for this, the game is not affected.\n");
+		debugPrintf("Usage: %s [<rounds>]\n", argv[0]);
+		debugPrintf("The default is %d rounds\n", rounds);
+		return true;
+	}
+
+	// Load the scripts of the game into a segment manager of our own, so
+	// that reloading one of them does not affect the game
+	SegManager *segMan = new SegManager(_engine->getResMan(), _engine->getScriptPatcher());
+	const Common::Array<SegmentObj *> &gameSegments = _engine->_gamestate->_segMan->getSegments();
+	for (uint i = 0; i < gameSegments.size(); i++) {
+		if (gameSegments[i] && gameSegments[i]->getType() == SEG_TYPE_SCRIPT && !static_cast<Script *>(gameSegments[i])->isMarkedAsDeleted())
+			segMan->instantiateScript(static_cast<Script *>(gameSegments[i])->getScriptNumber());
+	}
+
+	// Send every variable and method selector of its class hierarchy to each
+	// object, like the scripts do
+	Common::Array<reg_t> objects;
+	Common::Array<Selector> selectors;
+	int reloadScriptNr = -1;
+	uint reloadObjectCount = 0;
+	const Common::Array<SegmentObj *> &segments = segMan->getSegments();
+	for (uint i = 0; i < segments.size(); i++) {
+		if (!segments[i] || segments[i]->getType() != SEG_TYPE_SCRIPT)
+			continue;
+		const Script *script = static_cast<Script *>(segments[i]);
+		const ObjMap &objectMap = script->getObjectMap();
+		if (objectMap.size() > reloadObjectCount) {
+			reloadScriptNr = script->getScriptNumber();
+			reloadObjectCount = objectMap.size();
+		}
+		for (ObjMap::const_iterator it = objectMap.begin(); it != objectMap.end(); ++it) {
+			const reg_t pos = it->_value.getPos();
+			const uint first = selectors.size();
+			const Object *obj = segMan->getObject(pos);
+			const Object *objClass = obj->getClass(segMan);
+			for (uint v = 0; objClass && v < objClass->getVarCount(); v++) {
+				objects.push_back(pos);
+				selectors.push_back(objClass->getVarSelector(v));
+			}
+			for (; obj; obj = segMan->getObject(obj->getSuperClassSelector())) {
+				for (uint m = 0; m < obj->getMethodCount(); m++) {
+					const Selector selectorId = obj->getFuncSelector(m);
+					uint s = first;
+					while (s < selectors.size() && selectors[s] != selectorId)
+						s++;
+					if (s == selectors.size()) {
+						objects.push_back(pos);
+						selectors.push_back(selectorId);
+					}
+				}
+			}
+		}
+	}
+
+	if (selectors.empty()) {
+		debugPrintf("No objects in the loaded scripts\n");
+		delete segMan;
+		return true;
+	}
+
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	Common::Array<SelectorType> types;
+	Common::Array<reg_t> values;
+	for (uint i = 0; i < selectors.size(); i++) {
+		reg_t value;
+		cache.invalidate();
+		types.push_back(lookupSelectorValue(segMan, objects[i], selectors[i], value));
+		values.push_back(value);
+	}
+
+	uint32 scanSum = 0, cacheSum = 0;
+	uint32 start = g_system->getMillis();
+	for (int round = 0; round < rounds; round++) {
+		for (uint i = 0; i < selectors.size(); i++) {
+			reg_t value;
+			cache.invalidate();
+			scanSum += lookupSelectorValue(segMan, objects[i], selectors[i], value) + value.getOffset();
+		}
+	}
+	const uint32 scanTime = g_system->getMillis() - start;
+
+	cache.invalidate();
+	cache.resetStatistics();
+	start = g_system->getMillis();
+	for (int round = 0; round < rounds; round++) {
+		for (uint i = 0; i < selectors.size(); i++) {
+			reg_t value;
+			cacheSum += lookupSelectorValue(segMan, objects[i], selectors[i], value) + value.getOffset();
+		}
+	}
+	const uint32 cacheTime = g_system->getMillis() - start;
+
+	const uint64 lookups = (uint64)selectors.size() * rounds;
+	debugPrintf("%u sends to the objects of the loaded scripts, %d rounds\n", selectors.size(), rounds);
+	debugPrintf("Every lookup missing the cache: %u ms, %u ns per lookup\n", scanTime, (uint32)((uint64)scanTime * 1000000 / lookups));
+	debugPrintf("Through the cache: %u ms, %u ns per lookup, %u%% found in the cache\n", cacheTime, (uint32)((uint64)cacheTime * 1000000 / lookups),
+	            (uint32)((uint64)cache.getHits() * 100 / cache.getLookups()));
+
+	uint wrong = 0;
+	for (uint i = 0; i < selectors.size(); i++) {
+		reg_t value;
+		if (lookupSelectorValue(segMan, objects[i], selectors[i], value) != types[i] || value != values[i])
+			wrong++;
+	}
+	if (scanSum != cacheSum || wrong)
+		debugPrintf("%u lookups through the cache differ from the lookups without it!\n", wrong);
+
+	// Reload the script, and check that the lookups of its objects are
+	// not found in the cache afterwards, but looked up again
+	const SegmentId reloadSegment = segMan->getScriptSegment(reloadScriptNr);
+	segMan->deallocateScript(reloadScriptNr);
+	segMan->instantiateScript(reloadScriptNr);
+	uint stale = 0;
+	wrong = 0;
+	for (uint i = 0; i < selectors.size(); i++) {
+		if (objects[i].getSegment() != reloadSegment)
+			continue;
+		const reg_t obj = make_reg32(segMan->getScriptSegment(reloadScriptNr), objects[i].getOffset());
+		if (cache.find(obj, selectors[i]))
+			stale++;
+		reg_t value;
+		if (lookupSelectorValue(segMan, obj, selectors[i], value) != types[i] || value.getOffset() != values[i].getOffset())
+			wrong++;
+	}
+	debugPrintf("Reloaded script %d: %u lookups of its %u objects found in the cache, %u wrong\n",
+	            reloadScriptNr, stale, reloadObjectCount, wrong);
+
+	delete segMan;
+	debugPrintf("Use selector_lookups for the hit rate of the running game\n");
+	return true;
+}
+
+bool Console::cmdVMCalls(int argc, const char **argv) {
+	ExecutionStack &stack = _engine->_gamestate->_executionStack;
+
+	if (resetThroughput(argc, argv, _vmCallsStartTime)) {
+		stack.resetStatistics();
+		return true;
+	}
+
+	printThroughput(argv[0], "Execution stack frames (calls, sends and kernel calls)", stack.getPushedFrames(), _vmCallsStartTime);
+	debugPrintf("Frames now: %u, at most: %u of %d\n", stack.size(), stack.getMaxSize(), (int)ExecutionStack::kMaxFrames);
+	debugPrintf("The execution stack does not allocate memory for calls, see allocstats for other allocations\n");
+	return true;
+}
+
+/**
+ * A method which sums up 3 * i for i from its parameter down to 1, in a
+ * loop of common instructions.
+ */
+static const byte s_vmBenchmarkCode[] = {
+	0x3f, 0x02, // link 2
+	0x87, 0x01, // lap 1
+	0xa5, 0x00, // sat 0
+	0x35, 0x00, // ldi 0
+	0xa5, 0x01, // sat 1
+	0x85, 0x00, // loop: lat 0
+	0x31, 0x0f, // bnt end
+	0x8d, 0x00, // lst 0
+	0x35, 0x03, // ldi 3
+	0x06,       // mul
+	0x36,       // push
+	0x85, 0x01, // lat 1
+	0x02,       // add
+	0xa5, 0x01, // sat 1
+	0xe5, 0x00, // -at 0
+	0x33, 0xed, // jmp loop
+	0x85, 0x01, // end: lat 1
+	0x48        // ret
+};
+
+enum {
+	kVMBenchmarkLoopInstructions = 11,
+	kVMBenchmarkOtherInstructions = 9,
+	kVMBenchmarkIterations = 10000,
+	// A script number no game uses
+	kVMBenchmarkScript = 0xFFFF
+};
+
+/**
+ * Run the benchmark method with run_vm() in a temporary script, leaving
+ * the state of the VM as it was.
+ *
+ * @return the time taken in ms, or -1 if the method computed a wrong sum
+ */
+static int runVMBenchmark(EngineState *s, int rounds) {
+	SegManager *segMan = s->_segMan;
+	SegmentId segment;
+	Script *script = segMan->allocateScript(kVMBenchmarkScript, &segment);
+	script->loadCode(kVMBenchmarkScript, s_vmBenchmarkCode, sizeof(s_vmBenchmarkCode));
+
+	// Save everything run_vm() changes
+	const reg_t acc = s->r_acc, prev = s->r_prev;
+	const int16 rest = s->r_rest;
+	ExecStack *const xs = s->xs;
+	reg_t *variables[4], *variablesBase[4];
+	SegmentId variablesSegment[4];
+	int variablesMax[4];
+	for (int i = 0; i < 4; i++) {
+		variables[i] = s->variables[i];
+		variablesBase[i] = s->variablesBase[i];
+		variablesSegment[i] = s->variablesSegment[i];
+		variablesMax[i] = s->variablesMax[i];
+	}
+	const bool stackPosChanged = s->_executionStackPosChanged;
+	const int stepCounter = s->scriptStepCounter;
+	DebugState &debugState = g_sci->_debugState;
+	const bool debugging = debugState.debugging;
+	const int oldPcOffset = debugState.old_pc_offset;
+	StackPtr const oldSp = debugState.old_sp;
+	debugState.debugging = false;
+
+	// Put the parameters above the stack of the running scripts
+	StackPtr argp = s->_executionStack.empty() ? s->stack_base : s->xs->sp;
+	argp[0] = make_reg(0, 1);
+	argp[1] = make_reg(0, kVMBenchmarkIterations);
+
+	const uint32 start = g_system->getMillis();
+	bool correct = true;
+	for (int round = 0; round < rounds && correct; round++) {
+		ExecStack frame(NULL_REG, NULL_REG, argp + 2, 1, argp, segment, make_reg32(segment, 0),
+		                -1, -1, -1, -1, -1, s->_executionStack.size() - 1, EXEC_STACK_TYPE_CALL);
+		s->_executionStack.push_back(frame);
+		run_vm(s);
+		correct = s->r_acc.toUint16() == (uint16)(3 * kVMBenchmarkIterations * (kVMBenchmarkIterations + 1) / 2);
+	}
+	const uint32 time = g_system->getMillis() - start;
+
+	s->r_acc = acc;
+	s->r_prev = prev;
+	s->r_rest = rest;
+	s->xs = xs;
+	for (int i = 0; i < 4; i++) {
+		s->variables[i] = variables[i];
+		s->variablesBase[i] = variablesBase[i];
+		s->variablesSegment[i] = variablesSegment[i];
+		s->variablesMax[i] = variablesMax[i];
+	}
+	s->_executionStackPosChanged = stackPosChanged;
+	s->scriptStepCounter = stepCounter;
+	debugState.debugging = debugging;
+	debugState.old_pc_offset = oldPcOffset;
+	debugState.old_sp = oldSp;
+
+	segMan->deallocateScript(kVMBenchmarkScript);
+	return correct ? (int)time : -1;
+}
+
+bool Console::cmdVMBenchmark(int argc, const char **argv) {
+	int rounds = 100;
+	if (argc > 2 || (argc == 2 && (rounds = atoi(argv[1])) <= 0)) {
+		debugPrintf("Measures how fast the VM fetches the instructions of the methods of\n");
+		debugPrintf("the loaded scripts, reading them from the script buffer like the\n");
+		debugPrintf("disassembler does, and from the decoded instructions like run_vm() does.\n");
+		debugPrintf("Then measures how fast run_vm() executes a loop of common instructions.\n");
+		debugPrintf("Usage: %s [<rounds>]\n", argv[0]);
+		debugPrintf("The default is %d rounds\n", rounds);
+		return true;
+	}
+
+	// Collect the instructions of all methods, up to their first ret
+	Common::Array<Script *> scripts;
+	Common::Array<uint32> offsets;
+	const Common::Array<SegmentObj *> &segments = _engine->_gamestate->_segMan->getSegments();
+	for (uint i = 0; i < segments.size(); i++) {
+		if (!segments[i] || segments[i]->getType() != SEG_TYPE_SCRIPT)
+			continue;
+		Script *script = static_cast<Script *>(segments[i]);
+		const ObjMap &objects = script->getObjectMap();
+		for (ObjMap::const_iterator it = objects.begin(); it != objects.end(); ++it) {
+			for (uint m = 0; m < it->_value.getMethodCount(); m++) {
+				uint32 offset = it->_value.getFunction(m).getOffset();
+				while (offset < script->getBufSize()) {
+					int16 opparams[4];
+					byte extOpcode;
+					scripts.push_back(script);
+					offsets.push_back(offset);
+					offset += readPMachineInstruction(script->getBuf(offset), extOpcode, opparams);
+					if ((extOpcode >> 1) == op_ret)
+						break;
+				}
+			}
+		}
+	}
+
+	if (offsets.empty()) {
+		debugPrintf("No methods in the loaded scripts\n");
+	} else {
+		uint32 readSum = 0, decodedSum = 0;
+		uint32 start = g_system->getMillis();
+		for (int round = 0; round < rounds; round++) {
+			for (uint i = 0; i < offsets.size(); i++) {
+				int16 opparams[4];
+				byte extOpcode;
+				readSum += readPMachineInstruction(scripts[i]->getBuf(offsets[i]), extOpcode, opparams);
+				readSum += extOpcode + opparams[0];
+			}
+		}
+		const uint32 readTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int round = 0; round < rounds; round++) {
+			for (uint i = 0; i < offsets.size(); i++) {
+				const Script::DecodedInstruction &instruction = scripts[i]->getDecodedInstruction(offsets[i]);
+				decodedSum += instruction.size;
+				decodedSum += instruction.extOpcode + instruction.opparams[0];
+			}
+		}
+		const uint32 decodedTime = g_system->getMillis() - start;
+
+		const uint64 fetched = (uint64)offsets.size() * rounds;
+		debugPrintf("%u instructions in the methods of the loaded scripts, %d rounds\n", offsets.size(), rounds);
+		debugPrintf("Read from the script buffer: %u ms, %u ns per instruction\n", readTime, (uint32)((uint64)readTime * 1000000 / fetched));
+		debugPrintf("Decoded instructions: %u ms, %u ns per instruction\n", decodedTime, (uint32)((uint64)decodedTime * 1000000 / fetched));
+		if (readSum != decodedSum)
+			debugPrintf("The decoded instructions differ from the script buffer!\n");
+	}
+
+	if (_engine->_gamestate->_segMan->getScriptSegment(kVMBenchmarkScript)) {
+		debugPrintf("Script %d is in use, run_vm() cannot be timed\n", kVMBenchmarkScript);
+		return true;
+	}
+
+	const int runTime = runVMBenchmark(_engine->_gamestate, rounds);
+	if (runTime < 0) {
+		debugPrintf("run_vm() computed a wrong result!\n");
+	} else {
+		const uint64 executed = (uint64)(kVMBenchmarkLoopInstructions * kVMBenchmarkIterations + kVMBenchmarkOtherInstructions) * rounds;
+		debugPrintf("run_vm(): %d ms for %u instructions, %u ns per instruction\n", runTime, (uint32)executed, (uint32)((uint64)runTime * 1000000 / executed));
+	}
+	debugPrintf("Use script_steps for the throughput of the running game\n");
 	return true;
 }
 
@@ -3605,7 +4126,7 @@ bool Console::cmdDisassembleAddress(int argc, const char **argv) {
 		return true;
 	}
 
-	SegmentRef ref = _engine->_gamestate->_segMan->dereference(vpc);
+	SegmentRef ref = _engine->_gamestate->_segMan->dereferenceReadOnly(vpc);
 	size = ref.maxSize + vpc.getOffset(); // total segment size
 
 	for (int i = 2; i < argc; i++) {
@@ -5012,7 +5533,7 @@ void Console::printReference(reg_t reg, reg_t reg_end) {
 					break;
 #endif
 				default: {
-					const SegmentRef block = _engine->_gamestate->_segMan->dereference(reg);
+					const SegmentRef block = _engine->_gamestate->_segMan->dereferenceReadOnly(reg);
 					uint16 size = block.maxSize;
 
 					debugPrintf("raw data\n");
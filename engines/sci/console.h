@@ -73,6 +73,7 @@ private:
 	bool cmdList(int argc, const char **argv);
 	bool cmdResourceIntegrityDump(int argc, const char **argv);
 	bool cmdAllocList(int argc, const char **argv);
+	bool cmdResourceCache(int argc, const char **argv);
 	bool cmdHexgrep(int argc, const char **argv);
 	bool cmdVerifyScripts(int argc, const char **argv);
 	// Game
@@ -95,6 +96,8 @@ private:
 	bool cmdAnimateList(int argc, const char **argv);
 	bool cmdWindowList(int argc, const char **argv);
 	bool cmdPlaneList(int argc, const char **argv);
+	bool cmdPlaneTiming(int argc, const char **argv);
+	bool cmdCelCache(int argc, const char **argv);
 	bool cmdVisiblePlaneList(int argc, const char **argv);
 	bool cmdPlaneItemList(int argc, const char **argv);
 	bool cmdVisiblePlaneItemList(int argc, const char **argv);
@@ -153,6 +156,10 @@ private:
 	bool cmdBreakpointAddress(int argc, const char **argv);
 	// VM
 	bool cmdScriptSteps(int argc, const char **argv);
+	bool cmdSelectorLookups(int argc, const char **argv);
+	bool cmdSelectorBenchmark(int argc, const char **argv);
+	bool cmdVMCalls(int argc, const char **argv);
+	bool cmdVMBenchmark(int argc, const char **argv);
 	bool cmdScriptObjects(int argc, const char **argv);
 	bool cmdScriptStrings(int argc, const char **argv);
 	bool cmdScriptSaid(int argc, const char **argv);
@@ -194,12 +201,34 @@ private:
 	void printBitmap(reg_t reg);
 #endif
 
+	/**
+	 * Handles the "reset" argument of the commands which report the work of
+	 * the VM since their last reset. Remembers the time of the reset in
+	 * startTime, the caller then resets its counters.
+	 *
+	 * @return true if the statistics are to be reset
+	 */
+	bool resetThroughput(int argc, const char **argv, uint32 &startTime);
+
+	/**
+	 * Prints how often something happened since startTime, and how often
+	 * per second. The time includes kernel calls and the time spent in the
+	 * debugger.
+	 */
+	void printThroughput(const char *command, const char *what, uint32 count, uint32 startTime);
+
 	void writeIntegrityDumpLine(const Common::String &statusName, const Common::String &resourceName, Common::WriteStream &out, Common::ReadStream *const data, const int size, const bool writeHash);
 
 	SciEngine *_engine;
 	DebugState &_debugState;
 	Common::String _videoFile;
 	int _videoFrameDelay;
+	/** Step counter at the last "script_steps reset". */
+	int _scriptStepsStart;
+	/** Times of the last reset of the VM statistics, see resetThroughput(). */
+	uint32 _scriptStepsStartTime;
+	uint32 _selectorLookupsStartTime;
+	uint32 _vmCallsStartTime;
 };
 
 } // End of namespace Sci
@@ -33,6 +33,44 @@
 #include "sci/resource.h"
 
 namespace Sci {
+Decompressor *createDecompressor(ResourceCompression compression) {
+	switch (compression) {
+	case kCompNone:
+		return new Decompressor;
+	case kCompHuffman:
+		return new DecompressorHuffman;
+	case kCompLZW:
+	case kCompLZW1:
+	case kCompLZW1View:
+	case kCompLZW1Pic:
+		return new DecompressorLZW(compression);
+	case kCompDCL:
+		return new DecompressorDCL;
+#ifdef ENABLE_SCI32
+	case kCompSTACpack:
+		return new DecompressorLZS;
+#endif
+	default:
+		return NULL;
+	}
+}
+
+void Decompressor::warn(const char *s, ...) {
+	va_list va;
+	va_start(va, s);
+	const Common::String message = Common::String::vformat(s, va);
+	va_end(va);
+
+	if (!_deferWarnings) {
+		warning("%s", message.c_str());
+		return;
+	}
+
+	if (!_warnings.empty())
+		_warnings += "; ";
+	_warnings += message;
+}
+
 int Decompressor::unpack(Common::ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked) {
 	uint32 chunk;
 	while (nPacked && !(src->eos() || src->err())) {
@@ -189,6 +227,8 @@ int DecompressorLZW::unpackLZW(Common::ReadStream *src, byte *dest, uint32 nPack
 		free(tokenlist);
 		free(tokenlengthlist);
 
+		if (_deferWarnings)
+			return SCI_ERROR_DECOMPRESSION_ERROR;
 		error("[DecompressorLZW::unpackLZW] Cannot allocate token memory buffers");
 	}
 
@@ -209,7 +249,7 @@ int DecompressorLZW::unpackLZW(Common::ReadStream *src, byte *dest, uint32 nPack
 		} else {
 			if (token > 0xff) {
 				if (token >= _curtoken) {
-					warning("unpackLZW: Bad token %x", token);
+					warn("unpackLZW: Bad token %x", token);
 
 					free(tokenlist);
 					free(tokenlengthlist);
@@ -219,8 +259,8 @@ int DecompressorLZW::unpackLZW(Common::ReadStream *src, byte *dest, uint32 nPack
 				tokenlastlength = tokenlengthlist[token] + 1;
 				if (_dwWrote + tokenlastlength > _szUnpacked) {
 					// For me this seems a normal situation, It's necessary to handle it
-					warning("unpackLZW: Trying to write beyond the end of array(len=%d, destctr=%d, tok_len=%d)",
-					        _szUnpacked, _dwWrote, tokenlastlength);
+					warn("unpackLZW: Trying to write beyond the end of array(len=%d, destctr=%d, tok_len=%d)",
+					     _szUnpacked, _dwWrote, tokenlastlength);
 					for (int i = 0; _dwWrote < _szUnpacked; i++)
 						putByte(dest[tokenlist[token] + i]);
 				} else
@@ -229,7 +269,7 @@ int DecompressorLZW::unpackLZW(Common::ReadStream *src, byte *dest, uint32 nPack
 			} else {
 				tokenlastlength = 1;
 				if (_dwWrote >= _szUnpacked)
-					warning("unpackLZW: Try to write single byte beyond end of array");
+					warn("unpackLZW: Try to write single byte beyond end of array");
 				else
 					putByte(token);
 			}
@@ -263,6 +303,8 @@ int DecompressorLZW::unpackLZW1(Common::ReadStream *src, byte *dest, uint32 nPac
 		free(stak);
 		free(tokens);
 
+		if (_deferWarnings)
+			return SCI_ERROR_DECOMPRESSION_ERROR;
 		error("[DecompressorLZW::unpackLZW1] Cannot allocate decompression buffers");
 	}
 
@@ -555,7 +597,7 @@ void DecompressorLZW::reorderView(byte *src, byte *dest) {
 	for (l = 0; l < loopheaders; l++) {
 		if (lh_mask & lb) { /* The loop is _not_ present */
 			if (lh_last == -1) {
-				warning("Error: While reordering view: Loop not present, but can't re-use last loop");
+				warn("Error: While reordering view: Loop not present, but can't re-use last loop");
 				lh_last = 0;
 			}
 			WRITE_LE_UINT16(lh_ptr, lh_last);
@@ -589,7 +631,7 @@ void DecompressorLZW::reorderView(byte *src, byte *dest) {
 	}
 
 	if (celindex < cel_total) {
-		warning("View decompression generated too few (%d / %d) headers", celindex, cel_total);
+		warn("View decompression generated too few (%d / %d) headers", celindex, cel_total);
 		free(cc_pos);
 		free(cc_lengths);
 		return;
@@ -650,14 +692,14 @@ int DecompressorLZS::unpackLZS() {
 				if (!offs) // This is the end marker - a 7 bit offset of zero
 					break;
 				if (!(clen = getCompLen())) {
-					warning("lzsDecomp: length mismatch");
+					warn("lzsDecomp: length mismatch");
 					return SCI_ERROR_DECOMPRESSION_ERROR;
 				}
 				copyComp(offs, clen);
 			} else { // Eleven bit offset follows
 				offs = getBitsMSB(11);
 				if (!(clen = getCompLen())) {
-					warning("lzsDecomp: length mismatch");
+					warn("lzsDecomp: length mismatch");
 					return SCI_ERROR_DECOMPRESSION_ERROR;
 				}
 				copyComp(offs, clen);
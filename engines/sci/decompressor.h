@@ -24,6 +24,7 @@
 #define SCI_DECOMPRESSOR_H
 
 #include "common/scummsys.h"
+#include "common/str.h"
 
 namespace Common {
 class ReadStream;
@@ -51,13 +52,26 @@ enum ResourceCompression {
  */
 class Decompressor {
 public:
-	Decompressor() {}
+	Decompressor() : _deferWarnings(false) {}
 	virtual ~Decompressor() {}
 
 
 	virtual int unpack(Common::ReadStream *src, byte *dest, uint32 nPacked, uint32 nUnpacked);
 
+	/**
+	 * Collect warnings in getDeferredWarnings() instead of printing them, and
+	 * fail instead of calling error(). Used when decompressing on a worker
+	 * thread.
+	 */
+	void deferWarnings() { _deferWarnings = true; }
+	const Common::String &getDeferredWarnings() const { return _warnings; }
+
 protected:
+	/**
+	 * Print a warning, or collect it if warnings are deferred.
+	 */
+	void warn(const char *s, ...) GCC_PRINTF(2, 3);
+
 	/**
 	 * Initialize decompressor.
 	 * @param src		source stream to read from
@@ -117,6 +131,9 @@ protected:
 	uint32 _dwWrote;	///< number of bytes written to _dest
 	Common::ReadStream *_src;
 	byte *_dest;
+
+	bool _deferWarnings;
+	Common::String _warnings;
 };
 
 /**
@@ -194,6 +211,13 @@ protected:
 };
 #endif
 
+/**
+ * Creates a decompressor for the given compression method.
+ * @param compression	the compression method of the resource
+ * @return the new decompressor, or NULL if the method is not supported
+ */
+Decompressor *createDecompressor(ResourceCompression compression);
+
 } // End of namespace Sci
 
 #endif // SCI_SCICORE_DECOMPRESSOR_H
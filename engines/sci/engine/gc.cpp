@@ -110,15 +110,17 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 
 	// Initialize value stack
 	// We do this one by hand since the stack doesn't know the current execution stack
-	Common::List<ExecStack>::const_iterator iter = s->_executionStack.reverse_begin();
+	uint top = s->_executionStack.size() - 1;
 
 	// Skip fake kernel stack frame if it's on top
-	if ((*iter).type == EXEC_STACK_TYPE_KERNEL)
-		--iter;
+	if (s->_executionStack[top].type == EXEC_STACK_TYPE_KERNEL) {
+		assert(top > 0);
+		--top;
+	}
 
-	assert((iter != s->_executionStack.end()) && ((*iter).type != EXEC_STACK_TYPE_KERNEL));
+	assert(s->_executionStack[top].type != EXEC_STACK_TYPE_KERNEL);
 
-	const StackPtr sp = iter->sp;
+	const StackPtr sp = s->_executionStack[top].sp;
 
 	for (reg_t *pos = s->stack_base; pos < sp; pos++)
 		wm.push(*pos);
@@ -126,7 +128,7 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	debugC(kDebugLevelGC, "[GC] -- Finished adding value stack");
 
 	// Init: Execution Stack
-	for (iter = s->_executionStack.begin();
+	for (ExecutionStack::const_iterator iter = s->_executionStack.begin();
 	     iter != s->_executionStack.end(); ++iter) {
 		const ExecStack &es = *iter;
 
@@ -715,7 +715,7 @@ reg_t kFileIOReadString(EngineState *s, int argc, reg_t *argv) {
 	bytesRead = fgets_wrapper(s, buf, maxsize, handle);
 
 	// Fix up size too large for destination.
-	SegmentRef dest_r = s->_segMan->dereference(argv[0]);
+	SegmentRef dest_r = s->_segMan->dereferenceReadOnly(argv[0]);
 	if (!dest_r.isValid()) {
 		error("kFileIO(readString): invalid destination %04x:%04x", PRINT_REG(argv[0]));
 	} else if ((int)bytesRead > dest_r.maxSize) {
@@ -747,10 +747,10 @@ reg_t kFileIOWriteString(EngineState *s, int argc, reg_t *argv) {
 	// directly. Since the sciAudio calls are only creating text files,
 	// this is probably the most straightforward place to handle them.
 	if (handle == kVirtualFileHandleSciAudio) {
-		Common::List<ExecStack>::const_iterator iter = s->_executionStack.reverse_begin();
-		iter--;	// sciAudio
-		iter--;	// sciAudio child
-		g_sci->_audio->handleFanmadeSciAudio(iter->sendp, s->_segMan);
+		const uint top = s->_executionStack.size() - 1;
+		// Skip the frames of sciAudio and the sciAudio child
+		assert(top >= 2);
+		g_sci->_audio->handleFanmadeSciAudio(s->_executionStack[top - 2].sendp, s->_segMan);
 		return NULL_REG;
 	}
 
@@ -329,7 +329,7 @@ reg_t kMemory(EngineState *s, int argc, reg_t *argv) {
 			return s->r_acc;
 		}
 
-		SegmentRef ref = s->_segMan->dereference(argv[1]);
+		SegmentRef ref = s->_segMan->dereferenceReadOnly(argv[1]);
 
 		if (!ref.isValid() || ref.maxSize < 2) {
 			error("Attempt to peek invalid memory at %04x:%04x", PRINT_REG(argv[1]));
@@ -345,7 +345,7 @@ reg_t kMemory(EngineState *s, int argc, reg_t *argv) {
 		break;
 	}
 	case K_MEMORY_POKE : {
-		SegmentRef ref = s->_segMan->dereference(argv[1]);
+		SegmentRef ref = s->_segMan->dereferenceReadOnly(argv[1]);
 
 		if (!ref.isValid() || ref.maxSize < 2) {
 			error("Attempt to poke invalid memory at %04x:%04x", PRINT_REG(argv[1]));
@@ -358,6 +358,7 @@ reg_t kMemory(EngineState *s, int argc, reg_t *argv) {
 				return s->r_acc;
 			}
 			WRITE_SCIENDIAN_UINT16(ref.raw, argv[2].getOffset());		// Amiga versions are BE
+			s->_segMan->markWritten(argv[1], 2);
 		} else {
 			if (ref.skipByte)
 				error("Attempt to poke memory at odd offset %04X:%04X", PRINT_REG(argv[1]));
@@ -757,7 +758,7 @@ reg_t kStub(EngineState *s, int argc, reg_t *argv) {
 	int kernelCallNr = -1;
 	int kernelSubCallNr = -1;
 
-	Common::List<ExecStack>::const_iterator callIterator = s->_executionStack.end();
+	ExecutionStack::const_iterator callIterator = s->_executionStack.end();
 	if (callIterator != s->_executionStack.begin()) {
 		callIterator--;
 		ExecStack lastCall = *callIterator;
@@ -39,7 +39,7 @@ namespace Sci {
 
 reg_t kSaid(EngineState *s, int argc, reg_t *argv) {
 	reg_t heap_said_block = argv[0];
-	byte *said_block;
+	const byte *said_block;
 	int new_lastmatch;
 	Vocabulary *voc = g_sci->getVocabulary();
 #ifdef DEBUG_PARSER
@@ -51,7 +51,7 @@ reg_t kSaid(EngineState *s, int argc, reg_t *argv) {
 	if (!heap_said_block.getSegment())
 		return NULL_REG;
 
-	said_block = (byte *)s->_segMan->derefBulkPtr(heap_said_block, 0);
+	said_block = s->_segMan->derefBulkPtrReadOnly(heap_said_block, 0);
 
 	if (!said_block) {
 		warning("Said on non-string, pointer %04x:%04x", PRINT_REG(heap_said_block));
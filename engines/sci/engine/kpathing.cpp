@@ -405,7 +405,7 @@ static void draw_polygon(EngineState *s, reg_t polygon, int width, int height) {
 	Common::Point first, prev;
 	int i;
 
-	SegmentRef pointList = segMan->dereference(points);
+	SegmentRef pointList = segMan->dereferenceReadOnly(points);
 	if (!pointList.isValid() || pointList.skipByte) {
 		warning("draw_polygon: Polygon data pointer is invalid, skipping polygon");
 		return;
@@ -462,7 +462,7 @@ static void print_polygon(SegManager *segMan, reg_t polygon) {
 
 	debugN(-1, "%i:", type);
 
-	SegmentRef pointList = segMan->dereference(points);
+	SegmentRef pointList = segMan->dereferenceReadOnly(points);
 	if (!pointList.isValid() || pointList.skipByte) {
 		warning("print_polygon: Polygon data pointer is invalid, skipping polygon");
 		return;
@@ -1166,7 +1166,7 @@ static Polygon *convert_polygon(EngineState *s, reg_t polygon) {
 		return NULL;
 	}
 
-	SegmentRef pointList = segMan->dereference(points);
+	SegmentRef pointList = segMan->dereferenceReadOnly(points);
 	// Check if the target polygon is still valid. It may have been released
 	// in the meantime (e.g. in LSL6, room 700, when using the elevator).
 	// Refer to bug #3034501.
@@ -1667,7 +1667,7 @@ reg_t kIntersections(EngineState *s, int argc, reg_t *argv) {
 	const int32 kVertical = 0x7fffffff;
 
 	uint16 curIndex = startIndex;
-	reg_t *inpBuf = s->_segMan->derefRegPtr(argv[4], endIndex + 2);
+	const reg_t *inpBuf = s->_segMan->derefRegPtrReadOnly(argv[4], endIndex + 2);
 
 	if (!inpBuf) {
 		warning("Intersections: input buffer invalid");
@@ -2379,7 +2379,7 @@ reg_t kMergePoly(EngineState *s, int argc, reg_t *argv) {
 	// The size of the "work" point list SSCI uses. We use a dynamic one instead
 	//reg_t listSize = argv[2];
 
-	SegmentRef pointList = s->_segMan->dereference(polygonData);
+	SegmentRef pointList = s->_segMan->dereferenceReadOnly(polygonData);
 	if (!pointList.isValid() || pointList.skipByte) {
 		warning("kMergePoly: Polygon data pointer is invalid");
 		return make_reg(0, 0);
@@ -46,6 +46,10 @@ reg_t kLoad(EngineState *s, int argc, reg_t *argv) {
 	if (restype == kResourceTypeMemory)
 		return s->_segMan->allocateHunkEntry("kLoad()", resnr);
 
+	// Scripts announce the resources of a room with kLoad before using them,
+	// so start decompressing them in the background
+	g_sci->getResMan()->prefetchResource(ResourceId(restype, resnr));
+
 	return make_reg(0, ((restype << 11) | resnr)); // Return the resource identifier as handle
 }
 
@@ -63,6 +67,8 @@ reg_t kUnLoad(EngineState *s, int argc, reg_t *argv) {
 
 	if (restype == kResourceTypeMemory)
 		s->_segMan->freeHunkEntry(resnr);
+	else
+		g_sci->getResMan()->cancelPrefetch(ResourceId(restype, resnr.toUint16()));
 
 	return s->r_acc;
 }
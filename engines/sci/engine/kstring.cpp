@@ -90,7 +90,7 @@ reg_t kStrAt(EngineState *s, int argc, reg_t *argv) {
 		return NULL_REG;
 	}
 
-	SegmentRef dest_r = s->_segMan->dereference(argv[0]);
+	SegmentRef dest_r = s->_segMan->dereferenceReadOnly(argv[0]);
 	if (!dest_r.isValid()) {
 		warning("Attempt to StrAt at invalid pointer %04x:%04x", PRINT_REG(argv[0]));
 		return NULL_REG;
@@ -112,8 +112,10 @@ reg_t kStrAt(EngineState *s, int argc, reg_t *argv) {
 	// FIXME: Move this to segman
 	if (dest_r.isRaw) {
 		value = dest_r.raw[offset];
-		if (argc > 2) /* Request to modify this char */
+		if (argc > 2) { /* Request to modify this char */
 			dest_r.raw[offset] = newvalue;
+			s->_segMan->markWritten(argv[0], offset + 1);
+		}
 	} else {
 		if (dest_r.skipByte)
 			offset++;
@@ -557,7 +559,7 @@ reg_t kMessage(EngineState *s, int argc, reg_t *argv) {
 
 		bool ok = false;
 
-		if (s->_segMan->dereference(argv[1]).isRaw) {
+		if (s->_segMan->dereferenceReadOnly(argv[1]).isRaw) {
 			byte *buffer = s->_segMan->derefBulkPtr(argv[1], 10);
 
 			if (buffer) {
@@ -616,7 +618,7 @@ reg_t kStrSplit(EngineState *s, int argc, reg_t *argv) {
 	Common::String str = g_sci->strSplit(format.c_str(), sep);
 
 	// Make sure target buffer is large enough
-	SegmentRef buf_r = s->_segMan->dereference(argv[0]);
+	SegmentRef buf_r = s->_segMan->dereferenceReadOnly(argv[0]);
 	if (!buf_r.isValid() || buf_r.maxSize < (int)str.size() + 1) {
 		warning("StrSplit: buffer %04x:%04x invalid or too small to hold the following text of %i bytes: '%s'",
 						PRINT_REG(argv[0]), str.size() + 1, str.c_str());
@@ -618,7 +618,7 @@ void MessageState::outputString(reg_t buf, const Common::String &str) {
 		sciString->fromString(str);
 	} else {
 #endif
-		SegmentRef buffer_r = _segMan->dereference(buf);
+		SegmentRef buffer_r = _segMan->dereferenceReadOnly(buf);
 
 		if ((unsigned)buffer_r.maxSize >= str.size() + 1) {
 			_segMan->strcpy(buf, str.c_str());
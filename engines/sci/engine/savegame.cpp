@@ -1169,6 +1169,8 @@ void SegManager::reconstructClones() {
 			}	// end for
 		}	// end if
 	}	// end for
+
+	_selectorLookupCache.invalidate();
 }
 
 
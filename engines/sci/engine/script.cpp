@@ -73,6 +73,53 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupObjectCount = 0;
 	_offsetLookupStringCount = 0;
 	_offsetLookupSaidCount = 0;
+
+	freeDecodedInstructions();
+}
+
+void Script::freeDecodedInstructions() {
+	for (uint i = 0; i < _decodedPages.size(); i++)
+		delete[] _decodedPages[i];
+	_decodedPages.clear();
+}
+
+void Script::freeDecodedInstructions(uint32 start, uint32 end) {
+	// Instructions starting before start may reach into the range
+	start = start >= kMaxInstructionSize - 1 ? start - (kMaxInstructionSize - 1) : 0;
+	const uint32 endPage = MIN<uint32>(((end - 1) >> kDecodedPageBits) + 1, _decodedPages.size());
+	for (uint32 page = start >> kDecodedPageBits; page < endPage; page++) {
+		delete[] _decodedPages[page];
+		_decodedPages[page] = nullptr;
+	}
+}
+
+const Script::DecodedInstruction &Script::decodeInstruction(uint32 offset) {
+	if (_decodedPages.empty())
+		_decodedPages.resize((_buf->size() >> kDecodedPageBits) + 1);
+
+	DecodedInstruction *&page = _decodedPages[offset >> kDecodedPageBits];
+	if (!page)
+		page = new DecodedInstruction[kDecodedPageSize]();
+
+	DecodedInstruction &instruction = page[offset & (kDecodedPageSize - 1)];
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+	return instruction;
+}
+
+void Script::invalidateDecodedInstructions(uint32 offset, uint32 size) {
+	if (_decodedPages.empty() || !size || offset >= _buf->size())
+		return;
+
+	freeDecodedInstructions(offset, size < _buf->size() - offset ? offset + size : _buf->size());
+}
+
+uint Script::getDecodedPageCount() const {
+	uint count = 0;
+	for (uint i = 0; i < _decodedPages.size(); i++) {
+		if (_decodedPages[i])
+			count++;
+	}
+	return count;
 }
 
 enum {
@@ -80,6 +127,15 @@ enum {
 	kSci11ExportTableOffset = 8
 };
 
+void Script::loadCode(int script_nr, const byte *code, uint32 size) {
+	freeScript();
+
+	_nr = script_nr;
+	SciSpan<byte> outBuffer = _buf->allocate(size, Common::String::format("script %d code", script_nr));
+	memcpy(outBuffer.getUnsafeDataAt(0, size), code, size);
+	_script = _buf->subspan(0, size);
+}
+
 void Script::load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptPatcher) {
 	freeScript();
 
@@ -935,6 +991,17 @@ bool Script::isValidOffset(uint32 offset) const {
 }
 
 SegmentRef Script::dereference(reg_t pointer) {
+	const SegmentRef ret = dereferenceReadOnly(pointer);
+
+	// The pointer may be written through, so the code it can reach must be
+	// decoded again
+	if (ret.isValid())
+		invalidateDecodedInstructions(pointer.getOffset(), ret.maxSize);
+
+	return ret;
+}
+
+SegmentRef Script::dereferenceReadOnly(reg_t pointer) {
 	if (pointer.getOffset() > _buf->size()) {
 		error("Script::dereference(): Attempt to dereference invalid pointer %04x:%04x into script %d segment (script size=%u)",
 				  PRINT_REG(pointer), _nr, _buf->size());
@@ -103,6 +103,64 @@ private:
 	uint16 _offsetLookupSaidCount;
 
 public:
+	/**
+	 * A PMachine instruction as read by readPMachineInstruction().
+	 */
+	struct DecodedInstruction {
+		int16 opparams[4];
+		byte extOpcode;
+		/** Size of the instruction in bytes, or 0 if it was not decoded yet. */
+		uint16 size;
+	};
+
+private:
+	enum {
+		kDecodedPageBits = 6,
+		kDecodedPageSize = 1 << kDecodedPageBits,
+		/** The opcode and three operands of two bytes each */
+		kMaxInstructionSize = 7
+	};
+
+	/**
+	 * Instructions decoded by the VM, in pages of kDecodedPageSize offsets
+	 * which are allocated when code in them is executed the first time.
+	 */
+	Common::Array<DecodedInstruction *> _decodedPages;
+
+	const DecodedInstruction &decodeInstruction(uint32 offset);
+	void freeDecodedInstructions();
+	/** Drop the decoded instructions which overlap the bytes from start to end. */
+	void freeDecodedInstructions(uint32 start, uint32 end);
+
+public:
+	/**
+	 * Get the instruction at the given offset, decoding it only the first
+	 * time. The buffer stays authoritative: every raw pointer handed out
+	 * by dereference() drops the decoded instructions it can reach, while
+	 * dereferenceReadOnly() and the writes of SegManager only drop those
+	 * which are actually written to.
+	 */
+	inline const DecodedInstruction &getDecodedInstruction(uint32 offset) {
+		const uint32 page = offset >> kDecodedPageBits;
+		if (page < _decodedPages.size() && _decodedPages[page]) {
+			const DecodedInstruction &instruction = _decodedPages[page][offset & (kDecodedPageSize - 1)];
+			if (instruction.size)
+				return instruction;
+		}
+		return decodeInstruction(offset);
+	}
+
+	/**
+	 * Drop the decoded instructions which overlap the given bytes of the
+	 * buffer, after they were written to.
+	 */
+	void invalidateDecodedInstructions(uint32 offset, uint32 size);
+
+	/**
+	 * Number of pages with decoded instructions, for the debugger.
+	 */
+	uint getDecodedPageCount() const;
+
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
 
@@ -135,8 +193,15 @@ public:
 	void freeScript(const bool keepLocalsSegment = false);
 	void load(int script_nr, ResourceManager *resMan, ScriptPatcher *scriptPatcher);
 
+	/**
+	 * Use the given code as the script, without exports, objects or local
+	 * variables. The debugger uses this to time the VM.
+	 */
+	void loadCode(int script_nr, const byte *code, uint32 size);
+
 	virtual bool isValidOffset(uint32 offset) const;
 	virtual SegmentRef dereference(reg_t pointer);
+	virtual SegmentRef dereferenceReadOnly(reg_t pointer);
 	virtual reg_t findCanonicAddress(SegManager *segMan, reg_t sub_addr) const;
 	virtual void freeAtAddress(SegManager *segMan, reg_t sub_addr);
 	virtual Common::Array<reg_t> listAllDeallocatable(SegmentId segId) const;
@@ -1044,7 +1044,7 @@ void logKernelCall(const KernelFunction *kernelCall, const KernelSubFunction *ke
 						// use special handling?
 
 						if (kernelCall->function == &kSaid) {
-							SegmentRef saidSpec = s->_segMan->dereference(argv[parmNr]);
+							SegmentRef saidSpec = s->_segMan->dereferenceReadOnly(argv[parmNr]);
 							if (saidSpec.isRaw) {
 								debugN(" ('");
 								g_sci->getVocabulary()->debugDecipherSaidBlock(SciSpan<const byte>(saidSpec.raw, saidSpec.maxSize, Common::String::format("said %04x:%04x", PRINT_REG(argv[parmNr]))));
@@ -1076,7 +1076,7 @@ void logBacktrace() {
 	EngineState *s = g_sci->getEngineState();
 
 	con->debugPrintf("Call stack (current base: 0x%x):\n", s->executionStackBase);
-	Common::List<ExecStack>::const_iterator iter;
+	ExecutionStack::const_iterator iter;
 	uint i = 0;
 
 
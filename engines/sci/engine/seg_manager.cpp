@@ -80,6 +80,8 @@ void SegManager::resetSegMan() {
 	// Reinitialize class table
 	_classTable.clear();
 	createClassTable();
+
+	_selectorLookupCache.invalidate();
 }
 
 void SegManager::initSysStrings() {
@@ -182,6 +184,9 @@ void SegManager::deallocate(SegmentId seg) {
 
 	delete mobj;
 	_heap[actualSegment] = NULL;
+
+	// Objects at addresses in this segment are gone
+	_selectorLookupCache.invalidate();
 }
 
 bool SegManager::isHeapObject(reg_t pos) const {
@@ -534,8 +539,23 @@ SegmentRef SegManager::dereference(reg_t pointer) {
 	return mobj->dereference(pointer);
 }
 
-static void *derefPtr(SegManager *segMan, reg_t pointer, int entries, bool wantRaw) {
-	SegmentRef ret = segMan->dereference(pointer);
+SegmentRef SegManager::dereferenceReadOnly(reg_t pointer) {
+	if (!pointer.getSegment() || (pointer.getSegment() >= _heap.size()) || !_heap[pointer.getSegment()]) {
+		warning("SegManager::dereferenceReadOnly(): Attempt to dereference invalid pointer %04x:%04x", PRINT_REG(pointer));
+		return SegmentRef(); /* Invalid */
+	}
+
+	return _heap[pointer.getSegment()]->dereferenceReadOnly(pointer);
+}
+
+void SegManager::markWritten(reg_t pointer, uint32 size) {
+	SegmentObj *mobj = _heap[pointer.getSegment()];
+	if (mobj->getType() == SEG_TYPE_SCRIPT)
+		static_cast<Script *>(mobj)->invalidateDecodedInstructions(pointer.getOffset(), size);
+}
+
+static void *derefPtr(SegManager *segMan, reg_t pointer, int entries, bool wantRaw, bool readOnly) {
+	SegmentRef ret = segMan->dereferenceReadOnly(pointer);
 
 	if (!ret.isValid())
 		return NULL;
@@ -557,6 +577,11 @@ static void *derefPtr(SegManager *segMan, reg_t pointer, int entries, bool wantR
 		return NULL;
 	}
 
+	// Only the expected entries are written, or anything after the
+	// pointer if their number is not known
+	if (!readOnly)
+		segMan->markWritten(pointer, entries ? entries : ret.maxSize);
+
 	if (ret.isRaw)
 		return ret.raw;
 	else
@@ -564,15 +589,23 @@ static void *derefPtr(SegManager *segMan, reg_t pointer, int entries, bool wantR
 }
 
 byte *SegManager::derefBulkPtr(reg_t pointer, int entries) {
-	return (byte *)derefPtr(this, pointer, entries, true);
+	return (byte *)derefPtr(this, pointer, entries, true, false);
+}
+
+const byte *SegManager::derefBulkPtrReadOnly(reg_t pointer, int entries) {
+	return (const byte *)derefPtr(this, pointer, entries, true, true);
 }
 
 reg_t *SegManager::derefRegPtr(reg_t pointer, int entries) {
-	return (reg_t *)derefPtr(this, pointer, 2*entries, false);
+	return (reg_t *)derefPtr(this, pointer, 2*entries, false, false);
+}
+
+const reg_t *SegManager::derefRegPtrReadOnly(reg_t pointer, int entries) {
+	return (const reg_t *)derefPtr(this, pointer, 2*entries, false, true);
 }
 
-char *SegManager::derefString(reg_t pointer, int entries) {
-	return (char *)derefPtr(this, pointer, entries, true);
+const char *SegManager::derefString(reg_t pointer, int entries) {
+	return (const char *)derefPtr(this, pointer, entries, true, true);
 }
 
 // Helper functions for getting/setting characters in string fragments
@@ -634,7 +667,7 @@ static void forwardCopy(byte *dest, const byte *src, size_t n) {
 }
 
 void SegManager::strncpy(reg_t dest, const char* src, size_t n) {
-	SegmentRef dest_r = dereference(dest);
+	SegmentRef dest_r = dereferenceReadOnly(dest);
 	if (!dest_r.isValid()) {
 		warning("Attempt to strncpy to invalid pointer %04x:%04x", PRINT_REG(dest));
 		return;
@@ -643,6 +676,9 @@ void SegManager::strncpy(reg_t dest, const char* src, size_t n) {
 
 	if (dest_r.isRaw) {
 		forwardCopy<true>(dest_r.raw, (const byte *)src, n);
+		// Without a limit, the string is copied up to its terminating NUL.
+		// Otherwise, all n bytes are written, padded with NULs.
+		markWritten(dest, n == 0xFFFFFFFFU ? ::strlen(src) + 1 : n);
 	} else {
 		// raw -> non-raw
 		for (uint i = 0; i < n; i++) {
@@ -665,8 +701,8 @@ void SegManager::strncpy(reg_t dest, reg_t src, size_t n) {
 		return;	// empty text
 	}
 
-	SegmentRef dest_r = dereference(dest);
-	const SegmentRef src_r = dereference(src);
+	SegmentRef dest_r = dereferenceReadOnly(dest);
+	const SegmentRef src_r = dereferenceReadOnly(src);
 	if (!src_r.isValid()) {
 		warning("Attempt to strncpy from invalid pointer %04x:%04x", PRINT_REG(src));
 
@@ -687,12 +723,16 @@ void SegManager::strncpy(reg_t dest, reg_t src, size_t n) {
 		strncpy(dest, (const char*)src_r.raw, n);
 	} else if (dest_r.isRaw && !src_r.isRaw) {
 		// non-raw -> raw
-		for (uint i = 0; i < n; i++) {
+		uint i;
+		for (i = 0; i < n; i++) {
 			char c = getChar(src_r, i);
 			dest_r.raw[i] = c;
-			if (!c)
+			if (!c) {
+				i++;
 				break;
+			}
 		}
+		markWritten(dest, i);
 	} else {
 		// non-raw -> non-raw
 		for (uint i = 0; i < n; i++) {
@@ -713,7 +753,7 @@ void SegManager::strcpy(reg_t dest, reg_t src) {
 }
 
 void SegManager::memcpy(reg_t dest, const byte* src, size_t n) {
-	SegmentRef dest_r = dereference(dest);
+	SegmentRef dest_r = dereferenceReadOnly(dest);
 	if (!dest_r.isValid()) {
 		warning("Attempt to memcpy to invalid pointer %04x:%04x", PRINT_REG(dest));
 		return;
@@ -726,6 +766,7 @@ void SegManager::memcpy(reg_t dest, const byte* src, size_t n) {
 	if (dest_r.isRaw) {
 		// raw -> raw
 		forwardCopy<false>(dest_r.raw, src, n);
+		markWritten(dest, n);
 	} else {
 		// raw -> non-raw
 		for (uint i = 0; i < n; i++)
@@ -734,8 +775,8 @@ void SegManager::memcpy(reg_t dest, const byte* src, size_t n) {
 }
 
 void SegManager::memcpy(reg_t dest, reg_t src, size_t n) {
-	SegmentRef dest_r = dereference(dest);
-	const SegmentRef src_r = dereference(src);
+	SegmentRef dest_r = dereferenceReadOnly(dest);
+	const SegmentRef src_r = dereferenceReadOnly(src);
 	if (!dest_r.isValid()) {
 		warning("Attempt to memcpy to invalid pointer %04x:%04x", PRINT_REG(dest));
 		return;
@@ -759,6 +800,7 @@ void SegManager::memcpy(reg_t dest, reg_t src, size_t n) {
 	} else if (dest_r.isRaw) {
 		// * -> raw
 		memcpy(dest_r.raw, src, n);
+		markWritten(dest, n);
 	} else {
 		// non-raw -> non-raw
 		for (uint i = 0; i < n; i++) {
@@ -769,7 +811,7 @@ void SegManager::memcpy(reg_t dest, reg_t src, size_t n) {
 }
 
 void SegManager::memcpy(byte *dest, reg_t src, size_t n) {
-	const SegmentRef src_r = dereference(src);
+	const SegmentRef src_r = dereferenceReadOnly(src);
 	if (!src_r.isValid()) {
 		warning("Attempt to memcpy from invalid pointer %04x:%04x", PRINT_REG(src));
 		return;
@@ -795,7 +837,7 @@ size_t SegManager::strlen(reg_t str) {
 	if (str.isNull())
 		return 0;	// empty text
 
-	SegmentRef str_r = dereference(str);
+	SegmentRef str_r = dereferenceReadOnly(str);
 	if (!str_r.isValid()) {
 		warning("Attempt to call strlen on invalid pointer %04x:%04x", PRINT_REG(str));
 		return 0;
@@ -820,7 +862,7 @@ Common::String SegManager::getString(reg_t pointer) {
 	if (pointer.isNull())
 		return ret;	// empty text
 
-	SegmentRef src_r = dereference(pointer);
+	SegmentRef src_r = dereferenceReadOnly(pointer);
 	if (!src_r.isValid()) {
 		warning("SegManager::getString(): Attempt to dereference invalid pointer %04x:%04x", PRINT_REG(pointer));
 		return ret;
@@ -1046,6 +1088,10 @@ int SegManager::instantiateScript(int scriptNum) {
 	scr->initializeLocals(this);
 	scr->initializeClasses(this);
 	scr->initializeObjects(this, segmentId);
+
+	// The script may contain superclasses of objects which have been looked
+	// up before, or replace the objects of a previous instance of itself.
+	_selectorLookupCache.invalidate();
 #ifdef ENABLE_SCI32
 	g_sci->_guestAdditions->instantiateScriptHook(*scr);
 #endif
@@ -1075,6 +1121,8 @@ void SegManager::uninstantiateScript(int script_nr) {
 
 	if (getSciVersion() < SCI_VERSION_1_1)
 		uninstantiateScriptSci0(script_nr);
+
+	_selectorLookupCache.invalidate();
 	// FIXME: Add proper script uninstantiation for SCI 1.1
 
 	if (!scr->getLockers()) {
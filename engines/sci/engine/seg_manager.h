@@ -272,6 +272,22 @@ public:
 	 */
 	SegmentRef dereference(reg_t pointer);
 
+	/**
+	 * Dereferences a raw memory pointer which is only read through, which
+	 * keeps the decoded instructions of scripts.
+	 * @param[in]  reg	The reference to dereference
+	 * @return			The data block referenced
+	 */
+	SegmentRef dereferenceReadOnly(reg_t pointer);
+
+	/**
+	 * Note that memory returned by dereferenceReadOnly() was written to,
+	 * so that script instructions decoded from it are decoded again.
+	 * @param pointer	The address the write started at
+	 * @param size		The number of bytes written
+	 */
+	void markWritten(reg_t pointer, uint32 size);
+
 	/**
 	 * Dereferences a heap pointer pointing to raw memory.
 	 * @param pointer The pointer to dereference
@@ -281,6 +297,12 @@ public:
 	 */
 	byte *derefBulkPtr(reg_t pointer, int entries);
 
+	/**
+	 * Like derefBulkPtr(), for memory which is only read. This keeps the
+	 * decoded instructions of scripts.
+	 */
+	const byte *derefBulkPtrReadOnly(reg_t pointer, int entries);
+
 	/**
 	 * Dereferences a heap pointer pointing to a (list of) register(s).
 	 * Ensures alignedness of data.
@@ -292,13 +314,19 @@ public:
 	reg_t *derefRegPtr(reg_t pointer, int entries);
 
 	/**
-	 * Dereferences a heap pointer pointing to raw memory.
+	 * Like derefRegPtr(), for registers which are only read. This keeps
+	 * the decoded instructions of scripts.
+	 */
+	const reg_t *derefRegPtrReadOnly(reg_t pointer, int entries);
+
+	/**
+	 * Dereferences a heap pointer pointing to a string, for reading it.
 	 * @param pointer The pointer to dereference
 	 * @parm entries The number of values expected (for checking)
 	 * @return A physical reference to the address pointed to, or NULL on error or
 	 * if not enough entries were available.
 	 */
-	char *derefString(reg_t pointer, int entries = 0);
+	const char *derefString(reg_t pointer, int entries = 0);
 
 	/**
 	 * Return the string referenced by pointer.
@@ -456,6 +484,12 @@ public:
 
 	const Common::Array<SegmentObj *> &getSegments() const { return _heap; }
 
+	/**
+	 * Get the cache of lookupSelector() results. It is invalidated whenever
+	 * scripts are loaded or freed, clones are freed or a game is restored.
+	 */
+	SelectorLookupCache &getSelectorLookupCache() { return _selectorLookupCache; }
+
 private:
 	Common::Array<SegmentObj *> _heap;
 	Common::Array<Class> _classTable; /**< Table of all classes */
@@ -465,6 +499,8 @@ private:
 	ResourceManager *_resMan;
 	ScriptPatcher *_scriptPatcher;
 
+	SelectorLookupCache _selectorLookupCache;
+
 	SegmentId _clonesSegId; ///< ID of the (a) clones segment
 	SegmentId _listsSegId; ///< ID of the (a) list segment
 	SegmentId _nodesSegId; ///< ID of the (a) node segment
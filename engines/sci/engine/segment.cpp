@@ -125,6 +125,9 @@ void CloneTable::freeAtAddress(SegManager *segMan, reg_t addr) {
 #endif
 
 	freeEntry(addr.getOffset());
+
+	// A new clone may get the same address
+	segMan->getSelectorLookupCache().invalidate();
 }
 
 
@@ -105,6 +105,15 @@ public:
 	 */
 	virtual SegmentRef dereference(reg_t pointer);
 
+	/**
+	 * Dereferences a raw memory pointer which is only read through.
+	 * Segments which keep data derived from their memory, and drop it when
+	 * a pointer into the memory is handed out, override this.
+	 * @param reg	reference to dereference
+	 * @return		the data block referenced
+	 */
+	virtual SegmentRef dereferenceReadOnly(reg_t pointer) { return dereference(pointer); }
+
 	/**
 	 * Finds the canonic address associated with sub_reg.
 	 * Used by the garbage collector.
@@ -311,8 +311,6 @@ void invokeSelector(EngineState *s, reg_t object, int selectorId,
 }
 
 SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr) {
-	const Object *obj = segMan->getObject(obj_location);
-	int index;
 	bool oldScriptHeader = (getSciVersion() == SCI_VERSION_0_EARLY);
 
 	// Early SCI versions used the LSB in the selector ID as a read/write
@@ -320,6 +318,21 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 	if (oldScriptHeader)
 		selectorId &= ~1;
 
+	SelectorLookupCache &cache = segMan->getSelectorLookupCache();
+	const SelectorLookupCache::Entry *cached = cache.find(obj_location, selectorId);
+	if (cached) {
+		if (cached->type == kSelectorVariable && varp) {
+			varp->obj = obj_location;
+			varp->varindex = cached->varIndex;
+		} else if (cached->type == kSelectorMethod && fptr) {
+			*fptr = cached->funcAddress;
+		}
+		return cached->type;
+	}
+
+	const Object *obj = segMan->getObject(obj_location);
+	int index;
+
 	if (!obj) {
 		const SciCallOrigin origin = g_sci->getEngineState()->getCurrentCallOrigin();
 		error("lookupSelector: Attempt to send to non-object or invalid script. Address %04x:%04x, %s", PRINT_REG(obj_location), origin.toString().c_str());
@@ -333,21 +346,25 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 			varp->obj = obj_location;
 			varp->varindex = index;
 		}
+		cache.store(obj_location, selectorId, kSelectorVariable, index, NULL_REG);
 		return kSelectorVariable;
 	} else {
 		// Check if it's a method, with recursive lookup in superclasses
 		while (obj) {
 			index = obj->funcSelectorPosition(selectorId);
 			if (index >= 0) {
+				const reg_t funcAddress = obj->getFunction(index);
 				if (fptr)
-					*fptr = obj->getFunction(index);
+					*fptr = funcAddress;
 
+				cache.store(obj_location, selectorId, kSelectorMethod, -1, funcAddress);
 				return kSelectorMethod;
 			} else {
 				obj = segMan->getObject(obj->getSuperClassSelector());
 			}
 		}
 
+		cache.store(obj_location, selectorId, kSelectorNone, -1, NULL_REG);
 		return kSelectorNone;
 	}
 
@@ -167,10 +167,7 @@ void EngineState::shrinkStackToBase() {
 	if (_executionStack.size() > 0) {
 		uint size = executionStackBase + 1;
 		assert(_executionStack.size() >= size);
-		Common::List<ExecStack>::iterator iter = _executionStack.begin();
-		for (uint i = 0; i < size; ++i)
-			++iter;
-		_executionStack.erase(iter, _executionStack.end());
+		_executionStack.truncate(size);
 	}
 }
 
@@ -392,7 +389,7 @@ SciCallOrigin EngineState::getCurrentCallOrigin() const {
 
 	if (xs->debugLocalCallOffset != -1) {
 		// if lastcall was actually a local call search back for a real call
-		Common::List<ExecStack>::const_iterator callIterator = _executionStack.end();
+		ExecutionStack::const_iterator callIterator = _executionStack.end();
 		while (callIterator != _executionStack.begin()) {
 			callIterator--;
 			const ExecStack &loopCall = *callIterator;
@@ -423,7 +420,7 @@ SciCallOrigin EngineState::getCurrentCallOrigin() const {
 }
 
 bool EngineState::callInStack(const reg_t object, const Selector selector) const {
-	Common::List<ExecStack>::const_iterator it;
+	ExecutionStack::const_iterator it;
 	for (it = _executionStack.begin(); it != _executionStack.end(); ++it) {
 		const ExecStack &call = *it;
 		if (call.sendp == object && call.debugSelector == selector) {
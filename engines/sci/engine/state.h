@@ -145,7 +145,7 @@ public:
 public:
 	/* VM Information */
 
-	Common::List<ExecStack> _executionStack; /**< The execution stack */
+	ExecutionStack _executionStack; /**< The execution stack */
 	/**
 	 * When called from kernel functions, the vm is re-started recursively on
 	 * the same stack. This variable contains the stack base for the current vm.
@@ -23,6 +23,7 @@
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/system.h"
 
 #include "sci/sci.h"
 #include "sci/console.h"
@@ -272,7 +273,8 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 	int activeBreakpointTypes = g_sci->_debugState._activeBreakpointTypes;
 	ObjVarRef varp;
 
-	Common::List<ExecStack>::iterator prevElementIterator = s->_executionStack.end();
+	// The frames are inserted here, so that the first one ends up on top
+	const uint firstFrameIndex = s->_executionStack.size();
 
 	while (framesize > 0) {
 		selector = argp->requireUint16();
@@ -314,10 +316,7 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 
 		// The new stack entries should be put on the stack in reverse order
 		// so that the first one is executed first
-		s->_executionStack.insert(prevElementIterator, xstack);
-		// Decrement the stack end pointer so that it points to our recently
-		// added element, so that the next insert() places it before this one.
-		--prevElementIterator;
+		s->_executionStack.insert(firstFrameIndex, xstack);
 
 		framesize -= (2 + argc);
 		argp += argc + 1;
@@ -452,7 +451,7 @@ static void callKernelFunc(EngineState *s, int kernelCallNr, int argc) {
 	}
 
 	// Remove callk stack frame again, if there's still an execution stack
-	if (s->_executionStack.begin() != s->_executionStack.end())
+	if (!s->_executionStack.empty())
 		s->_executionStack.pop_back();
 }
 
@@ -615,6 +614,7 @@ void run_vm(EngineState *s) {
 				error("No script in segment %d",  s->xs->addr.pc.getSegment());
 			s->xs = &(s->_executionStack.back());
 			s->_executionStackPosChanged = false;
+			s->_executionStack.updateMaxSize();
 
 			obj = s->_segMan->getObject(s->xs->objp);
 			local_script = s->_segMan->getScriptIfLoaded(s->xs->local_segment);
@@ -655,9 +655,12 @@ void run_vm(EngineState *s) {
 			error("run_vm(): program counter gone astray, addr: %d, code buffer size: %d",
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
-		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		// Get opcode. The operands are copied, as kernel calls may drop the
+		// decoded instructions of the script.
+		const Script::DecodedInstruction &instruction = scr->getDecodedInstruction(s->xs->addr.pc.getOffset());
+		const byte extOpcode = instruction.extOpcode;
+		memcpy(opparams, instruction.opparams, sizeof(opparams));
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -28,6 +28,9 @@
 #include "sci/engine/vm_types.h"	// for reg_t
 #include "sci/resource.h"	// for SciVersion
 
+#include "common/memory.h"
+#include "common/noncopyable.h"
+#include "common/textconsole.h"
 #include "common/util.h"
 
 namespace Sci {
@@ -130,6 +133,136 @@ struct ExecStack {
 	}
 };
 
+/**
+ * The execution stack of the VM.
+ *
+ * The frames are stored contiguously in a block which is allocated once, so
+ * that calls do not allocate any memory. Pointers to frames and their indices
+ * stay valid until the frames are removed.
+ */
+class ExecutionStack : Common::NonCopyable {
+public:
+	typedef ExecStack *iterator;
+	typedef const ExecStack *const_iterator;
+
+	enum {
+		/**
+		 * Maximum number of frames. Every frame takes at least one entry of
+		 * the data stack, so valid scripts overflow the data stack first.
+		 */
+		kMaxFrames = VM_STACK_SIZE
+	};
+
+	ExecutionStack() : _size(0) {
+		_frames = (ExecStack *)malloc(kMaxFrames * sizeof(ExecStack));
+		if (!_frames)
+			error("Cannot allocate the execution stack");
+
+		resetStatistics();
+	}
+
+	~ExecutionStack() {
+		free(_frames);
+	}
+
+	bool empty() const { return _size == 0; }
+	uint size() const { return _size; }
+
+	iterator begin() { return _frames; }
+	iterator end() { return _frames + _size; }
+	const_iterator begin() const { return _frames; }
+	const_iterator end() const { return _frames + _size; }
+
+	ExecStack &operator[](uint index) {
+		assert(index < _size);
+		return _frames[index];
+	}
+
+	const ExecStack &operator[](uint index) const {
+		assert(index < _size);
+		return _frames[index];
+	}
+
+	ExecStack &back() {
+		assert(_size > 0);
+		return _frames[_size - 1];
+	}
+
+	const ExecStack &back() const {
+		assert(_size > 0);
+		return _frames[_size - 1];
+	}
+
+	void push_back(const ExecStack &frame) {
+		if (_size == kMaxFrames)
+			overflow();
+
+		new ((void *)&_frames[_size++]) ExecStack(frame);
+		++_pushedFrames;
+	}
+
+	void pop_back() {
+		assert(_size > 0);
+		--_size;
+	}
+
+	/**
+	 * Insert a frame at the given index, moving the frames from there on up.
+	 * Pointers to the moved frames become invalid.
+	 */
+	void insert(uint index, const ExecStack &frame) {
+		assert(index <= _size);
+		if (_size == kMaxFrames)
+			overflow();
+
+		memmove(&_frames[index + 1], &_frames[index], (_size - index) * sizeof(ExecStack));
+		new ((void *)&_frames[index]) ExecStack(frame);
+		++_size;
+		++_pushedFrames;
+	}
+
+	/**
+	 * Remove all frames from the given index on.
+	 */
+	void truncate(uint index) {
+		assert(index <= _size);
+		_size = index;
+	}
+
+	void clear() { _size = 0; }
+
+	/** Number of frames pushed or inserted since the statistics were reset */
+	uint32 getPushedFrames() const { return _pushedFrames; }
+	/** Highest number of frames since the statistics were reset */
+	uint getMaxSize() const { return _maxSize; }
+
+	/**
+	 * Update the highest number of frames. This is done by the VM whenever
+	 * it calls something, not on every push.
+	 */
+	void updateMaxSize() {
+		if (_size > _maxSize)
+			_maxSize = _size;
+	}
+
+	void resetStatistics() {
+		_pushedFrames = 0;
+		_maxSize = _size;
+	}
+
+private:
+	// The debugger opens on errors, its backtrace shows the calls
+	void overflow() const {
+		error("Execution stack overflow, more than %d nested calls", (int)kMaxFrames);
+	}
+
+	ExecStack *_frames;
+	uint _size;
+
+	uint32 _pushedFrames;
+	uint _maxSize;
+};
+
 enum {
 	VAR_GLOBAL = 0,
 	VAR_LOCAL  = 1,
@@ -376,6 +509,110 @@ void run_vm(EngineState *s);
  */
 void script_debug(EngineState *s);
 
+/**
+ * Remembers the results of lookupSelector() for pairs of object and selector.
+ * Scripts send the same selectors to the same objects over and over again,
+ * and every lookup otherwise scans the selector tables of the object and its
+ * superclasses.
+ *
+ * The cache has to be invalidated whenever objects are freed or (re)loaded,
+ * as their address may then refer to a different object. The SegManager,
+ * which owns the cache, takes care of this.
+ */
+class SelectorLookupCache {
+public:
+	struct Entry {
+		reg_t obj;
+		Selector selectorId;
+		uint32 generation;
+		SelectorType type;
+		/** Index of the variable, if type is kSelectorVariable */
+		int varIndex;
+		/** Address of the method, if type is kSelectorMethod */
+		reg_t funcAddress;
+	};
+
+	SelectorLookupCache() : _generation(1) {
+		memset(_entries, 0, sizeof(_entries));
+		resetStatistics();
+	}
+
+	/**
+	 * Find the cached lookup of a selector.
+	 * @return the entry, or NULL if the lookup is not cached
+	 */
+	const Entry *find(reg_t obj, Selector selectorId) {
+		++_lookups;
+		const Entry &entry = _entries[getIndex(obj, selectorId)];
+		if (entry.generation != _generation || !isSameObject(entry.obj, obj) || entry.selectorId != selectorId)
+			return NULL;
+
+		++_hits;
+		return &entry;
+	}
+
+	/**
+	 * Remember the result of a lookup, replacing the lookup cached at the
+	 * same position.
+	 */
+	void store(reg_t obj, Selector selectorId, SelectorType type, int varIndex, reg_t funcAddress) {
+		Entry &entry = _entries[getIndex(obj, selectorId)];
+		entry.obj = obj;
+		entry.selectorId = selectorId;
+		entry.generation = _generation;
+		entry.type = type;
+		entry.varIndex = varIndex;
+		entry.funcAddress = funcAddress;
+	}
+
+	/**
+	 * Forget all cached lookups.
+	 */
+	void invalidate() {
+		++_generation;
+
+		// After a wrap around, old entries could look valid again
+		if (!_generation) {
+			memset(_entries, 0, sizeof(_entries));
+			_generation = 1;
+		}
+	}
+
+	/** Number of calls to find() since the statistics were reset */
+	uint32 getLookups() const { return _lookups; }
+	/** Number of lookups found in the cache since the statistics were reset */
+	uint32 getHits() const { return _hits; }
+
+	void resetStatistics() {
+		_lookups = 0;
+		_hits = 0;
+	}
+
+private:
+	enum {
+		kSize = 1024
+	};
+
+	// Within a game, equal addresses are stored the same way, so the cache
+	// uses the fields of reg_t directly instead of the accessors, which check
+	// the SCI version on every call
+	static bool isSameObject(reg_t a, reg_t b) {
+		return a._segment == b._segment && a._offset == b._offset;
+	}
+
+	static uint getIndex(reg_t obj, Selector selectorId) {
+		const uint32 hash = (obj._segment * 0x9E3779B1) ^ (obj._offset * 0x85EBCA6B) ^ (selectorId * 0xC2B2AE35);
+		return (hash ^ (hash >> 16)) & (kSize - 1);
+	}
+
+	Entry _entries[kSize];
+	/** Entries of other generations are invalid */
+	uint32 _generation;
+
+	uint32 _lookups;
+	uint32 _hits;
+};
+
 /**
  * Looks up a selector and returns its type and value
  * varindex is written to iff it is non-NULL and the selector indicates a property of the object.
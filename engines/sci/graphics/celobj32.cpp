@@ -34,6 +34,7 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/simd.h"
 
 namespace Sci {
 #pragma mark CelScaler
@@ -82,9 +83,67 @@ const CelScalerTable &CelScaler::getScalerTable(const Ratio &scaleX, const Ratio
 	return _scaleTables[_activeIndex];
 }
 
+#pragma mark -
+#pragma mark CelPixelCache
+
+CelPixelCache::CelPixelCache(const uint32 maxMemory) :
+	_memory(0),
+	_maxMemory(maxMemory) {}
+
+CelPixelCache::Pixels CelPixelCache::get(const CelType type, const GuiResourceId resourceId, const uint32 celHeaderOffset) {
+	const Key key = { type, resourceId, celHeaderOffset };
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		++_stats.misses;
+		return Pixels();
+	}
+
+	++_stats.hits;
+	_lru.erase(it->_value.lruPosition);
+	_lru.push_back(key);
+	it->_value.lruPosition = --_lru.end();
+	return it->_value.pixels;
+}
+
+void CelPixelCache::put(const CelType type, const GuiResourceId resourceId, const uint32 celHeaderOffset, const Pixels &pixels) {
+	const Key key = { type, resourceId, celHeaderOffset };
+	assert(!_entries.contains(key));
+
+	Entry &entry = _entries[key];
+	entry.pixels = pixels;
+	_lru.push_back(key);
+	entry.lruPosition = --_lru.end();
+	_memory += pixels->size();
+
+	freeOldEntries();
+}
+
+void CelPixelCache::clear() {
+	_entries.clear();
+	_lru.clear();
+	_memory = 0;
+}
+
+void CelPixelCache::setMemoryLimit(const uint32 maxMemory) {
+	_maxMemory = maxMemory;
+	freeOldEntries();
+}
+
+void CelPixelCache::freeOldEntries() {
+	while (_memory > _maxMemory && !_lru.empty()) {
+		EntryMap::iterator it = _entries.find(_lru.front());
+		assert(it != _entries.end());
+		_memory -= it->_value.pixels->size();
+		_entries.erase(it);
+		_lru.pop_front();
+		++_stats.evictions;
+	}
+}
+
 #pragma mark -
 #pragma mark CelObj
 bool CelObj::_drawBlackLines = false;
+Common::ScopedPtr<CelPixelCache> CelObj::_pixelCache;
 
 void CelObj::init() {
 	CelObj::deinit();
@@ -92,11 +151,19 @@ void CelObj::init() {
 	_nextCacheId = 1;
 	_scaler.reset(new CelScaler());
 	_cache.reset(new CelCache(100));
+
+	uint32 pixelCacheSize = 8 * 1024 * 1024;
+	if (ConfMan.hasKey("sci_cel_cache_size")) {
+		// The size is given in KiB; 0 disables the cache
+		pixelCacheSize = MIN<uint32>(MAX(ConfMan.getInt("sci_cel_cache_size"), 0), 0x3FFFFF) * 1024;
+	}
+	_pixelCache.reset(new CelPixelCache(pixelCacheSize));
 }
 
 void CelObj::deinit() {
 	_scaler.reset();
 	_cache.reset();
+	_pixelCache.reset();
 }
 
 #pragma mark -
@@ -147,6 +214,18 @@ struct SCALER_NoScale {
 			return *_row++;
 		}
 	}
+
+	/**
+	 * Reads `width` pixels at once. Only unflipped rows are contiguous in
+	 * memory, so this is not available for FLIP.
+	 */
+	inline const byte *readRow(const int16 width) {
+		assert(!FLIP);
+		assert(_row + width <= _rowEdge);
+		const byte *row = _row;
+		_row += width;
+		return row;
+	}
 };
 
 template<bool FLIP, typename READER>
@@ -355,14 +434,74 @@ private:
 	uint32 _dataOffset;
 	uint32 _uncompressedDataOffset;
 	int16 _y;
+	const int16 _sourceWidth;
 	const int16 _sourceHeight;
 	const uint8 _skipColor;
 	const int16 _maxWidth;
 
+	/**
+	 * The pixels of the whole cel, for cels which are kept in the
+	 * CelPixelCache. If this is not set, rows are decompressed on demand.
+	 */
+	CelPixelCache::Pixels _pixels;
+
+	void decompressRow(const int16 y, byte *buffer, const int16 maxWidth) const {
+		// compressed data segment for row
+		const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
+
+		uint32 rowCompressedSize;
+		if (y + 1 < _sourceHeight) {
+			rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
+		} else {
+			rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
+		}
+
+		const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
+
+		// uncompressed data segment for row
+		const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
+
+		uint32 literalRowSize;
+		if (y + 1 < _sourceHeight) {
+			literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
+		} else {
+			literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
+		}
+
+		const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
+
+		uint8 length;
+		for (int16 i = 0; i < maxWidth; i += length) {
+			const byte controlByte = *row++;
+			length = controlByte;
+
+			// Run-length encoded
+			if (controlByte & 0x80) {
+				length &= 0x3F;
+				assert(i + length < kCelScalerTableSize);
+
+				// Fill with skip color
+				if (controlByte & 0x40) {
+					memset(buffer + i, _skipColor, length);
+				// Next value is fill color
+				} else {
+					memset(buffer + i, *literal, length);
+					++literal;
+				}
+			// Uncompressed
+			} else {
+				assert(i + length < kCelScalerTableSize);
+				memcpy(buffer + i, literal, length);
+				literal += length;
+			}
+		}
+	}
+
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
 	_resource(celObj.getResPointer()),
 	_y(-1),
+	_sourceWidth(celObj._width),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
@@ -372,60 +511,32 @@ public:
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
+
+		// Bitmaps in memory may be changed by the game scripts, so only
+		// resource cels can be cached
+		const CelType type = celObj._info.type;
+		if (CelObj::_pixelCache && (type == kCelTypeView || type == kCelTypePic) &&
+			(uint32)(_sourceWidth * _sourceHeight) <= CelObj::_pixelCache->getMemoryLimit()) {
+			_pixels = CelObj::_pixelCache->get(type, celObj._info.resourceId, celObj._celHeaderOffset);
+			if (!_pixels) {
+				_pixels = CelPixelCache::Pixels(new Common::Array<byte>(_sourceWidth * _sourceHeight));
+				for (int16 y = 0; y < _sourceHeight; ++y) {
+					decompressRow(y, _buffer, _sourceWidth);
+					memcpy(_pixels->begin() + y * _sourceWidth, _buffer, _sourceWidth);
+				}
+				CelObj::_pixelCache->put(type, celObj._info.resourceId, celObj._celHeaderOffset, _pixels);
+			}
+		}
 	}
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
-		if (y != _y) {
-			// compressed data segment for row
-			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
-
-			uint32 rowCompressedSize;
-			if (y + 1 < _sourceHeight) {
-				rowCompressedSize = _resource.getUint32SEAt(_controlOffset + (y + 1) * sizeof(uint32)) - rowOffset;
-			} else {
-				rowCompressedSize = _resource.size() - rowOffset - _dataOffset;
-			}
-
-			const byte *row = _resource.getUnsafeDataAt(_dataOffset + rowOffset, rowCompressedSize);
-
-			// uncompressed data segment for row
-			const uint32 literalOffset = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + y * sizeof(uint32));
-
-			uint32 literalRowSize;
-			if (y + 1 < _sourceHeight) {
-				literalRowSize = _resource.getUint32SEAt(_controlOffset + _sourceHeight * sizeof(uint32) + (y + 1) * sizeof(uint32)) - literalOffset;
-			} else {
-				literalRowSize = _resource.size() - literalOffset - _uncompressedDataOffset;
-			}
-
-			const byte *literal = _resource.getUnsafeDataAt(_uncompressedDataOffset + literalOffset, literalRowSize);
-
-			uint8 length;
-			for (int16 i = 0; i < _maxWidth; i += length) {
-				const byte controlByte = *row++;
-				length = controlByte;
-
-				// Run-length encoded
-				if (controlByte & 0x80) {
-					length &= 0x3F;
-					assert(i + length < (int)sizeof(_buffer));
+		if (_pixels) {
+			return _pixels->begin() + y * _sourceWidth;
+		}
 
-					// Fill with skip color
-					if (controlByte & 0x40) {
-						memset(_buffer + i, _skipColor, length);
-					// Next value is fill color
-					} else {
-						memset(_buffer + i, *literal, length);
-						++literal;
-					}
-				// Uncompressed
-				} else {
-					assert(i + length < (int)sizeof(_buffer));
-					memcpy(_buffer + i, literal, length);
-					literal += length;
-				}
-			}
+		if (y != _y) {
+			decompressRow(y, _buffer, _maxWidth);
 			_y = y;
 		}
 
@@ -433,9 +544,79 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark CelObj - Row blitters
+
+/**
+ * Copies a row of pixels, leaving the target pixels where the source pixel
+ * is `skipColor` untouched.
+ */
+static inline void copyRowSkip(byte *target, const byte *source, const int16 width, const uint8 skipColor) {
+	int16 x = 0;
+#if defined(SCUMMVM_SSE2)
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+	for (; x + 16 <= width; x += 16) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)(source + x));
+		const __m128i background = _mm_loadu_si128((const __m128i *)(target + x));
+		const __m128i transparent = _mm_cmpeq_epi8(pixels, skip);
+		_mm_storeu_si128((__m128i *)(target + x), _mm_or_si128(_mm_and_si128(transparent, background), _mm_andnot_si128(transparent, pixels)));
+	}
+#elif defined(SCUMMVM_NEON)
+	const uint8x16_t skip = vdupq_n_u8(skipColor);
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t pixels = vld1q_u8(source + x);
+		const uint8x16_t transparent = vceqq_u8(pixels, skip);
+		vst1q_u8(target + x, vbslq_u8(transparent, vld1q_u8(target + x), pixels));
+	}
+#endif
+	for (; x < width; ++x) {
+		if (source[x] != skipColor) {
+			target[x] = source[x];
+		}
+	}
+}
+
+/**
+ * Copies a row of pixels like copyRowSkip, additionally leaving the target
+ * pixels untouched where the source pixel is in the remap range starting at
+ * `startColor`.
+ */
+static inline void copyRowSkipRemap(byte *target, const byte *source, const int16 width, const uint8 skipColor, const uint8 startColor) {
+	int16 x = 0;
+#if defined(SCUMMVM_SSE2)
+	const __m128i skip = _mm_set1_epi8((char)skipColor);
+	const __m128i start = _mm_set1_epi8((char)startColor);
+	for (; x + 16 <= width; x += 16) {
+		const __m128i pixels = _mm_loadu_si128((const __m128i *)(source + x));
+		const __m128i background = _mm_loadu_si128((const __m128i *)(target + x));
+		// There is no unsigned byte comparison, but pixel >= start exactly
+		// when max(pixel, start) == pixel
+		const __m128i remapped = _mm_cmpeq_epi8(_mm_max_epu8(pixels, start), pixels);
+		const __m128i keep = _mm_or_si128(_mm_cmpeq_epi8(pixels, skip), remapped);
+		_mm_storeu_si128((__m128i *)(target + x), _mm_or_si128(_mm_and_si128(keep, background), _mm_andnot_si128(keep, pixels)));
+	}
+#elif defined(SCUMMVM_NEON)
+	const uint8x16_t skip = vdupq_n_u8(skipColor);
+	const uint8x16_t start = vdupq_n_u8(startColor);
+	for (; x + 16 <= width; x += 16) {
+		const uint8x16_t pixels = vld1q_u8(source + x);
+		const uint8x16_t keep = vorrq_u8(vceqq_u8(pixels, skip), vcgeq_u8(pixels, start));
+		vst1q_u8(target + x, vbslq_u8(keep, vld1q_u8(target + x), pixels));
+	}
+#endif
+	for (; x < width; ++x) {
+		if (source[x] != skipColor && source[x] < startColor) {
+			target[x] = source[x];
+		}
+	}
+}
+
 #pragma mark -
 #pragma mark CelObj - Remappers
 
+// Besides drawing single pixels, every mapper can draw a whole row with
+// drawRow, which is used for unscaled and unflipped cels.
+
 /**
  * Pixel mapper for a CelObj with transparent pixels and no
  * remapping data.
@@ -446,6 +627,10 @@ struct MAPPER_NoMD {
 			*target = pixel;
 		}
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		copyRowSkip(target, source, width, skipColor);
+	}
 };
 
 /**
@@ -456,6 +641,10 @@ struct MAPPER_NoMDNoSkip {
 	inline void draw(byte *target, const byte pixel, const uint8) const {
 		*target = pixel;
 	}
+
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8) const {
+		memcpy(target, source, width);
+	}
 };
 
 /**
@@ -474,6 +663,11 @@ struct MAPPER_Map {
 			}
 		}
 	}
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		for (int16 x = 0; x < width; ++x) {
+			draw(target++, *source++, skipColor);
+		}
+	}
 };
 
 /**
@@ -488,6 +682,9 @@ struct MAPPER_NoMap {
 			*target = pixel;
 		}
 	}
+	inline void drawRow(byte *target, const byte *source, const int16 width, const uint8 skipColor) const {
+		copyRowSkipRemap(target, source, width, skipColor, g_sci->_gfxRemap32->getStartColor());
+	}
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
@@ -708,6 +905,29 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 #pragma mark -
 #pragma mark CelObj - Drawing
 
+/**
+ * Draws one row of a cel, pixel by pixel.
+ */
+template<typename MAPPER, typename SCALER>
+struct ROW_RENDERER {
+	static inline void draw(MAPPER &mapper, SCALER &scaler, byte *targetPixel, const int16 targetWidth, const uint8 skipColor) {
+		for (int16 x = 0; x < targetWidth; ++x) {
+			mapper.draw(targetPixel++, scaler.read(), skipColor);
+		}
+	}
+};
+
+/**
+ * Draws one row of an unscaled and unflipped cel, whose source pixels are
+ * contiguous, with the row blitter of the mapper.
+ */
+template<typename MAPPER, typename READER>
+struct ROW_RENDERER<MAPPER, SCALER_NoScale<false, READER> > {
+	static inline void draw(MAPPER &mapper, SCALER_NoScale<false, READER> &scaler, byte *targetPixel, const int16 targetWidth, const uint8 skipColor) {
+		mapper.drawRow(targetPixel, scaler.readRow(targetWidth), targetWidth, skipColor);
+	}
+};
+
 template<typename MAPPER, typename SCALER, bool DRAW_BLACK_LINES>
 struct RENDERER {
 	MAPPER &_mapper;
@@ -733,12 +953,8 @@ struct RENDERER {
 			}
 
 			_scaler.setTarget(targetRect.left, targetRect.top + y);
-
-			for (int16 x = 0; x < targetWidth; ++x) {
-				_mapper.draw(targetPixel++, _scaler.read(), _skipColor);
-			}
-
-			targetPixel += skipStride;
+			ROW_RENDERER<MAPPER, SCALER>::draw(_mapper, _scaler, targetPixel, targetWidth, _skipColor);
+			targetPixel += targetWidth + skipStride;
 		}
 	}
 };
@@ -23,6 +23,9 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource.h"
@@ -151,6 +154,97 @@ struct CelCacheEntry {
 
 typedef Common::Array<CelCacheEntry> CelCache;
 
+#pragma mark -
+#pragma mark CelPixelCache
+
+/**
+ * A cache for the decompressed pixels of RLE compressed view and pic cels,
+ * so that cels which are drawn again and again only need to be decompressed
+ * once. The least recently used cels are freed when the cache uses more than
+ * its memory limit.
+ *
+ * The cached pixels are palette indexes, before any remapping, so they stay
+ * valid when the palette or the remap state changes.
+ */
+class CelPixelCache {
+public:
+	/**
+	 * The pixels of a whole cel, `width * height` bytes. They are shared with
+	 * the readers using them, so evicting a cel while it is drawn is safe.
+	 */
+	typedef Common::SharedPtr<Common::Array<byte> > Pixels;
+
+	struct Statistics {
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+		Statistics() : hits(0), misses(0), evictions(0) {}
+	};
+
+	CelPixelCache(const uint32 maxMemory);
+
+	/**
+	 * Returns the pixels of the cel with the given cel header offset in the
+	 * given resource, or a null pointer if they are not cached.
+	 */
+	Pixels get(const CelType type, const GuiResourceId resourceId, const uint32 celHeaderOffset);
+
+	/**
+	 * Adds the pixels of a cel to the cache, freeing the least recently used
+	 * cels if necessary.
+	 */
+	void put(const CelType type, const GuiResourceId resourceId, const uint32 celHeaderOffset, const Pixels &pixels);
+
+	void clear();
+
+	uint32 getMemory() const { return _memory; }
+	uint32 getMemoryLimit() const { return _maxMemory; }
+	void setMemoryLimit(const uint32 maxMemory);
+	uint getEntries() const { return _entries.size(); }
+
+	const Statistics &getStatistics() const { return _stats; }
+	void resetStatistics() { _stats = Statistics(); }
+
+private:
+	struct Key {
+		CelType type;
+		GuiResourceId resourceId;
+		uint32 celHeaderOffset;
+
+		bool operator==(const Key &other) const {
+			return type == other.type && resourceId == other.resourceId && celHeaderOffset == other.celHeaderOffset;
+		}
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const {
+			return (key.type << 28) ^ (key.resourceId << 16) ^ key.celHeaderOffset;
+		}
+	};
+
+	typedef Common::List<Key> LRUList;
+
+	struct Entry {
+		Pixels pixels;
+		LRUList::iterator lruPosition;
+	};
+
+	typedef Common::HashMap<Key, Entry, KeyHash> EntryMap;
+
+	EntryMap _entries;
+
+	/**
+	 * The cached cels, least recently used first.
+	 */
+	LRUList _lru;
+
+	uint32 _memory;
+	uint32 _maxMemory;
+	Statistics _stats;
+
+	void freeOldEntries();
+};
+
 #pragma mark -
 #pragma mark CelScaler
 
@@ -265,6 +359,11 @@ protected:
 public:
 	static Common::ScopedPtr<CelScaler> _scaler;
 
+	/**
+	 * The cache for decompressed cel pixels, see CelPixelCache.
+	 */
+	static Common::ScopedPtr<CelPixelCache> _pixelCache;
+
 	/**
 	 * The basic identifying information for this cel. This information
 	 * effectively acts as a composite key for a cel object, and any cel object
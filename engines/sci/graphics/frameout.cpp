@@ -71,7 +71,10 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	_overdrawThreshold(0),
 	_throttleKernelFrameOut(true),
 	_palMorphIsOn(false),
-	_lastScreenUpdateTick(0) {
+	_lastScreenUpdateTick(0),
+	_renderStatsEnabled(false),
+	_renderStatsFrames(0),
+	_renderStatsShowTime(0) {
 
 	if (g_sci->getGameId() == GID_PHANTASMAGORIA) {
 		_currentBuffer.create(630, 450, Graphics::PixelFormat::createFormatCLUT8());
@@ -428,8 +431,12 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 	_remapOccurred = _palette->updateForFrame();
 
 	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
-		drawEraseList(eraseLists[i], *_planes[i]);
-		drawScreenItemList(screenItemLists[i]);
+		if (_renderStatsEnabled) {
+			drawPlaneWithStats(*_planes[i], eraseLists[i], screenItemLists[i]);
+		} else {
+			drawEraseList(eraseLists[i], *_planes[i]);
+			drawScreenItemList(screenItemLists[i]);
+		}
 	}
 
 	if (robotIsActive) {
@@ -439,7 +446,15 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 	_palette->updateHardware();
 
 	if (shouldShowBits) {
+		const uint32 showStartTime = _renderStatsEnabled ? g_system->getMillis() : 0;
 		showBits();
+		if (_renderStatsEnabled) {
+			_renderStatsShowTime += g_system->getMillis() - showStartTime;
+		}
+	}
+
+	if (_renderStatsEnabled) {
+		++_renderStatsFrames;
 	}
 
 	if (robotIsActive) {
@@ -1410,4 +1425,74 @@ void GfxFrameout::printVisiblePlaneItemList(Console *con, const reg_t planeObjec
 	printPlaneItemListInternal(con, p->_screenItemList);
 }
 
+void GfxFrameout::setRenderStatsEnabled(const bool enable) {
+	_renderStatsEnabled = enable;
+	if (enable) {
+		_renderStatsFrames = 0;
+		_renderStatsShowTime = 0;
+		_renderStats.clear();
+	}
+}
+
+void GfxFrameout::drawPlaneWithStats(const Plane &plane, const RectList &eraseList, const DrawList &screenItemList) {
+	const uint32 startTime = g_system->getMillis();
+	drawEraseList(eraseList, plane);
+	const uint32 eraseEndTime = g_system->getMillis();
+	drawScreenItemList(screenItemList);
+	const uint32 drawEndTime = g_system->getMillis();
+
+	PlaneRenderStats *stats = nullptr;
+	for (uint i = 0; i < _renderStats.size(); ++i) {
+		if (_renderStats[i].object == plane._object) {
+			stats = &_renderStats[i];
+			break;
+		}
+	}
+
+	if (!stats) {
+		PlaneRenderStats newStats;
+		newStats.object = plane._object;
+		newStats.eraseTime = newStats.drawTime = 0;
+		newStats.itemsDrawn = 0;
+		newStats.pixelsDrawn = 0;
+		_renderStats.push_back(newStats);
+		stats = &_renderStats.back();
+	}
+
+	stats->eraseTime += eraseEndTime - startTime;
+	stats->drawTime += drawEndTime - eraseEndTime;
+	stats->itemsDrawn += screenItemList.size();
+	for (DrawList::size_type i = 0; i < screenItemList.size(); ++i) {
+		const Common::Rect &rect = screenItemList[i]->rect;
+		stats->pixelsDrawn += rect.width() * rect.height();
+	}
+}
+
+void GfxFrameout::printRenderStats(Console *con) const {
+	if (!_renderStatsFrames) {
+		con->debugPrintf("No frames rendered yet\n");
+		return;
+	}
+
+	con->debugPrintf("%u frames, average times in microseconds per frame:\n", _renderStatsFrames);
+	for (uint i = 0; i < _renderStats.size(); ++i) {
+		const PlaneRenderStats &stats = _renderStats[i];
+		const char *name;
+		if (stats.object.isNumber()) {
+			name = "-scummvm-";
+		} else {
+			name = _segMan->getObjectName(stats.object);
+		}
+
+		con->debugPrintf("%04x:%04x (%s): erase %u, draw %u, %u items, %u pixels\n",
+			PRINT_REG(stats.object),
+			name,
+			stats.eraseTime * 1000 / _renderStatsFrames,
+			stats.drawTime * 1000 / _renderStatsFrames,
+			stats.itemsDrawn / _renderStatsFrames,
+			(uint32)(stats.pixelsDrawn / _renderStatsFrames));
+	}
+	con->debugPrintf("Screen update: %u\n", _renderStatsShowTime * 1000 / _renderStatsFrames);
+}
+
 } // End of namespace Sci
@@ -432,6 +432,35 @@ public:
 	void printPlaneItemList(Console *con, const reg_t planeObject) const;
 	void printVisiblePlaneItemList(Console *con, const reg_t planeObject) const;
 	void printPlaneItemListInternal(Console *con, const ScreenItemList &screenItemList) const;
+
+	/**
+	 * Enables or disables collecting render times per plane in `frameOut`.
+	 * Enabling it resets the collected times.
+	 */
+	void setRenderStatsEnabled(const bool enable);
+	bool getRenderStatsEnabled() const { return _renderStatsEnabled; }
+	void printRenderStats(Console *con) const;
+
+private:
+	/**
+	 * Render times of a plane, summed up over all frames since collecting
+	 * them was enabled. OSystem only has a millisecond timer, so the times
+	 * only become meaningful when averaged over many frames.
+	 */
+	struct PlaneRenderStats {
+		reg_t object;
+		uint32 eraseTime;
+		uint32 drawTime;
+		uint32 itemsDrawn;
+		uint64 pixelsDrawn;
+	};
+
+	bool _renderStatsEnabled;
+	uint32 _renderStatsFrames;
+	uint32 _renderStatsShowTime;
+	Common::Array<PlaneRenderStats> _renderStats;
+
+	void drawPlaneWithStats(const Plane &plane, const RectList &eraseList, const DrawList &screenItemList);
 };
 
 } // End of namespace Sci
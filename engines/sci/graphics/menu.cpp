@@ -465,7 +465,7 @@ reg_t GfxMenu::kernelSelect(reg_t eventObject, bool pauseSound) {
 			itemEntry = *itemIterator;
 
 			if (!itemEntry->saidVmPtr.isNull()) {
-				byte *saidSpec = _segMan->derefBulkPtr(itemEntry->saidVmPtr, 0);
+				const byte *saidSpec = _segMan->derefBulkPtrReadOnly(itemEntry->saidVmPtr, 0);
 
 				if (!saidSpec) {
 					warning("Could not dereference saidSpec");
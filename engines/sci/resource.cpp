@@ -22,6 +22,7 @@
 
 // Resource library
 
+#include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/macresman.h"
@@ -420,6 +421,66 @@ void ResourceManager::loadResource(Resource *res) {
 	res->_source->loadResource(this, res);
 }
 
+bool ResourceManager::loadPrefetchedResource(Resource *res) {
+	if (!_prefetcher)
+		return false;
+
+	uint32 size;
+	byte *data = _prefetcher->take(res->_id, res->_source, res->_fileOffset, size);
+	if (!data)
+		return false;
+
+	res->_data = data;
+	res->_size = size;
+	res->_status = kResStatusAllocated;
+	return true;
+}
+
+void ResourceManager::prefetchResources(const Common::List<ResourceId> &ids) {
+	for (Common::List<ResourceId>::const_iterator it = ids.begin(); it != ids.end(); ++it)
+		prefetchResource(*it);
+}
+
+void ResourceManager::prefetchResource(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!_prefetcher || !_prefetcher->isRunning() || !res || res->_status != kResStatusNoMalloc || _prefetcher->isQueued(id))
+		return;
+
+	// Only plain volume resources are read in one piece by the default
+	// loader; audio resources get their size fixed up after loading.
+	// Volumes are reopened by name for the worker thread.
+	if (res->_source->getSourceType() != kSourceVolume || res->getType() == kResourceTypeAudio || res->_source->_resourceFile)
+		return;
+
+	// Make room by dropping the resources queued the longest time ago, which
+	// the scripts evidently did not need yet
+	while (_prefetcher->getMemory() + res->_size > _maxMemoryLRU) {
+		if (!_prefetcher->evictOldest())
+			return;
+	}
+
+	Common::SeekableReadStream *fileStream = getVolumeFile(res->_source);
+	if (!fileStream)
+		return;
+
+	fileStream->seek(res->_fileOffset, SEEK_SET);
+
+	// Only the header is read here, the worker thread reads the packed data
+	uint32 szPacked = 0;
+	ResourceCompression compression = kCompUnknown;
+	if (res->readResourceInfo(_volVersion, fileStream, szPacked, compression) == SCI_ERROR_NONE) {
+		if (_prefetcher->queue(id, res->_source, res->_fileOffset, res->_source->getLocationName(), fileStream->pos(), compression, szPacked, res->_size))
+			++_cacheStats.prefetches;
+	}
+
+	disposeVolumeFileStream(fileStream, res->_source);
+}
+
+void ResourceManager::cancelPrefetch(ResourceId id) {
+	if (_prefetcher)
+		_prefetcher->cancel(id);
+}
+
 
 void PatchResourceSource::loadResource(ResourceManager *resMan, Resource *res) {
 	bool result = res->loadFromPatchFile();
@@ -964,13 +1025,16 @@ void ResourceManager::freeResourceSources() {
 }
 
 ResourceManager::ResourceManager(const bool detectionMode) :
-	_detectionMode(detectionMode) {}
+	_detectionMode(detectionMode), _prefetcher(nullptr) {}
 
 void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
 	_LRU.clear();
+	resetCacheStatistics();
+	if (!_detectionMode && !_prefetcher && Common::Thread::isSupported())
+		_prefetcher = new ResourcePrefetcher();
 	_resMap.clear();
 	_audioMapSCI1 = NULL;
 #ifdef ENABLE_SCI32
@@ -1025,6 +1089,13 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Users with plenty of memory can trade it for less decompression
+	if (ConfMan.hasKey("sci_resource_cache_size")) {
+		const int cacheSize = ConfMan.getInt("sci_resource_cache_size"); // in KiB
+		if (cacheSize > 0)
+			_maxMemoryLRU = MIN<uint32>(cacheSize, 0x3FFFFF) * 1024;
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1051,6 +1122,9 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	// The prefetcher references the resource sources
+	delete _prefetcher;
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1071,7 +1145,7 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
+	_LRU.erase(res->_lruPosition);
 	_memoryLRU -= res->size();
 	res->_status = kResStatusAllocated;
 }
@@ -1082,6 +1156,7 @@ void ResourceManager::addToLRU(Resource *res) {
 		return;
 	}
 	_LRU.push_front(res);
+	res->_lruPosition = _LRU.begin();
 	_memoryLRU += res->size();
 #if SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1105,7 +1180,12 @@ void ResourceManager::printLRU() {
 		++it;
 	}
 
-	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
+	debug("Total: %d entries, %d bytes (mgr says %u)", entries, mem, _memoryLRU);
+}
+
+void ResourceManager::setCacheMemoryLimit(uint32 size) {
+	_maxMemoryLRU = size;
+	freeOldResources();
 }
 
 void ResourceManager::freeOldResources() {
@@ -1114,6 +1194,7 @@ void ResourceManager::freeOldResources() {
 		Resource *goner = _LRU.back();
 		removeFromLRU(goner);
 		goner->unalloc();
+		++_cacheStats.evictions;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
@@ -1139,9 +1220,17 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return NULL;
 
-	if (retval->_status == kResStatusNoMalloc)
-		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	if (retval->_status == kResStatusNoMalloc) {
+		++_cacheStats.misses;
+		if (loadPrefetchedResource(retval))
+			++_cacheStats.prefetchHits;
+		else
+			loadResource(retval);
+	} else {
+		++_cacheStats.hits;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
@@ -2243,29 +2332,8 @@ int Resource::decompress(ResVersion volVersion, Common::SeekableReadStream *file
 		return errorNum;
 
 	// getting a decompressor
-	Decompressor *dec = NULL;
-	switch (compression) {
-	case kCompNone:
-		dec = new Decompressor;
-		break;
-	case kCompHuffman:
-		dec = new DecompressorHuffman;
-		break;
-	case kCompLZW:
-	case kCompLZW1:
-	case kCompLZW1View:
-	case kCompLZW1Pic:
-		dec = new DecompressorLZW(compression);
-		break;
-	case kCompDCL:
-		dec = new DecompressorDCL;
-		break;
-#ifdef ENABLE_SCI32
-	case kCompSTACpack:
-		dec = new DecompressorLZS;
-		break;
-#endif
-	default:
+	Decompressor *dec = createDecompressor(compression);
+	if (!dec) {
 		error("Resource %s: Compression method %d not supported", _id.toString().c_str(), compression);
 		return SCI_ERROR_UNKNOWN_COMPRESSION;
 	}
@@ -145,6 +145,7 @@ enum ResVersion {
 
 class ResourceManager;
 class ResourceSource;
+class ResourcePrefetcher;
 
 class ResourceId {
 	static inline ResourceType fixupType(ResourceType type) {
@@ -298,6 +299,7 @@ protected:
 	uint16 _lockers; /**< Number of places where this resource was locked */
 	ResourceSource *_source;
 	ResourceManager *_resMan;
+	Common::List<Resource *>::iterator _lruPosition; /**< Position in the LRU list, valid while enqueued */
 
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
@@ -465,6 +467,53 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/**
+	 * Counters for the resource cache, for the debugger.
+	 */
+	struct CacheStatistics {
+		uint32 hits;      ///< Requests for resources which were still in memory
+		uint32 misses;    ///< Requests which had to load the resource
+		uint32 evictions; ///< Resources freed to stay within the memory budget
+		uint32 prefetches;    ///< Resources queued for loading in the background
+		uint32 prefetchHits;  ///< Misses which were served by a prefetched resource
+		CacheStatistics() : hits(0), misses(0), evictions(0), prefetches(0), prefetchHits(0) {}
+	};
+
+	const CacheStatistics &getCacheStatistics() const { return _cacheStats; }
+	void resetCacheStatistics() { _cacheStats = CacheStatistics(); }
+
+	/**
+	 * Returns the number of bytes used by unlocked resources that are kept
+	 * in memory for later use, and the maximum for this.
+	 */
+	uint32 getCacheMemory() const { return _memoryLRU; }
+	uint32 getCacheMemoryLimit() const { return _maxMemoryLRU; }
+	uint32 getLockedMemory() const { return _memoryLocked; }
+	uint getCacheEntries() const { return _LRU.size(); }
+
+	/**
+	 * Changes the maximum number of bytes used by unlocked resources kept in
+	 * memory, freeing the least recently used ones if necessary.
+	 */
+	void setCacheMemoryLimit(uint32 size);
+
+	/**
+	 * Starts decompressing the given resources on a worker thread, so that
+	 * later findResource() calls for them do not have to wait for it.
+	 *
+	 * This is only a hint. Resources which are already in memory, which are
+	 * not stored in resource volumes, or which would exceed the memory budget
+	 * are skipped, as is everything when threads are not available.
+	 */
+	void prefetchResources(const Common::List<ResourceId> &ids);
+	void prefetchResource(ResourceId id);
+
+	/**
+	 * Drops a resource queued by prefetchResource(), for when scripts
+	 * announce that they no longer need it.
+	 */
+	void cancelPrefetch(ResourceId id);
+
 protected:
 	bool _detectionMode;
 
@@ -472,14 +521,16 @@ protected:
 	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
 	// for resources which are not explicitly locked. However, a warning will be
 	// issued whenever this limit is exceeded.
-	int _maxMemoryLRU;
+	uint32 _maxMemoryLRU;
 
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
 	typedef Common::List<ResourceSource *> SourcesList;
 	SourcesList _sources;
-	int _memoryLocked;	///< Amount of resource bytes in locked memory
-	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	uint32 _memoryLocked;	///< Amount of resource bytes in locked memory
+	uint32 _memoryLRU;		///< Amount of resource bytes under LRU control
+	Common::List<Resource *> _LRU; ///< Last Resource Used list; resources remember their position in it
+	CacheStatistics _cacheStats;
+	ResourcePrefetcher *_prefetcher; ///< Background loader, NULL if threads are unavailable
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -539,6 +590,7 @@ protected:
 	Common::SeekableReadStream *getVolumeFile(ResourceSource *source);
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
+	bool loadPrefetchedResource(Resource *res);
 	void freeOldResources();
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
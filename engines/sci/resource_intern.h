@@ -23,6 +23,11 @@
 #ifndef SCI_RESOURCE_INTERN_H
 #define SCI_RESOURCE_INTERN_H
 
+#include "common/file.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/thread.h"
+
 #include "sci/resource.h"
 
 namespace Common {
@@ -237,6 +242,113 @@ protected:
 
 #endif
 
+/**
+ * Reads and decompresses resources on a worker thread, for
+ * ResourceManager::prefetchResources().
+ *
+ * Volume files are opened by the engine thread, as the archive lookup is
+ * not thread safe, but the prefetcher opens its own handles for them, which
+ * only the worker reads from. All methods must be called from the engine
+ * thread.
+ */
+class ResourcePrefetcher : Common::NonCopyable {
+public:
+	ResourcePrefetcher();
+	~ResourcePrefetcher();
+
+	/**
+	 * Whether the worker thread could be started.
+	 */
+	bool isRunning() const { return _worker.isRunning(); }
+
+	bool isQueued(const ResourceId &id) const;
+
+	/**
+	 * Queues a resource for reading and decompression.
+	 * @param volumeName	the name of the volume file holding the resource
+	 * @param dataOffset	the offset of the packed data in the volume file
+	 * @return false if the volume file could not be opened
+	 */
+	bool queue(const ResourceId &id, const ResourceSource *source, uint32 fileOffset, const Common::String &volumeName, uint32 dataOffset, ResourceCompression compression, uint32 packedSize, uint32 unpackedSize);
+
+	/**
+	 * Removes a resource from the queue and returns its decompressed data,
+	 * waiting for the worker thread if it is working on it right now.
+	 * The data is only returned if the resource is still stored at the
+	 * location it was read from. Warnings the decompressor gave are printed
+	 * now.
+	 * @return the data, allocated with new[], or NULL if the resource has not
+	 *         been queued, has not been decompressed yet or failed to
+	 *         decompress
+	 */
+	byte *take(const ResourceId &id, const ResourceSource *source, uint32 fileOffset, uint32 &size);
+
+	/**
+	 * Removes a resource from the queue, dropping its data.
+	 */
+	void cancel(const ResourceId &id);
+
+	/**
+	 * Drops the oldest queued resource the worker is not busy with.
+	 * @return false if there was nothing to drop
+	 */
+	bool evictOldest();
+
+	/**
+	 * Returns the number of bytes of decompressed data held or expected for
+	 * queued resources.
+	 */
+	uint32 getMemory() const { return _memory; }
+
+private:
+	enum JobState {
+		kJobPending,
+		kJobRunning,
+		kJobDone,
+		kJobFailed
+	};
+
+	struct Job {
+		ResourceId id;
+		const ResourceSource *source;
+		uint32 fileOffset;
+		Common::SeekableReadStream *volume;
+		uint32 dataOffset;
+		ResourceCompression compression;
+		uint32 packedSize;
+		byte *data;
+		uint32 size;
+		Common::String warnings;
+		JobState state;
+	};
+
+	typedef Common::HashMap<ResourceId, Job *, ResourceIdHash> JobMap;
+	typedef Common::HashMap<Common::String, Common::File *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> VolumeMap;
+
+	static void workerProc(void *prefetcher);
+	void runWorker();
+	void process(Job *job);
+
+	/**
+	 * Takes a job away from the worker, waiting for it to finish the job if
+	 * it is working on it.
+	 */
+	void removeJob(Job *job);
+	static void deleteJob(Job *job);
+
+	Common::Mutex _mutex; ///< Guards _pending, _waitingFor, _quit and the job states
+	JobMap _jobs; ///< Only accessed by the engine thread
+	Common::List<Job *> _queueOrder; ///< _jobs, oldest first
+	VolumeMap _volumes; ///< Opened by the engine thread, read by the worker
+	Common::List<Job *> _pending;
+	Job *_waitingFor;
+	uint32 _memory;
+	Common::Semaphore _workAvailable;
+	Common::Semaphore _jobFinished;
+	Common::Thread _worker;
+	bool _quit;
+};
+
 } // End of namespace Sci
 
 #endif // SCI_RESOURCE_INTERN_H
@@ -0,0 +1,234 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ */
+
+// Background loading of resources
+
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+#include "sci/resource.h"
+#include "sci/resource_intern.h"
+#include "sci/decompressor.h"
+
+namespace Sci {
+
+ResourcePrefetcher::ResourcePrefetcher() : _waitingFor(nullptr), _memory(0), _quit(false) {
+	// If no thread can be started, jobs stay pending and the resources are
+	// loaded normally when they are needed
+	_worker.start(workerProc, this);
+}
+
+ResourcePrefetcher::~ResourcePrefetcher() {
+	_mutex.lock();
+	_quit = true;
+	_mutex.unlock();
+	_workAvailable.post();
+	_worker.join();
+
+	for (JobMap::iterator it = _jobs.begin(); it != _jobs.end(); ++it)
+		deleteJob(it->_value);
+
+	for (VolumeMap::iterator it = _volumes.begin(); it != _volumes.end(); ++it)
+		delete it->_value;
+}
+
+bool ResourcePrefetcher::isQueued(const ResourceId &id) const {
+	return _jobs.contains(id);
+}
+
+bool ResourcePrefetcher::queue(const ResourceId &id, const ResourceSource *source, uint32 fileOffset, const Common::String &volumeName, uint32 dataOffset, ResourceCompression compression, uint32 packedSize, uint32 unpackedSize) {
+	assert(!isQueued(id));
+
+	Common::File *volume = _volumes.getVal(volumeName, nullptr);
+	if (!volume) {
+		volume = new Common::File;
+		if (!volume->open(volumeName)) {
+			delete volume;
+			return false;
+		}
+		_volumes.setVal(volumeName, volume);
+	}
+
+	Job *job = new Job;
+	job->id = id;
+	job->source = source;
+	job->fileOffset = fileOffset;
+	job->volume = volume;
+	job->dataOffset = dataOffset;
+	job->compression = compression;
+	job->packedSize = packedSize;
+	job->data = nullptr;
+	job->size = unpackedSize;
+	job->state = kJobPending;
+
+	_jobs.setVal(id, job);
+	_queueOrder.push_back(job);
+	_memory += unpackedSize;
+
+	_mutex.lock();
+	_pending.push_back(job);
+	_mutex.unlock();
+	_workAvailable.post();
+	return true;
+}
+
+byte *ResourcePrefetcher::take(const ResourceId &id, const ResourceSource *source, uint32 fileOffset, uint32 &size) {
+	Job *job = _jobs.getVal(id, nullptr);
+	if (!job)
+		return nullptr;
+
+	removeJob(job);
+
+	byte *data = nullptr;
+	// The resource may have been replaced by a patch in the meantime
+	if (job->state == kJobDone && job->source == source && job->fileOffset == fileOffset) {
+		if (!job->warnings.empty())
+			warning("Decompressing %s: %s", id.toString().c_str(), job->warnings.c_str());
+		data = job->data;
+		size = job->size;
+		job->data = nullptr;
+	} else if (job->state == kJobFailed) {
+		// Loading it again on the engine thread reports the problem
+		debugC(kDebugLevelResMan, "Prefetching %s failed", id.toString().c_str());
+	}
+
+	deleteJob(job);
+	return data;
+}
+
+void ResourcePrefetcher::cancel(const ResourceId &id) {
+	Job *job = _jobs.getVal(id, nullptr);
+	if (job) {
+		removeJob(job);
+		deleteJob(job);
+	}
+}
+
+bool ResourcePrefetcher::evictOldest() {
+	for (Common::List<Job *>::iterator it = _queueOrder.begin(); it != _queueOrder.end(); ++it) {
+		Job *job = *it;
+
+		_mutex.lock();
+		const bool busy = (job->state == kJobRunning);
+		_mutex.unlock();
+
+		if (!busy) {
+			removeJob(job);
+			deleteJob(job);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ResourcePrefetcher::removeJob(Job *job) {
+	_jobs.erase(job->id);
+	_queueOrder.remove(job);
+	_memory -= job->size;
+
+	_mutex.lock();
+	if (job->state == kJobPending)
+		_pending.remove(job);
+
+	while (job->state == kJobRunning) {
+		_waitingFor = job;
+		_mutex.unlock();
+		_jobFinished.wait();
+		_mutex.lock();
+	}
+	_waitingFor = nullptr;
+	_mutex.unlock();
+}
+
+void ResourcePrefetcher::workerProc(void *prefetcher) {
+	((ResourcePrefetcher *)prefetcher)->runWorker();
+}
+
+void ResourcePrefetcher::runWorker() {
+	for (;;) {
+		_workAvailable.wait();
+
+		_mutex.lock();
+		if (_quit) {
+			_mutex.unlock();
+			return;
+		}
+
+		// The job may have been taken away in the meantime
+		if (_pending.empty()) {
+			_mutex.unlock();
+			continue;
+		}
+
+		Job *job = _pending.front();
+		_pending.pop_front();
+		job->state = kJobRunning;
+		_mutex.unlock();
+
+		process(job);
+	}
+}
+
+void ResourcePrefetcher::process(Job *job) {
+	// Only the worker reads from the prefetcher's volume handles
+	byte *packedData = (byte *)malloc(job->packedSize);
+	bool success = packedData && job->volume->seek(job->dataOffset, SEEK_SET) &&
+		job->volume->read(packedData, job->packedSize) == job->packedSize;
+
+	byte *data = nullptr;
+	Common::String warnings;
+	if (success) {
+		Decompressor *dec = createDecompressor(job->compression);
+		data = new byte[job->size];
+		Common::MemoryReadStream stream(packedData, job->packedSize);
+		if (dec) {
+			// Warnings and errors must not be raised on this thread
+			dec->deferWarnings();
+			success = !dec->unpack(&stream, data, job->packedSize, job->size);
+			warnings = dec->getDeferredWarnings();
+		} else {
+			success = false;
+		}
+		delete dec;
+	}
+
+	free(packedData);
+	if (!success) {
+		delete[] data;
+		data = nullptr;
+	}
+
+	Common::StackLock lock(_mutex);
+	job->data = data;
+	job->warnings = warnings;
+	job->state = success ? kJobDone : kJobFailed;
+	if (_waitingFor == job)
+		_jobFinished.post();
+}
+
+void ResourcePrefetcher::deleteJob(Job *job) {
+	delete[] job->data;
+	delete job;
+}
+
+} // End of namespace Sci
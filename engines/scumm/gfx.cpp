@@ -215,6 +215,8 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
+	_stripCachePaletteMod = 0;
 }
 
 Gdi::~Gdi() {
@@ -255,6 +257,15 @@ GdiV2::~GdiV2() {
 #ifdef USE_RGB_COLOR
 GdiHE16bit::GdiHE16bit(ScummEngine *vm) : GdiHE(vm) {
 }
+
+bool GdiHE16bit::roomColorsChanged() {
+	const byte *palette = _vm->_hePalettes + 2048;
+	if (!memcmp(_stripCachePalette, palette, 512))
+		return false;
+
+	memcpy(_stripCachePalette, palette, 512);
+	return true;
+}
 #endif
 
 void Gdi::init() {
@@ -275,6 +286,22 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
+}
+
+void Gdi::clearStripCache() {
+	for (uint i = 0; i < _stripCache.size(); ++i)
+		_stripCache[i].src = 0;
+	_bmapCache.src = 0;
+}
+
+bool Gdi::roomColorsChanged() {
+	if (!memcmp(_stripCachePalette, _roomPalette, 256) && _stripCachePaletteMod == _paletteMod)
+		return false;
+
+	memcpy(_stripCachePalette, _roomPalette, 256);
+	_stripCachePaletteMod = _paletteMod;
+	return true;
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1913,6 +1940,11 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 			_roomPalette = _vm->_roomPalette;
 	}
 
+	// Only the room background is cached; object images may be stored in
+	// resources which are freed and reused while the room is shown
+	if (!_objectMode && vs->number == kMainVirtScreen)
+		return decompressCachedBitmap(dstPtr, vs->pitch, stripnr, smap_ptr + offset, height);
+
 	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
 }
 
@@ -2119,7 +2151,7 @@ void Gdi::drawBMAPBg(const byte *ptr, VirtScreen *vs) {
 	case 136:
 	case 137:
 	case 138:
-		drawStripHE(dst, vs->pitch, bmap_ptr, vs->w, vs->h, false);
+		drawCachedStripHE(dst, vs->pitch, bmap_ptr, vs->w, vs->h);
 		break;
 	case 144:
 	case 145:
@@ -2180,6 +2212,34 @@ void Gdi::drawBMAPBg(const byte *ptr, VirtScreen *vs) {
 	}
 }
 
+/**
+ * Draw an opaque BMAP room background like drawStripHE() does, from the
+ * cache if the same background was drawn before with the same colors. The
+ * transparent codes draw over the previous contents of the buffer, so they
+ * are not cached.
+ */
+void Gdi::drawCachedStripHE(byte *dst, int dstPitch, const byte *src, int width, int height) {
+	const int rowSize = width * _vm->_bytesPerPixel;
+
+	if (roomColorsChanged())
+		clearStripCache();
+
+	if (_bmapCache.src != src || _bmapCache.width != width || _bmapCache.height != height) {
+		_bmapCache.pixels.resize(rowSize * height);
+		drawStripHE(_bmapCache.pixels.begin(), rowSize, src, width, height, false);
+		_bmapCache.src = src;
+		_bmapCache.width = width;
+		_bmapCache.height = height;
+	}
+
+	const byte *cached = _bmapCache.pixels.begin();
+	for (int y = 0; y < height; ++y) {
+		memcpy(dst, cached, rowSize);
+		dst += dstPitch;
+		cached += rowSize;
+	}
+}
+
 void Gdi::drawBMAPObject(const byte *ptr, VirtScreen *vs, int obj, int x, int y, int w, int h) {
 	const byte *bmap_ptr = _vm->findResourceData(MKTAG('B','M','A','P'), ptr);
 	assert(bmap_ptr);
@@ -2427,6 +2487,51 @@ bool Gdi::decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLine
 	return transpStrip;
 }
 
+bool Gdi::decompressCachedBitmap(byte *dst, int dstPitch, int stripnr, const byte *src, int numLinesToProcess) {
+	const int stripPitch = 8 * _vm->_bytesPerPixel;
+
+	// The decompressors map colors through the room palette
+	if (roomColorsChanged())
+		clearStripCache();
+
+	if (stripnr >= (int)_stripCache.size())
+		_stripCache.resize(stripnr + 1);
+	StripCacheEntry &entry = _stripCache[stripnr];
+
+	if (entry.src == src && entry.height == numLinesToProcess) {
+		const byte *cached = entry.pixels.begin();
+		for (int y = 0; y < numLinesToProcess; ++y) {
+			memcpy(dst, cached, stripPitch);
+			dst += dstPitch;
+			cached += stripPitch;
+		}
+		// Only opaque strips are cached
+		return false;
+	}
+
+	const bool transpStrip = decompressBitmap(dst, dstPitch, src, numLinesToProcess);
+
+	// Transparent strips are drawn on top of what is already in the buffer,
+	// so they cannot be reused. The raw strips (code 149) skip the
+	// transparent color without being reported as transparent.
+	if (transpStrip || (!(_vm->_game.features & GF_16COLOR) && *src == 149)) {
+		entry.src = 0;
+		return transpStrip;
+	}
+
+	entry.src = src;
+	entry.height = numLinesToProcess;
+	entry.pixels.resize(numLinesToProcess * stripPitch);
+	byte *cached = entry.pixels.begin();
+	for (int y = 0; y < numLinesToProcess; ++y) {
+		memcpy(cached, dst, stripPitch);
+		dst += dstPitch;
+		cached += stripPitch;
+	}
+
+	return false;
+}
+
 void Gdi::decompressMaskImg(byte *dst, const byte *src, int height) const {
 	byte b, c;
 
@@ -24,6 +24,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -197,6 +198,43 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A decompressed strip of the room background, kept so that strips which
+	 * are redrawn (e.g. when scrolling back and forth) do not have to be
+	 * decompressed again.
+	 */
+	struct StripCacheEntry {
+		const byte *src;	///< The compressed strip data, or NULL if the entry is unused
+		int height;
+		Common::Array<byte> pixels;
+
+		StripCacheEntry() : src(0), height(0) {}
+	};
+
+	/** Decompressed background strips of the current room, by strip number. */
+	Common::Array<StripCacheEntry> _stripCache;
+
+	/**
+	 * The decompressed BMAP room background of HE 7.1+ games, which is
+	 * drawn as a whole on every full redraw instead of strip by strip.
+	 */
+	struct BMAPCacheEntry {
+		const byte *src;	///< The compressed BMAP data, or NULL if the entry is unused
+		int width, height;
+		Common::Array<byte> pixels;
+
+		BMAPCacheEntry() : src(0), width(0), height(0) {}
+	};
+
+	BMAPCacheEntry _bmapCache;
+
+	/**
+	 * The room colors the cached strips and background were decompressed
+	 * with: the room palette, or the 16 bit palette of HE games.
+	 */
+	byte _stripCachePalette[512];
+	byte _stripCachePaletteMod;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -208,6 +246,15 @@ public:
 protected:
 	/* Bitmap decompressors */
 	bool decompressBitmap(byte *dst, int dstPitch, const byte *src, int numLinesToProcess);
+	bool decompressCachedBitmap(byte *dst, int dstPitch, int stripnr, const byte *src, int numLinesToProcess);
+	void drawCachedStripHE(byte *dst, int dstPitch, const byte *src, int width, int height);
+	void clearStripCache();
+
+	/**
+	 * Check if the colors writeRoomColor() maps the room colors to changed
+	 * since the last call, and remember them.
+	 */
+	virtual bool roomColorsChanged();
 
 	void drawStripEGA(byte *dst, int dstPitch, const byte *src, int height) const;
 
@@ -438,6 +485,7 @@ public:
 class GdiHE16bit : public GdiHE {
 protected:
 	virtual void writeRoomColor(byte *dst, byte color) const;
+	virtual bool roomColorsChanged();
 public:
 	GdiHE16bit(ScummEngine *vm);
 };
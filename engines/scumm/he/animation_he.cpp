@@ -23,6 +23,7 @@
 #ifdef ENABLE_HE
 
 #include "common/scummsys.h"
+#include "common/config-manager.h"
 
 #include "scumm/he/animation_he.h"
 #include "scumm/he/intern_he.h"
@@ -41,9 +42,14 @@ namespace Scumm {
 
 MoviePlayer::MoviePlayer(ScummEngine_v90he *vm, Audio::Mixer *mixer) : _vm(vm) {
 #ifdef USE_BINK
-	if (_vm->_game.heversion >= 100 && (_vm->_game.features & GF_16BIT_COLOR))
-		_video = new Video::BinkDecoder();
-	else
+	if (_vm->_game.heversion >= 100 && (_vm->_game.features & GF_16BIT_COLOR)) {
+		Video::BinkDecoder *bink = new Video::BinkDecoder();
+		// Converting the frames in bands helps slow multi-core machines
+		// keep up
+		if (ConfMan.hasKey("video_threads"))
+			bink->setDecodeThreads(ConfMan.getInt("video_threads"));
+		_video = bink;
+	} else
 #endif
 		_video = new Video::SmackerDecoder();
 
@@ -192,7 +192,7 @@ void IMuseDigital::saveLoadEarly(Common::Serializer &s) {
 			} else
 				error("IMuseDigital::saveOrLoad(): Can't handle %d bit samples", bits);
 
-			track->stream = Audio::makeQueuingAudioStream(freq, (track->mixerFlags & kFlagStereo) != 0);
+			track->stream = Audio::makeLockFreeQueuingAudioStream(freq, (track->mixerFlags & kFlagStereo) != 0);
 
 			_mixer->playStream(track->getType(), &track->mixChanHandle, track->stream, -1, track->getVol(), track->getPan());
 			_mixer->pauseHandle(track->mixChanHandle, true);
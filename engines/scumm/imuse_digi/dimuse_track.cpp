@@ -165,7 +165,7 @@ void IMuseDigital::startSound(int soundId, const char *soundName, int soundType,
 			track->dataMod12Bit = otherTrack->dataMod12Bit;
 		}
 
-		track->stream = Audio::makeQueuingAudioStream(freq, track->mixerFlags & kFlagStereo);
+		track->stream = Audio::makeLockFreeQueuingAudioStream(freq, track->mixerFlags & kFlagStereo);
 		_mixer->playStream(track->getType(), &track->mixChanHandle, track->stream, -1, track->getVol(), track->getPan());
 	}
 
@@ -365,7 +365,7 @@ Track *IMuseDigital::cloneToFadeOutTrack(Track *track, int fadeDelay) {
 	fadeTrack->volFadeUsed = true;
 
 	// Create an appendable output buffer
-	fadeTrack->stream = Audio::makeQueuingAudioStream(_sound->getFreq(fadeTrack->soundDesc), track->mixerFlags & kFlagStereo);
+	fadeTrack->stream = Audio::makeLockFreeQueuingAudioStream(_sound->getFreq(fadeTrack->soundDesc), track->mixerFlags & kFlagStereo);
 	_mixer->playStream(track->getType(), &fadeTrack->mixChanHandle, fadeTrack->stream, -1, fadeTrack->getVol(), fadeTrack->getPan());
 	fadeTrack->used = true;
 
@@ -107,6 +107,7 @@ RenderedImage::RenderedImage(const Common::String &filename, bool &result) :
 	assert(pPackage);
 
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
+	_surface.setTransformCache(&_transformCache);
 
 	// Load file
 	byte *pFileData;
@@ -156,6 +157,7 @@ RenderedImage::RenderedImage(uint width, uint height, bool &result) :
 	_isTransparent(true) {
 
 	_surface.create(width, height, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	_surface.setTransformCache(&_transformCache);
 
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
@@ -169,6 +171,7 @@ RenderedImage::RenderedImage() : _isTransparent(true) {
 	_backSurface = Kernel::getInstance()->getGfx()->getSurface();
 
 	_surface.format = Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+	_surface.setTransformCache(&_transformCache);
 
 	_doCleanup = false;
 
@@ -208,6 +211,7 @@ bool RenderedImage::setContent(const byte *pixeldata, uint size, uint offset, ui
 		in += stride;
 	}
 
+	_transformCache.clear();
 	return true;
 }
 
@@ -216,6 +220,7 @@ void RenderedImage::replaceContent(byte *pixeldata, int width, int height) {
 	_surface.h = height;
 	_surface.pitch = width * 4;
 	_surface.setPixels(pixeldata);
+	_transformCache.clear();
 }
 // -----------------------------------------------------------------------------
 
@@ -113,6 +113,8 @@ public:
 
 private:
 	Graphics::TransparentSurface _surface;
+	/** The scaled versions of the image drawn last. */
+	Graphics::TransformCache _transformCache;
 	bool _doCleanup;
 	bool _isTransparent;
 
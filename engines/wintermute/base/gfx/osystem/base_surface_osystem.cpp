@@ -148,6 +148,7 @@ bool BaseSurfaceOSystem::finishLoad() {
 
 	_surface->free();
 	delete _surface;
+	_transformCache.clear();
 
 	bool needsColorKey = false;
 	bool replaceAlpha = true;
@@ -317,6 +318,7 @@ bool BaseSurfaceOSystem::startPixelOp() {
 	// Any pixel-op makes the caching useless:
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
+	_transformCache.clear();
 	return STATUS_OK;
 }
 
@@ -458,6 +460,7 @@ bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAl
 	}
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
+	_transformCache.clear();
 
 	return STATUS_OK;
 }
@@ -83,8 +83,10 @@ public:
 	}
 
 	Graphics::AlphaType getAlphaType() const { return _alphaType; }
+	Graphics::TransformCache &getTransformCache() { return _transformCache; }
 private:
 	Graphics::Surface *_surface;
+	Graphics::TransformCache _transformCache;
 	bool _loaded;
 	bool finishLoad();
 	bool drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect, Graphics::TransformStruct transformStruct);
@@ -43,14 +43,9 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	_wantsDraw(true),
 	_transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
-		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
-		}
-		// Then scale it if necessary
+		assert(surf->format.bytesPerPixel == 4);
+		// Scale it if necessary, reusing the result of drawing the same part
+		// of the surface with the same transform before
 		//
 		// NB: The numTimesX/numTimesY properties don't yet mix well with
 		// scaling and rotation, but there is no need for that functionality at
@@ -58,41 +53,26 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// NB: Mirroring and rotation are probably done in the wrong order.
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
-		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.rotoscaleT<Graphics::FILTER_BILINEAR>(transform);
-			} else {
-				temp = src.rotoscaleT<Graphics::FILTER_NEAREST>(transform);
-			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
-		} else if ((dstRect->width() != srcRect->width() ||
-					dstRect->height() != srcRect->height()) &&
-					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::TransparentSurface src(*_surface, false);
-			Graphics::Surface *temp;
-			if (owner->_gameRef->getBilinearFiltering()) {
-				temp = src.scaleT<Graphics::FILTER_BILINEAR>(dstRect->width(), dstRect->height());
-			} else {
-				temp = src.scaleT<Graphics::FILTER_NEAREST>(dstRect->width(), dstRect->height());
+		if (_transform._angle != Graphics::kDefaultAngle ||
+				((dstRect->width() != srcRect->width() ||
+				  dstRect->height() != srcRect->height()) &&
+				 _transform._numTimesX * _transform._numTimesY == 1)) {
+			Graphics::TFilteringMode filteringMode = owner->_gameRef->getBilinearFiltering() ? Graphics::FILTER_BILINEAR : Graphics::FILTER_NEAREST;
+			_surface = owner->getTransformCache().getTransformed(*surf, *srcRect, transform,
+				(uint16)dstRect->width(), (uint16)dstRect->height(), filteringMode);
+		} else {
+			// Get a clipped copy of the surface
+			Graphics::Surface *clipped = new Graphics::Surface();
+			clipped->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+			for (int i = 0; i < clipped->h; i++) {
+				memcpy(clipped->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * clipped->format.bytesPerPixel);
 			}
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			_surface = Common::SharedPtr<const Graphics::Surface>(clipped, Graphics::SurfaceDeleter());
 		}
-	} else {
-		_surface = nullptr;
 	}
 }
 
 RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
-	}
 }
 
 bool RenderTicket::operator==(const RenderTicket &t) const {
@@ -32,6 +32,7 @@
 #include "graphics/transparent_surface.h"
 #include "graphics/surface.h"
 #include "common/rect.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 
@@ -45,6 +46,8 @@ class BaseSurfaceOSystem;
  * skip drawing the same region again, unless anything has changed. Since a surface
  * can have a potentially large amount of draw-calls made to it, at varying rotation,
  * zoom, and crop-levels we also need to hold a copy of the necessary data.
+ * Transformed parts are shared with the TransformCache of the surface rather
+ * than copied, as the cache never changes an image it handed out.
  * (Video-surfaces may even change their data). The promise that is made when a ticket
  * is created is that what the state was of the surface at THAT point, is what will end
  * up on screen at flip() time.
@@ -54,7 +57,7 @@ public:
 	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
 	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
 	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	const Graphics::Surface *getSurface() const { return _surface.get(); }
 	// Non-dirty-rects:
 	void drawToSurface(Graphics::Surface *_targetSurface) const;
 	// Dirty-rects:
@@ -71,7 +74,7 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
-	Graphics::Surface *_surface;
+	Common::SharedPtr<const Graphics::Surface> _surface;
 	Common::Rect _srcRect;
 };
 
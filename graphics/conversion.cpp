@@ -24,6 +24,7 @@
 #include "graphics/pixelformat.h"
 
 #include "common/endian.h"
+#include "common/simd.h"
 
 namespace Graphics {
 
@@ -96,6 +97,56 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+template<typename Color>
+void keyBlitLogic(byte *dst, const byte *src, const uint w, const uint h,
+                  const uint dstPitch, const uint srcPitch, const Color key) {
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	// Each vector holds 16 bytes of pixels. The destination is kept where
+	// the source equals the key.
+	const uint vectorPixels = 16 / sizeof(Color);
+#if defined(SCUMMVM_SSE2)
+	const __m128i keyVector = sizeof(Color) == 1 ? _mm_set1_epi8((char)key) :
+		sizeof(Color) == 2 ? _mm_set1_epi16((short)key) : _mm_set1_epi32((int)key);
+#else
+	const uint8x16_t keyVector = sizeof(Color) == 1 ? vdupq_n_u8(key) :
+		sizeof(Color) == 2 ? vreinterpretq_u8_u16(vdupq_n_u16(key)) : vreinterpretq_u8_u32(vdupq_n_u32(key));
+#endif
+#endif
+
+	for (uint y = 0; y < h; ++y) {
+		uint x = 0;
+
+#if defined(SCUMMVM_SSE2)
+		for (; x + vectorPixels <= w; x += vectorPixels) {
+			const __m128i srcPixels = _mm_loadu_si128((const __m128i *)(src + x * sizeof(Color)));
+			const __m128i dstPixels = _mm_loadu_si128((const __m128i *)(dst + x * sizeof(Color)));
+			const __m128i transparent = sizeof(Color) == 1 ? _mm_cmpeq_epi8(srcPixels, keyVector) :
+				sizeof(Color) == 2 ? _mm_cmpeq_epi16(srcPixels, keyVector) : _mm_cmpeq_epi32(srcPixels, keyVector);
+			_mm_storeu_si128((__m128i *)(dst + x * sizeof(Color)),
+				_mm_or_si128(_mm_and_si128(transparent, dstPixels), _mm_andnot_si128(transparent, srcPixels)));
+		}
+#elif defined(SCUMMVM_NEON)
+		for (; x + vectorPixels <= w; x += vectorPixels) {
+			const uint8x16_t srcPixels = vld1q_u8(src + x * sizeof(Color));
+			const uint8x16_t dstPixels = vld1q_u8(dst + x * sizeof(Color));
+			const uint8x16_t transparent = sizeof(Color) == 1 ? vceqq_u8(srcPixels, keyVector) :
+				sizeof(Color) == 2 ? vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(srcPixels), vreinterpretq_u16_u8(keyVector))) :
+				vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(srcPixels), vreinterpretq_u32_u8(keyVector)));
+			vst1q_u8(dst + x * sizeof(Color), vbslq_u8(transparent, dstPixels, srcPixels));
+		}
+#endif
+
+		for (; x < w; ++x) {
+			const Color color = ((const Color *)src)[x];
+			if (color != key)
+				((Color *)dst)[x] = color;
+		}
+
+		src += srcPitch;
+		dst += dstPitch;
+	}
+}
+
 } // End of anonymous namespace
 
 // Function to blit a rect from one color format to another
@@ -167,4 +218,23 @@ bool crossBlit(byte *dst, const byte *src,
 	return true;
 }
 
+bool keyBlit(byte *dst, const byte *src,
+             const uint dstPitch, const uint srcPitch,
+             const uint w, const uint h,
+             const uint bytesPerPixel, const uint32 key) {
+	switch (bytesPerPixel) {
+	case 1:
+		keyBlitLogic<uint8>(dst, src, w, h, dstPitch, srcPitch, (uint8)key);
+		return true;
+	case 2:
+		keyBlitLogic<uint16>(dst, src, w, h, dstPitch, srcPitch, (uint16)key);
+		return true;
+	case 4:
+		keyBlitLogic<uint32>(dst, src, w, h, dstPitch, srcPitch, key);
+		return true;
+	default:
+		return false;
+	}
+}
+
 } // End of namespace Graphics
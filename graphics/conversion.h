@@ -72,6 +72,28 @@ bool crossBlit(byte *dst, const byte *src,
                const uint w, const uint h,
                const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt);
 
+/**
+ * Blits a rectangle, skipping all pixels of the source which have the given
+ * color key. Source and destination have the same pixel format.
+ *
+ * @param dst		the buffer which will recieve the graphics data
+ * @param src		the buffer containing the original graphics data
+ * @param dstPitch	width in bytes of one full line of the dest buffer
+ * @param srcPitch	width in bytes of one full line of the source buffer
+ * @param w			the width of the graphics data
+ * @param h			the height of the graphics data
+ * @param bytesPerPixel	the number of bytes per pixel, 1, 2 or 4
+ * @param key		the color of the transparent pixels
+ * @return			true if the blit completes successfully,
+ *					false if the bytes per pixel are not supported.
+ *
+ * @note The buffers must not overlap.
+ */
+bool keyBlit(byte *dst, const byte *src,
+             const uint dstPitch, const uint srcPitch,
+             const uint w, const uint h,
+             const uint bytesPerPixel, const uint32 key);
+
 } // End of namespace Graphics
 
 #endif // GRAPHICS_CONVERSION_H
@@ -21,6 +21,7 @@
  */
 
 #include "graphics/managed_surface.h"
+#include "graphics/conversion.h"
 #include "common/algorithm.h"
 #include "common/textconsole.h"
 
@@ -181,14 +182,25 @@ void ManagedSurface::blitFrom(const Surface &src, const Common::Rect &srcRect,
 		assert(src.format.bytesPerPixel == 2 || src.format.bytesPerPixel == 4);
 	}
 
-	for (int y = 0; y < srcBounds.height(); ++y) {
-		const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top + y);
-		byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top + y);
+	if (src.format == format) {
+		// Matching surface formats, so we can do a straight copy
+		const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top);
+		byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top);
+		const uint rowSize = srcBounds.width() * format.bytesPerPixel;
+
+		for (int y = 0; y < srcBounds.height(); ++y, srcP += src.pitch, destP += pitch)
+			memmove(destP, srcP, rowSize);
+	} else if (src.format.aBits() == 0) {
+		// Without an alpha channel, all source pixels are opaque, so they
+		// only have to be converted
+		crossBlit((byte *)getBasePtr(destBounds.left, destBounds.top),
+			(const byte *)src.getBasePtr(srcBounds.left, srcBounds.top), pitch, src.pitch,
+			srcBounds.width(), srcBounds.height(), format, src.format);
+	} else {
+		for (int y = 0; y < srcBounds.height(); ++y) {
+			const byte *srcP = (const byte *)src.getBasePtr(srcBounds.left, srcBounds.top + y);
+			byte *destP = (byte *)getBasePtr(destBounds.left, destBounds.top + y);
 
-		if (src.format == format) {
-			// Matching surface formats, so we can do a straight copy
-			Common::copy(srcP, srcP + srcBounds.width() * format.bytesPerPixel, destP);
-		} else {
 			for (int x = 0; x < srcBounds.width(); ++x,
 					srcP += src.format.bytesPerPixel,
 					destP += format.bytesPerPixel) {
@@ -239,7 +251,7 @@ void ManagedSurface::transBlitFrom(const Surface &src, const Common::Point &dest
 void ManagedSurface::transBlitFrom(const Surface &src, const Common::Rect &srcRect,
 		const Common::Point &destPos, uint transColor, bool flipped, uint overrideColor) {
 	transBlitFrom(src, srcRect, Common::Rect(destPos.x, destPos.y,
-		destPos.x + src.w, destPos.y + src.h), transColor, false, overrideColor);
+		destPos.x + srcRect.width(), destPos.y + srcRect.height()), transColor, false, overrideColor);
 }
 
 template<typename TSRC, typename TDEST>
@@ -308,6 +320,22 @@ void ManagedSurface::transBlitFrom(const Surface &src, const Common::Rect &srcRe
 	if (src.w == 0 || src.h == 0 || destRect.width() == 0 || destRect.height() == 0)
 		return;
 
+	if (src.format == format && !flipped && !overrideColor && format.bytesPerPixel != 3
+			&& srcRect.width() == destRect.width() && srcRect.height() == destRect.height()) {
+		// Unscaled blit in the same format, which only has to skip the
+		// transparent pixels
+		Common::Rect srcBounds = srcRect;
+		Common::Rect destBounds = destRect;
+		if (clip(srcBounds, destBounds)) {
+			keyBlit((byte *)getBasePtr(destBounds.left, destBounds.top),
+				(const byte *)src.getBasePtr(srcBounds.left, srcBounds.top), pitch, src.pitch,
+				destBounds.width(), destBounds.height(), format.bytesPerPixel, transColor);
+		}
+
+		addDirtyRect(destRect);
+		return;
+	}
+
 	HANDLE_BLIT(1, 1, byte, byte)
 	HANDLE_BLIT(2, 2, uint16, uint16)
 	HANDLE_BLIT(4, 4, uint32, uint32)
@@ -20,8 +20,10 @@
  *
  */
 
+#include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 #include "graphics/scaler/scalebit.h"
+#include "common/simd.h"
 #include "common/util.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -116,9 +118,146 @@ void InitLUT(Graphics::PixelFormat format) {
 
 	hqx_green_redBlue_Mask = (hqx_greenMask << 16) | hqx_redBlueMask;
 #endif
+
+#ifdef USE_HQ_PATTERN_ROWS
+	InitHQ2xRules();
+	InitHQ3xRules();
+#endif
+}
+
+#ifdef USE_HQ_PATTERN_ROWS
+HQPatternRows::HQPatternRows(const uint16 *src, uint32 pitch, int width) : _src(src), _pitch(pitch), _width(width) {
+	// One allocation for the three rows of YUV values and the keys
+	_buffer = (uint32 *)malloc((3 * (width + 2)) * sizeof(uint32) + width * sizeof(uint16));
+	if (!_buffer)
+		error("[HQPatternRows] Cannot allocate memory for %d pixels", width);
+
+	_yuv[0] = _buffer;
+	_yuv[1] = _yuv[0] + width + 2;
+	_yuv[2] = _yuv[1] + width + 2;
+	_keys = (uint16 *)(_yuv[2] + width + 2);
+
+	convertRow(src - pitch, _yuv[1]);
+	convertRow(src, _yuv[2]);
+}
+
+HQPatternRows::~HQPatternRows() {
+	free(_buffer);
+}
+
+void HQPatternRows::convertRow(const uint16 *src, uint32 *yuv) const {
+	for (int x = -1; x <= _width; x++)
+		*yuv++ = RGBtoYUV[src[x]];
+}
+
+#if defined(SCUMMVM_SSE2)
+/**
+ * Get bit in each of the four pixels of center which differ from the one in
+ * other, like diffYUV() does. As no Y, U or V value is larger than 0xFF, the
+ * differences of all channels are found at once with saturated subtractions.
+ */
+static inline __m128i diffYUVBit(__m128i center, const uint32 *other, __m128i threshold, int bit) {
+	const __m128i yuv = _mm_loadu_si128((const __m128i *)other);
+	const __m128i diff = _mm_or_si128(_mm_subs_epu8(center, yuv), _mm_subs_epu8(yuv, center));
+	const __m128i same = _mm_cmpeq_epi32(_mm_subs_epu8(diff, threshold), _mm_setzero_si128());
+	return _mm_andnot_si128(same, _mm_set1_epi32(bit));
+}
+#elif defined(SCUMMVM_NEON)
+static inline uint32x4_t diffYUVBit(uint32x4_t center, const uint32 *other, uint8x16_t threshold, uint32 bit) {
+	const uint8x16_t yuv = vreinterpretq_u8_u32(vld1q_u32(other));
+	const uint32x4_t greater = vreinterpretq_u32_u8(vcgtq_u8(vabdq_u8(vreinterpretq_u8_u32(center), yuv), threshold));
+	return vandq_u32(vtstq_u32(greater, greater), vdupq_n_u32(bit));
 }
 #endif
 
+const uint16 *HQPatternRows::nextRow() {
+	uint32 *yuv = _yuv[0];
+	_yuv[0] = _yuv[1];
+	_yuv[1] = _yuv[2];
+	_yuv[2] = yuv;
+
+	_src += _pitch;
+	convertRow(_src, _yuv[2]);
+
+	// The center pixels are at index x + 1 of the current row
+	const uint32 *above = _yuv[0];
+	const uint32 *row = _yuv[1];
+	const uint32 *below = _yuv[2];
+	int x = 0;
+
+	// The thresholds of diffYUV() for the V, U and Y bytes. The unused top
+	// byte never differs.
+	const uint32 thresholds = 0xFF300706;
+
+#if defined(SCUMMVM_SSE2)
+	const __m128i threshold = _mm_set1_epi32(thresholds);
+	for (; x + 4 <= _width; x += 4) {
+		const __m128i center = _mm_loadu_si128((const __m128i *)(row + x + 1));
+		__m128i key = diffYUVBit(center, above + x, threshold, 0x01);
+		key = _mm_or_si128(key, diffYUVBit(center, above + x + 1, threshold, 0x02));
+		key = _mm_or_si128(key, diffYUVBit(center, above + x + 2, threshold, 0x04));
+		key = _mm_or_si128(key, diffYUVBit(center, row + x, threshold, 0x08));
+		key = _mm_or_si128(key, diffYUVBit(center, row + x + 2, threshold, 0x10));
+		key = _mm_or_si128(key, diffYUVBit(center, below + x, threshold, 0x20));
+		key = _mm_or_si128(key, diffYUVBit(center, below + x + 1, threshold, 0x40));
+		key = _mm_or_si128(key, diffYUVBit(center, below + x + 2, threshold, 0x80));
+
+		const __m128i w2 = _mm_loadu_si128((const __m128i *)(above + x + 1));
+		const __m128i w8 = _mm_loadu_si128((const __m128i *)(below + x + 1));
+		key = _mm_or_si128(key, diffYUVBit(w2, row + x, threshold, kDiff42));
+		key = _mm_or_si128(key, diffYUVBit(w2, row + x + 2, threshold, kDiff26));
+		key = _mm_or_si128(key, diffYUVBit(w8, row + x, threshold, kDiff84));
+		key = _mm_or_si128(key, diffYUVBit(w8, row + x + 2, threshold, kDiff68));
+
+		_mm_storel_epi64((__m128i *)(_keys + x), _mm_packs_epi32(key, key));
+	}
+#elif defined(SCUMMVM_NEON)
+	const uint8x16_t threshold = vreinterpretq_u8_u32(vdupq_n_u32(thresholds));
+	for (; x + 4 <= _width; x += 4) {
+		const uint32x4_t center = vld1q_u32(row + x + 1);
+		uint32x4_t key = diffYUVBit(center, above + x, threshold, 0x01);
+		key = vorrq_u32(key, diffYUVBit(center, above + x + 1, threshold, 0x02));
+		key = vorrq_u32(key, diffYUVBit(center, above + x + 2, threshold, 0x04));
+		key = vorrq_u32(key, diffYUVBit(center, row + x, threshold, 0x08));
+		key = vorrq_u32(key, diffYUVBit(center, row + x + 2, threshold, 0x10));
+		key = vorrq_u32(key, diffYUVBit(center, below + x, threshold, 0x20));
+		key = vorrq_u32(key, diffYUVBit(center, below + x + 1, threshold, 0x40));
+		key = vorrq_u32(key, diffYUVBit(center, below + x + 2, threshold, 0x80));
+
+		const uint32x4_t w2 = vld1q_u32(above + x + 1);
+		const uint32x4_t w8 = vld1q_u32(below + x + 1);
+		key = vorrq_u32(key, diffYUVBit(w2, row + x, threshold, kDiff42));
+		key = vorrq_u32(key, diffYUVBit(w2, row + x + 2, threshold, kDiff26));
+		key = vorrq_u32(key, diffYUVBit(w8, row + x, threshold, kDiff84));
+		key = vorrq_u32(key, diffYUVBit(w8, row + x + 2, threshold, kDiff68));
+
+		vst1_u16(_keys + x, vmovn_u32(key));
+	}
+#endif
+
+	for (; x < _width; x++) {
+		const int yuv5 = row[x + 1];
+		int key = 0;
+		if (diffYUV(yuv5, above[x])) key |= 0x0001;
+		if (diffYUV(yuv5, above[x + 1])) key |= 0x0002;
+		if (diffYUV(yuv5, above[x + 2])) key |= 0x0004;
+		if (diffYUV(yuv5, row[x])) key |= 0x0008;
+		if (diffYUV(yuv5, row[x + 2])) key |= 0x0010;
+		if (diffYUV(yuv5, below[x])) key |= 0x0020;
+		if (diffYUV(yuv5, below[x + 1])) key |= 0x0040;
+		if (diffYUV(yuv5, below[x + 2])) key |= 0x0080;
+		if (diffYUV(row[x], above[x + 1])) key |= kDiff42;
+		if (diffYUV(above[x + 1], row[x + 2])) key |= kDiff26;
+		if (diffYUV(below[x + 1], row[x])) key |= kDiff84;
+		if (diffYUV(row[x + 2], below[x + 1])) key |= kDiff68;
+		_keys[x] = key;
+	}
+
+	return _keys;
+}
+#endif // USE_HQ_PATTERN_ROWS
+#endif
+
 
 /** Lookup table for the DotMatrix scaler. */
 uint16 g_dotmatrix[16] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
@@ -178,6 +317,127 @@ void Normal1x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPit
 	}
 }
 
+BandedScaler::BandedScaler() : _threads(1), _bandCount(1) {
+}
+
+void BandedScaler::setThreads(uint threads) {
+	_threads = _workers.setThreads(CLIP<uint>(threads, 1, kMaxThreads));
+}
+
+void BandedScaler::add(ScalerProc *scaler, const uint8 *srcPtr, uint32 srcPitch,
+		uint8 *dstPtr, uint32 dstPitch, int width, int height, int scaleFactor) {
+	if (width <= 0 || height <= 0)
+		return;
+
+	Area area;
+	area.scaler = scaler;
+	area.srcPtr = srcPtr;
+	area.srcPitch = srcPitch;
+	area.dstPtr = dstPtr;
+	area.dstPitch = dstPitch;
+	area.width = width;
+	area.height = height;
+	area.scaleFactor = scaleFactor;
+
+	for (uint i = 0; i < _areas.size(); i++) {
+		if (overlaps(_areas[i], area)) {
+			run();
+			break;
+		}
+	}
+
+	_areas.push_back(area);
+}
+
+void BandedScaler::run() {
+	if (_areas.empty())
+		return;
+
+	uint bandCount = _threads;
+
+	bool split = false;
+	for (uint i = 0; i < _areas.size() && bandCount > 1; i++) {
+		if (!isReentrant(_areas[i].scaler))
+			bandCount = 1;
+		else if (_areas[i].height >= (int)(kMinBandHeight * bandCount))
+			split = true;
+	}
+
+	// Without an area to split, each thread gets whole areas
+	if (!split)
+		bandCount = MIN<uint>(bandCount, _areas.size());
+
+	_bandCount = bandCount;
+	_workers.run(scaleBand, this, bandCount);
+
+	_areas.clear();
+}
+
+void BandedScaler::scaleBand(void *scaler, uint band) {
+	const BandedScaler *owner = (const BandedScaler *)scaler;
+	const Common::Array<Area> &areas = owner->_areas;
+	const uint count = owner->_bandCount;
+
+	for (uint i = 0; i < areas.size(); i++) {
+		const Area &area = areas[i];
+
+		// Small areas are not worth splitting, they are handed out to the
+		// threads in turn instead.
+		if (area.height < (int)(kMinBandHeight * count)) {
+			if (i % count == band)
+				area.scaler(area.srcPtr, area.srcPitch, area.dstPtr, area.dstPitch, area.width, area.height);
+			continue;
+		}
+
+		// The bands start at even rows, which keeps the pattern of the
+		// DotMatrix scaler in place.
+		const int pairs = area.height / 2;
+		const int top = pairs * band / count * 2;
+		const int bottom = (band + 1 == count) ? area.height : pairs * (band + 1) / count * 2;
+
+		area.scaler(area.srcPtr + top * area.srcPitch, area.srcPitch,
+			area.dstPtr + top * area.scaleFactor * area.dstPitch, area.dstPitch,
+			area.width, bottom - top);
+	}
+}
+
+bool BandedScaler::overlaps(const Area &a, const Area &b) {
+	// Without a common pitch the areas can't be compared
+	if (a.dstPitch != b.dstPitch)
+		return true;
+
+	const int pitch = a.dstPitch;
+	const int aBytes = a.width * a.scaleFactor * sizeof(uint16);
+	const int bBytes = b.width * b.scaleFactor * sizeof(uint16);
+	const int aRows = a.height * a.scaleFactor;
+	const int bRows = b.height * b.scaleFactor;
+
+	// Offset of b from a in rows and bytes. The column of b can be left
+	// or right of the one of a, which gives two candidates.
+	const int offset = b.dstPtr - a.dstPtr;
+	int row = offset / pitch;
+	int column = offset % pitch;
+	if (column < 0) {
+		row--;
+		column += pitch;
+	}
+
+	for (int i = 0; i < 2; i++, row++, column -= pitch) {
+		if (row < aRows && row + bRows > 0 && column < aBytes && column + bBytes > 0)
+			return true;
+	}
+	return false;
+}
+
+bool BandedScaler::isReentrant(ScalerProc *scaler) {
+#if defined(USE_HQ_SCALERS) && defined(USE_NASM)
+	// The assembly versions keep their state in global variables
+	if (scaler == HQ2x || scaler == HQ3x)
+		return false;
+#endif
+	return true;
+}
+
 #ifdef USE_SCALERS
 
 
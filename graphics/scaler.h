@@ -24,6 +24,9 @@
 #define GRAPHICS_SCALER_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/thread.h"
 #include "graphics/surface.h"
 
 extern void InitScalers(uint32 BitFormat);
@@ -62,6 +65,86 @@ DECLARE_SCALER(HQ3x);
 
 #endif // #ifdef USE_SCALERS
 
+/**
+ * Runs scalers on several threads, by splitting the areas to scale into
+ * horizontal bands.
+ *
+ * The areas are queued with add() and scaled with run(). Each thread scales
+ * its band of every queued area. The threads are started by setThreads()
+ * and wait for the next run() in between, so scaling does not start or join
+ * threads per frame. Scalers like HQ2x or AdvMame read the row above and
+ * below the rows they scale. As the bands share the same source, which is
+ * not written while scaling, these rows hold the same pixels as for a single
+ * call, and the result is identical to scaling each area at once.
+ *
+ * Without thread support, or with a single thread, run() simply calls the
+ * scalers on the calling thread.
+ */
+class BandedScaler : Common::NonCopyable {
+public:
+	enum {
+		kMaxThreads = 4
+	};
+
+	BandedScaler();
+
+	/**
+	 * Set the number of threads scaling, including the calling thread, and
+	 * start the threads needed.
+	 */
+	void setThreads(uint threads);
+	uint getThreads() const { return _threads; }
+
+	/**
+	 * Queue an area to be scaled by the next run().
+	 *
+	 * The parameters are the ones passed to the scaler, with scaleFactor
+	 * being the number of destination rows written for each source row.
+	 *
+	 * When the destination of the area overlaps the one of a queued area,
+	 * the queue is run first. This keeps the order of the writes, which
+	 * matters for scalers like DotMatrix, whose pattern starts at the
+	 * corner of each area.
+	 */
+	void add(ScalerProc *scaler, const uint8 *srcPtr, uint32 srcPitch,
+			uint8 *dstPtr, uint32 dstPitch, int width, int height, int scaleFactor);
+
+	/**
+	 * Scale all queued areas and clear the queue.
+	 */
+	void run();
+
+private:
+	enum {
+		/** Areas with less source rows per thread are not split. */
+		kMinBandHeight = 8
+	};
+
+	struct Area {
+		ScalerProc *scaler;
+		const uint8 *srcPtr;
+		uint32 srcPitch;
+		uint8 *dstPtr;
+		uint32 dstPitch;
+		int width, height;
+		int scaleFactor;
+	};
+
+	uint _threads;
+	uint _bandCount;
+	Common::Array<Area> _areas;
+	Common::WorkerPool _workers;
+
+	/** WorkerPool task scaling a single band of all areas. */
+	static void scaleBand(void *scaler, uint band);
+
+	/** Whether the destinations of two areas share any pixels. */
+	static bool overlaps(const Area &a, const Area &b);
+
+	/** Whether the scaler can be called from several threads at once. */
+	static bool isReentrant(ScalerProc *scaler);
+};
+
 // creates a 160x100 thumbnail for 320x200 games
 // and 160x120 thumbnail for 320x240 and 640x480 games
 // only 565 mode
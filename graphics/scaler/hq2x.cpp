@@ -41,6 +41,65 @@ void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 
 #else
 
+#ifdef USE_HQ_PATTERN_ROWS
+
+// The cases store the rule of each output pixel, see HQInterpolator
+#define PIXEL00_0	*(q) = HQ_RULE(0, 0, 0);
+#define PIXEL00_10	*(q) = HQ_RULE(0, 0, 4);
+#define PIXEL00_11	*(q) = HQ_RULE(0, 4, 0);
+#define PIXEL00_12	*(q) = HQ_RULE(4, 0, 0);
+#define PIXEL00_20	*(q) = HQ_RULE(4, 4, 0);
+#define PIXEL00_21	*(q) = HQ_RULE(4, 0, 4);
+#define PIXEL00_22	*(q) = HQ_RULE(0, 4, 4);
+#define PIXEL00_60	*(q) = HQ_RULE(4, 2, 0);
+#define PIXEL00_61	*(q) = HQ_RULE(2, 4, 0);
+#define PIXEL00_70	*(q) = HQ_RULE(2, 2, 0);
+#define PIXEL00_90	*(q) = HQ_RULE(6, 6, 0) | HQ_RULE_MASKED;
+#define PIXEL00_100	*(q) = HQ_RULE(1, 1, 0) | HQ_RULE_MASKED;
+
+#define PIXEL01_0	*(q+1) = HQ_RULE(0, 0, 0);
+#define PIXEL01_10	*(q+1) = HQ_RULE(0, 0, 4);
+#define PIXEL01_11	*(q+1) = HQ_RULE(4, 0, 0);
+#define PIXEL01_12	*(q+1) = HQ_RULE(0, 4, 0);
+#define PIXEL01_20	*(q+1) = HQ_RULE(4, 4, 0);
+#define PIXEL01_21	*(q+1) = HQ_RULE(0, 4, 4);
+#define PIXEL01_22	*(q+1) = HQ_RULE(4, 0, 4);
+#define PIXEL01_60	*(q+1) = HQ_RULE(2, 4, 0);
+#define PIXEL01_61	*(q+1) = HQ_RULE(4, 2, 0);
+#define PIXEL01_70	*(q+1) = HQ_RULE(2, 2, 0);
+#define PIXEL01_90	*(q+1) = HQ_RULE(6, 6, 0) | HQ_RULE_MASKED;
+#define PIXEL01_100	*(q+1) = HQ_RULE(1, 1, 0) | HQ_RULE_MASKED;
+
+#define PIXEL10_0	*(q+nextlineDst) = HQ_RULE(0, 0, 0);
+#define PIXEL10_10	*(q+nextlineDst) = HQ_RULE(0, 0, 4);
+#define PIXEL10_11	*(q+nextlineDst) = HQ_RULE(4, 0, 0);
+#define PIXEL10_12	*(q+nextlineDst) = HQ_RULE(0, 4, 0);
+#define PIXEL10_20	*(q+nextlineDst) = HQ_RULE(4, 4, 0);
+#define PIXEL10_21	*(q+nextlineDst) = HQ_RULE(0, 4, 4);
+#define PIXEL10_22	*(q+nextlineDst) = HQ_RULE(4, 0, 4);
+#define PIXEL10_60	*(q+nextlineDst) = HQ_RULE(2, 4, 0);
+#define PIXEL10_61	*(q+nextlineDst) = HQ_RULE(4, 2, 0);
+#define PIXEL10_70	*(q+nextlineDst) = HQ_RULE(2, 2, 0);
+#define PIXEL10_90	*(q+nextlineDst) = HQ_RULE(6, 6, 0) | HQ_RULE_MASKED;
+#define PIXEL10_100	*(q+nextlineDst) = HQ_RULE(1, 1, 0) | HQ_RULE_MASKED;
+
+#define PIXEL11_0	*(q+1+nextlineDst) = HQ_RULE(0, 0, 0);
+#define PIXEL11_10	*(q+1+nextlineDst) = HQ_RULE(0, 0, 4);
+#define PIXEL11_11	*(q+1+nextlineDst) = HQ_RULE(0, 4, 0);
+#define PIXEL11_12	*(q+1+nextlineDst) = HQ_RULE(4, 0, 0);
+#define PIXEL11_20	*(q+1+nextlineDst) = HQ_RULE(4, 4, 0);
+#define PIXEL11_21	*(q+1+nextlineDst) = HQ_RULE(4, 0, 4);
+#define PIXEL11_22	*(q+1+nextlineDst) = HQ_RULE(0, 4, 4);
+#define PIXEL11_60	*(q+1+nextlineDst) = HQ_RULE(4, 2, 0);
+#define PIXEL11_61	*(q+1+nextlineDst) = HQ_RULE(2, 4, 0);
+#define PIXEL11_70	*(q+1+nextlineDst) = HQ_RULE(2, 2, 0);
+#define PIXEL11_90	*(q+1+nextlineDst) = HQ_RULE(6, 6, 0) | HQ_RULE_MASKED;
+#define PIXEL11_100	*(q+1+nextlineDst) = HQ_RULE(1, 1, 0) | HQ_RULE_MASKED;
+
+#define DIFF(a, b)	(key & HQPatternRows::kDiff ## a ## b)
+
+#else
+
 #define PIXEL00_0	*(q) = w5;
 #define PIXEL00_10	*(q) = interpolate16_3_1<ColorMask >(w5, w1);
 #define PIXEL00_11	*(q) = interpolate16_3_1<ColorMask >(w5, w4);
@@ -95,6 +154,26 @@ void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 
 extern "C" uint32   *RGBtoYUV;
 #define YUV(x)	RGBtoYUV[w ## x]
+#define DIFF(a, b)	diffYUV(YUV(a), YUV(b))
+
+#endif
+
+#ifdef USE_HQ_PATTERN_ROWS
+
+static uint16 hq2xRules[4 * HQPatternRows::kKeys];
+
+/**
+ * Store the rules of the HQ2x output pixels for every key of HQPatternRows.
+ */
+void InitHQ2xRules() {
+	const uint32 nextlineDst = 2;
+	for (int conditions = 0; conditions < HQPatternRows::kKeys >> 8; conditions++) {
+		for (int pattern = 0; pattern < 256; pattern++) {
+			const int key = conditions << 8 | pattern;
+			uint16 rules[4];
+			uint16 *q = rules;
+
+#else
 
 /*
  * The HQ2x high quality 2x graphics filter.
@@ -149,6 +228,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
 			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
 			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+#endif
 
 			switch (pattern) {
 			case 0:
@@ -283,7 +363,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 18:
 			case 50:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_20
@@ -296,7 +376,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_20
 				PIXEL01_22
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_20
@@ -306,7 +386,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 76:
 				PIXEL00_21
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_20
@@ -315,7 +395,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 10:
 			case 138:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_20
@@ -371,7 +451,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 22:
 			case 54:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -384,7 +464,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_20
 				PIXEL01_22
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -394,7 +474,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 108:
 				PIXEL00_21
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -403,7 +483,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 11:
 			case 139:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
@@ -414,7 +494,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 19:
 			case 51:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_11
 					PIXEL01_10
 				} else {
@@ -427,7 +507,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 146:
 			case 178:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 					PIXEL11_12
 				} else {
@@ -439,7 +519,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 84:
 			case 85:
 				PIXEL00_20
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL01_11
 					PIXEL11_10
 				} else {
@@ -452,7 +532,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 113:
 				PIXEL00_20
 				PIXEL01_22
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL10_12
 					PIXEL11_10
 				} else {
@@ -464,7 +544,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 204:
 				PIXEL00_21
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 					PIXEL11_11
 				} else {
@@ -474,7 +554,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 73:
 			case 77:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_12
 					PIXEL10_10
 				} else {
@@ -486,7 +566,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 42:
 			case 170:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 					PIXEL10_11
 				} else {
@@ -498,7 +578,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 14:
 			case 142:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 					PIXEL01_12
 				} else {
@@ -558,12 +638,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 26:
 			case 31:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -574,13 +654,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 82:
 			case 214:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -590,12 +670,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 248:
 				PIXEL00_21
 				PIXEL01_22
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -603,13 +683,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 74:
 			case 107:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_21
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -617,7 +697,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_22
 				break;
 			case 27:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
@@ -628,7 +708,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 86:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -640,7 +720,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_21
 				PIXEL01_22
 				PIXEL10_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -649,7 +729,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 106:
 				PIXEL00_10
 				PIXEL01_21
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -658,7 +738,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 30:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -670,7 +750,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_22
 				PIXEL01_10
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -679,7 +759,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 120:
 				PIXEL00_21
 				PIXEL01_22
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -687,7 +767,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_10
 				break;
 			case 75:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
@@ -769,12 +849,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_12
 				break;
 			case 58:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
@@ -784,13 +864,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 83:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -799,25 +879,25 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 92:
 				PIXEL00_21
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 202:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
 				PIXEL01_21
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
@@ -825,13 +905,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_11
 				break;
 			case 78:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
@@ -839,12 +919,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_22
 				break;
 			case 154:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
@@ -854,13 +934,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 114:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -869,34 +949,34 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 89:
 				PIXEL00_12
 				PIXEL01_22
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 90:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -904,7 +984,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 55:
 			case 23:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_11
 					PIXEL01_0
 				} else {
@@ -917,7 +997,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 182:
 			case 150:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 					PIXEL11_12
 				} else {
@@ -929,7 +1009,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 213:
 			case 212:
 				PIXEL00_20
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL01_11
 					PIXEL11_0
 				} else {
@@ -942,7 +1022,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 240:
 				PIXEL00_20
 				PIXEL01_22
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL10_12
 					PIXEL11_0
 				} else {
@@ -954,7 +1034,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 232:
 				PIXEL00_21
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 					PIXEL11_11
 				} else {
@@ -964,7 +1044,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 109:
 			case 105:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_12
 					PIXEL10_0
 				} else {
@@ -976,7 +1056,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 171:
 			case 43:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 					PIXEL10_11
 				} else {
@@ -988,7 +1068,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 143:
 			case 15:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 					PIXEL01_12
 				} else {
@@ -1001,7 +1081,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 124:
 				PIXEL00_21
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1009,7 +1089,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_10
 				break;
 			case 203:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
@@ -1020,7 +1100,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 62:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -1032,7 +1112,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_11
 				PIXEL01_10
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -1040,7 +1120,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 118:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -1052,7 +1132,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_12
 				PIXEL01_22
 				PIXEL10_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -1061,7 +1141,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 110:
 				PIXEL00_10
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1069,7 +1149,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_22
 				break;
 			case 155:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
@@ -1129,24 +1209,24 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 220:
 				PIXEL00_21
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 158:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -1155,13 +1235,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_12
 				break;
 			case 234:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
 				PIXEL01_21
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1170,25 +1250,25 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 242:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 59:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
@@ -1199,12 +1279,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 121:
 				PIXEL00_12
 				PIXEL01_22
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -1212,26 +1292,26 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 87:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 79:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
@@ -1239,88 +1319,88 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_22
 				break;
 			case 122:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 94:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 218:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 91:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -1351,12 +1431,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_12
 				break;
 			case 186:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
@@ -1366,13 +1446,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 115:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
 				}
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -1381,25 +1461,25 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 93:
 				PIXEL00_12
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
 				}
 				break;
 			case 206:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
 				}
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
@@ -1410,7 +1490,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 201:
 				PIXEL00_12
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_10
 				} else {
 					PIXEL10_70
@@ -1419,7 +1499,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 174:
 			case 46:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_10
 				} else {
 					PIXEL00_70
@@ -1431,7 +1511,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 179:
 			case 147:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_10
 				} else {
 					PIXEL01_70
@@ -1444,7 +1524,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_20
 				PIXEL01_11
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_10
 				} else {
 					PIXEL11_70
@@ -1464,12 +1544,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 126:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1477,21 +1557,21 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_10
 				break;
 			case 219:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_10
 				PIXEL10_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 125:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_12
 					PIXEL10_0
 				} else {
@@ -1503,7 +1583,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 221:
 				PIXEL00_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL01_11
 					PIXEL11_0
 				} else {
@@ -1513,7 +1593,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_10
 				break;
 			case 207:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 					PIXEL01_12
 				} else {
@@ -1526,7 +1606,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 238:
 				PIXEL00_10
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 					PIXEL11_11
 				} else {
@@ -1536,7 +1616,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 190:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 					PIXEL11_12
 				} else {
@@ -1546,7 +1626,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_11
 				break;
 			case 187:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 					PIXEL10_11
 				} else {
@@ -1559,7 +1639,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 243:
 				PIXEL00_11
 				PIXEL01_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL10_12
 					PIXEL11_0
 				} else {
@@ -1568,7 +1648,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 119:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_11
 					PIXEL01_0
 				} else {
@@ -1582,7 +1662,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 233:
 				PIXEL00_12
 				PIXEL01_20
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
@@ -1591,7 +1671,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 175:
 			case 47:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
@@ -1603,7 +1683,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 183:
 			case 151:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
@@ -1616,7 +1696,7 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL00_20
 				PIXEL01_11
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
@@ -1625,25 +1705,25 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 250:
 				PIXEL00_10
 				PIXEL01_10
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 123:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_10
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1651,12 +1731,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_10
 				break;
 			case 95:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -1666,13 +1746,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 222:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
 				PIXEL10_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -1681,12 +1761,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 252:
 				PIXEL00_21
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
@@ -1695,25 +1775,25 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 249:
 				PIXEL00_12
 				PIXEL01_22
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 235:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_21
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
@@ -1721,13 +1801,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_11
 				break;
 			case 111:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1735,12 +1815,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_22
 				break;
 			case 63:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
@@ -1749,12 +1829,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_21
 				break;
 			case 159:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
@@ -1764,13 +1844,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 215:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
 				}
 				PIXEL10_21
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -1778,13 +1858,13 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 246:
 				PIXEL00_22
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
@@ -1792,17 +1872,17 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 254:
 				PIXEL00_10
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
@@ -1811,43 +1891,43 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 253:
 				PIXEL00_12
 				PIXEL01_11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
 				}
 				break;
 			case 251:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
 				PIXEL01_10
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
 				}
 				break;
 			case 239:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
 				PIXEL01_12
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
@@ -1855,17 +1935,17 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_11
 				break;
 			case 127:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_20
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_20
@@ -1873,12 +1953,12 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_10
 				break;
 			case 191:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
@@ -1887,18 +1967,18 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11_12
 				break;
 			case 223:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_20
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
 				}
 				PIXEL10_10
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_20
@@ -1906,41 +1986,48 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 247:
 				PIXEL00_11
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
 				}
 				PIXEL10_12
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
 				}
 				break;
 			case 255:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_0
 				} else {
 					PIXEL00_100
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_0
 				} else {
 					PIXEL01_100
 				}
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_0
 				} else {
 					PIXEL10_100
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL11_0
 				} else {
 					PIXEL11_100
 				}
 				break;
 			}
+#ifdef USE_HQ_PATTERN_ROWS
+			for (int i = 0; i < 4; i++)
+				hq2xRules[i * HQPatternRows::kKeys + key] = rules[i];
+		}
+	}
+}
+#else
 
 			w1 = w2;
 			w4 = w5;
@@ -1956,13 +2043,21 @@ static void HQ2x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		q += (nextlineDst - width) * 2;
 	}
 }
+#endif
 
 void HQ2x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
+#ifdef USE_HQ_PATTERN_ROWS
+	if (gBitFormat == 565)
+		HQInterpolator<2>::scale<Graphics::ColorMasks<565> >(hq2xRules, srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	else
+		HQInterpolator<2>::scale<Graphics::ColorMasks<555> >(hq2xRules, srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+#else
 	if (gBitFormat == 565)
 		HQ2x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 	else
 		HQ2x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+#endif
 }
 
 #endif // Assembly version
@@ -42,6 +42,67 @@ void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 
 #else
 
+#ifdef USE_HQ_PATTERN_ROWS
+
+// The cases store the rule of each output pixel, see HQInterpolator
+#define PIXEL00_1M  *(q) = HQ_RULE(0, 0, 4);
+#define PIXEL00_1U  *(q) = HQ_RULE(4, 0, 0);
+#define PIXEL00_1L  *(q) = HQ_RULE(0, 4, 0);
+#define PIXEL00_2   *(q) = HQ_RULE(4, 4, 0);
+#define PIXEL00_4   *(q) = HQ_RULE(7, 7, 0) | HQ_RULE_MASKED;
+#define PIXEL00_5   *(q) = HQ_RULE(8, 8, 0);
+#define PIXEL00_C   *(q) = HQ_RULE(0, 0, 0);
+
+#define PIXEL01_1   *(q+1) = HQ_RULE(4, 0, 0);
+#define PIXEL01_3   *(q+1) = HQ_RULE(2, 0, 0);
+#define PIXEL01_6   *(q+1) = HQ_RULE(12, 0, 0);
+#define PIXEL01_C   *(q+1) = HQ_RULE(0, 0, 0);
+
+#define PIXEL02_1M  *(q+2) = HQ_RULE(0, 0, 4);
+#define PIXEL02_1U  *(q+2) = HQ_RULE(4, 0, 0);
+#define PIXEL02_1R  *(q+2) = HQ_RULE(0, 4, 0);
+#define PIXEL02_2   *(q+2) = HQ_RULE(4, 4, 0);
+#define PIXEL02_4   *(q+2) = HQ_RULE(7, 7, 0) | HQ_RULE_MASKED;
+#define PIXEL02_5   *(q+2) = HQ_RULE(8, 8, 0);
+#define PIXEL02_C   *(q+2) = HQ_RULE(0, 0, 0);
+
+#define PIXEL10_1   *(q+nextlineDst) = HQ_RULE(0, 4, 0);
+#define PIXEL10_3   *(q+nextlineDst) = HQ_RULE(0, 2, 0);
+#define PIXEL10_6   *(q+nextlineDst) = HQ_RULE(0, 12, 0);
+#define PIXEL10_C   *(q+nextlineDst) = HQ_RULE(0, 0, 0);
+
+#define PIXEL11     *(q+1+nextlineDst) = HQ_RULE(0, 0, 0);
+
+#define PIXEL12_1   *(q+2+nextlineDst) = HQ_RULE(0, 4, 0);
+#define PIXEL12_3   *(q+2+nextlineDst) = HQ_RULE(0, 2, 0);
+#define PIXEL12_6   *(q+2+nextlineDst) = HQ_RULE(0, 12, 0);
+#define PIXEL12_C   *(q+2+nextlineDst) = HQ_RULE(0, 0, 0);
+
+#define PIXEL20_1M  *(q+nextlineDst2) = HQ_RULE(0, 0, 4);
+#define PIXEL20_1D  *(q+nextlineDst2) = HQ_RULE(4, 0, 0);
+#define PIXEL20_1L  *(q+nextlineDst2) = HQ_RULE(0, 4, 0);
+#define PIXEL20_2   *(q+nextlineDst2) = HQ_RULE(4, 4, 0);
+#define PIXEL20_4   *(q+nextlineDst2) = HQ_RULE(7, 7, 0) | HQ_RULE_MASKED;
+#define PIXEL20_5   *(q+nextlineDst2) = HQ_RULE(8, 8, 0);
+#define PIXEL20_C   *(q+nextlineDst2) = HQ_RULE(0, 0, 0);
+
+#define PIXEL21_1   *(q+1+nextlineDst2) = HQ_RULE(4, 0, 0);
+#define PIXEL21_3   *(q+1+nextlineDst2) = HQ_RULE(2, 0, 0);
+#define PIXEL21_6   *(q+1+nextlineDst2) = HQ_RULE(12, 0, 0);
+#define PIXEL21_C   *(q+1+nextlineDst2) = HQ_RULE(0, 0, 0);
+
+#define PIXEL22_1M  *(q+2+nextlineDst2) = HQ_RULE(0, 0, 4);
+#define PIXEL22_1D  *(q+2+nextlineDst2) = HQ_RULE(4, 0, 0);
+#define PIXEL22_1R  *(q+2+nextlineDst2) = HQ_RULE(0, 4, 0);
+#define PIXEL22_2   *(q+2+nextlineDst2) = HQ_RULE(4, 4, 0);
+#define PIXEL22_4   *(q+2+nextlineDst2) = HQ_RULE(7, 7, 0) | HQ_RULE_MASKED;
+#define PIXEL22_5   *(q+2+nextlineDst2) = HQ_RULE(8, 8, 0);
+#define PIXEL22_C   *(q+2+nextlineDst2) = HQ_RULE(0, 0, 0);
+
+#define DIFF(a, b)	(key & HQPatternRows::kDiff ## a ## b)
+
+#else
+
 #define PIXEL00_1M  *(q) = interpolate16_3_1<ColorMask >(w5, w1);
 #define PIXEL00_1U  *(q) = interpolate16_3_1<ColorMask >(w5, w2);
 #define PIXEL00_1L  *(q) = interpolate16_3_1<ColorMask >(w5, w4);
@@ -98,6 +159,27 @@ void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
 
 extern "C" uint32   *RGBtoYUV;
 #define YUV(x)	RGBtoYUV[w ## x]
+#define DIFF(a, b)	diffYUV(YUV(a), YUV(b))
+
+#endif
+
+#ifdef USE_HQ_PATTERN_ROWS
+
+static uint16 hq3xRules[9 * HQPatternRows::kKeys];
+
+/**
+ * Store the rules of the HQ3x output pixels for every key of HQPatternRows.
+ */
+void InitHQ3xRules() {
+	const uint32 nextlineDst = 3;
+	const uint32 nextlineDst2 = 2 * nextlineDst;
+	for (int conditions = 0; conditions < HQPatternRows::kKeys >> 8; conditions++) {
+		for (int pattern = 0; pattern < 256; pattern++) {
+			const int key = conditions << 8 | pattern;
+			uint16 rules[9];
+			uint16 *q = rules;
+
+#else
 
 /*
  * The HQ3x high quality 3x graphics filter.
@@ -153,6 +235,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			if (w5 != w7 && diffYUV(yuv5, YUV(7))) pattern |= 0x0020;
 			if (w5 != w8 && diffYUV(yuv5, YUV(8))) pattern |= 0x0040;
 			if (w5 != w9 && diffYUV(yuv5, YUV(9))) pattern |= 0x0080;
+#endif
 
 			switch (pattern) {
 			case 0:
@@ -352,7 +435,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 18:
 			case 50:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_1M
 					PIXEL12_C
@@ -375,7 +458,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_1M
@@ -392,7 +475,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_2
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_1M
 					PIXEL21_C
@@ -405,7 +488,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 10:
 			case 138:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL10_C
@@ -498,7 +581,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 22:
 			case 54:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -521,7 +604,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -538,7 +621,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_2
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -551,7 +634,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 11:
 			case 139:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -569,7 +652,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 19:
 			case 51:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_1M
@@ -588,7 +671,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 146:
 			case 178:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_1M
 					PIXEL12_C
@@ -607,7 +690,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 84:
 			case 85:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -626,7 +709,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 112:
 			case 113:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -645,7 +728,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 200:
 			case 204:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_1M
 					PIXEL21_C
@@ -664,7 +747,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 73:
 			case 77:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_1M
@@ -683,7 +766,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 42:
 			case 170:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL10_C
@@ -702,7 +785,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 14:
 			case 142:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 					PIXEL01_C
 					PIXEL02_1R
@@ -809,7 +892,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 26:
 			case 31:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -817,7 +900,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -832,7 +915,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 82:
 			case 214:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -843,7 +926,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -857,7 +940,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL01_1
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -865,7 +948,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -875,7 +958,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 74:
 			case 107:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -886,7 +969,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -896,7 +979,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 27:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -914,7 +997,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 86:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -936,7 +1019,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -952,7 +1035,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -965,7 +1048,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 30:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -987,7 +1070,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1003,7 +1086,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1015,7 +1098,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 75:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1164,13 +1247,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 58:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1185,7 +1268,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 83:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1195,7 +1278,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1M
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1208,20 +1291,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 202:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1231,7 +1314,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1240,7 +1323,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 78:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1250,7 +1333,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1259,13 +1342,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 154:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1280,7 +1363,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 114:
 				PIXEL00_1M
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1290,7 +1373,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1303,26 +1386,26 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 90:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1330,13 +1413,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1344,7 +1427,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 55:
 			case 23:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_C
@@ -1363,7 +1446,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 182:
 			case 150:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1382,7 +1465,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 213:
 			case 212:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -1401,7 +1484,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 241:
 			case 240:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -1420,7 +1503,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 236:
 			case 232:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1439,7 +1522,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 109:
 			case 105:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_C
@@ -1458,7 +1541,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 171:
 			case 43:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1477,7 +1560,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 143:
 			case 15:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL02_1R
@@ -1500,7 +1583,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1512,7 +1595,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 203:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1530,7 +1613,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 62:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1552,7 +1635,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1564,7 +1647,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 118:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1586,7 +1669,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1602,7 +1685,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1R
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1614,7 +1697,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 155:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1724,12 +1807,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1740,12 +1823,12 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 158:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1761,7 +1844,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 234:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -1770,7 +1853,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1784,7 +1867,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 242:
 				PIXEL00_1M
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1792,7 +1875,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_1
 				PIXEL11
 				PIXEL20_1L
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1803,7 +1886,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 59:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1812,7 +1895,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -1829,7 +1912,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1838,7 +1921,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -1846,7 +1929,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 87:
 				PIXEL00_1L
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1859,14 +1942,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL20_1M
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 79:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1878,7 +1961,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1R
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -1887,20 +1970,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 122:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -1909,19 +1992,19 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 94:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -1932,38 +2015,38 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 218:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -1974,7 +2057,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 91:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -1983,20 +2066,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
 				}
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2047,13 +2130,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 186:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2068,7 +2151,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 115:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2078,7 +2161,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2091,20 +2174,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 206:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -2114,7 +2197,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -2130,7 +2213,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_1M
 				} else {
 					PIXEL20_2
@@ -2140,7 +2223,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 174:
 			case 46:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_1M
 				} else {
 					PIXEL00_2
@@ -2158,7 +2241,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 147:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_1M
 				} else {
 					PIXEL02_2
@@ -2180,7 +2263,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_1M
 				} else {
 					PIXEL22_2
@@ -2210,7 +2293,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 126:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2220,7 +2303,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL12_3
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2232,7 +2315,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 219:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2244,7 +2327,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -2255,7 +2338,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 125:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL00_1U
 					PIXEL10_C
 					PIXEL20_C
@@ -2273,7 +2356,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 221:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL02_1U
 					PIXEL12_C
 					PIXEL21_C
@@ -2291,7 +2374,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL20_1M
 				break;
 			case 207:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL02_1R
@@ -2309,7 +2392,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 238:
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2327,7 +2410,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_1
 				break;
 			case 190:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2345,7 +2428,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL21_1
 				break;
 			case 187:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2363,7 +2446,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 243:
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL20_1L
 					PIXEL21_C
@@ -2381,7 +2464,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				break;
 			case 119:
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL00_1L
 					PIXEL01_C
 					PIXEL02_C
@@ -2406,7 +2489,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2416,7 +2499,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 175:
 			case 47:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2434,7 +2517,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 151:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2456,7 +2539,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2467,7 +2550,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL01_C
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -2475,7 +2558,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2484,7 +2567,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 123:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2495,7 +2578,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2505,7 +2588,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 95:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -2513,7 +2596,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2527,7 +2610,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 222:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2538,7 +2621,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2552,7 +2635,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1U
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
@@ -2560,7 +2643,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_4
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2572,13 +2655,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL02_1M
 				PIXEL10_C
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2587,7 +2670,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 235:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2598,7 +2681,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2607,7 +2690,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 111:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2617,7 +2700,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2627,13 +2710,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 63:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2647,7 +2730,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 159:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
@@ -2655,7 +2738,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL10_3
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2669,7 +2752,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 215:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2678,7 +2761,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL11
 				PIXEL12_C
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2688,7 +2771,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 246:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2700,7 +2783,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
@@ -2708,7 +2791,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				break;
 			case 254:
 				PIXEL00_1M
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 				} else {
@@ -2716,14 +2799,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL02_4
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 				} else {
 					PIXEL10_3
 					PIXEL20_4
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL21_C
 					PIXEL22_C
@@ -2740,20 +2823,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 251:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 				} else {
@@ -2762,7 +2845,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL02_1M
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL10_C
 					PIXEL20_C
 					PIXEL21_C
@@ -2771,7 +2854,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL20_2
 					PIXEL21_3
 				}
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL12_C
 					PIXEL22_C
 				} else {
@@ -2780,7 +2863,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				break;
 			case 239:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
@@ -2790,7 +2873,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_1
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
@@ -2799,7 +2882,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1R
 				break;
 			case 127:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL01_C
 					PIXEL10_C
@@ -2808,7 +2891,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL01_3
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 					PIXEL12_C
 				} else {
@@ -2816,7 +2899,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 					PIXEL12_3
 				}
 				PIXEL11
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 					PIXEL21_C
 				} else {
@@ -2826,13 +2909,13 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1M
 				break;
 			case 191:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2845,14 +2928,14 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL22_1D
 				break;
 			case 223:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 					PIXEL10_C
 				} else {
 					PIXEL00_4
 					PIXEL10_3
 				}
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL01_C
 					PIXEL02_C
 					PIXEL12_C
@@ -2863,7 +2946,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				}
 				PIXEL11
 				PIXEL20_1M
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL21_C
 					PIXEL22_C
 				} else {
@@ -2874,7 +2957,7 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 			case 247:
 				PIXEL00_1L
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2884,20 +2967,20 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL12_C
 				PIXEL20_1L
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
 				}
 				break;
 			case 255:
-				if (diffYUV(YUV(4), YUV(2))) {
+				if (DIFF(4, 2)) {
 					PIXEL00_C
 				} else {
 					PIXEL00_2
 				}
 				PIXEL01_C
-				if (diffYUV(YUV(2), YUV(6))) {
+				if (DIFF(2, 6)) {
 					PIXEL02_C
 				} else {
 					PIXEL02_2
@@ -2905,19 +2988,26 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 				PIXEL10_C
 				PIXEL11
 				PIXEL12_C
-				if (diffYUV(YUV(8), YUV(4))) {
+				if (DIFF(8, 4)) {
 					PIXEL20_C
 				} else {
 					PIXEL20_2
 				}
 				PIXEL21_C
-				if (diffYUV(YUV(6), YUV(8))) {
+				if (DIFF(6, 8)) {
 					PIXEL22_C
 				} else {
 					PIXEL22_2
 				}
 				break;
 			}
+#ifdef USE_HQ_PATTERN_ROWS
+			for (int i = 0; i < 9; i++)
+				hq3xRules[i * HQPatternRows::kKeys + key] = rules[i];
+		}
+	}
+}
+#else
 
 			w1 = w2;
 			w4 = w5;
@@ -2933,13 +3023,21 @@ static void HQ3x_implementation(const uint8 *srcPtr, uint32 srcPitch, uint8 *dst
 		q += (nextlineDst - width) * 3;
 	}
 }
+#endif
 
 void HQ3x(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
 	extern int gBitFormat;
+#ifdef USE_HQ_PATTERN_ROWS
+	if (gBitFormat == 565)
+		HQInterpolator<3>::scale<Graphics::ColorMasks<565> >(hq3xRules, srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+	else
+		HQInterpolator<3>::scale<Graphics::ColorMasks<555> >(hq3xRules, srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+#else
 	if (gBitFormat == 565)
 		HQ3x_implementation<Graphics::ColorMasks<565> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
 	else
 		HQ3x_implementation<Graphics::ColorMasks<555> >(srcPtr, srcPitch, dstPtr, dstPitch, width, height);
+#endif
 }
 
 #endif // Assembly version
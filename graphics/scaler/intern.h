@@ -24,6 +24,9 @@
 #define GRAPHICS_SCALER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/noncopyable.h"
+#include "common/simd.h"
+#include "common/textconsole.h"
 #include "graphics/colormasks.h"
 
 
@@ -524,4 +527,484 @@ static inline bool diffYUV(int yuv1, int yuv2) {
 */
 }
 
+#if defined(USE_HQ_SCALERS) && !defined(USE_NASM) && (defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON))
+#define USE_HQ_PATTERN_ROWS
+
+/**
+ * Finds the neighbours of each pixel which differ from it, for the hq
+ * scalers, one row at a time.
+ *
+ * Bit 0 to 7 of a key are set when diffYUV() is true for the pixel and
+ * its neighbour w1, w2, w3, w4, w6, w7, w8 and w9 respectively, numbered as
+ * in the scalers, which is the pattern the scalers switch on. Bit 8 to 11
+ * hold the comparisons of the neighbours some cases check to decide how to
+ * blend a corner. The YUV values are looked up once for every source pixel
+ * and kept for the next rows, and the comparisons are done with SSE2 or
+ * NEON for four pixels at once. Without these, the scalers compare each
+ * pixel on their own, which is faster than a separate pass.
+ */
+class HQPatternRows : Common::NonCopyable {
+public:
+	enum {
+		/** diffYUV() is true for w4 and w2 */
+		kDiff42 = 0x100,
+		/** diffYUV() is true for w2 and w6 */
+		kDiff26 = 0x200,
+		/** diffYUV() is true for w8 and w4 */
+		kDiff84 = 0x400,
+		/** diffYUV() is true for w6 and w8 */
+		kDiff68 = 0x800,
+
+		kKeys = 0x1000
+	};
+
+	/**
+	 * @param src    the first pixel of the first row to scale
+	 * @param pitch  the distance between the rows, in pixels
+	 * @param width  the number of pixels in each row
+	 */
+	HQPatternRows(const uint16 *src, uint32 pitch, int width);
+	~HQPatternRows();
+
+	/**
+	 * Get the keys of the next row, starting with the first one.
+	 */
+	const uint16 *nextRow();
+
+private:
+	const uint16 *_src;
+	const uint32 _pitch;
+	const int _width;
+
+	uint32 *_buffer;
+	/** YUV values of the rows above, at and below the current one. */
+	uint32 *_yuv[3];
+	uint16 *_keys;
+
+	/** Look up the YUV values of a row, from the pixel left of it to the one right of it. */
+	void convertRow(const uint16 *src, uint32 *yuv) const;
+};
+
+/**
+ * The rule for blending an output pixel of the hq scalers, see
+ * HQInterpolator: the weights of the vertical, horizontal and diagonal
+ * neighbour, in sixteenths.
+ */
+#define HQ_RULE(vertical, horizontal, diagonal)	((vertical) | (horizontal) << 4 | (diagonal) << 8)
+
+/**
+ * Added to the rules of the pixels whose interpolate16 function masks the
+ * color components, which drops the bits outside of them, i.e. the unused
+ * top bit of 555. The other functions blend that bit into the result like
+ * the color components, and may carry it into the red component.
+ */
+#define HQ_RULE_MASKED	0x1000
+
+/**
+ * Blend an output pixel of the hq scalers with the interpolate16 function
+ * its rule stands for, like the scalers do without HQPatternRows.
+ */
+template<typename ColorMask>
+static inline uint16 interpolateHQRule(uint rule, uint p5, uint pV, uint pH, uint pD) {
+	switch (rule) {
+	case HQ_RULE(0, 0, 0):
+		return p5;
+	case HQ_RULE(4, 0, 0):
+		return interpolate16_3_1<ColorMask>(p5, pV);
+	case HQ_RULE(0, 4, 0):
+		return interpolate16_3_1<ColorMask>(p5, pH);
+	case HQ_RULE(0, 0, 4):
+		return interpolate16_3_1<ColorMask>(p5, pD);
+	case HQ_RULE(12, 0, 0):
+		return interpolate16_3_1<ColorMask>(pV, p5);
+	case HQ_RULE(0, 12, 0):
+		return interpolate16_3_1<ColorMask>(pH, p5);
+	case HQ_RULE(2, 0, 0):
+		return interpolate16_7_1<ColorMask>(p5, pV);
+	case HQ_RULE(0, 2, 0):
+		return interpolate16_7_1<ColorMask>(p5, pH);
+	case HQ_RULE(4, 4, 0):
+		return interpolate16_2_1_1<ColorMask>(p5, pV, pH);
+	case HQ_RULE(4, 0, 4):
+		return interpolate16_2_1_1<ColorMask>(p5, pV, pD);
+	case HQ_RULE(0, 4, 4):
+		return interpolate16_2_1_1<ColorMask>(p5, pH, pD);
+	case HQ_RULE(4, 2, 0):
+		return interpolate16_5_2_1<ColorMask>(p5, pV, pH);
+	case HQ_RULE(2, 4, 0):
+		return interpolate16_5_2_1<ColorMask>(p5, pH, pV);
+	case HQ_RULE(2, 2, 0):
+		return interpolate16_6_1_1<ColorMask>(p5, pV, pH);
+	case HQ_RULE(8, 8, 0):
+		return interpolate16_1_1<ColorMask>(pV, pH);
+	case HQ_RULE(6, 6, 0) | HQ_RULE_MASKED:
+		return interpolate16_2_3_3<ColorMask>(p5, pV, pH);
+	case HQ_RULE(7, 7, 0) | HQ_RULE_MASKED:
+		return interpolate16_2_7_7<ColorMask>(p5, pV, pH);
+	case HQ_RULE(1, 1, 0) | HQ_RULE_MASKED:
+		return interpolate16_14_1_1<ColorMask>(p5, pV, pH);
+	default:
+		error("[interpolateHQRule] Unknown rule %x", rule);
+	}
+}
+
+/**
+ * Store the rules of every output pixel for each key of HQPatternRows.
+ * Called by InitScalers().
+ */
+void InitHQ2xRules();
+void InitHQ3xRules();
+
+#if defined(SCUMMVM_SSE2)
+typedef __m128i HQPixels;
+
+static inline HQPixels loadHQPixels(const uint16 *src) {
+	return _mm_loadu_si128((const __m128i *)src);
+}
+
+static inline HQPixels orHQPixels(HQPixels a, HQPixels b) {
+	return _mm_or_si128(a, b);
+}
+
+static inline HQPixels andHQPixels(HQPixels a, HQPixels b) {
+	return _mm_and_si128(a, b);
+}
+
+static inline HQPixels addHQPixels(HQPixels a, HQPixels b) {
+	return _mm_add_epi16(a, b);
+}
+
+template<int shift, int max>
+static inline HQPixels getHQComponent(HQPixels pixels) {
+	return _mm_and_si128(_mm_srli_epi16(pixels, shift), _mm_set1_epi16(max));
+}
+
+template<int shift>
+static inline HQPixels putHQComponent(HQPixels component) {
+	return _mm_slli_epi16(component, shift);
+}
+
+/**
+ * Split the rules of eight output pixels into the weights of the source
+ * pixel and the vertical, horizontal and diagonal neighbour, followed by
+ * a mask of the pixels without HQ_RULE_MASKED.
+ */
+static inline void getHQWeights(const uint16 *rules, HQPixels *weights) {
+	const HQPixels rule = loadHQPixels(rules);
+	const HQPixels mask = _mm_set1_epi16(15);
+	weights[1] = _mm_and_si128(rule, mask);
+	weights[2] = _mm_and_si128(_mm_srli_epi16(rule, 4), mask);
+	weights[3] = _mm_and_si128(_mm_srli_epi16(rule, 8), mask);
+	weights[0] = _mm_sub_epi16(_mm_set1_epi16(16), _mm_add_epi16(_mm_add_epi16(weights[1], weights[2]), weights[3]));
+	weights[4] = _mm_cmpeq_epi16(_mm_and_si128(rule, _mm_set1_epi16(HQ_RULE_MASKED)), _mm_setzero_si128());
+}
+
+/**
+ * Sum a color component of eight output pixels, multiplied by the weights.
+ */
+static inline HQPixels sumHQComponent(HQPixels source, HQPixels vertical, HQPixels horizontal, HQPixels diagonal, const HQPixels *weights) {
+	HQPixels sum = _mm_mullo_epi16(source, weights[0]);
+	sum = _mm_add_epi16(sum, _mm_mullo_epi16(vertical, weights[1]));
+	sum = _mm_add_epi16(sum, _mm_mullo_epi16(horizontal, weights[2]));
+	return _mm_add_epi16(sum, _mm_mullo_epi16(diagonal, weights[3]));
+}
+
+/**
+ * Sum a color component of eight output pixels blended with a single
+ * neighbour, of the given weight.
+ */
+static inline HQPixels sumHQComponent(HQPixels source, HQPixels neighbour, HQPixels weight) {
+	const HQPixels sum = _mm_mullo_epi16(source, _mm_sub_epi16(_mm_set1_epi16(16), weight));
+	return _mm_add_epi16(sum, _mm_mullo_epi16(neighbour, weight));
+}
+
+/**
+ * Divide the sums of a color component by 16, rounding down.
+ */
+static inline HQPixels divideHQComponent(HQPixels sum) {
+	return _mm_srli_epi16(sum, 4);
+}
+
+/**
+ * Store two rows of eight pixels interleaved, a[0], b[0], a[1]...
+ */
+static inline void storeHQPixels(uint16 *dst, HQPixels a, HQPixels b) {
+	_mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(a, b));
+	_mm_storeu_si128((__m128i *)(dst + 8), _mm_unpackhi_epi16(a, b));
+}
+
+static inline void storeHQPixels(uint16 *dst, HQPixels a, HQPixels b, HQPixels c) {
+	// SSE2 can't shuffle 16 bit lanes across the register, so a[i], b[i],
+	// c[i] and a zero are packed into 64 bits and stored overlapping, the
+	// zero being overwritten by the next store
+	const HQPixels zero = _mm_setzero_si128();
+	const HQPixels abLow = _mm_unpacklo_epi16(a, b), abHigh = _mm_unpackhi_epi16(a, b);
+	const HQPixels cLow = _mm_unpacklo_epi16(c, zero), cHigh = _mm_unpackhi_epi16(c, zero);
+	const HQPixels pixels[4] = {
+		_mm_unpacklo_epi32(abLow, cLow), _mm_unpackhi_epi32(abLow, cLow),
+		_mm_unpacklo_epi32(abHigh, cHigh), _mm_unpackhi_epi32(abHigh, cHigh)
+	};
+	for (int i = 0; i < 4; i++) {
+		_mm_storel_epi64((__m128i *)(dst + i * 6), pixels[i]);
+		if (i < 3) {
+			_mm_storel_epi64((__m128i *)(dst + i * 6 + 3), _mm_srli_si128(pixels[i], 8));
+		}
+	}
+	// The last pixel must not write past the output
+	const uint32 last = _mm_cvtsi128_si32(_mm_srli_si128(pixels[3], 8));
+	dst[21] = (uint16)last;
+	dst[22] = (uint16)(last >> 16);
+	dst[23] = (uint16)_mm_extract_epi16(pixels[3], 6);
+}
+#elif defined(SCUMMVM_NEON)
+typedef uint16x8_t HQPixels;
+
+static inline HQPixels loadHQPixels(const uint16 *src) {
+	return vld1q_u16(src);
+}
+
+static inline HQPixels orHQPixels(HQPixels a, HQPixels b) {
+	return vorrq_u16(a, b);
+}
+
+static inline HQPixels andHQPixels(HQPixels a, HQPixels b) {
+	return vandq_u16(a, b);
+}
+
+static inline HQPixels addHQPixels(HQPixels a, HQPixels b) {
+	return vaddq_u16(a, b);
+}
+
+template<int shift, int max>
+static inline HQPixels getHQComponent(HQPixels pixels) {
+	// Shifting by a negative count shifts to the right
+	return vandq_u16(vshlq_u16(pixels, vdupq_n_s16(-shift)), vdupq_n_u16(max));
+}
+
+template<int shift>
+static inline HQPixels putHQComponent(HQPixels component) {
+	return vshlq_u16(component, vdupq_n_s16(shift));
+}
+
+static inline void getHQWeights(const uint16 *rules, HQPixels *weights) {
+	const HQPixels rule = loadHQPixels(rules);
+	const HQPixels mask = vdupq_n_u16(15);
+	weights[1] = vandq_u16(rule, mask);
+	weights[2] = vandq_u16(vshrq_n_u16(rule, 4), mask);
+	weights[3] = vandq_u16(vshrq_n_u16(rule, 8), mask);
+	weights[0] = vsubq_u16(vdupq_n_u16(16), vaddq_u16(vaddq_u16(weights[1], weights[2]), weights[3]));
+	weights[4] = vceqq_u16(vandq_u16(rule, vdupq_n_u16(HQ_RULE_MASKED)), vdupq_n_u16(0));
+}
+
+static inline HQPixels sumHQComponent(HQPixels source, HQPixels vertical, HQPixels horizontal, HQPixels diagonal, const HQPixels *weights) {
+	HQPixels sum = vmulq_u16(source, weights[0]);
+	sum = vmlaq_u16(sum, vertical, weights[1]);
+	sum = vmlaq_u16(sum, horizontal, weights[2]);
+	return vmlaq_u16(sum, diagonal, weights[3]);
+}
+
+static inline HQPixels sumHQComponent(HQPixels source, HQPixels neighbour, HQPixels weight) {
+	const HQPixels sum = vmulq_u16(source, vsubq_u16(vdupq_n_u16(16), weight));
+	return vmlaq_u16(sum, neighbour, weight);
+}
+
+static inline HQPixels divideHQComponent(HQPixels sum) {
+	return vshrq_n_u16(sum, 4);
+}
+
+static inline void storeHQPixels(uint16 *dst, HQPixels a, HQPixels b) {
+	const uint16x8x2_t pixels = { { a, b } };
+	vst2q_u16(dst, pixels);
+}
+
+static inline void storeHQPixels(uint16 *dst, HQPixels a, HQPixels b, HQPixels c) {
+	const uint16x8x3_t pixels = { { a, b, c } };
+	vst3q_u16(dst, pixels);
+}
+#endif
+
+/**
+ * Blends the output pixels of the hq scalers with SSE2 or NEON, eight source
+ * pixels at a time.
+ *
+ * Each output pixel of HQ2x and HQ3x is a blend of the source pixel and the
+ * neighbours towards its corner or edge, e.g. w1, w2 and w4 for the top left
+ * one and only w2 for the top middle one of HQ3x. The weights only depend
+ * on the key found by HQPatternRows, so InitScalers() runs the cases of the
+ * scalers once for every key, storing an HQ_RULE for each output pixel.
+ * Scaling then looks up the rules of the source pixels and computes
+ * (kS * source + kV * vertical + kH * horizontal + kD * diagonal) / 16 for
+ * each color component, rounded down like the interpolate16 functions do.
+ * The unused top bit of 555 is blended the way those functions treat it,
+ * so the results are the same as blending each pixel on its own.
+ */
+template<int factor>
+class HQInterpolator : Common::NonCopyable {
+public:
+	/**
+	 * Scale like HQ2x or HQ3x do.
+	 *
+	 * @param rules  the rules of each key, for every output pixel in turn
+	 */
+	template<typename ColorMask>
+	static void scale(const uint16 *rules, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch, int width, int height) {
+		const uint16 *src = (const uint16 *)srcPtr;
+		uint16 *dst = (uint16 *)dstPtr;
+		srcPitch /= sizeof(uint16);
+		dstPitch /= sizeof(uint16);
+
+		HQPatternRows patternRows(src, srcPitch, width);
+		HQInterpolator interpolator(rules, width);
+		while (height--) {
+			interpolator.interpolateRow<ColorMask>(patternRows.nextRow(), src, srcPitch, dst, dstPitch);
+			src += srcPitch;
+			dst += dstPitch * factor;
+		}
+	}
+
+private:
+	enum {
+		kOutputPixels = factor * factor
+	};
+
+	const uint16 *_rules;
+	const int _width;
+	/** The rules of a row of source pixels, for each output pixel in turn. */
+	uint16 *_rowRules;
+
+	HQInterpolator(const uint16 *rules, int width) : _rules(rules), _width(width) {
+		_rowRules = (uint16 *)malloc(kOutputPixels * width * sizeof(uint16));
+		if (!_rowRules)
+			error("[HQInterpolator] Cannot allocate memory for %d pixels", width);
+	}
+
+	~HQInterpolator() {
+		free(_rowRules);
+	}
+
+	/**
+	 * The index of the vertical and horizontal neighbour of an output pixel
+	 * in w1 to w9, counting from 0, or the one of the source pixel when it
+	 * has none.
+	 */
+	static int getVertical(int row) { return row == 0 ? 1 : (row == factor - 1 ? 7 : 4); }
+	static int getHorizontal(int column) { return column == 0 ? 3 : (column == factor - 1 ? 5 : 4); }
+
+	template<typename ColorMask>
+	void interpolateRow(const uint16 *keys, const uint16 *src, uint32 srcPitch, uint16 *dst, uint32 dstPitch);
+};
+
+template<int factor>
+template<typename ColorMask>
+void HQInterpolator<factor>::interpolateRow(const uint16 *keys, const uint16 *src, uint32 srcPitch, uint16 *dst, uint32 dstPitch) {
+	enum {
+		kRedMax = ColorMask::kRedMask >> ColorMask::kRedShift,
+		kGreenMax = ColorMask::kGreenMask >> ColorMask::kGreenShift,
+		kBlueMax = ColorMask::kBlueMask >> ColorMask::kBlueShift,
+		// The unused top bit of 555, see HQ_RULE_MASKED
+		kTopBit = 0x8000 & ~(ColorMask::kRedMask | ColorMask::kGreenMask | ColorMask::kBlueMask)
+	};
+
+	for (int i = 0; i < kOutputPixels; i++) {
+		// The middle pixel of HQ3x is copied below
+		if (factor == 3 && i == 4)
+			continue;
+		const uint16 *rules = &_rules[i * HQPatternRows::kKeys];
+		uint16 *rowRules = &_rowRules[i * _width];
+		for (int x = 0; x < _width; x++)
+			rowRules[x] = rules[keys[x]];
+	}
+
+	// Offsets of w1 to w9 from the source pixel
+	const int offsets[9] = {
+		-(int)srcPitch - 1, -(int)srcPitch, -(int)srcPitch + 1,
+		-1, 0, 1,
+		(int)srcPitch - 1, (int)srcPitch, (int)srcPitch + 1
+	};
+
+	int x = 0;
+	for (; x + 8 <= _width; x += 8) {
+		HQPixels red[9], green[9], blue[9], top[9];
+		for (int i = 0; i < 9; i++) {
+			const HQPixels pixels = loadHQPixels(src + x + offsets[i]);
+			red[i] = getHQComponent<ColorMask::kRedShift, kRedMax>(pixels);
+			green[i] = getHQComponent<ColorMask::kGreenShift, kGreenMax>(pixels);
+			blue[i] = getHQComponent<ColorMask::kBlueShift, kBlueMax>(pixels);
+			if (kTopBit != 0)
+				top[i] = getHQComponent<15, 1>(pixels);
+		}
+
+		HQPixels results[factor][factor];
+		for (int row = 0; row < factor; row++) {
+			const int v = getVertical(row);
+			for (int column = 0; column < factor; column++) {
+				const int h = getHorizontal(column);
+				if (v == 4 && h == 4) {
+					// The middle pixel of HQ3x is always the source pixel
+					results[row][column] = loadHQPixels(src + x);
+					continue;
+				}
+				const int d = v / 3 * 3 + h % 3;
+
+				HQPixels weights[5];
+				getHQWeights(&_rowRules[(row * factor + column) * _width + x], weights);
+				HQPixels result, topSum;
+				if (v == 4 || h == 4) {
+					// The middle pixels of the edges of HQ3x only blend with
+					// the neighbour on that edge, which is also the diagonal one
+					const int n = (v == 4) ? h : v;
+					const HQPixels weight = addHQPixels(weights[(v == 4) ? 2 : 1], weights[3]);
+					result = putHQComponent<ColorMask::kRedShift>(divideHQComponent(sumHQComponent(red[4], red[n], weight)));
+					result = orHQPixels(result, putHQComponent<ColorMask::kGreenShift>(divideHQComponent(sumHQComponent(green[4], green[n], weight))));
+					result = orHQPixels(result, putHQComponent<ColorMask::kBlueShift>(divideHQComponent(sumHQComponent(blue[4], blue[n], weight))));
+					if (kTopBit != 0)
+						topSum = sumHQComponent(top[4], top[n], weight);
+				} else {
+					result = putHQComponent<ColorMask::kRedShift>(divideHQComponent(sumHQComponent(red[4], red[v], red[h], red[d], weights)));
+					result = orHQPixels(result, putHQComponent<ColorMask::kGreenShift>(divideHQComponent(sumHQComponent(green[4], green[v], green[h], green[d], weights))));
+					result = orHQPixels(result, putHQComponent<ColorMask::kBlueShift>(divideHQComponent(sumHQComponent(blue[4], blue[v], blue[h], blue[d], weights))));
+					if (kTopBit != 0)
+						topSum = sumHQComponent(top[4], top[v], top[h], top[d], weights);
+				}
+
+				// Like the interpolate16 functions, add the weighted top bits
+				// in sixteenths at bit 11, which may carry into red
+				if (kTopBit != 0)
+					result = addHQPixels(result, putHQComponent<11>(andHQPixels(topSum, weights[4])));
+				results[row][column] = result;
+			}
+		}
+
+		for (int row = 0; row < factor; row++) {
+			if (factor == 2)
+				storeHQPixels(dst + row * dstPitch + x * factor, results[row][0], results[row][1]);
+			else
+				storeHQPixels(dst + row * dstPitch + x * factor, results[row][0], results[row][1], results[row][factor - 1]);
+		}
+	}
+
+	// The pixels left over are blended one by one, exactly like the scalers
+	// do without HQPatternRows
+	for (; x < _width; x++) {
+		for (int row = 0; row < factor; row++) {
+			const int v = getVertical(row);
+			for (int column = 0; column < factor; column++) {
+				const int h = getHorizontal(column);
+				const int d = v / 3 * 3 + h % 3;
+
+				if (v == 4 && h == 4) {
+					dst[row * dstPitch + x * factor + column] = src[x];
+					continue;
+				}
+
+				const uint rule = _rowRules[(row * factor + column) * _width + x];
+				dst[row * dstPitch + x * factor + column] = interpolateHQRule<ColorMask>(rule,
+					src[x], src[x + offsets[v]], src[x + offsets[h]], src[x + offsets[d]]);
+			}
+		}
+	}
+}
+
+#endif
+
 #endif
@@ -24,6 +24,7 @@
 #include "common/endian.h"
 #include "common/util.h"
 #include "common/rect.h"
+#include "common/simd.h"
 #include "common/textconsole.h"
 #include "graphics/primitives.h"
 #include "graphics/surface.h"
@@ -225,6 +226,32 @@ void Surface::vLine(int x, int y, int y2, uint32 color) {
 	}
 }
 
+template<typename T>
+static void fillRow(T *ptr, int width, uint32 color) {
+	int x = 0;
+
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	// Fill up to the first 16 byte boundary, then whole vectors
+	for (; x < width && ((size_t)(ptr + x) & 15); ++x)
+		ptr[x] = (T)color;
+
+	const uint32 pattern = sizeof(T) == 2 ? ((color & 0xFFFF) | (color << 16)) : color;
+	const int vectorPixels = 16 / sizeof(T);
+#if defined(SCUMMVM_SSE2)
+	const __m128i vector = _mm_set1_epi32((int)pattern);
+	for (; x + vectorPixels <= width; x += vectorPixels)
+		_mm_store_si128((__m128i *)(ptr + x), vector);
+#else
+	const uint32x4_t vector = vdupq_n_u32(pattern);
+	for (; x + vectorPixels <= width; x += vectorPixels)
+		vst1q_u32((uint32 *)(ptr + x), vector);
+#endif
+#endif
+
+	for (; x < width; ++x)
+		ptr[x] = (T)color;
+}
+
 void Surface::fillRect(Common::Rect r, uint32 color) {
 	r.clip(w, h);
 
@@ -256,13 +283,13 @@ void Surface::fillRect(Common::Rect r, uint32 color) {
 		if (format.bytesPerPixel == 2) {
 			uint16 *ptr = (uint16 *)getBasePtr(r.left, r.top);
 			while (height--) {
-				Common::fill(ptr, ptr + width, (uint16)color);
+				fillRow<uint16>(ptr, width, color);
 				ptr += pitch / 2;
 			}
 		} else {
 			uint32 *ptr = (uint32 *)getBasePtr(r.left, r.top);
 			while (height--) {
-				Common::fill(ptr, ptr + width, color);
+				fillRow<uint32>(ptr, width, color);
 				ptr += pitch / 4;
 			}
 		}
@@ -32,6 +32,7 @@
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/math.h"
+#include "common/simd.h"
 #include "common/textconsole.h"
 #include "graphics/primitives.h"
 #include "graphics/transparent_surface.h"
@@ -64,9 +65,184 @@ void doBlitAdditiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 void doBlitSubtractiveBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
 
-TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL) {}
+// The vectorized blitters below give the exact same results as the plain
+// loops. They handle four pixels at once, which must be stored with alpha
+// in the lowest byte, so they are only used on little endian targets, and
+// only when the source is not flipped horizontally.
+#if (defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)) && defined(SCUMM_LITTLE_ENDIAN)
+#define TRANSPARENT_SURFACE_SIMD
 
-TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL) {
+#if defined(SCUMMVM_SSE2)
+
+/** Replicate the alpha value of the two pixels, unpacked to 16 bits per channel, to all channels. */
+static inline __m128i broadcastAlpha(__m128i pixels) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0));
+}
+
+static uint32 blitOpaqueRow(const byte *in, byte *out, uint32 width) {
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4)
+		_mm_storeu_si128((__m128i *)(out + j * 4), _mm_or_si128(_mm_loadu_si128((const __m128i *)(in + j * 4)), alphaMask));
+	return j;
+}
+
+static uint32 blitBinaryRow(const byte *in, byte *out, uint32 width) {
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const __m128i src = _mm_loadu_si128((const __m128i *)(in + j * 4));
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(out + j * 4));
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), _mm_setzero_si128());
+		_mm_storeu_si128((__m128i *)(out + j * 4),
+			_mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, _mm_or_si128(src, alphaMask))));
+	}
+	return j;
+}
+
+static uint32 blitAlphaBlendRow(const byte *in, byte *out, uint32 width) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const __m128i full = _mm_set1_epi16(255);
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const __m128i src = _mm_loadu_si128((const __m128i *)(in + j * 4));
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(out + j * 4));
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		const __m128i alphaLo = broadcastAlpha(srcLo);
+		const __m128i alphaHi = broadcastAlpha(srcHi);
+
+		// (in * a + out * (255 - a)) >> 8, which stays below 65536
+		const __m128i blendLo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo),
+			_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(full, alphaLo))), 8);
+		const __m128i blendHi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi),
+			_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(full, alphaHi))), 8);
+		const __m128i blend = _mm_or_si128(_mm_packus_epi16(blendLo, blendHi), alphaMask);
+
+		// Fully transparent pixels leave the destination untouched
+		const __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+		_mm_storeu_si128((__m128i *)(out + j * 4), _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, blend)));
+	}
+	return j;
+}
+
+static uint32 blitAlphaBlendModRow(const byte *in, byte *out, uint32 width, byte ca, byte cr, byte cg, byte cb) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xFF);
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i alphaMod = _mm_set1_epi16(ca);
+	const __m128i colorMod = _mm_set_epi16(cr, cg, cb, 0, cr, cg, cb, 0);
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const __m128i src = _mm_loadu_si128((const __m128i *)(in + j * 4));
+		const __m128i dst = _mm_loadu_si128((const __m128i *)(out + j * 4));
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+
+		// ina = a * ca >> 8
+		const __m128i inaLo = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(srcLo), alphaMod), 8);
+		const __m128i inaHi = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(srcHi), alphaMod), 8);
+
+		// (out * (255 - ina) >> 8) + (in * c * ina >> 16), which stays below 255
+		const __m128i blendLo = _mm_add_epi16(
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(dst, zero), _mm_sub_epi16(full, inaLo)), 8),
+			_mm_mulhi_epu16(_mm_mullo_epi16(srcLo, colorMod), inaLo));
+		const __m128i blendHi = _mm_add_epi16(
+			_mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(dst, zero), _mm_sub_epi16(full, inaHi)), 8),
+			_mm_mulhi_epu16(_mm_mullo_epi16(srcHi, colorMod), inaHi));
+
+		_mm_storeu_si128((__m128i *)(out + j * 4), _mm_or_si128(_mm_packus_epi16(blendLo, blendHi), alphaMask));
+	}
+	return j;
+}
+
+#elif defined(SCUMMVM_NEON)
+
+static uint32 blitOpaqueRow(const byte *in, byte *out, uint32 width) {
+	const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF));
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4)
+		vst1q_u8(out + j * 4, vorrq_u8(vld1q_u8(in + j * 4), alphaMask));
+	return j;
+}
+
+static uint32 blitBinaryRow(const byte *in, byte *out, uint32 width) {
+	const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF));
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const uint8x16_t src = vld1q_u8(in + j * 4);
+		const uint8x16_t transparent = vreinterpretq_u8_u32(vceqq_u32(
+			vandq_u32(vreinterpretq_u32_u8(src), vdupq_n_u32(0xFF)), vdupq_n_u32(0)));
+		vst1q_u8(out + j * 4, vbslq_u8(transparent, vld1q_u8(out + j * 4), vorrq_u8(src, alphaMask)));
+	}
+	return j;
+}
+
+static uint32 blitAlphaBlendRow(const byte *in, byte *out, uint32 width) {
+	const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF));
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const uint8x16_t src = vld1q_u8(in + j * 4);
+		const uint8x16_t dst = vld1q_u8(out + j * 4);
+		const uint32x4_t alpha32 = vandq_u32(vreinterpretq_u32_u8(src), vdupq_n_u32(0xFF));
+		const uint8x16_t alpha = vreinterpretq_u8_u32(vmulq_n_u32(alpha32, 0x01010101));
+		const uint8x16_t invAlpha = vmvnq_u8(alpha);
+
+		// (in * a + out * (255 - a)) >> 8, which stays below 65536
+		const uint16x8_t blendLo = vmlal_u8(vmull_u8(vget_low_u8(src), vget_low_u8(alpha)), vget_low_u8(dst), vget_low_u8(invAlpha));
+		const uint16x8_t blendHi = vmlal_u8(vmull_u8(vget_high_u8(src), vget_high_u8(alpha)), vget_high_u8(dst), vget_high_u8(invAlpha));
+		const uint8x16_t blend = vorrq_u8(vcombine_u8(vshrn_n_u16(blendLo, 8), vshrn_n_u16(blendHi, 8)), alphaMask);
+
+		// Fully transparent pixels leave the destination untouched
+		const uint8x16_t transparent = vreinterpretq_u8_u32(vceqq_u32(alpha32, vdupq_n_u32(0)));
+		vst1q_u8(out + j * 4, vbslq_u8(transparent, dst, blend));
+	}
+	return j;
+}
+
+/** (a * b) >> 16 for 16 bit lanes. */
+static inline uint16x8_t mulhi(uint16x8_t a, uint16x8_t b) {
+	return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16),
+		vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16));
+}
+
+static uint32 blitAlphaBlendModRow(const byte *in, byte *out, uint32 width, byte ca, byte cr, byte cg, byte cb) {
+	const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF));
+	const uint8x8_t alphaMod = vdup_n_u8(ca);
+	const uint8x16_t colorMod = vreinterpretq_u8_u32(vdupq_n_u32(((uint32)cr << 24) | ((uint32)cg << 16) | ((uint32)cb << 8)));
+	const uint16x8_t full = vdupq_n_u16(255);
+	uint32 j = 0;
+	for (; j + 4 <= width; j += 4) {
+		const uint8x16_t src = vld1q_u8(in + j * 4);
+		const uint8x16_t dst = vld1q_u8(out + j * 4);
+		const uint32x4_t alpha32 = vandq_u32(vreinterpretq_u32_u8(src), vdupq_n_u32(0xFF));
+		const uint8x16_t alpha = vreinterpretq_u8_u32(vmulq_n_u32(alpha32, 0x01010101));
+
+		// ina = a * ca >> 8
+		const uint16x8_t inaLo = vshrq_n_u16(vmull_u8(vget_low_u8(alpha), alphaMod), 8);
+		const uint16x8_t inaHi = vshrq_n_u16(vmull_u8(vget_high_u8(alpha), alphaMod), 8);
+
+		// (out * (255 - ina) >> 8) + (in * c * ina >> 16), which stays below 255
+		const uint16x8_t blendLo = vaddq_u16(
+			vshrq_n_u16(vmulq_u16(vmovl_u8(vget_low_u8(dst)), vsubq_u16(full, inaLo)), 8),
+			mulhi(vmull_u8(vget_low_u8(src), vget_low_u8(colorMod)), inaLo));
+		const uint16x8_t blendHi = vaddq_u16(
+			vshrq_n_u16(vmulq_u16(vmovl_u8(vget_high_u8(dst)), vsubq_u16(full, inaHi)), 8),
+			mulhi(vmull_u8(vget_high_u8(src), vget_high_u8(colorMod)), inaHi));
+
+		vst1q_u8(out + j * 4, vorrq_u8(vcombine_u8(vmovn_u16(blendLo), vmovn_u16(blendHi)), alphaMask));
+	}
+	return j;
+}
+
+#endif
+
+#endif // SIMD && SCUMM_LITTLE_ENDIAN
+
+TransparentSurface::TransparentSurface() : Surface(), _alphaMode(ALPHA_FULL), _transformCache(nullptr) {}
+
+TransparentSurface::TransparentSurface(const Surface &surf, bool copyData) : Surface(), _alphaMode(ALPHA_FULL), _transformCache(nullptr) {
 	if (copyData) {
 		copyFrom(surf);
 	} else {
@@ -92,8 +268,15 @@ void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
+#ifdef TRANSPARENT_SURFACE_SIMD
+		const uint32 done = blitOpaqueRow(in, out, width);
+		memcpy(out + done * 4, in + done * 4, (width - done) * 4);
+		out += done * 4;
+		for (uint32 j = done; j < width; j++) {
+#else
 		memcpy(out, in, width * 4);
 		for (uint32 j = 0; j < width; j++) {
+#endif
 			out[kAIndex] = 0xFF;
 			out += 4;
 		}
@@ -113,7 +296,15 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	for (uint32 i = 0; i < height; i++) {
 		out = outo;
 		in = ino;
-		for (uint32 j = 0; j < width; j++) {
+		uint32 j = 0;
+#ifdef TRANSPARENT_SURFACE_SIMD
+		if (inStep == 4) {
+			j = blitBinaryRow(in, out, width);
+			in += j * 4;
+			out += j * 4;
+		}
+#endif
+		for (; j < width; j++) {
 			uint32 pix = *(uint32 *)in;
 			int a = in[kAIndex];
 
@@ -149,7 +340,15 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef TRANSPARENT_SURFACE_SIMD
+			if (inStep == 4) {
+				j = blitAlphaBlendRow(in, out, width);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				if (in[kAIndex] != 0) {
 					out[kAIndex] = 255;
@@ -174,7 +373,15 @@ void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 		for (uint32 i = 0; i < height; i++) {
 			out = outo;
 			in = ino;
-			for (uint32 j = 0; j < width; j++) {
+			uint32 j = 0;
+#ifdef TRANSPARENT_SURFACE_SIMD
+			if (inStep == 4) {
+				j = blitAlphaBlendModRow(in, out, width, ca, cr, cg, cb);
+				in += j * 4;
+				out += j * 4;
+			}
+#endif
+			for (; j < width; j++) {
 
 				uint32 ina = in[kAIndex] * ca >> 8;
 				out[kAIndex] = 255;
@@ -415,6 +622,7 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 		return retSize;
 	}
 
+	Common::Rect srcRect(0, 0, w, h);
 	if (pPartRect) {
 
 		int xOffset = pPartRect->left;
@@ -431,6 +639,7 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 		srcImage.pixels = getBasePtr(xOffset, yOffset);
 		srcImage.w = pPartRect->width();
 		srcImage.h = pPartRect->height();
+		srcRect = Common::Rect(xOffset, yOffset, xOffset + srcImage.w, yOffset + srcImage.h);
 
 		debug(6, "Blit(%d, %d, %d, [%d, %d, %d, %d], %08x, %d, %d)", posX, posY, flipping,
 			  pPartRect->left,  pPartRect->top, pPartRect->width(), pPartRect->height(), color, width, height);
@@ -455,11 +664,17 @@ Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int p
 
 	Graphics::Surface *img = nullptr;
 	Graphics::Surface *imgScaled = nullptr;
+	TransparentSurface cachedImage;
 	byte *savedPixels = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
 		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
+		if (_transformCache) {
+			cachedImage = TransparentSurface(*_transformCache->getTransformed(*this, srcRect, TransformStruct(), width, height, FILTER_NEAREST), false);
+			img = &cachedImage;
+		} else {
+			img = imgScaled = srcImage.scale(width, height);
+			savedPixels = (byte *)img->getPixels();
+		}
 	} else {
 		img = &srcImage;
 	}
@@ -562,6 +777,7 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 		return retSize;
 	}
 
+	Common::Rect srcRect(0, 0, w, h);
 	if (pPartRect) {
 
 		int xOffset = pPartRect->left;
@@ -578,6 +794,7 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 		srcImage.pixels = getBasePtr(xOffset, yOffset);
 		srcImage.w = pPartRect->width();
 		srcImage.h = pPartRect->height();
+		srcRect = Common::Rect(xOffset, yOffset, xOffset + srcImage.w, yOffset + srcImage.h);
 
 		debug(6, "Blit(%d, %d, %d, [%d, %d, %d, %d], %08x, %d, %d)", posX, posY, flipping,
 			pPartRect->left, pPartRect->top, pPartRect->width(), pPartRect->height(), color, width, height);
@@ -602,11 +819,17 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 
 	Graphics::Surface *img = nullptr;
 	Graphics::Surface *imgScaled = nullptr;
+	TransparentSurface cachedImage;
 	byte *savedPixels = nullptr;
 	if ((width != srcImage.w) || (height != srcImage.h)) {
 		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
+		if (_transformCache) {
+			cachedImage = TransparentSurface(*_transformCache->getTransformed(*this, srcRect, TransformStruct(), width, height, FILTER_NEAREST), false);
+			img = &cachedImage;
+		} else {
+			img = imgScaled = srcImage.scale(width, height);
+			savedPixels = (byte *)img->getPixels();
+		}
 	} else {
 		img = &srcImage;
 	}
@@ -713,6 +936,69 @@ void TransparentSurface::applyColorKey(uint8 rKey, uint8 gKey, uint8 bKey, bool
 	}
 }
 
+TransformCache::TransformCache(uint maxEntries) : _maxEntries(maxEntries), _hits(0), _misses(0) {
+	assert(maxEntries > 0);
+}
+
+TransformCache::~TransformCache() {
+	clear();
+}
+
+Common::SharedPtr<const TransparentSurface> TransformCache::getTransformed(const Surface &src, const Common::Rect &srcRect, const TransformStruct &transform,
+		uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode) {
+	for (uint i = 0; i < _entries.size(); ++i) {
+		const Entry &entry = _entries[i];
+		// Only the angle, zoom and hotspot change the transformed image
+		if (entry.srcRect == srcRect && entry.width == newWidth && entry.height == newHeight &&
+				entry.filteringMode == filteringMode && entry.transform._angle == transform._angle &&
+				entry.transform._zoom == transform._zoom && entry.transform._hotspot == transform._hotspot) {
+			_hits++;
+			if (i > 0)
+				_entries.insert_at(0, _entries.remove_at(i));
+			return _entries[0].surface;
+		}
+	}
+
+	_misses++;
+
+	// Transform a compact copy of the part, since scaleT() expects the
+	// pitch to match the width
+	TransparentSurface part;
+	part.create(srcRect.width(), srcRect.height(), src.format);
+	part.copyRectToSurface(src, 0, 0, srcRect);
+
+	Entry entry;
+	entry.srcRect = srcRect;
+	entry.transform = transform;
+	entry.width = newWidth;
+	entry.height = newHeight;
+	entry.filteringMode = filteringMode;
+	TransparentSurface *transformed;
+	if (transform._angle != 0) {
+		if (filteringMode == FILTER_BILINEAR)
+			transformed = part.rotoscaleT<FILTER_BILINEAR>(transform);
+		else
+			transformed = part.rotoscaleT<FILTER_NEAREST>(transform);
+	} else {
+		if (filteringMode == FILTER_BILINEAR)
+			transformed = part.scaleT<FILTER_BILINEAR>(newWidth, newHeight);
+		else
+			transformed = part.scaleT<FILTER_NEAREST>(newWidth, newHeight);
+	}
+	entry.surface = Common::SharedPtr<const TransparentSurface>(transformed, SharedPtrTransparentSurfaceDeleter());
+	part.free();
+
+	if (_entries.size() >= _maxEntries)
+		_entries.pop_back();
+	_entries.insert_at(0, entry);
+
+	return entry.surface;
+}
+
+void TransformCache::clear() {
+	_entries.clear();
+}
+
 AlphaType TransparentSurface::getAlphaMode() const {
 	return _alphaMode;
 }
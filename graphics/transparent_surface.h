@@ -26,6 +26,10 @@
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
 
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/ptr.h"
+
 /*
  * This code is based on Broken Sword 2.5 engine
  *
@@ -45,6 +49,8 @@
 
 namespace Graphics {
 
+class TransformCache;
+
 // Enums
 /**
  @brief The possible flipping parameters for the blit method.
@@ -174,24 +180,90 @@ struct TransparentSurface : public Graphics::Surface {
 
 	AlphaType getAlphaMode() const;
 	void setAlphaMode(AlphaType);
+
+	/**
+	 * Set a cache for the scaled images blit() needs, so that blitting the
+	 * same part of the surface with the same size again does not need to
+	 * scale it again. The cache must be cleared when the pixels change.
+	 *
+	 * @param cache the cache to use, or nullptr to scale on every blit
+	 */
+	void setTransformCache(TransformCache *cache) { _transformCache = cache; }
+
 private:
 	AlphaType _alphaMode;
+	TransformCache *_transformCache;
 
 	template <typename Size>
 	void scaleNN(int *scaleCacheX, TransparentSurface *target) const;
 };
 
 /**
- * A deleter for Surface objects which can be used with SharedPtr.
+ * Keeps the last results of scaling or rotating parts of a surface, so that
+ * drawing the same part of a sprite with the same transform again does not
+ * need to transform and allocate it again.
+ *
+ * The cache does not notice changes to the source surface: its owner must
+ * call clear() whenever the pixels change. The transformed images are
+ * reference counted, so users may keep one past clear() or its eviction,
+ * still showing the pixels it was made from.
+ */
+class TransformCache : Common::NonCopyable {
+public:
+	/**
+	 * @param maxEntries the number of transformed images to keep
+	 */
+	explicit TransformCache(uint maxEntries = 2);
+	~TransformCache();
+
+	/**
+	 * Get a part of the source surface transformed like
+	 * TransparentSurface::rotoscaleT() does, if the angle of the transform
+	 * is not 0, or else scaled to the given size like
+	 * TransparentSurface::scaleT() does.
+	 *
+	 * @return the transformed image, shared with the cache
+	 */
+	Common::SharedPtr<const TransparentSurface> getTransformed(const Surface &src, const Common::Rect &srcRect, const TransformStruct &transform,
+	                                         uint16 newWidth, uint16 newHeight, TFilteringMode filteringMode);
+
+	/**
+	 * Free all transformed images.
+	 */
+	void clear();
+
+	uint32 getHits() const { return _hits; }
+	uint32 getMisses() const { return _misses; }
+
+private:
+	struct Entry {
+		Common::Rect srcRect;
+		TransformStruct transform;
+		uint16 width;
+		uint16 height;
+		TFilteringMode filteringMode;
+		Common::SharedPtr<const TransparentSurface> surface;
+	};
+
+	/** The cached images, the most recently used first. */
+	Common::Array<Entry> _entries;
+	const uint _maxEntries;
+
+	uint32 _hits;
+	uint32 _misses;
+};
+
+/**
+ * A deleter for TransparentSurface objects which can be used with SharedPtr.
  *
  * This deleter assures Surface::free is called on deletion.
  */
-/*struct SharedPtrTransparentSurfaceDeleter {
-    void operator()(TransparentSurface *ptr) {
-        ptr->free();
-        delete ptr;
-    }
-};*/
+struct SharedPtrTransparentSurfaceDeleter {
+	void operator()(TransparentSurface *ptr) {
+		ptr->free();
+		delete ptr;
+	}
+};
 
 } // End of namespace Graphics
 
@@ -83,6 +83,9 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/simd.h"
+#include "common/util.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -157,8 +160,9 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 	}
 }
 
-YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
+YUVToRGBManager::YUVToRGBManager() : _useSIMD(true) {
+	for (int i = 0; i < kLookupCacheSize; i++)
+		_lookups[i] = 0;
 
 	int16 *Cr_r_tab = &_colorTab[0 * 256];
 	int16 *Cr_g_tab = &_colorTab[1 * 256];
@@ -180,16 +184,30 @@ YUVToRGBManager::YUVToRGBManager() {
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (int i = 0; i < kLookupCacheSize; i++)
+		delete _lookups[i];
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
-		return _lookup;
+	if (_lookups[0] && _lookups[0]->getFormat() == format && _lookups[0]->getScale() == scale)
+		return _lookups[0];
+
+	int i = 1;
+	while (i < kLookupCacheSize - 1 && _lookups[i] && (_lookups[i]->getFormat() != format || _lookups[i]->getScale() != scale))
+		i++;
+
+	YUVToRGBLookup *lookup = _lookups[i];
+	if (!lookup || lookup->getFormat() != format || lookup->getScale() != scale) {
+		// Not cached, replace the least recently used table
+		delete lookup;
+		lookup = new YUVToRGBLookup(format, scale);
+	}
+
+	for (; i > 0; i--)
+		_lookups[i] = _lookups[i - 1];
+	_lookups[0] = lookup;
 
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale);
-	return _lookup;
+	return lookup;
 }
 
 #define PUT_PIXEL(s, d) \
@@ -227,21 +245,6 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
-void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
-	// Sanity checks
-	assert(dst && dst->getPixels());
-	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
-	assert(ySrc && uSrc && vSrc);
-
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
-
-	// Use a templated function to avoid an if check on every pixel
-	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
-}
-
 template<typename PixelInt>
 void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
@@ -274,28 +277,570 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
 	}
 }
 
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+
+// The vectorized conversion computes the entries of the lookup tables
+// instead of reading them, giving the exact same results:
+//
+// - The chroma tables hold trunc(k * c) for c = -128..127, which is
+//   calculated as the sign of c times |c| * k in fixed point. The
+//   multipliers below have been verified to be exact for all values.
+// - The rgbToPix tables clamp the sum of luma and chroma to the range of
+//   the luminance scale. For the ITU scale, the value v = i - 16 is mapped
+//   to v * 255 / 219 = v + ((v * 10776) >> 16), which is exact for
+//   v = 0..219 and stays out of range otherwise. Both scales are clamped
+//   by saturating to bytes.
+// - The bytes are then shifted into place according to the pixel format.
+//
+// Each iteration handles 16 pixels of a row, or of each of the two rows
+// sharing a chroma row in YUV420. The remaining pixels are left to the
+// table based functions above.
+
+namespace {
+
+// |c| * k is |c| * kInt + mulhi(|c| << kShift, kMul)
+const int kCrRShift = 6, kCrRMul = 410;   // |Cr| * 0.419 / 0.299
+const int kCrGShift = 5, kCrGMul = 1462;  // |Cr| * 0.299 / 0.419
+const int kCbGShift = 2, kCbGMul = 5642;  // |Cb| * 0.114 / 0.331
+const int kCbBShift = 1, kCbBMul = 25342; // |Cb| * 0.587 / 0.331
+
+/** Byte positions of the channels of 32 bit formats with 8 bits per channel. */
+enum {
+	kLayoutRGBA, ///< R in the highest byte, then G, B, alpha/unused
+	kLayoutARGB, ///< Alpha/unused in the highest byte, then R, G, B
+	kLayoutABGR, ///< Alpha/unused in the highest byte, then B, G, R
+	kLayoutBGRA, ///< B in the highest byte, then G, R, alpha/unused
+	kLayoutOther
+};
+
+#ifdef SCUMM_LITTLE_ENDIAN
+int getByteLayout(const Graphics::PixelFormat &format) {
+	if (format.bytesPerPixel != 4 || format.rLoss || format.gLoss || format.bLoss || (format.aLoss != 0 && format.aLoss != 8))
+		return kLayoutOther;
+
+	if (format.rShift == 24 && format.gShift == 16 && format.bShift == 8 && (format.aLoss == 8 || format.aShift == 0))
+		return kLayoutRGBA;
+	if (format.rShift == 16 && format.gShift == 8 && format.bShift == 0 && (format.aLoss == 8 || format.aShift == 24))
+		return kLayoutARGB;
+	if (format.rShift == 0 && format.gShift == 8 && format.bShift == 16 && (format.aLoss == 8 || format.aShift == 24))
+		return kLayoutABGR;
+	if (format.rShift == 8 && format.gShift == 16 && format.bShift == 24 && (format.aLoss == 8 || format.aShift == 0))
+		return kLayoutBGRA;
+
+	return kLayoutOther;
+}
+#endif
+
+#if defined(SCUMMVM_SSE2)
+
+/** trunc(c * k) for a channel, given |c| and the sign mask of c. */
+template<int kInt, int kShift, int kMul>
+inline __m128i chromaProduct(__m128i abs, __m128i sign) {
+	__m128i product = _mm_mulhi_epu16(_mm_slli_epi16(abs, kShift), _mm_set1_epi16(kMul));
+	if (kInt)
+		product = _mm_add_epi16(product, abs);
+	return _mm_sub_epi16(_mm_xor_si128(product, sign), sign);
+}
+
+/** The chroma offsets of 8 pixels, relative to the start of the luminance range. */
+struct Chroma {
+	__m128i r, g, b;
+};
+
+inline void computeChroma(Chroma &chroma, __m128i u, __m128i v, __m128i base) {
+	const __m128i cr = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	const __m128i cb = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	const __m128i crSign = _mm_srai_epi16(cr, 15);
+	const __m128i cbSign = _mm_srai_epi16(cb, 15);
+	const __m128i crAbs = _mm_sub_epi16(_mm_xor_si128(cr, crSign), crSign);
+	const __m128i cbAbs = _mm_sub_epi16(_mm_xor_si128(cb, cbSign), cbSign);
+
+	chroma.r = _mm_add_epi16(base, chromaProduct<1, kCrRShift, kCrRMul>(crAbs, crSign));
+	chroma.g = _mm_sub_epi16(_mm_sub_epi16(base, chromaProduct<0, kCrGShift, kCrGMul>(crAbs, crSign)),
+	                         chromaProduct<0, kCbGShift, kCbGMul>(cbAbs, cbSign));
+	chroma.b = _mm_add_epi16(base, chromaProduct<1, kCbBShift, kCbBMul>(cbAbs, cbSign));
+}
+
+/** Add luma and chroma of 16 pixels and saturate them to bytes. */
+template<bool scaleITU>
+inline __m128i computeChannel(__m128i yLo, __m128i yHi, __m128i cLo, __m128i cHi) {
+	__m128i lo = _mm_add_epi16(yLo, cLo);
+	__m128i hi = _mm_add_epi16(yHi, cHi);
+
+	if (scaleITU) {
+		lo = _mm_add_epi16(lo, _mm_mulhi_epi16(lo, _mm_set1_epi16(10776)));
+		hi = _mm_add_epi16(hi, _mm_mulhi_epi16(hi, _mm_set1_epi16(10776)));
+	}
+
+	return _mm_packus_epi16(lo, hi);
+}
+
+/** Writes pixels in formats with 8 bit channels in whole bytes. */
+template<int layout>
+struct BytePixelWriter {
+	typedef uint32 PixelInt;
+
+	__m128i alpha;
+
+	explicit BytePixelWriter(const Graphics::PixelFormat &format) {
+		alpha = _mm_set1_epi8((char)(format.aLoss ? 0 : 0xFF));
+	}
+
+	void write(uint32 *dst, __m128i r, __m128i g, __m128i b) const {
+		// The channels from the lowest to the highest byte
+		__m128i c0, c1, c2, c3;
+		switch (layout) {
+		case kLayoutRGBA: c0 = alpha; c1 = b; c2 = g; c3 = r; break;
+		case kLayoutARGB: c0 = b; c1 = g; c2 = r; c3 = alpha; break;
+		case kLayoutABGR: c0 = r; c1 = g; c2 = b; c3 = alpha; break;
+		default:          c0 = alpha; c1 = r; c2 = g; c3 = b; break;
+		}
+
+		const __m128i lo01 = _mm_unpacklo_epi8(c0, c1), hi01 = _mm_unpackhi_epi8(c0, c1);
+		const __m128i lo23 = _mm_unpacklo_epi8(c2, c3), hi23 = _mm_unpackhi_epi8(c2, c3);
+		_mm_storeu_si128((__m128i *)dst + 0, _mm_unpacklo_epi16(lo01, lo23));
+		_mm_storeu_si128((__m128i *)dst + 1, _mm_unpackhi_epi16(lo01, lo23));
+		_mm_storeu_si128((__m128i *)dst + 2, _mm_unpacklo_epi16(hi01, hi23));
+		_mm_storeu_si128((__m128i *)dst + 3, _mm_unpackhi_epi16(hi01, hi23));
+	}
+};
+
+/** Writes pixels in any 16 bit format. */
+struct PixelWriter16 {
+	typedef uint16 PixelInt;
+
+	__m128i rLoss, gLoss, bLoss, rShift, gShift, bShift, alpha;
+
+	explicit PixelWriter16(const Graphics::PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss); rShift = _mm_cvtsi32_si128(format.rShift);
+		gLoss = _mm_cvtsi32_si128(format.gLoss); gShift = _mm_cvtsi32_si128(format.gShift);
+		bLoss = _mm_cvtsi32_si128(format.bLoss); bShift = _mm_cvtsi32_si128(format.bShift);
+		alpha = _mm_set1_epi16((int16)((0xFF >> format.aLoss) << format.aShift));
+	}
+
+	__m128i pack(__m128i r, __m128i g, __m128i b) const {
+		__m128i pixels = _mm_or_si128(alpha, _mm_sll_epi16(_mm_srl_epi16(r, rLoss), rShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(g, gLoss), gShift));
+		return _mm_or_si128(pixels, _mm_sll_epi16(_mm_srl_epi16(b, bLoss), bShift));
+	}
+
+	void write(uint16 *dst, __m128i r, __m128i g, __m128i b) const {
+		const __m128i zero = _mm_setzero_si128();
+		_mm_storeu_si128((__m128i *)dst + 0, pack(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(b, zero)));
+		_mm_storeu_si128((__m128i *)dst + 1, pack(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(b, zero)));
+	}
+};
+
+/** Writes pixels in any 32 bit format. */
+struct PixelWriter32 {
+	typedef uint32 PixelInt;
+
+	__m128i rLoss, gLoss, bLoss, rShift, gShift, bShift, alpha;
+
+	explicit PixelWriter32(const Graphics::PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss); rShift = _mm_cvtsi32_si128(format.rShift);
+		gLoss = _mm_cvtsi32_si128(format.gLoss); gShift = _mm_cvtsi32_si128(format.gShift);
+		bLoss = _mm_cvtsi32_si128(format.bLoss); bShift = _mm_cvtsi32_si128(format.bShift);
+		alpha = _mm_set1_epi32((int32)((0xFF >> format.aLoss) << format.aShift));
+	}
+
+	__m128i pack(__m128i r, __m128i g, __m128i b) const {
+		__m128i pixels = _mm_or_si128(alpha, _mm_sll_epi32(_mm_srl_epi32(r, rLoss), rShift));
+		pixels = _mm_or_si128(pixels, _mm_sll_epi32(_mm_srl_epi32(g, gLoss), gShift));
+		return _mm_or_si128(pixels, _mm_sll_epi32(_mm_srl_epi32(b, bLoss), bShift));
+	}
+
+	void write(uint32 *dst, __m128i r, __m128i g, __m128i b) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i rLo = _mm_unpacklo_epi8(r, zero), rHi = _mm_unpackhi_epi8(r, zero);
+		const __m128i gLo = _mm_unpacklo_epi8(g, zero), gHi = _mm_unpackhi_epi8(g, zero);
+		const __m128i bLo = _mm_unpacklo_epi8(b, zero), bHi = _mm_unpackhi_epi8(b, zero);
+		_mm_storeu_si128((__m128i *)dst + 0, pack(_mm_unpacklo_epi16(rLo, zero), _mm_unpacklo_epi16(gLo, zero), _mm_unpacklo_epi16(bLo, zero)));
+		_mm_storeu_si128((__m128i *)dst + 1, pack(_mm_unpackhi_epi16(rLo, zero), _mm_unpackhi_epi16(gLo, zero), _mm_unpackhi_epi16(bLo, zero)));
+		_mm_storeu_si128((__m128i *)dst + 2, pack(_mm_unpacklo_epi16(rHi, zero), _mm_unpacklo_epi16(gHi, zero), _mm_unpacklo_epi16(bHi, zero)));
+		_mm_storeu_si128((__m128i *)dst + 3, pack(_mm_unpackhi_epi16(rHi, zero), _mm_unpackhi_epi16(gHi, zero), _mm_unpackhi_epi16(bHi, zero)));
+	}
+};
+
+template<class Writer, bool scaleITU>
+inline void convertPixels(const Writer &writer, typename Writer::PixelInt *dst, const byte *ySrc, const Chroma &lo, const Chroma &hi) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y = _mm_loadu_si128((const __m128i *)ySrc);
+	const __m128i yLo = _mm_unpacklo_epi8(y, zero);
+	const __m128i yHi = _mm_unpackhi_epi8(y, zero);
+
+	writer.write(dst,
+	             computeChannel<scaleITU>(yLo, yHi, lo.r, hi.r),
+	             computeChannel<scaleITU>(yLo, yHi, lo.g, hi.g),
+	             computeChannel<scaleITU>(yLo, yHi, lo.b, hi.b));
+}
+
+/**
+ * Convert the pixels of the given rows in groups of 16.
+ *
+ * @return the number of pixels converted in each row
+ */
+template<class Writer, bool yuv420, bool scaleITU>
+int convertRowsSIMD(const Writer &writer, byte *dstPtr, int dstPitch, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	typedef typename Writer::PixelInt PixelInt;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i base = _mm_set1_epi16(scaleITU ? -16 : 0);
+	const int width = yWidth & ~15;
+
+	for (int h = 0; h < yHeight; h += (yuv420 ? 2 : 1)) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+
+		for (int x = 0; x < width; x += 16) {
+			Chroma lo, hi;
+
+			if (yuv420) {
+				Chroma chroma;
+				computeChroma(chroma, _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(uSrc + (x >> 1))), zero),
+				                      _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(vSrc + (x >> 1))), zero), base);
+
+				// Each chroma value is used for two neighboring pixels
+				lo.r = _mm_unpacklo_epi16(chroma.r, chroma.r); hi.r = _mm_unpackhi_epi16(chroma.r, chroma.r);
+				lo.g = _mm_unpacklo_epi16(chroma.g, chroma.g); hi.g = _mm_unpackhi_epi16(chroma.g, chroma.g);
+				lo.b = _mm_unpacklo_epi16(chroma.b, chroma.b); hi.b = _mm_unpackhi_epi16(chroma.b, chroma.b);
+
+				convertPixels<Writer, scaleITU>(writer, dst + x, ySrc + x, lo, hi);
+				convertPixels<Writer, scaleITU>(writer, (PixelInt *)(dstPtr + dstPitch) + x, ySrc + yPitch + x, lo, hi);
+			} else {
+				const __m128i u = _mm_loadu_si128((const __m128i *)(uSrc + x));
+				const __m128i v = _mm_loadu_si128((const __m128i *)(vSrc + x));
+				computeChroma(lo, _mm_unpacklo_epi8(u, zero), _mm_unpacklo_epi8(v, zero), base);
+				computeChroma(hi, _mm_unpackhi_epi8(u, zero), _mm_unpackhi_epi8(v, zero), base);
+
+				convertPixels<Writer, scaleITU>(writer, dst + x, ySrc + x, lo, hi);
+			}
+		}
+
+		dstPtr += dstPitch * (yuv420 ? 2 : 1);
+		ySrc += yPitch * (yuv420 ? 2 : 1);
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+
+	return width;
+}
+
+#elif defined(SCUMMVM_NEON)
+
+/** trunc(c * k) for a channel, given |c| and the sign mask of c. */
+template<int kInt, int kShift, int kMul>
+inline int16x8_t chromaProduct(int16x8_t abs, int16x8_t sign) {
+	// vqdmulh doubles the product, so this is mulhi(abs << kShift, kMul)
+	int16x8_t product = vqdmulhq_s16(vshlq_n_s16(abs, kShift), vdupq_n_s16(kMul / 2));
+	if (kInt)
+		product = vaddq_s16(product, abs);
+	return vsubq_s16(veorq_s16(product, sign), sign);
+}
+
+/** The chroma offsets of 8 pixels, relative to the start of the luminance range. */
+struct Chroma {
+	int16x8_t r, g, b;
+};
+
+inline void computeChroma(Chroma &chroma, uint8x8_t u, uint8x8_t v, int16x8_t base) {
+	const int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), vdupq_n_s16(128));
+	const int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), vdupq_n_s16(128));
+	const int16x8_t crSign = vshrq_n_s16(cr, 15);
+	const int16x8_t cbSign = vshrq_n_s16(cb, 15);
+	const int16x8_t crAbs = vabsq_s16(cr);
+	const int16x8_t cbAbs = vabsq_s16(cb);
+
+	chroma.r = vaddq_s16(base, chromaProduct<1, kCrRShift, kCrRMul>(crAbs, crSign));
+	chroma.g = vsubq_s16(vsubq_s16(base, chromaProduct<0, kCrGShift, kCrGMul>(crAbs, crSign)),
+	                     chromaProduct<0, kCbGShift, kCbGMul>(cbAbs, cbSign));
+	chroma.b = vaddq_s16(base, chromaProduct<1, kCbBShift, kCbBMul>(cbAbs, cbSign));
+}
+
+/** Add luma and chroma of 16 pixels and saturate them to bytes. */
+template<bool scaleITU>
+inline uint8x16_t computeChannel(int16x8_t yLo, int16x8_t yHi, int16x8_t cLo, int16x8_t cHi) {
+	int16x8_t lo = vaddq_s16(yLo, cLo);
+	int16x8_t hi = vaddq_s16(yHi, cHi);
+
+	if (scaleITU) {
+		// vqdmulh doubles the product, so this is (value * 10776) >> 16
+		lo = vaddq_s16(lo, vqdmulhq_s16(lo, vdupq_n_s16(5388)));
+		hi = vaddq_s16(hi, vqdmulhq_s16(hi, vdupq_n_s16(5388)));
+	}
+
+	return vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi));
+}
+
+/** Writes pixels in formats with 8 bit channels in whole bytes. */
+template<int layout>
+struct BytePixelWriter {
+	typedef uint32 PixelInt;
+
+	uint8x16_t alpha;
+
+	explicit BytePixelWriter(const Graphics::PixelFormat &format) {
+		alpha = vdupq_n_u8(format.aLoss ? 0 : 0xFF);
+	}
+
+	void write(uint32 *dst, uint8x16_t r, uint8x16_t g, uint8x16_t b) const {
+		// The channels from the lowest to the highest byte, which is
+		// their order in memory on little endian systems
+		uint8x16x4_t pixels;
+		switch (layout) {
+		case kLayoutRGBA: pixels.val[0] = alpha; pixels.val[1] = b; pixels.val[2] = g; pixels.val[3] = r; break;
+		case kLayoutARGB: pixels.val[0] = b; pixels.val[1] = g; pixels.val[2] = r; pixels.val[3] = alpha; break;
+		case kLayoutABGR: pixels.val[0] = r; pixels.val[1] = g; pixels.val[2] = b; pixels.val[3] = alpha; break;
+		default:          pixels.val[0] = alpha; pixels.val[1] = r; pixels.val[2] = g; pixels.val[3] = b; break;
+		}
+
+		vst4q_u8((uint8 *)dst, pixels);
+	}
+};
+
+/** Writes pixels in any 16 bit format. */
+struct PixelWriter16 {
+	typedef uint16 PixelInt;
+
+	int16x8_t rLoss, gLoss, bLoss, rShift, gShift, bShift;
+	uint16x8_t alpha;
+
+	explicit PixelWriter16(const Graphics::PixelFormat &format) {
+		// vshl shifts to the right for negative counts
+		rLoss = vdupq_n_s16(-format.rLoss); rShift = vdupq_n_s16(format.rShift);
+		gLoss = vdupq_n_s16(-format.gLoss); gShift = vdupq_n_s16(format.gShift);
+		bLoss = vdupq_n_s16(-format.bLoss); bShift = vdupq_n_s16(format.bShift);
+		alpha = vdupq_n_u16((uint16)((0xFF >> format.aLoss) << format.aShift));
+	}
+
+	uint16x8_t pack(uint16x8_t r, uint16x8_t g, uint16x8_t b) const {
+		uint16x8_t pixels = vorrq_u16(alpha, vshlq_u16(vshlq_u16(r, rLoss), rShift));
+		pixels = vorrq_u16(pixels, vshlq_u16(vshlq_u16(g, gLoss), gShift));
+		return vorrq_u16(pixels, vshlq_u16(vshlq_u16(b, bLoss), bShift));
+	}
+
+	void write(uint16 *dst, uint8x16_t r, uint8x16_t g, uint8x16_t b) const {
+		vst1q_u16(dst + 0, pack(vmovl_u8(vget_low_u8(r)), vmovl_u8(vget_low_u8(g)), vmovl_u8(vget_low_u8(b))));
+		vst1q_u16(dst + 8, pack(vmovl_u8(vget_high_u8(r)), vmovl_u8(vget_high_u8(g)), vmovl_u8(vget_high_u8(b))));
+	}
+};
+
+/** Writes pixels in any 32 bit format. */
+struct PixelWriter32 {
+	typedef uint32 PixelInt;
+
+	int32x4_t rLoss, gLoss, bLoss, rShift, gShift, bShift;
+	uint32x4_t alpha;
+
+	explicit PixelWriter32(const Graphics::PixelFormat &format) {
+		// vshl shifts to the right for negative counts
+		rLoss = vdupq_n_s32(-format.rLoss); rShift = vdupq_n_s32(format.rShift);
+		gLoss = vdupq_n_s32(-format.gLoss); gShift = vdupq_n_s32(format.gShift);
+		bLoss = vdupq_n_s32(-format.bLoss); bShift = vdupq_n_s32(format.bShift);
+		alpha = vdupq_n_u32((0xFF >> format.aLoss) << format.aShift);
+	}
+
+	uint32x4_t pack(uint16x4_t r, uint16x4_t g, uint16x4_t b) const {
+		uint32x4_t pixels = vorrq_u32(alpha, vshlq_u32(vshlq_u32(vmovl_u16(r), rLoss), rShift));
+		pixels = vorrq_u32(pixels, vshlq_u32(vshlq_u32(vmovl_u16(g), gLoss), gShift));
+		return vorrq_u32(pixels, vshlq_u32(vshlq_u32(vmovl_u16(b), bLoss), bShift));
+	}
+
+	void write(uint32 *dst, uint8x16_t r, uint8x16_t g, uint8x16_t b) const {
+		const uint16x8_t rLo = vmovl_u8(vget_low_u8(r)), rHi = vmovl_u8(vget_high_u8(r));
+		const uint16x8_t gLo = vmovl_u8(vget_low_u8(g)), gHi = vmovl_u8(vget_high_u8(g));
+		const uint16x8_t bLo = vmovl_u8(vget_low_u8(b)), bHi = vmovl_u8(vget_high_u8(b));
+		vst1q_u32(dst +  0, pack(vget_low_u16(rLo), vget_low_u16(gLo), vget_low_u16(bLo)));
+		vst1q_u32(dst +  4, pack(vget_high_u16(rLo), vget_high_u16(gLo), vget_high_u16(bLo)));
+		vst1q_u32(dst +  8, pack(vget_low_u16(rHi), vget_low_u16(gHi), vget_low_u16(bHi)));
+		vst1q_u32(dst + 12, pack(vget_high_u16(rHi), vget_high_u16(gHi), vget_high_u16(bHi)));
+	}
+};
+
+template<class Writer, bool scaleITU>
+inline void convertPixels(const Writer &writer, typename Writer::PixelInt *dst, const byte *ySrc, const Chroma &lo, const Chroma &hi) {
+	const uint8x16_t y = vld1q_u8(ySrc);
+	const int16x8_t yLo = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y)));
+	const int16x8_t yHi = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y)));
+
+	writer.write(dst,
+	             computeChannel<scaleITU>(yLo, yHi, lo.r, hi.r),
+	             computeChannel<scaleITU>(yLo, yHi, lo.g, hi.g),
+	             computeChannel<scaleITU>(yLo, yHi, lo.b, hi.b));
+}
+
+/**
+ * Convert the pixels of the given rows in groups of 16.
+ *
+ * @return the number of pixels converted in each row
+ */
+template<class Writer, bool yuv420, bool scaleITU>
+int convertRowsSIMD(const Writer &writer, byte *dstPtr, int dstPitch, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	typedef typename Writer::PixelInt PixelInt;
+
+	const int16x8_t base = vdupq_n_s16(scaleITU ? -16 : 0);
+	const int width = yWidth & ~15;
+
+	for (int h = 0; h < yHeight; h += (yuv420 ? 2 : 1)) {
+		PixelInt *dst = (PixelInt *)dstPtr;
+
+		for (int x = 0; x < width; x += 16) {
+			Chroma lo, hi;
+
+			if (yuv420) {
+				Chroma chroma;
+				computeChroma(chroma, vld1_u8(uSrc + (x >> 1)), vld1_u8(vSrc + (x >> 1)), base);
+
+				// Each chroma value is used for two neighboring pixels
+				const int16x8x2_t r = vzipq_s16(chroma.r, chroma.r);
+				const int16x8x2_t g = vzipq_s16(chroma.g, chroma.g);
+				const int16x8x2_t b = vzipq_s16(chroma.b, chroma.b);
+				lo.r = r.val[0]; hi.r = r.val[1];
+				lo.g = g.val[0]; hi.g = g.val[1];
+				lo.b = b.val[0]; hi.b = b.val[1];
+
+				convertPixels<Writer, scaleITU>(writer, dst + x, ySrc + x, lo, hi);
+				convertPixels<Writer, scaleITU>(writer, (PixelInt *)(dstPtr + dstPitch) + x, ySrc + yPitch + x, lo, hi);
+			} else {
+				const uint8x16_t u = vld1q_u8(uSrc + x);
+				const uint8x16_t v = vld1q_u8(vSrc + x);
+				computeChroma(lo, vget_low_u8(u), vget_low_u8(v), base);
+				computeChroma(hi, vget_high_u8(u), vget_high_u8(v), base);
+
+				convertPixels<Writer, scaleITU>(writer, dst + x, ySrc + x, lo, hi);
+			}
+		}
+
+		dstPtr += dstPitch * (yuv420 ? 2 : 1);
+		ySrc += yPitch * (yuv420 ? 2 : 1);
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+
+	return width;
+}
+
+#endif
+
+template<class Writer, bool yuv420>
+int convertRowsSIMD(const Writer &writer, YUVToRGBManager::LuminanceScale scale, byte *dstPtr, int dstPitch, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	if (scale == YUVToRGBManager::kScaleITU)
+		return convertRowsSIMD<Writer, yuv420, true>(writer, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	else
+		return convertRowsSIMD<Writer, yuv420, false>(writer, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+/**
+ * Convert the given rows of an image as far as possible with vector
+ * instructions.
+ *
+ * @return the number of pixels converted in each row
+ */
+template<bool yuv420>
+int convertRowsSIMD(const Graphics::PixelFormat &format, YUVToRGBManager::LuminanceScale scale, byte *dstPtr, int dstPitch, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	if (format.bytesPerPixel == 2)
+		return convertRowsSIMD<PixelWriter16, yuv420>(PixelWriter16(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+
+#ifdef SCUMM_LITTLE_ENDIAN
+	switch (getByteLayout(format)) {
+	case kLayoutRGBA:
+		return convertRowsSIMD<BytePixelWriter<kLayoutRGBA>, yuv420>(BytePixelWriter<kLayoutRGBA>(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	case kLayoutARGB:
+		return convertRowsSIMD<BytePixelWriter<kLayoutARGB>, yuv420>(BytePixelWriter<kLayoutARGB>(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	case kLayoutABGR:
+		return convertRowsSIMD<BytePixelWriter<kLayoutABGR>, yuv420>(BytePixelWriter<kLayoutABGR>(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	case kLayoutBGRA:
+		return convertRowsSIMD<BytePixelWriter<kLayoutBGRA>, yuv420>(BytePixelWriter<kLayoutBGRA>(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	default:
+		break;
+	}
+#endif
+
+	return convertRowsSIMD<PixelWriter32, yuv420>(PixelWriter32(format), scale, dstPtr, dstPitch, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+}
+
+} // End of anonymous namespace
+
+#endif // SCUMMVM_SSE2 || SCUMMVM_NEON
+
+void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convert444Rows(dst, scale, ySrc, uSrc, vSrc, yWidth, yPitch, uvPitch, 0, yHeight);
+}
+
+void YUVToRGBManager::convert444Rows(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yPitch, int uvPitch, int firstRow, int rowCount) {
+	// Sanity checks
+	assert(dst && dst->getPixels());
+	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
+	assert(ySrc && uSrc && vSrc);
+	assert(firstRow >= 0 && rowCount >= 0);
+
+	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+
+	byte *dstPtr = (byte *)dst->getBasePtr(0, firstRow);
+	ySrc += firstRow * yPitch;
+	uSrc += firstRow * uvPitch;
+	vSrc += firstRow * uvPitch;
+
+	int done = 0;
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	if (_useSIMD) {
+		done = convertRowsSIMD<false>(dst->format, scale, dstPtr, dst->pitch, ySrc, uSrc, vSrc, yWidth, rowCount, yPitch, uvPitch);
+		if (done == yWidth)
+			return;
+
+		dstPtr += done * dst->format.bytesPerPixel;
+	}
+#endif
+
+	// Use a templated function to avoid an if check on every pixel
+	if (dst->format.bytesPerPixel == 2)
+		convertYUV444ToRGB<uint16>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + done, uSrc + done, vSrc + done, yWidth - done, rowCount, yPitch, uvPitch);
+	else
+		convertYUV444ToRGB<uint32>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + done, uSrc + done, vSrc + done, yWidth - done, rowCount, yPitch, uvPitch);
+}
+
 void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	convert420Rows(dst, scale, ySrc, uSrc, vSrc, yWidth, yPitch, uvPitch, 0, yHeight);
+}
+
+void YUVToRGBManager::convert420Rows(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yPitch, int uvPitch, int firstRow, int rowCount) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 	assert((yWidth & 1) == 0);
-	assert((yHeight & 1) == 0);
+	assert(firstRow >= 0 && (firstRow & 1) == 0);
+	assert(rowCount >= 0 && (rowCount & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
 
+	byte *dstPtr = (byte *)dst->getBasePtr(0, firstRow);
+	ySrc += firstRow * yPitch;
+	uSrc += (firstRow >> 1) * uvPitch;
+	vSrc += (firstRow >> 1) * uvPitch;
+
+	int done = 0;
+#if defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)
+	if (_useSIMD) {
+		done = convertRowsSIMD<true>(dst->format, scale, dstPtr, dst->pitch, ySrc, uSrc, vSrc, yWidth, rowCount, yPitch, uvPitch);
+		if (done == yWidth)
+			return;
+
+		dstPtr += done * dst->format.bytesPerPixel;
+	}
+#endif
+
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, rowCount, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>(dstPtr, dst->pitch, lookup, _colorTab, ySrc + done, uSrc + done / 2, vSrc + done / 2, yWidth - done, rowCount, yPitch, uvPitch);
 }
 
 #define READ_QUAD(ptr, prefix) \
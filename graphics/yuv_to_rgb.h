@@ -66,6 +66,26 @@ public:
 	 */
 	void convert444(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a band of rows of a YUV444 image to an RGB surface
+	 *
+	 * Only the rows [firstRow, firstRow + rowCount) of the image are
+	 * converted, into the same rows of the destination surface. This allows
+	 * updating just the part of a frame which has changed.
+	 *
+	 * @param dst      the destination surface, covering the whole image
+	 * @param scale    the scale of the luminance values
+	 * @param ySrc     the source of the y component of the whole image
+	 * @param uSrc     the source of the u component of the whole image
+	 * @param vSrc     the source of the v component of the whole image
+	 * @param yWidth   the width of the y surface
+	 * @param yPitch   the pitch of the y surface
+	 * @param uvPitch  the pitch of the u and v surfaces
+	 * @param firstRow the first row to convert
+	 * @param rowCount the number of rows to convert
+	 */
+	void convert444Rows(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yPitch, int uvPitch, int firstRow, int rowCount);
+
 	/**
 	 * Convert a YUV420 image to an RGB surface
 	 *
@@ -81,6 +101,26 @@ public:
 	 */
 	void convert420(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Convert a band of rows of a YUV420 image to an RGB surface
+	 *
+	 * Only the rows [firstRow, firstRow + rowCount) of the image are
+	 * converted, into the same rows of the destination surface. This allows
+	 * updating just the part of a frame which has changed.
+	 *
+	 * @param dst      the destination surface, covering the whole image
+	 * @param scale    the scale of the luminance values
+	 * @param ySrc     the source of the y component of the whole image
+	 * @param uSrc     the source of the u component of the whole image
+	 * @param vSrc     the source of the v component of the whole image
+	 * @param yWidth   the width of the y surface (must be divisible by 2)
+	 * @param yPitch   the pitch of the y surface
+	 * @param uvPitch  the pitch of the u and v surfaces
+	 * @param firstRow the first row to convert (must be divisible by 2)
+	 * @param rowCount the number of rows to convert (must be divisible by 2)
+	 */
+	void convert420Rows(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yPitch, int uvPitch, int firstRow, int rowCount);
+
 	/**
 	 * Convert a YUV410 image to an RGB surface
 	 *
@@ -102,6 +142,13 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Enable or disable the vectorized YUV444 and YUV420 conversions, where
+	 * they are available. When disabled, the lookup tables are used for all
+	 * pixels. Both give the same results; this is meant for comparing them.
+	 */
+	void setUseSIMD(bool useSIMD) { _useSIMD = useSIMD; }
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -109,8 +156,14 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
-	YUVToRGBLookup *_lookup;
+	/** Number of lookup tables kept for different formats and scales. */
+	static const int kLookupCacheSize = 4;
+
+	/** The lookup tables, most recently used first. */
+	YUVToRGBLookup *_lookups[kLookupCacheSize];
 	int16 _colorTab[4 * 256]; // 2048 bytes
+
+	bool _useSIMD;
 };
 
 } // End of namespace Graphics
@@ -26,10 +26,12 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/system.h"
+#include "common/archive.h"
+#include "common/arena.h"
+#include "common/memory.h"
 
 #ifndef DISABLE_MD5
 #include "common/md5.h"
-#include "common/archive.h"
 #include "common/macresman.h"
 #include "common/stream.h"
 #endif
@@ -68,6 +70,8 @@ Debugger::Debugger() {
 
 	registerCmd("help",				WRAP_METHOD(Debugger, cmdHelp));
 	registerCmd("openlog",			WRAP_METHOD(Debugger, cmdOpenLog));
+	registerCmd("searchstats",		WRAP_METHOD(Debugger, cmdSearchStats));
+	registerCmd("allocstats",		WRAP_METHOD(Debugger, cmdAllocStats));
 #ifndef DISABLE_MD5
 	registerCmd("md5",				WRAP_METHOD(Debugger, cmdMd5));
 	registerCmd("md5mac",			WRAP_METHOD(Debugger, cmdMd5Mac));
@@ -606,6 +610,33 @@ bool Debugger::cmdOpenLog(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdSearchStats(int argc, const char **argv) {
+	const Common::SearchSet::LookupStatistics stats = SearchMan.getLookupStatistics();
+	const uint32 percent = stats.lookups ? (uint32)((uint64)stats.cacheHits * 100 / stats.lookups) : 0;
+
+	debugPrintf("File lookups: %d, without searching the archives: %d (%d%%)\n", stats.lookups, stats.cacheHits, percent);
+	debugPrintf("Remembered names: %d, discarded %d times\n", stats.cacheSize, stats.invalidations);
+	return true;
+}
+
+bool Debugger::cmdAllocStats(int argc, const char **argv) {
+#ifdef RELEASE_BUILD
+	debugPrintf("Heap allocations are not counted in release builds\n");
+#else
+	debugPrintf("Heap allocations by arrays and strings: %d\n", Common::atomicLoad(&Common::g_heapAllocations));
+#endif
+
+	const Common::FrameAllocator *frameAllocator = Common::FrameAllocator::getForCurrentThread();
+	if (frameAllocator) {
+		const Common::FrameAllocator::FrameStatistics &stats = frameAllocator->getLastFrameStatistics();
+		debugPrintf("Last frame: %d heap allocations, %d frame arena allocations, frame arena size %d bytes\n",
+		            stats.heapAllocations, stats.arenaAllocations, (int)stats.arenaSize);
+	} else {
+		debugPrintf("The engine does not use the frame arena\n");
+	}
+	return true;
+}
+
 #ifndef DISABLE_MD5
 struct ArchiveMemberLess {
 	bool operator()(const Common::ArchiveMemberPtr &x, const Common::ArchiveMemberPtr &y) const {
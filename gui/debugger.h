@@ -225,6 +225,8 @@ protected:
 	bool cmdExit(int argc, const char **argv);
 	bool cmdHelp(int argc, const char **argv);
 	bool cmdOpenLog(int argc, const char **argv);
+	bool cmdSearchStats(int argc, const char **argv);
+	bool cmdAllocStats(int argc, const char **argv);
 #ifndef DISABLE_MD5
 	bool cmdMd5(int argc, const char **argv);
 	bool cmdMd5Mac(int argc, const char **argv);
@@ -2,10 +2,42 @@
 
 #include "audio/audiostream.h"
 
+#include "common/thread.h"
+
 #include "helper.h"
 
 class AudioStreamTestSuite : public CxxTest::TestSuite
 {
+private:
+	struct QueueProducer {
+		Audio::QueuingAudioStream *stream;
+		int numBuffers;
+		int samplesPerBuffer;
+		int underruns;
+	};
+
+	static void produceBuffers(void *arg) {
+		QueueProducer *producer = (QueueProducer *)arg;
+		int16 value = 0;
+
+		for (int i = 0; i < producer->numBuffers; ++i) {
+			int16 *data = (int16 *)malloc(sizeof(int16) * producer->samplesPerBuffer);
+			for (int j = 0; j < producer->samplesPerBuffer; ++j)
+				WRITE_LE_UINT16(&data[j], value++);
+
+			producer->stream->queueBuffer((byte *)data, sizeof(int16) * producer->samplesPerBuffer, DisposeAfterUse::YES, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+
+			// Keep the queue short, so that the reader often runs dry. Like
+			// iMUSE Digital, check for that from the queuing thread.
+			if (producer->stream->endOfData())
+				++producer->underruns;
+			while (producer->stream->numQueuedStreams() > 16)
+				Common::Thread::yield();
+		}
+
+		producer->stream->finish();
+	}
+
 public:
 	void test_convertTimeToStreamPos() {
 		const Audio::Timestamp a = Audio::convertTimeToStreamPos(Audio::Timestamp(500, 1000), 11025, true);
@@ -205,4 +237,43 @@ public:
 	void test_sub_looping_audio_stream_stereo_22050_end_fixed_iter() {
 		testSubLoopingAudioStreamFixedIter(22050, true, 2, 2);
 	}
+
+	void test_lock_free_queuing_audio_stream_threaded() {
+		if (!Common::Thread::isSupported())
+			return;
+
+		// A small capacity makes the producer spill into the overflow queue
+		QueueProducer producer;
+		producer.stream = Audio::makeLockFreeQueuingAudioStream(22050, false, 4);
+		producer.numBuffers = 5000;
+		producer.samplesPerBuffer = 301;
+		producer.underruns = 0;
+
+		Common::Thread thread;
+		TS_ASSERT(thread.start(produceBuffers, &producer));
+
+		int16 buffer[512];
+		int16 expected = 0;
+		int total = 0;
+		bool inOrder = true;
+
+		while (!producer.stream->endOfStream()) {
+			const int len = producer.stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			for (int i = 0; i < len; ++i) {
+				if (buffer[i] != expected++)
+					inOrder = false;
+			}
+			total += len;
+
+			if (!len)
+				Common::Thread::yield();
+		}
+
+		thread.join();
+
+		TS_ASSERT(inOrder);
+		TS_ASSERT_EQUALS(total, producer.numBuffers * producer.samplesPerBuffer);
+
+		delete producer.stream;
+	}
 };
@@ -5,6 +5,7 @@
 
 #include "common/stream.h"
 #include "common/endian.h"
+#include "common/memstream.h"
 
 #include <math.h>
 #include <limits>
@@ -0,0 +1,70 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "common/str.h"
+
+#include "helper.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Times one mixer callback worth of work for a full mixer: every one of the
+ * 16 channels of MixerImpl playing at once, each through its own rate
+ * converter into the shared output buffer, the same way
+ * MixerImpl::mixCallback does it. The channels use a mix of the sample
+ * rates and channel counts games commonly play.
+ */
+class MixerBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kChannels = 16,     // MixerImpl::NUM_CHANNELS
+		kCallbackSamples = 2048,
+		kSeconds = 4
+	};
+
+	void benchmarkMix(const uint outputRate) {
+		static const uint inputRates[] = { 11025, 22050, 44100, 48000 };
+
+		Audio::AudioStream *streams[kChannels];
+		Audio::RateConverter *converters[kChannels];
+		for (int i = 0; i < kChannels; ++i) {
+			const uint rate = inputRates[i % ARRAYSIZE(inputRates)];
+			const bool isStereo = (i & 4) != 0;
+			streams[i] = Audio::makeLoopingAudioStream(createSineStream<int16>(rate, 1, nullptr, false, isStereo), 0);
+			converters[i] = Audio::makeRateConverter(rate, outputRate, isStereo, false);
+		}
+
+		int16 *buffer = new int16[kCallbackSamples * 2];
+		const uint callbacks = outputRate * kSeconds / kCallbackSamples;
+		uint mixed = 0;
+
+		const Benchmark::Timer timer;
+		for (uint c = 0; c < callbacks; ++c) {
+			memset(buffer, 0, kCallbackSamples * 2 * sizeof(int16));
+			for (int i = 0; i < kChannels; ++i)
+				mixed += converters[i]->flow(*streams[i], buffer, kCallbackSamples, Audio::Mixer::kMaxMixerVolume / 2, Audio::Mixer::kMaxMixerVolume / 2);
+		}
+		const uint32 elapsed = timer.elapsed();
+
+		TS_ASSERT_EQUALS(mixed, callbacks * kCallbackSamples * kChannels);
+		TS_TRACE(Common::String::format("Mixing %d channels at %u Hz: %u us per callback of %d samples, %u us for %d s of audio",
+			(int)kChannels, outputRate, elapsed / callbacks, (int)kCallbackSamples, elapsed, (int)kSeconds).c_str());
+
+		delete[] buffer;
+		for (int i = 0; i < kChannels; ++i) {
+			delete converters[i];
+			delete streams[i];
+		}
+	}
+
+	void test_mix_all_channels_44100() {
+		benchmarkMix(44100);
+	}
+
+	void test_mix_all_channels_48000() {
+		benchmarkMix(48000);
+	}
+};
@@ -0,0 +1,173 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite
+{
+private:
+	static int16 mixReference(int16 out, int16 in, Audio::st_volume_t vol) {
+		return CLIP<int>(out + (in * (int)vol) / Audio::Mixer::kMaxMixerVolume, Audio::ST_SAMPLE_MIN, Audio::ST_SAMPLE_MAX);
+	}
+
+	// Fills the output buffer with values close to the limits, so that the
+	// converters have to clip.
+	static void fillOutput(int16 *buffer, const int samples) {
+		for (int i = 0; i < samples; ++i)
+			buffer[i] = (i % 3 == 0) ? 30000 : ((i % 3 == 1) ? -30000 : (int16)(i * 7));
+	}
+
+	void copyTestTemplate(const bool isStereo, const bool reverseStereo, const Audio::st_volume_t volL, const Audio::st_volume_t volR) {
+		const int sampleRate = 22050;
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(sampleRate, 1, &sine, false, isStereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(sampleRate, sampleRate, isStereo, reverseStereo);
+
+		// Use an odd amount of sample pairs to exercise the scalar tail
+		const int pairs = 1001;
+		int16 *buffer = new int16[pairs * 2];
+		fillOutput(buffer, pairs * 2);
+
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, pairs, volL, volR), pairs);
+
+		int16 *expected = new int16[pairs * 2];
+		fillOutput(expected, pairs * 2);
+		for (int i = 0; i < pairs; ++i) {
+			const int16 in0 = isStereo ? sine[i * 2] : sine[i];
+			const int16 in1 = isStereo ? sine[i * 2 + 1] : sine[i];
+			expected[i * 2 + (reverseStereo ? 1 : 0)] = mixReference(expected[i * 2 + (reverseStereo ? 1 : 0)], in0, volL);
+			expected[i * 2 + (reverseStereo ? 0 : 1)] = mixReference(expected[i * 2 + (reverseStereo ? 0 : 1)], in1, volR);
+		}
+
+		TS_ASSERT_EQUALS(memcmp(expected, buffer, sizeof(int16) * pairs * 2), 0);
+
+		delete[] expected;
+		delete[] buffer;
+		delete converter;
+		delete[] sine;
+		delete s;
+	}
+
+public:
+	void test_copy_mono() {
+		copyTestTemplate(false, false, 256, 256);
+	}
+
+	void test_copy_mono_balance() {
+		copyTestTemplate(false, false, 201, 37);
+	}
+
+	void test_copy_stereo() {
+		copyTestTemplate(true, false, 256, 256);
+	}
+
+	void test_copy_stereo_balance() {
+		copyTestTemplate(true, false, 13, 255);
+	}
+
+	void test_copy_stereo_reverse() {
+		copyTestTemplate(true, true, 180, 99);
+	}
+
+	void test_simple_downsample() {
+		int16 *sine;
+		Audio::SeekableAudioStream *s = createSineStream<int16>(22050, 1, &sine, false, false);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 11025, false);
+
+		const int pairs = 11025;
+		int16 *buffer = new int16[pairs * 2];
+		memset(buffer, 0, sizeof(int16) * pairs * 2);
+
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, pairs, 128, 64), pairs);
+
+		// Every second input sample is used
+		for (int i = 0; i < pairs; ++i) {
+			TS_ASSERT_EQUALS(buffer[i * 2], (sine[i * 2 + 1] * 128) / Audio::Mixer::kMaxMixerVolume);
+			TS_ASSERT_EQUALS(buffer[i * 2 + 1], (sine[i * 2 + 1] * 64) / Audio::Mixer::kMaxMixerVolume);
+		}
+
+		delete[] buffer;
+		delete converter;
+		delete[] sine;
+		delete s;
+	}
+
+	void test_linear_end_of_stream() {
+		Audio::SeekableAudioStream *s = createSineStream<int16>(11025, 1, 0, false, true);
+		Audio::RateConverter *converter = Audio::makeRateConverter(11025, 44100, true);
+
+		// Ask for more than the stream can provide
+		const int pairs = 50000;
+		int16 *buffer = new int16[pairs * 2];
+		memset(buffer, 0, sizeof(int16) * pairs * 2);
+
+		const int len = converter->flow(*s, buffer, pairs, 256, 256);
+		TS_ASSERT_LESS_THAN(len, pairs);
+		TS_ASSERT_LESS_THAN(44100 - 8, len);
+
+		delete[] buffer;
+		delete converter;
+		delete s;
+	}
+
+	void test_polyphase_dc() {
+		// A constant signal has to pass the filter unchanged
+		const int inputSamples = 22050;
+		int16 *dc = (int16 *)malloc(sizeof(int16) * inputSamples);
+		for (int i = 0; i < inputSamples; ++i)
+			WRITE_LE_UINT16(&dc[i], 10000);
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)dc, sizeof(int16) * inputSamples, DisposeAfterUse::YES);
+		Audio::SeekableAudioStream *s = Audio::makeRawStream(data, 22050, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 48000, false, false, Audio::kRateConverterPolyphase);
+
+		const int pairs = 40000;
+		int16 *buffer = new int16[pairs * 2];
+		memset(buffer, 0, sizeof(int16) * pairs * 2);
+
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, pairs, 256, 256), pairs);
+
+		// Skip the start, where the filter still sees the silent history
+		for (int i = 100; i < pairs * 2; ++i)
+			TS_ASSERT_DELTA(buffer[i], 10000, 1);
+
+		delete[] buffer;
+		delete converter;
+		delete s;
+	}
+
+	void test_polyphase_sine() {
+		// Resample a 440 Hz sine and compare it against the ideal result
+		const int inRate = 11025, outRate = 48000;
+		int16 *sine = (int16 *)malloc(sizeof(int16) * inRate * 2);
+		for (int i = 0; i < inRate; ++i) {
+			const int16 sample = (int16)(sin(2 * M_PI * 440 * i / inRate) * 16000);
+			WRITE_LE_UINT16(&sine[i * 2], sample);
+			WRITE_LE_UINT16(&sine[i * 2 + 1], -sample);
+		}
+
+		Common::SeekableReadStream *data = new Common::MemoryReadStream((const byte *)sine, sizeof(int16) * inRate * 2, DisposeAfterUse::YES);
+		Audio::SeekableAudioStream *s = Audio::makeRawStream(data, inRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | Audio::FLAG_STEREO);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, true, false, Audio::kRateConverterPolyphase);
+
+		const int pairs = 40000;
+		int16 *buffer = new int16[pairs * 2];
+		memset(buffer, 0, sizeof(int16) * pairs * 2);
+
+		TS_ASSERT_EQUALS(converter->flow(*s, buffer, pairs, 256, 256), pairs);
+
+		for (int i = 100; i < pairs; ++i) {
+			const double expected = sin(2 * M_PI * 440 * i / outRate) * 16000;
+			TS_ASSERT_DELTA(buffer[i * 2], expected, 16);
+			TS_ASSERT_DELTA(buffer[i * 2 + 1], -expected, 16);
+		}
+
+		delete[] buffer;
+		delete converter;
+		delete s;
+	}
+};
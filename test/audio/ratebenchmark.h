@@ -0,0 +1,66 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+#include "common/str.h"
+
+#include "helper.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Compares the throughput of the linear and the polyphase rate converters
+ * for the conversions the mixer does most often.
+ */
+class RateBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kBufferSamples = 2048,
+		kSeconds = 4
+	};
+
+	static uint32 timeConversion(const uint inRate, const uint outRate, const bool isStereo, const Audio::RateConverterQuality quality) {
+		Audio::AudioStream *stream = Audio::makeLoopingAudioStream(createSineStream<int16>(inRate, 1, nullptr, false, isStereo), 0);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, isStereo, false, quality);
+		int16 *buffer = new int16[kBufferSamples * 2];
+		const uint buffers = outRate * kSeconds / kBufferSamples;
+		uint converted = 0;
+
+		const Benchmark::Timer timer;
+		for (uint i = 0; i < buffers; ++i) {
+			memset(buffer, 0, kBufferSamples * 2 * sizeof(int16));
+			converted += converter->flow(*stream, buffer, kBufferSamples, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		}
+		const uint32 elapsed = timer.elapsed();
+
+		TS_ASSERT_EQUALS(converted, buffers * kBufferSamples);
+
+		delete[] buffer;
+		delete converter;
+		delete stream;
+		return elapsed;
+	}
+
+	void test_linear_vs_polyphase() {
+		static const struct {
+			uint inRate;
+			uint outRate;
+			bool isStereo;
+		} conversions[] = {
+			{ 11025, 44100, false },
+			{ 22050, 44100, true },
+			{ 22050, 48000, false },
+			{ 44100, 48000, true }
+		};
+
+		for (int i = 0; i < ARRAYSIZE(conversions); ++i) {
+			const uint32 linear = timeConversion(conversions[i].inRate, conversions[i].outRate, conversions[i].isStereo, Audio::kRateConverterLinear);
+			const uint32 polyphase = timeConversion(conversions[i].inRate, conversions[i].outRate, conversions[i].isStereo, Audio::kRateConverterPolyphase);
+			TS_TRACE(Common::String::format("%u -> %u Hz %s, %d s of audio: linear %u us, polyphase %u us",
+				conversions[i].inRate, conversions[i].outRate, conversions[i].isStereo ? "stereo" : "mono",
+				(int)kSeconds, linear, polyphase).c_str());
+		}
+	}
+};
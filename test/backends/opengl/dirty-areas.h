@@ -0,0 +1,144 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/graphics/opengl/dirty-areas.h"
+
+/**
+ * Checks how the OpenGL surfaces merge the areas they upload.
+ */
+class OpenGLDirtyAreasTestSuite : public CxxTest::TestSuite
+{
+	public:
+	static bool contains(const OpenGL::DirtyAreas &dirty, const Common::Rect &area) {
+		for (uint i = 0; i < dirty.getAreas().size(); ++i) {
+			if (dirty.getAreas()[i] == area)
+				return true;
+		}
+		return false;
+	}
+
+	void test_separate() {
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(0, 0, 10, 10));
+		dirty.add(Common::Rect(20, 20, 30, 30));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 2U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 10, 10)));
+		TS_ASSERT(contains(dirty, Common::Rect(20, 20, 30, 30)));
+	}
+
+	void test_empty() {
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(5, 5, 5, 10));
+		TS_ASSERT(dirty.empty());
+		dirty.add(Common::Rect(0, 0, 10, 10));
+		dirty.add(Common::Rect(20, 20, 20, 20));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 1U);
+		dirty.clear();
+		TS_ASSERT(dirty.empty());
+	}
+
+	void test_overlapping() {
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(0, 0, 10, 10));
+		dirty.add(Common::Rect(5, 5, 15, 20));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 1U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 15, 20)));
+
+		// Contained in the existing area
+		dirty.add(Common::Rect(2, 2, 4, 4));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 1U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 15, 20)));
+	}
+
+	void test_touching() {
+		// Side by side with the same height, merging adds no clean pixels
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(0, 0, 10, 10));
+		dirty.add(Common::Rect(10, 0, 20, 10));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 1U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 20, 10)));
+
+		// Touching, but the bounds would include clean pixels
+		dirty.add(Common::Rect(0, 10, 5, 20));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 2U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 20, 10)));
+		TS_ASSERT(contains(dirty, Common::Rect(0, 10, 5, 20)));
+	}
+
+	void test_lines() {
+		// GLTexture::updateAreas relies on whole lines sharing or touching
+		// lines to be merged, and separate ones to stay apart
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(0, 0, 320, 10));
+		dirty.add(Common::Rect(0, 5, 320, 20));
+		dirty.add(Common::Rect(0, 20, 320, 30));
+		dirty.add(Common::Rect(0, 40, 320, 50));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 2U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 320, 30)));
+		TS_ASSERT(contains(dirty, Common::Rect(0, 40, 320, 50)));
+	}
+
+	void test_chain() {
+		// The new area overlaps one area, and the merged one overlaps the
+		// other, so all three end up as one
+		OpenGL::DirtyAreas dirty;
+		dirty.add(Common::Rect(0, 0, 10, 10));
+		dirty.add(Common::Rect(30, 0, 40, 10));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 2U);
+		dirty.add(Common::Rect(5, 0, 32, 5));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), 1U);
+		TS_ASSERT(contains(dirty, Common::Rect(0, 0, 40, 10)));
+	}
+
+	void test_full() {
+		OpenGL::DirtyAreas dirty;
+		for (int i = 0; i < OpenGL::DirtyAreas::kMaxAreas; ++i)
+			dirty.add(Common::Rect(i * 100, 0, i * 100 + 10, 10));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), (uint)OpenGL::DirtyAreas::kMaxAreas);
+
+		// Closest to the area at 300, so that one grows
+		dirty.add(Common::Rect(320, 0, 330, 10));
+		TS_ASSERT_EQUALS(dirty.getAreas().size(), (uint)OpenGL::DirtyAreas::kMaxAreas);
+		TS_ASSERT(contains(dirty, Common::Rect(300, 0, 330, 10)));
+		TS_ASSERT(contains(dirty, Common::Rect(200, 0, 210, 10)));
+		TS_ASSERT(contains(dirty, Common::Rect(400, 0, 410, 10)));
+	}
+
+	void test_random() {
+		// Whatever is added, the areas cover it, don't overlap and are
+		// not more than kMaxAreas
+		const int width = 64, height = 48;
+		uint32 seed = 1;
+		for (int run = 0; run < 50; ++run) {
+			OpenGL::DirtyAreas dirty;
+			bool added[height][width] = {};
+			for (int n = 0; n < 20; ++n) {
+				seed = seed * 1103515245 + 12345;
+				const int x = (seed >> 8) % width, y = (seed >> 16) % height;
+				seed = seed * 1103515245 + 12345;
+				const int w = (seed >> 8) % 12 + 1, h = (seed >> 16) % 12 + 1;
+				const Common::Rect area(x, y, MIN(x + w, width), MIN(y + h, height));
+				dirty.add(area);
+				for (int i = area.top; i < area.bottom; ++i)
+					for (int j = area.left; j < area.right; ++j)
+						added[i][j] = true;
+			}
+
+			const Common::Array<Common::Rect> &areas = dirty.getAreas();
+			TS_ASSERT_LESS_THAN_EQUALS(areas.size(), (uint)OpenGL::DirtyAreas::kMaxAreas);
+			for (uint i = 0; i < areas.size(); ++i) {
+				for (uint j = i + 1; j < areas.size(); ++j)
+					TS_ASSERT(!areas[i].intersects(areas[j]));
+			}
+			for (int i = 0; i < height; ++i) {
+				for (int j = 0; j < width; ++j) {
+					if (!added[i][j])
+						continue;
+					bool covered = false;
+					for (uint k = 0; k < areas.size(); ++k)
+						covered = covered || areas[k].contains(j, i);
+					TS_ASSERT(covered);
+				}
+			}
+		}
+	}
+};
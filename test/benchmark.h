@@ -0,0 +1,66 @@
+#ifndef TEST_BENCHMARK_H
+#define TEST_BENCHMARK_H
+
+#include "common/scummsys.h"
+
+#ifdef POSIX
+#include <sys/time.h>
+#endif
+
+/**
+ * Helpers for the benchmark suites, the test headers whose names end in
+ * "benchmark.h". They are not part of "make test", but have their own
+ * runner, built and run by "make benchmark".
+ */
+namespace Benchmark {
+
+/**
+ * Return a time in microseconds, for measuring intervals, or 0 when no
+ * timer is available.
+ */
+inline uint32 getMicros() {
+#ifdef POSIX
+	struct timeval tv;
+	gettimeofday(&tv, nullptr);
+	return tv.tv_sec * 1000000 + tv.tv_usec;
+#else
+	return 0;
+#endif
+}
+
+/**
+ * Measures the time taken by consecutive parts of a benchmark.
+ */
+class Timer {
+public:
+	Timer() : _start(getMicros()) {}
+
+	/**
+	 * Start measuring again from now.
+	 */
+	void restart() { _start = getMicros(); }
+
+	/**
+	 * Return the microseconds since the timer was created or last
+	 * restarted.
+	 */
+	uint32 elapsed() const { return getMicros() - _start; }
+
+	/**
+	 * Return the microseconds since the timer was created or last
+	 * restarted, and restart it.
+	 */
+	uint32 lap() {
+		const uint32 now = getMicros();
+		const uint32 elapsed = now - _start;
+		_start = now;
+		return elapsed;
+	}
+
+private:
+	uint32 _start;
+};
+
+} // End of namespace Benchmark
+
+#endif
@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+#include "common/array.h"
+#include "common/memory.h"
+#include "common/thread.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_allocate() {
+		Common::Arena arena(1024);
+
+		byte *first = (byte *)arena.allocate(10);
+		byte *second = (byte *)arena.allocate(100);
+		TS_ASSERT(first != second);
+		TS_ASSERT_EQUALS((size_t)first % 16, 0u);
+		TS_ASSERT_EQUALS((size_t)second % 16, 0u);
+		memset(first, 1, 10);
+		memset(second, 2, 100);
+		TS_ASSERT_EQUALS(first[9], 1);
+
+		// Larger than a block
+		uint32 *large = arena.allocateArray<uint32>(1000);
+		large[999] = 42;
+		TS_ASSERT_EQUALS(second[99], 2);
+		TS_ASSERT_EQUALS(arena.getAllocationCount(), 3u);
+
+		const char *str = arena.copyString(Common::String("arena"));
+		TS_ASSERT_EQUALS(Common::String(str), "arena");
+	}
+
+	void test_reuse() {
+		Common::Arena arena(1024);
+
+		for (int i = 0; i < 100; i++)
+			arena.allocate(100);
+		const size_t reserved = arena.getReservedSize();
+
+		// Blocks are reused after a reset
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getAllocationCount(), 0u);
+		for (int i = 0; i < 100; i++)
+			arena.allocate(100);
+		TS_ASSERT_EQUALS(arena.getReservedSize(), reserved);
+
+		arena.reset();
+		arena.allocate(100);
+		arena.freeUnusedBlocks();
+		TS_ASSERT(arena.getReservedSize() < reserved);
+	}
+
+	void test_scope() {
+		Common::Arena arena(1024);
+		void *before = arena.allocate(16);
+
+		void *inScope;
+		{
+			Common::ArenaScope scope(arena);
+			inScope = arena.allocate(16);
+			for (int i = 0; i < 100; i++)
+				arena.allocate(100);
+			TS_ASSERT_EQUALS(arena.getAllocationCount(), 102u);
+		}
+
+		TS_ASSERT_EQUALS(arena.getAllocationCount(), 1u);
+		TS_ASSERT_EQUALS(arena.allocate(16), inScope);
+		TS_ASSERT(before != inScope);
+	}
+
+	void test_heap_allocation_counter() {
+		const uint32 start = Common::g_heapAllocations;
+
+		Common::Array<int> array;
+		array.push_back(1);
+		Common::String str("a string longer than the builtin capacity of strings");
+
+#ifndef RELEASE_BUILD
+		TS_ASSERT_EQUALS(Common::g_heapAllocations - start, 2u);
+#else
+		TS_ASSERT_EQUALS(Common::g_heapAllocations - start, 0u);
+#endif
+	}
+
+	void test_frame_allocator() {
+		Common::FrameAllocator &allocator = FrameArena;
+		TS_ASSERT_EQUALS(Common::FrameAllocator::getForCurrentThread(), &allocator);
+
+		allocator.allocate(100);
+		allocator.allocate(100);
+		Common::Array<int> array;
+		array.push_back(1);
+		allocator.endFrame();
+
+		const Common::FrameAllocator::FrameStatistics &stats = allocator.getLastFrameStatistics();
+		TS_ASSERT_EQUALS(stats.arenaAllocations, 2u);
+#ifndef RELEASE_BUILD
+		TS_ASSERT(stats.heapAllocations >= 1u);
+#endif
+		TS_ASSERT_EQUALS(allocator.getAllocationCount(), 0u);
+
+		if (Common::Thread::isSupported()) {
+			// Other threads get their own frame allocator
+			Common::FrameAllocator *other = nullptr;
+			Common::Thread thread;
+			TS_ASSERT(thread.start(getFrameAllocator, &other));
+			thread.join();
+			TS_ASSERT(other);
+			TS_ASSERT_DIFFERS(other, &allocator);
+		}
+	}
+
+	void test_shared_arena() {
+		if (!Common::Thread::isSupported())
+			return;
+
+		Common::SharedArena arena(1024);
+		Common::Thread threads[4];
+		for (int i = 0; i < 4; i++)
+			TS_ASSERT(threads[i].start(fillSharedArena, &arena));
+		for (int i = 0; i < 4; i++)
+			threads[i].join();
+
+		TS_ASSERT_EQUALS(arena.getAllocationCount(), 4u * kSharedAllocations);
+	}
+
+	enum {
+		kSharedAllocations = 1000
+	};
+
+	static void getFrameAllocator(void *result) {
+		*(Common::FrameAllocator **)result = &FrameArena;
+	}
+
+	static void fillSharedArena(void *arg) {
+		Common::SharedArena *arena = (Common::SharedArena *)arg;
+		for (uint i = 0; i < kSharedAllocations; i++) {
+			uint32 *value = arena->allocateArray<uint32>(4);
+			value[0] = value[3] = i;
+		}
+	}
+};
@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atom.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class AtomTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty() {
+		Common::Atom atom;
+		TS_ASSERT(atom.empty());
+		TS_ASSERT_EQUALS(atom.toString(), "");
+		TS_ASSERT_EQUALS(atom, Common::Atom(""));
+		TS_ASSERT_EQUALS(atom.hash(), 0u);
+	}
+
+	void test_identity() {
+		Common::String name("exit");
+		const Common::Atom atom1("exit");
+		const Common::Atom atom2(name);
+		const Common::Atom atom3("Exit");
+
+		TS_ASSERT(!atom1.empty());
+		TS_ASSERT_EQUALS(atom1, atom2);
+		TS_ASSERT(atom1 != atom3);
+		TS_ASSERT(atom1 != Common::Atom());
+
+		// Both atoms share the interned string
+		TS_ASSERT_EQUALS(atom1.c_str(), atom2.c_str());
+		TS_ASSERT_EQUALS(atom1.toString(), "exit");
+		TS_ASSERT_EQUALS(atom3.toString(), "Exit");
+
+		// Changing the source string does not affect the atom
+		name.setChar('E', 0);
+		TS_ASSERT_EQUALS(atom2.toString(), "exit");
+		TS_ASSERT_EQUALS(Common::Atom(name), atom3);
+	}
+
+	void test_hash() {
+		const Common::Atom atom("dictionary");
+		TS_ASSERT_EQUALS(atom.hash(), Common::hashit("dictionary"));
+		TS_ASSERT_EQUALS(Common::Hash<Common::Atom>()(atom), atom.hash());
+	}
+
+	void test_hashmap() {
+		Common::HashMap<Common::Atom, int> map;
+		for (int i = 0; i < 500; i++)
+			map[Common::Atom(Common::String::format("selector%d", i))] = i;
+
+		TS_ASSERT_EQUALS(map.size(), 500u);
+		TS_ASSERT_EQUALS(map.getVal(Common::Atom("selector123"), -1), 123);
+		TS_ASSERT_EQUALS(map.getVal(Common::Atom("selector500"), -1), -1);
+
+		Common::Atom atom = Common::Atom("selector7");
+		atom = Common::Atom("selector8");
+		TS_ASSERT_EQUALS(map[atom], 8);
+	}
+};
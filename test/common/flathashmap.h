@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	public:
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringMap;
+
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		StringMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		StringMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		container.erase(container.find(0));
+		container.erase(1);
+		container.erase(2);
+		container.erase(container.find(3));
+		TS_ASSERT_EQUALS(container.size(), 1u);
+		container.erase(4);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_lookup_with_default() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = -1;
+
+		const Common::FlatHashMap<int, int> &containerRef = container;
+
+		TS_ASSERT_EQUALS(containerRef[0], 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(1), -1);
+		TS_ASSERT_EQUALS(containerRef.getVal(17), 0);
+		TS_ASSERT_EQUALS(containerRef.getVal(0, -10), 17);
+		TS_ASSERT_EQUALS(containerRef.getVal(17, -10), -10);
+		TS_ASSERT_EQUALS(containerRef.find(17), containerRef.end());
+		TS_ASSERT_EQUALS(container.size(), 2u);
+	}
+
+	void test_grow_and_erase() {
+		Common::FlatHashMap<int, int> container;
+
+		// Colliding keys, erased in between, and growing several times
+		for (int i = 0; i < 5000; i++)
+			container[i * 64] = i;
+		for (int i = 0; i < 5000; i += 2)
+			container.erase(i * 64);
+		for (int i = 5000; i < 6000; i++)
+			container.setVal(i * 64, i);
+
+		TS_ASSERT_EQUALS(container.size(), 3500u);
+		for (int i = 0; i < 6000; i++) {
+			const int expected = (i < 5000 && !(i & 1)) ? -1 : i;
+			TS_ASSERT_EQUALS(container.getVal(i * 64, -1), expected);
+		}
+
+		Common::FlatHashMap<int, int> copy;
+		copy[1] = 1;
+		copy = container;
+		TS_ASSERT_EQUALS(copy.size(), 3500u);
+		TS_ASSERT(!copy.contains(1));
+		TS_ASSERT_EQUALS(copy[64 * 5999], 5999);
+	}
+
+	void test_random_operations() {
+		Common::FlatHashMap<uint, uint> container;
+		Common::HashMap<uint, uint> reference;
+
+		uint32 seed = 1;
+		for (uint i = 0; i < 50000; i++) {
+			seed = seed * 1103515245 + 12345;
+			const uint key = (seed >> 8) % 3000;
+
+			switch ((seed >> 4) & 3) {
+			case 0:
+			case 1:
+				container[key] = i;
+				reference[key] = i;
+				break;
+			case 2:
+				container.erase(key);
+				reference.erase(key);
+				break;
+			default:
+				TS_ASSERT_EQUALS(container.getVal(key, 0xFFFF), reference.getVal(key, 0xFFFF));
+				break;
+			}
+		}
+
+		TS_ASSERT_EQUALS(container.size(), reference.size());
+		for (Common::HashMap<uint, uint>::const_iterator i = reference.begin(); i != reference.end(); ++i)
+			TS_ASSERT_EQUALS(container.getVal(i->_key, 0xFFFF), i->_value);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT_EQUALS(container.begin(), container.end());
+
+		for (int i = 0; i < 100; i++)
+			container[i] = i * 2;
+
+		// Erasing while iterating keeps the iterators valid
+		for (Common::FlatHashMap<int, int>::iterator i = container.begin(); i != container.end(); ++i) {
+			if (i->_key & 1)
+				container.erase(i);
+			else
+				i->_value++;
+		}
+
+		int found = 0;
+		Common::FlatHashMap<int, int>::const_iterator j;
+		for (j = container.begin(); j != container.end(); ++j) {
+			TS_ASSERT(!(j->_key & 1));
+			TS_ASSERT_EQUALS(j->_value, j->_key * 2 + 1);
+			found++;
+		}
+		TS_ASSERT_EQUALS(found, 50);
+	}
+
+	void test_reserve() {
+		StringMap container;
+		container["keep"] = "me";
+		container.reserve(1000);
+
+		for (int i = 0; i < 1000; i++)
+			container[Common::String::format("key%d", i)] = Common::String::format("value%d", i);
+
+		TS_ASSERT_EQUALS(container.size(), 1001u);
+		TS_ASSERT_EQUALS(container["KEEP"], "me");
+		TS_ASSERT_EQUALS(container["Key999"], "value999");
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/array.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Runs the same operations on HashMap and FlatHashMap, checks that they
+ * give the same results, and traces the time taken for each of them.
+ */
+class HashMapBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kKeys = 20000
+	};
+
+	struct PointerHash {
+		uint operator()(const int *key) const { return (uint)((size_t)key >> 2); }
+	};
+
+	struct Timings {
+		uint32 insert;
+		uint32 lookup;
+		uint32 iterate;
+		uint32 erase;
+		uint32 result;
+	};
+
+	/**
+	 * Insert the first half of keys, look up all of them, iterate over the
+	 * map and erase the keys again.
+	 */
+	template<class Map, class Key>
+	static Timings run(const Common::Array<Key> &keys) {
+		Timings timings;
+		const uint32 count = keys.size() / 2;
+		uint32 result = 0;
+		Map map;
+
+		Benchmark::Timer timer;
+		for (uint32 i = 0; i < count; i++)
+			map[keys[i]] = i;
+		timings.insert = timer.lap();
+
+		for (int pass = 0; pass < 4; pass++) {
+			for (uint32 i = 0; i < keys.size(); i++) {
+				typename Map::const_iterator it = map.find(keys[i]);
+				if (it != map.end())
+					result += it->_value;
+			}
+		}
+		timings.lookup = timer.lap();
+
+		for (int pass = 0; pass < 4; pass++) {
+			for (typename Map::const_iterator it = map.begin(); it != map.end(); ++it)
+				result += it->_value;
+		}
+		timings.iterate = timer.lap();
+
+		for (uint32 i = 0; i < count; i++)
+			map.erase(keys[i]);
+		timings.erase = timer.lap();
+
+		timings.result = result + map.size();
+		return timings;
+	}
+
+	template<class Map, class FlatMap, class Key>
+	void compare(const char *name, const Common::Array<Key> &keys) {
+		const Timings old = run<Map>(keys);
+		const Timings flat = run<FlatMap>(keys);
+
+		TS_ASSERT_EQUALS(old.result, flat.result);
+
+		Common::String trace = Common::String::format(
+			"%s keys, HashMap / FlatHashMap in us: insert %d / %d, lookup %d / %d, iterate %d / %d, erase %d / %d", name,
+			old.insert, flat.insert, old.lookup, flat.lookup, old.iterate, flat.iterate, old.erase, flat.erase);
+		TS_TRACE(trace.c_str());
+	}
+
+	void test_uint32_keys() {
+		Common::Array<uint32> keys;
+		for (uint32 i = 0; i < kKeys; i++)
+			keys.push_back(i * 7919);
+
+		compare<Common::HashMap<uint32, uint32>, Common::FlatHashMap<uint32, uint32> >("uint32", keys);
+	}
+
+	void test_string_keys() {
+		Common::Array<Common::String> keys;
+		for (uint32 i = 0; i < kKeys; i++)
+			keys.push_back(Common::String::format("resource_%d.dat", i));
+
+		compare<Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo>,
+			Common::FlatHashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> >("String", keys);
+	}
+
+	void test_pointer_keys() {
+		Common::Array<int> objects(kKeys);
+		Common::Array<const int *> keys;
+		for (uint32 i = 0; i < kKeys; i++)
+			keys.push_back(&objects[i]);
+
+		compare<Common::HashMap<const int *, uint32, PointerHash>, Common::FlatHashMap<const int *, uint32, PointerHash> >("pointer", keys);
+	}
+};
@@ -0,0 +1,85 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/ringbuffer.h"
+#include "common/thread.h"
+
+class RingBufferTestSuite : public CxxTest::TestSuite
+{
+private:
+	struct Counter {
+		Common::RingBuffer<uint32> *queue;
+		uint32 count;
+	};
+
+	static void produce(void *arg) {
+		Counter *counter = (Counter *)arg;
+		for (uint32 i = 0; i < counter->count; ++i) {
+			while (!counter->queue->push(i))
+				Common::Thread::yield();
+		}
+	}
+
+public:
+	void test_capacity() {
+		Common::RingBuffer<int> queue(5);
+		TS_ASSERT_EQUALS(queue.capacity(), 8u);
+		TS_ASSERT(queue.empty());
+
+		for (int i = 0; i < 8; ++i)
+			TS_ASSERT(queue.push(i));
+
+		TS_ASSERT(queue.isFull());
+		TS_ASSERT(!queue.push(8));
+		TS_ASSERT_EQUALS(queue.size(), 8u);
+	}
+
+	void test_fifo_wraparound() {
+		Common::RingBuffer<int> queue(4);
+
+		// Push and pop more values than the capacity, so the indices wrap
+		int next = 0;
+		for (int i = 0; i < 100; ++i) {
+			TS_ASSERT(queue.push(i * 2));
+			TS_ASSERT(queue.push(i * 2 + 1));
+
+			TS_ASSERT_EQUALS(queue.front(), next++);
+			queue.pop();
+			TS_ASSERT_EQUALS(queue.front(), next++);
+			queue.pop();
+		}
+
+		TS_ASSERT(queue.empty());
+	}
+
+	void test_threaded() {
+		if (!Common::Thread::isSupported())
+			return;
+
+		Common::RingBuffer<uint32> queue(16);
+		Counter counter;
+		counter.queue = &queue;
+		counter.count = 200000;
+
+		Common::Thread thread;
+		TS_ASSERT(thread.start(produce, &counter));
+
+		uint32 expected = 0;
+		bool inOrder = true;
+		while (expected < counter.count) {
+			if (queue.empty()) {
+				Common::Thread::yield();
+				continue;
+			}
+
+			if (queue.front() != expected)
+				inOrder = false;
+			queue.pop();
+			expected++;
+		}
+
+		thread.join();
+
+		TS_ASSERT(inOrder);
+		TS_ASSERT(queue.empty());
+	}
+};
@@ -0,0 +1,156 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+
+/**
+ * Archive containing a single empty member, counting how often it is
+ * searched.
+ */
+class CountingArchive : public Common::Archive {
+public:
+	CountingArchive(const Common::String &member) : _member(member), _searches(0) {}
+
+	mutable int _searches;
+
+	bool hasFile(const Common::String &name) const {
+		_searches++;
+		return name.equalsIgnoreCase(_member);
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const {
+		list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_member, this)));
+		return 1;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::String &name) const {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_member, this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::String &name) const {
+		if (!name.equalsIgnoreCase(_member))
+			return nullptr;
+		return new Common::MemoryReadStream(nullptr, 0);
+	}
+
+private:
+	Common::String _member;
+};
+
+/**
+ * Archive which opens a member it does not list, like a directory whose
+ * contents changed after it was scanned.
+ */
+class HiddenMemberArchive : public CountingArchive {
+public:
+	HiddenMemberArchive(const Common::String &member) : CountingArchive(member) {}
+
+	bool hasFile(const Common::String &name) const {
+		return false;
+	}
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_lookup_cache() {
+		Common::SearchSet set;
+		CountingArchive *high = new CountingArchive("a.dat");
+		CountingArchive *low = new CountingArchive("b.dat");
+		set.add("high", high, 1);
+		set.add("low", low, 0);
+
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(set.hasFile("B.DAT"));
+		TS_ASSERT(!set.hasFile("c.dat"));
+		TS_ASSERT(!set.hasFile("C.dat"));
+		TS_ASSERT_EQUALS(high->_searches, 2);
+		TS_ASSERT_EQUALS(low->_searches, 2);
+
+		Common::SearchSet::LookupStatistics stats = set.getLookupStatistics();
+		TS_ASSERT_EQUALS(stats.lookups, 4u);
+		TS_ASSERT_EQUALS(stats.cacheHits, 2u);
+		TS_ASSERT_EQUALS(stats.cacheSize, 2u);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b.DAT");
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT_EQUALS(low->_searches, 2);
+	}
+
+	void test_lookup_cache_invalidation() {
+		Common::SearchSet set;
+		set.add("first", new CountingArchive("a.dat"), 0);
+
+		TS_ASSERT(!set.hasFile("b.dat"));
+
+		// Newly added archives are searched
+		set.add("second", new CountingArchive("b.dat"), 0);
+		TS_ASSERT(set.hasFile("b.dat"));
+
+		// Priorities are respected
+		CountingArchive *other = new CountingArchive("b.dat");
+		set.add("third", other, 5);
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT(set.getMember("b.dat"));
+		TS_ASSERT_EQUALS(other->_searches, 1);
+
+		// Removed archives are not
+		set.remove("second");
+		set.remove("third");
+		TS_ASSERT(!set.hasFile("b.dat"));
+
+		TS_ASSERT_EQUALS(set.getLookupStatistics().invalidations, 3u);
+	}
+
+	void test_nested_set_invalidation() {
+		Common::SearchSet outer;
+		Common::SearchSet *inner = new Common::SearchSet;
+		outer.add("inner", inner, 0);
+		outer.add("other", new CountingArchive("a.dat"), 1);
+
+		TS_ASSERT(!outer.hasFile("b.dat"));
+
+		// Archives added to the nested set after it was added to the outer
+		// one must be found
+		inner->add("late", new CountingArchive("b.dat"), 0);
+		TS_ASSERT(outer.hasFile("b.dat"));
+
+		inner->remove("late");
+		TS_ASSERT(!outer.hasFile("b.dat"));
+	}
+
+	void test_nested_set_remove_then_add() {
+		Common::SearchSet outer;
+		Common::SearchSet *inner = new Common::SearchSet;
+		inner->add("member", new CountingArchive("b.dat"), 0);
+		outer.add("inner", inner, 0, false);
+
+		TS_ASSERT(outer.hasFile("b.dat"));
+
+		// Removing the nested set must forget the names found in it, even
+		// though it had changed as often as the outer set does now
+		outer.remove("inner");
+		TS_ASSERT(!outer.hasFile("b.dat"));
+		TS_ASSERT(!outer.getMember("b.dat"));
+
+		// Nor may adding another nested set bring them back
+		Common::SearchSet *other = new Common::SearchSet;
+		other->add("member", new CountingArchive("a.dat"), 0);
+		outer.add("other", other, 0);
+		TS_ASSERT(!outer.hasFile("b.dat"));
+		TS_ASSERT(outer.hasFile("a.dat"));
+
+		delete inner;
+	}
+
+	void test_read_stream_after_miss() {
+		Common::SearchSet set;
+		set.add("hidden", new HiddenMemberArchive("b.dat"), 0);
+
+		// The archive does not report the member, but can open it
+		TS_ASSERT(!set.hasFile("b.dat"));
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("b.dat");
+		TS_ASSERT(stream);
+		delete stream;
+	}
+};
@@ -0,0 +1,84 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/atomic.h"
+#include "common/thread.h"
+
+class ThreadTestSuite : public CxxTest::TestSuite
+{
+private:
+	struct PingPong {
+		Common::Semaphore ping;
+		Common::Semaphore pong;
+		uint32 rounds;
+		uint32 value;
+	};
+
+	static void answer(void *arg) {
+		PingPong *state = (PingPong *)arg;
+		for (uint32 i = 0; i < state->rounds; ++i) {
+			state->ping.wait();
+			++state->value;
+			state->pong.post();
+		}
+	}
+
+	static void countTask(void *arg, uint task) {
+		uint32 *counts = (uint32 *)arg;
+		Common::atomicAdd(&counts[task], 1);
+	}
+
+public:
+	void test_semaphore_count() {
+		Common::Semaphore semaphore(2);
+		TS_ASSERT(semaphore.tryWait());
+		semaphore.wait();
+		TS_ASSERT(!semaphore.tryWait());
+
+		semaphore.post(3);
+		for (int i = 0; i < 3; ++i)
+			TS_ASSERT(semaphore.tryWait());
+		TS_ASSERT(!semaphore.tryWait());
+	}
+
+	void test_semaphore_threads() {
+		if (!Common::Thread::isSupported())
+			return;
+
+		PingPong state;
+		state.rounds = 10000;
+		state.value = 0;
+
+		Common::Thread thread;
+		TS_ASSERT(thread.start(answer, &state));
+		for (uint32 i = 0; i < state.rounds; ++i) {
+			state.ping.post();
+			state.pong.wait();
+			TS_ASSERT_EQUALS(state.value, i + 1);
+		}
+		thread.join();
+	}
+
+	void test_worker_pool() {
+		enum { kTasks = 37 };
+
+		Common::WorkerPool pool;
+		TS_ASSERT_EQUALS(pool.getThreads(), 1u);
+		const uint threads = pool.setThreads(4);
+		TS_ASSERT(threads == 4 || (threads == 1 && !Common::Thread::isSupported()));
+
+		// Run several jobs on the same workers, with more and with fewer
+		// tasks than threads
+		for (uint tasks = 0; tasks <= kTasks; tasks += 3) {
+			uint32 counts[kTasks] = {};
+			pool.run(countTask, counts, tasks);
+			for (uint i = 0; i < kTasks; ++i)
+				TS_ASSERT_EQUALS(counts[i], i < tasks ? 1u : 0u);
+		}
+
+		TS_ASSERT_EQUALS(pool.setThreads(1), 1u);
+		uint32 counts[kTasks] = {};
+		pool.run(countTask, counts, kTasks);
+		for (uint i = 0; i < kTasks; ++i)
+			TS_ASSERT_EQUALS(counts[i], 1u);
+	}
+};
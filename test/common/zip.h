@@ -0,0 +1,223 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/array.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/unzip.h"
+
+/**
+ * Builds ZIP files in memory. Deflated members are made of stored deflate
+ * blocks, so that no compressor is needed.
+ */
+class ZipBuilder {
+public:
+	void addMember(const char *name, const Common::Array<byte> &data, bool deflate) {
+		Common::Array<byte> packed;
+		if (deflate) {
+			uint32 pos = 0;
+			do {
+				const uint32 length = MIN<uint32>(data.size() - pos, 65535);
+				packed.push_back(pos + length == data.size() ? 1 : 0);
+				packed.push_back(length & 0xFF);
+				packed.push_back(length >> 8);
+				packed.push_back(~length & 0xFF);
+				packed.push_back((~length >> 8) & 0xFF);
+				for (uint32 i = 0; i < length; i++)
+					packed.push_back(data[pos + i]);
+				pos += length;
+			} while (pos < data.size());
+		} else {
+			packed = data;
+		}
+
+		const uint32 nameLength = strlen(name);
+		const uint32 crc = crc32(data);
+		const uint32 offset = _file.size();
+
+		putUint32(_file, 0x04034B50);
+		putUint16(_file, 20);
+		putUint16(_file, 0);
+		putUint16(_file, deflate ? 8 : 0);
+		putUint32(_file, 0);
+		putUint32(_file, crc);
+		putUint32(_file, packed.size());
+		putUint32(_file, data.size());
+		putUint16(_file, nameLength);
+		putUint16(_file, 0);
+		for (uint32 i = 0; i < nameLength; i++)
+			_file.push_back(name[i]);
+		for (uint32 i = 0; i < packed.size(); i++)
+			_file.push_back(packed[i]);
+
+		putUint32(_directory, 0x02014B50);
+		putUint16(_directory, 20);
+		putUint16(_directory, 20);
+		putUint16(_directory, 0);
+		putUint16(_directory, deflate ? 8 : 0);
+		putUint32(_directory, 0);
+		putUint32(_directory, crc);
+		putUint32(_directory, packed.size());
+		putUint32(_directory, data.size());
+		putUint16(_directory, nameLength);
+		putUint32(_directory, 0);
+		putUint32(_directory, 0);
+		putUint32(_directory, 0);
+		putUint32(_directory, offset);
+		for (uint32 i = 0; i < nameLength; i++)
+			_directory.push_back(name[i]);
+
+		_members++;
+	}
+
+	Common::Archive *createArchive() {
+		Common::Array<byte> file = _file;
+		for (uint32 i = 0; i < _directory.size(); i++)
+			file.push_back(_directory[i]);
+
+		putUint32(file, 0x06054B50);
+		putUint32(file, 0);
+		putUint16(file, _members);
+		putUint16(file, _members);
+		putUint32(file, _directory.size());
+		putUint32(file, _file.size());
+		putUint16(file, 0);
+
+		byte *buffer = (byte *)malloc(file.size());
+		memcpy(buffer, file.begin(), file.size());
+		return Common::makeZipArchive(new Common::MemoryReadStream(buffer, file.size(), DisposeAfterUse::YES));
+	}
+
+	ZipBuilder() : _members(0) {}
+
+private:
+	Common::Array<byte> _file;
+	Common::Array<byte> _directory;
+	uint16 _members;
+
+	static void putUint16(Common::Array<byte> &dst, uint16 value) {
+		dst.push_back(value & 0xFF);
+		dst.push_back(value >> 8);
+	}
+
+	static void putUint32(Common::Array<byte> &dst, uint32 value) {
+		putUint16(dst, value & 0xFFFF);
+		putUint16(dst, value >> 16);
+	}
+
+	static uint32 crc32(const Common::Array<byte> &data) {
+		uint32 crc = 0xFFFFFFFF;
+		for (uint32 i = 0; i < data.size(); i++) {
+			crc ^= data[i];
+			for (int bit = 0; bit < 8; bit++)
+				crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+		}
+		return ~crc;
+	}
+};
+
+class ZipTestSuite : public CxxTest::TestSuite {
+public:
+	static Common::Array<byte> makeData(uint32 size, uint32 seed) {
+		Common::Array<byte> data(size);
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 16;
+		}
+		return data;
+	}
+
+	static bool checkRange(Common::SeekableReadStream &stream, const Common::Array<byte> &data, uint32 pos, uint32 size) {
+		Common::Array<byte> buffer(size);
+		if (!stream.seek(pos) || stream.read(buffer.begin(), size) != size)
+			return false;
+		return memcmp(buffer.begin(), &data[pos], size) == 0;
+	}
+
+	void test_stored_member() {
+		const Common::Array<byte> data = makeData(5000, 1);
+
+		ZipBuilder builder;
+		builder.addMember("stored.bin", data, false);
+		Common::ScopedPtr<Common::Archive> archive(builder.createArchive());
+		TS_ASSERT(archive);
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember("STORED.BIN"));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 5000);
+		TS_ASSERT(checkRange(*stream, data, 0, 5000));
+		TS_ASSERT(checkRange(*stream, data, 1234, 100));
+
+		// The member stays readable after the archive is gone
+		archive.reset();
+		TS_ASSERT(checkRange(*stream, data, 4000, 1000));
+	}
+
+#ifdef USE_ZLIB
+	void test_small_deflated_member() {
+		const Common::Array<byte> data = makeData(1000, 2);
+
+		ZipBuilder builder;
+		builder.addMember("small.bin", data, true);
+		Common::ScopedPtr<Common::Archive> archive(builder.createArchive());
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember("small.bin"));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), 1000);
+		TS_ASSERT(checkRange(*stream, data, 0, 1000));
+	}
+
+	void test_large_deflated_member() {
+		const uint32 size = 700000;
+		const Common::Array<byte> data = makeData(size, 3);
+
+		ZipBuilder builder;
+		builder.addMember("large.bin", data, true);
+		Common::ScopedPtr<Common::Archive> archive(builder.createArchive());
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember("large.bin"));
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), (int32)size);
+
+		TS_ASSERT(checkRange(*stream, data, 0, size));
+		TS_ASSERT(!stream->err());
+		TS_ASSERT_EQUALS(stream->pos(), (int32)size);
+
+		byte extra;
+		TS_ASSERT_EQUALS(stream->read(&extra, 1), 0u);
+		TS_ASSERT(stream->eos());
+
+		// Seeking backwards, forwards and relative to the end
+		TS_ASSERT(checkRange(*stream, data, 600000, 5000));
+		TS_ASSERT(checkRange(*stream, data, 10, 300000));
+		TS_ASSERT(checkRange(*stream, data, 262140, 10));
+		TS_ASSERT(checkRange(*stream, data, 524300, 1));
+		TS_ASSERT(stream->seek(-100, SEEK_END));
+		TS_ASSERT_EQUALS(stream->pos(), (int32)size - 100);
+		TS_ASSERT(!stream->seek(size + 1));
+		TS_ASSERT(!stream->err());
+	}
+
+	void test_interleaved_members() {
+		const Common::Array<byte> data1 = makeData(300000, 4);
+		const Common::Array<byte> data2 = makeData(200000, 5);
+
+		ZipBuilder builder;
+		builder.addMember("one.bin", data1, true);
+		builder.addMember("two.bin", data2, false);
+		Common::ScopedPtr<Common::Archive> archive(builder.createArchive());
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream1(archive->createReadStreamForMember("one.bin"));
+		Common::ScopedPtr<Common::SeekableReadStream> stream2(archive->createReadStreamForMember("two.bin"));
+		TS_ASSERT(stream1 && stream2);
+
+		archive.reset();
+
+		for (uint32 pos = 0; pos < 200000; pos += 50000) {
+			TS_ASSERT(checkRange(*stream1, data1, pos, 50000));
+			TS_ASSERT(checkRange(*stream2, data2, pos, 50000));
+		}
+		TS_ASSERT(checkRange(*stream1, data1, 250000, 50000));
+	}
+#endif
+};
@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+"""
+Plays a small Z-code story headless with a command file, and checks that
+the game ends with the commands and reports its opcode profile.
+
+Usage: headless_replay.py <scummvm executable> <engine data directory>
+
+The story is made up here, so no game data is needed. It reads a line
+with sread, prints "ok" and loops, so every command in the file makes
+one more sread, and the last one finds the end of the file and quits.
+"""
+
+import os
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+COMMANDS = ['look', 'north', 'take lamp']
+
+
+def make_story():
+	mem = bytearray(0x400)
+
+	def word(addr, value):
+		struct.pack_into('>H', mem, addr, value)
+
+	mem[0] = 3              # version
+	word(0x02, 1)           # release
+	word(0x04, 0x3c0)       # high memory
+	word(0x06, 0x3c0)       # initial pc
+	word(0x08, 0x3b0)       # dictionary
+	word(0x0a, 0x100)       # object table
+	word(0x0c, 0x150)       # globals
+	word(0x0e, 0x3b0)       # static memory
+	mem[0x12:0x18] = b'260101'
+	word(0x18, 0x40)        # abbreviations
+	word(0x13e + 7, 0x147)  # property table of object 1
+	mem[0x330] = 60         # text buffer size
+	mem[0x370] = 8          # parse buffer size
+	mem[0x3b0:0x3b4] = bytearray([0, 7, 0, 0])  # no separators, no words
+
+	code = bytearray()
+	code += bytearray([0xe4, 0x0f, 0x03, 0x30, 0x03, 0x70])   # sread text parse
+	code += bytearray([0x95, 0x10])                           # inc g00
+	code += bytearray([0xb2]) + struct.pack('>H', 0x8000 | 20 << 10 | 16 << 5 | 5)  # print "ok"
+	code += bytearray([0xbb])                                 # new_line
+	code += bytearray([0x8c]) + struct.pack('>h', -(len(code) + 1))  # jump to sread
+	mem[0x3c0:0x3c0 + len(code)] = code
+
+	word(0x1a, len(mem) // 2)             # file length
+	word(0x1c, sum(mem[0x40:]) & 0xffff)  # checksum
+	return mem
+
+
+def run(scummvm, extrapath, workdir, replay_file):
+	ini = os.path.join(workdir, 'scummvm.ini')
+	with open(ini, 'w') as f:
+		f.write('[scummvm]\n'
+			'[headless]\n'
+			'engineid=glk\n'
+			'gameid=zcode\n'
+			'path=%s\n'
+			'filename=test.z3\n'
+			'headless=true\n'
+			'replay_file=%s\n' % (workdir, replay_file))
+
+	proc = subprocess.Popen([scummvm, '-c', ini, '--extrapath=' + extrapath,
+		'--debugflags=profile', '-d1', 'headless'],
+		stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+	output = proc.communicate()[0].decode('utf-8', 'replace')
+	return proc.returncode, output
+
+
+def check(name, returncode, output, reads):
+	expected = '  VAR:4: %d' % reads
+	if returncode == 0 and expected in output.splitlines():
+		print('%s: OK' % name)
+		return True
+
+	print('%s: FAILED, expected exit code 0 and "%s"' % (name, expected.strip()))
+	print(output)
+	return False
+
+
+def main():
+	if len(sys.argv) != 3:
+		print(__doc__.strip())
+		return 2
+
+	scummvm = os.path.abspath(sys.argv[1])
+	extrapath = os.path.abspath(sys.argv[2])
+	workdir = tempfile.mkdtemp()
+	try:
+		with open(os.path.join(workdir, 'test.z3'), 'wb') as f:
+			f.write(make_story())
+		replay_file = os.path.join(workdir, 'commands.rec')
+		with open(replay_file, 'w') as f:
+			f.write(''.join(c + '\n' for c in COMMANDS))
+
+		# One sread per command, and one that finds the end of the file
+		returncode, output = run(scummvm, extrapath, workdir, replay_file)
+		ok = check('replay', returncode, output, len(COMMANDS) + 1)
+
+		# Without commands the first sread ends the game
+		returncode, output = run(scummvm, extrapath, workdir, os.path.join(workdir, 'missing.rec'))
+		ok = check('missing replay file', returncode, output, 1) and ok
+	finally:
+		shutil.rmtree(workdir)
+
+	return 0 if ok else 1
+
+
+if __name__ == '__main__':
+	sys.exit(main())
@@ -0,0 +1,33 @@
+#ifndef TEST_ENGINES_SCI_HELPER_H
+#define TEST_ENGINES_SCI_HELPER_H
+
+#include "engines/sci/engine/vm.h"
+
+namespace Sci {
+
+/**
+ * Make an address without the accessors of reg_t, which depend on the
+ * version of the running game.
+ */
+static inline reg_t makeTestReg(uint16 segment, uint16 offset) {
+	reg_t reg;
+	reg._segment = segment;
+	reg._offset = offset;
+	return reg;
+}
+
+/**
+ * Make a stack frame without the constructor of ExecStack, which depends
+ * on the version of the running game.
+ */
+static inline const ExecStack &makeTestFrame(byte *storage, int debugOrigin) {
+	memset(storage, 0, sizeof(ExecStack));
+	ExecStack &frame = *(ExecStack *)storage;
+	frame.debugOrigin = debugOrigin;
+	frame.type = EXEC_STACK_TYPE_CALL;
+	return frame;
+}
+
+} // End of namespace Sci
+
+#endif
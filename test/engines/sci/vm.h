@@ -0,0 +1,65 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/sci/engine/vm.h"
+
+#include "helper.h"
+
+class SciVMTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_execution_stack_insert() {
+		Sci::ExecutionStack *stack = new Sci::ExecutionStack();
+		byte storage[sizeof(Sci::ExecStack)];
+
+		for (int i = 0; i < 4; i++)
+			stack->push_back(Sci::makeTestFrame(storage, i));
+		stack->updateMaxSize();
+
+		// A send inserts its frames in reverse order below the frames of
+		// the sends it triggers
+		stack->insert(2, Sci::makeTestFrame(storage, 10));
+		stack->insert(2, Sci::makeTestFrame(storage, 11));
+		const int expected[] = { 0, 1, 11, 10, 2, 3 };
+		TS_ASSERT_EQUALS(stack->size(), 6U);
+		for (uint i = 0; i < stack->size(); i++)
+			TS_ASSERT_EQUALS((*stack)[i].debugOrigin, expected[i]);
+
+		stack->truncate(2);
+		TS_ASSERT_EQUALS(stack->back().debugOrigin, 1);
+		TS_ASSERT_EQUALS(stack->getMaxSize(), 4U);
+		stack->resetStatistics();
+		TS_ASSERT_EQUALS(stack->getPushedFrames(), 0U);
+		TS_ASSERT_EQUALS(stack->getMaxSize(), 2U);
+
+		delete stack;
+	}
+
+	void test_selector_lookup_cache_invalidate() {
+		Sci::SelectorLookupCache *cache = new Sci::SelectorLookupCache();
+		const Sci::reg_t obj = Sci::makeTestReg(3, 0x20), funcAddress = Sci::makeTestReg(4, 0x100);
+
+		cache->store(obj, 7, Sci::kSelectorMethod, -1, funcAddress);
+		const Sci::SelectorLookupCache::Entry *entry = cache->find(obj, 7);
+		TS_ASSERT(entry != nullptr);
+		if (entry) {
+			TS_ASSERT_EQUALS(entry->type, Sci::kSelectorMethod);
+			TS_ASSERT_EQUALS(entry->funcAddress._offset, funcAddress._offset);
+		}
+		TS_ASSERT(cache->find(obj, 8) == nullptr);
+		TS_ASSERT(cache->find(Sci::makeTestReg(3, 0x22), 7) == nullptr);
+
+		cache->invalidate();
+		TS_ASSERT(cache->find(obj, 7) == nullptr);
+
+		cache->store(obj, 7, Sci::kSelectorVariable, 5, Sci::makeTestReg(0, 0));
+		cache->resetStatistics();
+		entry = cache->find(obj, 7);
+		TS_ASSERT(entry != nullptr);
+		if (entry)
+			TS_ASSERT_EQUALS(entry->varIndex, 5);
+		TS_ASSERT_EQUALS(cache->getLookups(), 1U);
+		TS_ASSERT_EQUALS(cache->getHits(), 1U);
+
+		delete cache;
+	}
+};
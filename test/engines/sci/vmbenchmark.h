@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/list.h"
+#include "common/str.h"
+#include "engines/sci/engine/vm.h"
+
+#include "helper.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Times the parts of the SCI VM which do not need game data, with
+ * synthetic scripts, and checks their results.
+ */
+class SciVMBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kObjects = 48,
+		kClassDepth = 4,
+		kVariables = 24,
+		kMethods = 16,
+		kSends = 2000000,
+		kCalls = 240000
+	};
+
+	/**
+	 * A class hierarchy like the ones of SCI games: every class has its
+	 * own methods, and all classes share the variables of their species.
+	 * Class n inherits from class n - 1.
+	 */
+	struct Classes {
+		Sci::Selector variables[kVariables];
+		Sci::Selector methods[kClassDepth][kMethods];
+
+		Classes() {
+			Sci::Selector selector = 0;
+			for (int i = 0; i < kVariables; i++)
+				variables[i] = selector++;
+			for (int depth = 0; depth < kClassDepth; depth++) {
+				for (int i = 0; i < kMethods; i++)
+					methods[depth][i] = selector++;
+			}
+		}
+
+		/**
+		 * Look up a selector the way lookupSelector() does without the
+		 * cache: scan the variables, then the methods from the class of the
+		 * object up to the base class.
+		 */
+		Sci::SelectorType lookup(Sci::Selector selectorId, int *varIndex, Sci::reg_t *funcAddress) const {
+			for (int i = 0; i < kVariables; i++) {
+				if (variables[i] == selectorId) {
+					*varIndex = i;
+					return Sci::kSelectorVariable;
+				}
+			}
+			for (int depth = kClassDepth - 1; depth >= 0; depth--) {
+				for (int i = 0; i < kMethods; i++) {
+					if (methods[depth][i] == selectorId) {
+						*funcAddress = Sci::makeTestReg(depth + 1, i * 16);
+						return Sci::kSelectorMethod;
+					}
+				}
+			}
+			return Sci::kSelectorNone;
+		}
+	};
+
+	/**
+	 * The object and selector of a send. Scripts mostly send a few
+	 * selectors, like doit and the position variables, to the objects of
+	 * the current scene.
+	 */
+	static void getSend(uint32 &seed, Sci::reg_t &obj, Sci::Selector &selectorId) {
+		seed = seed * 1103515245 + 12345;
+		obj = Sci::makeTestReg(10 + (seed >> 8) % 4, ((seed >> 12) % (kObjects / 4)) * 0x40);
+		const uint32 selector = (seed >> 20) % 16;
+		selectorId = selector < 12 ? selector % 6 : kVariables + (selector % (kClassDepth * kMethods));
+	}
+
+	void test_selector_lookup_cache() {
+		Classes classes;
+		Sci::SelectorLookupCache *cache = new Sci::SelectorLookupCache();
+
+		uint32 seed = 0, scanned = 0;
+		Benchmark::Timer timer;
+		for (int i = 0; i < kSends; i++) {
+			Sci::reg_t obj, funcAddress;
+			Sci::Selector selectorId;
+			int varIndex = -1;
+			getSend(seed, obj, selectorId);
+			if (classes.lookup(selectorId, &varIndex, &funcAddress) == Sci::kSelectorVariable)
+				scanned += varIndex;
+			else
+				scanned += funcAddress._offset;
+		}
+		const uint32 scanTime = timer.elapsed();
+
+		seed = 0;
+		uint32 cached = 0;
+		timer.restart();
+		for (int i = 0; i < kSends; i++) {
+			Sci::reg_t obj, funcAddress;
+			Sci::Selector selectorId;
+			getSend(seed, obj, selectorId);
+			const Sci::SelectorLookupCache::Entry *entry = cache->find(obj, selectorId);
+			Sci::SelectorType type;
+			int varIndex = -1;
+			if (entry) {
+				type = entry->type;
+				varIndex = entry->varIndex;
+				funcAddress = entry->funcAddress;
+			} else {
+				type = classes.lookup(selectorId, &varIndex, &funcAddress);
+				cache->store(obj, selectorId, type, varIndex, funcAddress);
+			}
+			if (type == Sci::kSelectorVariable)
+				cached += varIndex;
+			else
+				cached += funcAddress._offset;
+		}
+		const uint32 cacheTime = timer.elapsed();
+
+		TS_ASSERT_EQUALS(cached, scanned);
+		TS_ASSERT_EQUALS(cache->getLookups(), (uint32)kSends);
+		TS_TRACE(Common::String::format("%d selector lookups: %u us scanning the classes, %u us with the cache, %u%% hits",
+			(int)kSends, scanTime, cacheTime, (uint32)((uint64)cache->getHits() * 100 / kSends)).c_str());
+
+		delete cache;
+	}
+
+	/**
+	 * Push and pop the frames of nested calls, sends and kernel calls, 1 to
+	 * 12 deep, like scripts do during a game cycle.
+	 */
+	template<class Stack>
+	static uint32 runCalls(Stack &stack, uint32 &maxSize) {
+		byte storage[sizeof(Sci::ExecStack)];
+		uint32 sum = 0;
+		maxSize = 0;
+		for (int call = 0; call < kCalls; call++) {
+			const int depth = 1 + call % 12;
+			for (int i = 0; i < depth; i++)
+				stack.push_back(Sci::makeTestFrame(storage, i));
+			if (stack.size() > maxSize)
+				maxSize = stack.size();
+			for (int i = 0; i < depth; i++) {
+				sum += stack.back().debugOrigin;
+				stack.pop_back();
+			}
+		}
+		return sum;
+	}
+
+	void test_execution_stack() {
+		Sci::ExecutionStack *stack = new Sci::ExecutionStack();
+		Common::List<Sci::ExecStack> list;
+		uint32 maxSize, listMaxSize;
+
+		Benchmark::Timer timer;
+		const uint32 listSum = runCalls(list, listMaxSize);
+		const uint32 listTime = timer.elapsed();
+
+		timer.restart();
+		const uint32 sum = runCalls(*stack, maxSize);
+		const uint32 stackTime = timer.elapsed();
+
+		TS_ASSERT_EQUALS(sum, listSum);
+		TS_ASSERT_EQUALS(maxSize, listMaxSize);
+		TS_ASSERT(stack->empty());
+		TS_ASSERT_EQUALS(stack->getPushedFrames(), (uint32)kCalls * 13 / 2);
+		TS_TRACE(Common::String::format("%u frames pushed and popped: %u us with Common::List, %u us with ExecutionStack",
+			stack->getPushedFrames(), listTime, stackTime).c_str());
+
+		delete stack;
+	}
+};
@@ -0,0 +1,159 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/scaler.h"
+
+class BandedScalerTestSuite : public CxxTest::TestSuite {
+public:
+	enum {
+		kWidth = 96,
+		kHeight = 83,
+		/** Pixels around the source, as the scalers read beyond the area. */
+		kBorder = 4,
+		kSrcPitch = (kWidth + 2 * kBorder) * 2
+	};
+
+	Common::Array<byte> _source;
+
+	void setUp() {
+		InitScalers(565);
+
+		_source.resize(kSrcPitch * (kHeight + 2 * kBorder));
+		uint32 seed = 7;
+		for (uint i = 0; i < _source.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			// Few different colors, so that the HQ scalers find edges
+			_source[i] = (seed >> 16) & 0x8C;
+		}
+	}
+
+	void tearDown() {
+		DestroyScalers();
+	}
+
+	const byte *sourceAt(int x, int y) const {
+		return &_source[(y + kBorder) * kSrcPitch + (x + kBorder) * 2];
+	}
+
+	/**
+	 * Scale some areas at once and with the banded scaler, and check that
+	 * the results are the same.
+	 */
+	void checkScaler(ScalerProc *scaler, int scale, uint threads) {
+		const uint32 dstPitch = kWidth * scale * 2;
+		Common::Array<byte> expected(dstPitch * kHeight * scale, 0);
+		Common::Array<byte> result(dstPitch * kHeight * scale, 0);
+
+		// A large area which is split, and small ones which are not
+		const int areas[][4] = {
+			{ 0, 0, kWidth, 60 },
+			{ 8, 60, 40, 5 },
+			{ 50, 61, 30, 21 },
+			{ 0, 81, 16, 2 }
+		};
+
+		BandedScaler banded;
+		banded.setThreads(threads);
+		TS_ASSERT_EQUALS(banded.getThreads(), threads);
+
+		for (uint i = 0; i < ARRAYSIZE(areas); i++) {
+			const int x = areas[i][0], y = areas[i][1], w = areas[i][2], h = areas[i][3];
+			const uint32 dstOffset = y * scale * dstPitch + x * scale * 2;
+
+			scaler(sourceAt(x, y), kSrcPitch, &expected[dstOffset], dstPitch, w, h);
+			banded.add(scaler, sourceAt(x, y), kSrcPitch, &result[dstOffset], dstPitch, w, h, scale);
+		}
+		banded.run();
+
+		TS_ASSERT(memcmp(expected.begin(), result.begin(), expected.size()) == 0);
+
+		// The queue is empty after running
+		memset(result.begin(), 0, result.size());
+		banded.run();
+		for (uint i = 0; i < result.size(); i++)
+			TS_ASSERT_EQUALS(result[i], 0);
+	}
+
+	void checkScaler(ScalerProc *scaler, int scale) {
+		checkScaler(scaler, scale, 1);
+		checkScaler(scaler, scale, 2);
+		checkScaler(scaler, scale, 3);
+		checkScaler(scaler, scale, BandedScaler::kMaxThreads);
+	}
+
+	void test_thread_count() {
+		BandedScaler banded;
+		TS_ASSERT_EQUALS(banded.getThreads(), 1u);
+		banded.setThreads(0);
+		TS_ASSERT_EQUALS(banded.getThreads(), 1u);
+		banded.setThreads(100);
+		TS_ASSERT_EQUALS(banded.getThreads(), (uint)BandedScaler::kMaxThreads);
+	}
+
+	void test_normal() {
+		checkScaler(Normal1x, 1);
+#ifdef USE_SCALERS
+		checkScaler(Normal2x, 2);
+		checkScaler(Normal3x, 3);
+#endif
+	}
+
+#ifdef USE_SCALERS
+	void test_advmame() {
+		checkScaler(AdvMame2x, 2);
+		checkScaler(AdvMame3x, 3);
+	}
+
+	void test_2xsai() {
+		checkScaler(_2xSaI, 2);
+		checkScaler(Super2xSaI, 2);
+		checkScaler(SuperEagle, 2);
+	}
+
+	void test_tv_dotmatrix() {
+		checkScaler(TV2x, 2);
+		checkScaler(DotMatrix, 2);
+	}
+
+	void test_overlapping() {
+		// The DotMatrix pattern starts at the corner of each area, so where
+		// areas overlap, the one added last has to win as when scaling
+		// them one after another. The pattern only differs when the areas
+		// are apart by an odd number of pixels in one direction.
+		const int scale = 2;
+		const uint32 dstPitch = kWidth * scale * 2;
+		const int areas[][4] = {
+			{ 10, 10, 40, 40 },
+			{ 31, 20, 30, 31 },
+			{ 5, 36, 21, 20 },
+			{ 60, 0, 30, 9 },
+			{ 61, 4, 5, 5 }
+		};
+
+		for (uint threads = 1; threads <= BandedScaler::kMaxThreads; threads++) {
+			Common::Array<byte> expected(dstPitch * kHeight * scale, 0);
+			Common::Array<byte> result(dstPitch * kHeight * scale, 0);
+
+			BandedScaler banded;
+			banded.setThreads(threads);
+			for (uint i = 0; i < ARRAYSIZE(areas); i++) {
+				const int x = areas[i][0], y = areas[i][1], w = areas[i][2], h = areas[i][3];
+				const uint32 dstOffset = y * scale * dstPitch + x * scale * 2;
+
+				DotMatrix(sourceAt(x, y), kSrcPitch, &expected[dstOffset], dstPitch, w, h);
+				banded.add(DotMatrix, sourceAt(x, y), kSrcPitch, &result[dstOffset], dstPitch, w, h, scale);
+			}
+			banded.run();
+
+			TS_ASSERT(memcmp(expected.begin(), result.begin(), expected.size()) == 0);
+		}
+	}
+
+#ifdef USE_HQ_SCALERS
+	void test_hq() {
+		checkScaler(HQ2x, 2);
+		checkScaler(HQ3x, 3);
+	}
+#endif
+#endif
+};
@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/scaler.h"
+#include "graphics/scaler/intern.h"
+
+#ifdef USE_HQ_PATTERN_ROWS
+extern "C" uint32 *RGBtoYUV;
+#endif
+
+/**
+ * Checks the pattern detection and the blending of the hq scalers against
+ * doing it one pixel at a time.
+ */
+class HQScalerTestSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		/** Pixels around the source, as the scalers read beyond it. */
+		kBorder = 4
+	};
+
+	void setUp() {
+		InitScalers(565);
+	}
+
+	void tearDown() {
+		DestroyScalers();
+	}
+
+	/**
+	 * Fill a 565 frame with horizontal runs of a few colors and some noise,
+	 * which gives the hq scalers both flat areas and edges.
+	 */
+	static void fillFrame(Common::Array<uint16> &frame, uint32 seed) {
+		uint16 color = 0;
+		for (uint i = 0; i < frame.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			if (((seed >> 16) & 15) == 0)
+				color = (seed >> 8) & 0xC718;
+			frame[i] = ((seed >> 20) & 7) ? color : (uint16)(seed >> 4);
+		}
+	}
+
+#ifdef USE_HQ_PATTERN_ROWS
+	void test_hq_patterns() {
+		// Odd width, so that the last pixels are compared one by one
+		const int width = 37, height = 9, pitch = width + 2 * kBorder;
+		Common::Array<uint16> src(pitch * (height + 2 * kBorder));
+		fillFrame(src, 5);
+		const uint16 *first = &src[kBorder * pitch + kBorder];
+
+		HQPatternRows patternRows(first, pitch, width);
+		for (int y = 0; y < height; y++) {
+			const uint16 *keys = patternRows.nextRow();
+			for (int x = 0; x < width; x++) {
+				const uint16 *p = first + y * pitch + x;
+				const int neighbours[8] = { -pitch - 1, -pitch, -pitch + 1, -1, 1, pitch - 1, pitch, pitch + 1 };
+
+				int key = 0;
+				for (int i = 0; i < 8; i++) {
+					if (diffYUV(RGBtoYUV[*p], RGBtoYUV[p[neighbours[i]]]))
+						key |= 1 << i;
+				}
+				if (diffYUV(RGBtoYUV[p[-1]], RGBtoYUV[p[-pitch]]))
+					key |= HQPatternRows::kDiff42;
+				if (diffYUV(RGBtoYUV[p[-pitch]], RGBtoYUV[p[1]]))
+					key |= HQPatternRows::kDiff26;
+				if (diffYUV(RGBtoYUV[p[pitch]], RGBtoYUV[p[-1]]))
+					key |= HQPatternRows::kDiff84;
+				if (diffYUV(RGBtoYUV[p[1]], RGBtoYUV[p[pitch]]))
+					key |= HQPatternRows::kDiff68;
+				TS_ASSERT_EQUALS(keys[x], key);
+			}
+		}
+	}
+
+	/**
+	 * Compare the SIMD blending against the interpolate16 functions, which
+	 * blend the pixels left over at the end of a row. Scaling the columns
+	 * one by one leaves all pixels over.
+	 */
+	void checkHQInterpolation(ScalerProc *scaler, int scale, uint16 topBits) {
+		const int width = 37, height = 9, pitch = width + 2 * kBorder;
+		Common::Array<uint16> src(pitch * (height + 2 * kBorder));
+		fillFrame(src, 6);
+		for (uint i = 0; i < src.size(); i++)
+			src[i] |= topBits;
+		const uint16 *first = &src[kBorder * pitch + kBorder];
+
+		const int dstPitch = width * scale;
+		Common::Array<uint16> rows(dstPitch * height * scale), columns(dstPitch * height * scale);
+		scaler((const uint8 *)first, pitch * 2, (uint8 *)rows.begin(), dstPitch * 2, width, height);
+		for (int x = 0; x < width; x++)
+			scaler((const uint8 *)(first + x), pitch * 2, (uint8 *)&columns[x * scale], dstPitch * 2, 1, height);
+
+		TS_ASSERT(memcmp(rows.begin(), columns.begin(), rows.size() * sizeof(uint16)) == 0);
+	}
+
+	void test_hq_interpolation() {
+		checkHQInterpolation(HQ2x, 2, 0);
+		checkHQInterpolation(HQ3x, 3, 0);
+	}
+
+	void test_hq_interpolation_555() {
+		// The noise of fillFrame() sets the unused top bit of some pixels,
+		// and the second run sets it for all of them
+		DestroyScalers();
+		InitScalers(555);
+		checkHQInterpolation(HQ2x, 2, 0);
+		checkHQInterpolation(HQ3x, 3, 0);
+		checkHQInterpolation(HQ2x, 2, 0x8000);
+		checkHQInterpolation(HQ3x, 3, 0x8000);
+	}
+#endif
+};
@@ -0,0 +1,178 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/managed_surface.h"
+
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite {
+public:
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		const byte *p = (const byte *)surface.getBasePtr(x, y);
+		switch (surface.format.bytesPerPixel) {
+		case 1:
+			return *p;
+		case 2:
+			return *(const uint16 *)p;
+		default:
+			return *(const uint32 *)p;
+		}
+	}
+
+	static void setPixel(Graphics::Surface &surface, int x, int y, uint32 color) {
+		byte *p = (byte *)surface.getBasePtr(x, y);
+		switch (surface.format.bytesPerPixel) {
+		case 1:
+			*p = color;
+			break;
+		case 2:
+			*(uint16 *)p = color;
+			break;
+		default:
+			*(uint32 *)p = color;
+			break;
+		}
+	}
+
+	/** Fill a surface with random colors, a third of them being the key. */
+	static void fillRandom(Graphics::Surface &surface, uint32 seed, uint32 key) {
+		for (int y = 0; y < surface.h; ++y) {
+			for (int x = 0; x < surface.w; ++x) {
+				seed = seed * 1103515245 + 12345;
+				const uint32 color = ((seed >> 8) % 3) ? seed : key;
+				setPixel(surface, x, y, color & (0xFFFFFFFF >> (32 - surface.format.bytesPerPixel * 8)));
+			}
+		}
+	}
+
+	static Graphics::PixelFormat getFormat(int bytesPerPixel) {
+		switch (bytesPerPixel) {
+		case 1:
+			return Graphics::PixelFormat::createFormatCLUT8();
+		case 2:
+			return Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		default:
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24);
+		}
+	}
+
+	void checkKeyBlit(int bytesPerPixel) {
+		// Odd sizes, so that the rows are not a multiple of the vector size
+		const Graphics::PixelFormat format = getFormat(bytesPerPixel);
+		const uint32 key = bytesPerPixel == 1 ? 0xFF : 0xF81F;
+
+		Graphics::Surface src, dest, reference;
+		src.create(37, 11, format);
+		dest.create(45, 13, format);
+		reference.create(45, 13, format);
+		fillRandom(src, 1, key);
+		fillRandom(dest, 2, 0);
+		reference.copyFrom(dest);
+
+		for (int y = 0; y < src.h; ++y) {
+			for (int x = 0; x < src.w; ++x) {
+				const uint32 color = getPixel(src, x, y);
+				if (color != key)
+					setPixel(reference, x + 5, y + 1, color);
+			}
+		}
+
+		TS_ASSERT(Graphics::keyBlit((byte *)dest.getBasePtr(5, 1), (const byte *)src.getPixels(),
+			dest.pitch, src.pitch, src.w, src.h, bytesPerPixel, key));
+		TS_ASSERT_EQUALS(memcmp(dest.getPixels(), reference.getPixels(), dest.pitch * dest.h), 0);
+
+		src.free();
+		dest.free();
+		reference.free();
+	}
+
+	void test_key_blit() {
+		checkKeyBlit(1);
+		checkKeyBlit(2);
+		checkKeyBlit(4);
+
+		byte pixel = 0;
+		TS_ASSERT(!Graphics::keyBlit(&pixel, &pixel, 3, 3, 1, 1, 3, 0));
+	}
+
+	void checkTransBlit(int bytesPerPixel, const Common::Rect &srcRect, const Common::Point &destPos) {
+		const Graphics::PixelFormat format = getFormat(bytesPerPixel);
+		const uint32 key = 3;
+
+		Graphics::Surface src;
+		src.create(50, 40, format);
+		fillRandom(src, 3, key);
+
+		Graphics::Surface reference;
+		reference.create(64, 48, format);
+		fillRandom(reference, 4, 0);
+		Graphics::ManagedSurface dest(64, 48, format);
+		dest.blitFrom(reference);
+
+		for (int y = 0; y < srcRect.height(); ++y) {
+			for (int x = 0; x < srcRect.width(); ++x) {
+				const uint32 color = getPixel(src, srcRect.left + x, srcRect.top + y);
+				const int destX = destPos.x + x, destY = destPos.y + y;
+				if (color != key && destX >= 0 && destX < dest.w && destY >= 0 && destY < dest.h)
+					setPixel(reference, destX, destY, color);
+			}
+		}
+
+		dest.transBlitFrom(src, srcRect, destPos, key);
+		for (int y = 0; y < dest.h; ++y)
+			TS_ASSERT_EQUALS(memcmp(dest.getBasePtr(0, y), reference.getBasePtr(0, y), dest.w * bytesPerPixel), 0);
+
+		src.free();
+		reference.free();
+	}
+
+	void test_trans_blit() {
+		for (int bytesPerPixel = 1; bytesPerPixel <= 4; bytesPerPixel *= 2) {
+			checkTransBlit(bytesPerPixel, Common::Rect(0, 0, 50, 40), Common::Point(3, 5));
+			// Clipped on all sides
+			checkTransBlit(bytesPerPixel, Common::Rect(0, 0, 50, 40), Common::Point(-7, -9));
+			checkTransBlit(bytesPerPixel, Common::Rect(0, 0, 50, 40), Common::Point(30, 20));
+			// Part of the source, which is not scaled to the full source size
+			checkTransBlit(bytesPerPixel, Common::Rect(11, 6, 30, 27), Common::Point(2, 1));
+		}
+	}
+
+	void test_blit_conversion() {
+		const Graphics::PixelFormat format16 = getFormat(2);
+		const Graphics::PixelFormat format32 = getFormat(4);
+
+		Graphics::Surface src;
+		src.create(21, 7, format16);
+		fillRandom(src, 5, 0);
+
+		Graphics::ManagedSurface dest(30, 10, format32);
+		dest.clear(format32.ARGBToColor(0xFF, 1, 2, 3));
+		dest.blitFrom(src, Common::Point(4, 2));
+
+		for (int y = 0; y < dest.h; ++y) {
+			for (int x = 0; x < dest.w; ++x) {
+				const bool inside = x >= 4 && x < 25 && y >= 2 && y < 9;
+				byte r, g, b;
+				format16.colorToRGB(inside ? getPixel(src, x - 4, y - 2) : format16.RGBToColor(1, 2, 3), r, g, b);
+				const uint32 expected = inside ? format32.ARGBToColor(0xFF, r, g, b) : format32.ARGBToColor(0xFF, 1, 2, 3);
+				TS_ASSERT_EQUALS(getPixel(dest.rawSurface(), x, y), expected);
+			}
+		}
+
+		src.free();
+	}
+
+	void test_fill() {
+		for (int bytesPerPixel = 2; bytesPerPixel <= 4; bytesPerPixel *= 2) {
+			Graphics::ManagedSurface surface(37, 9, getFormat(bytesPerPixel));
+			const uint32 color = bytesPerPixel == 2 ? 0x1234 : 0x12345678;
+			surface.clear(0x5555);
+			surface.fillRect(Common::Rect(1, 2, 36, 8), color);
+
+			for (int y = 0; y < surface.h; ++y) {
+				for (int x = 0; x < surface.w; ++x) {
+					const bool inside = x >= 1 && x < 36 && y >= 2 && y < 8;
+					TS_ASSERT_EQUALS(getPixel(surface.rawSurface(), x, y), inside ? color : 0x5555u);
+				}
+			}
+		}
+	}
+};
@@ -0,0 +1,95 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/scaler.h"
+#include "graphics/scaler/intern.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Traces the time every scaler takes for a frame of common game screen
+ * sizes.
+ */
+class ScalerBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kFrames = 3,
+		/** Pixels around the source, as the scalers read beyond it. */
+		kBorder = 4
+	};
+
+	struct Scaler {
+		const char *name;
+		ScalerProc *proc;
+		int scale;
+	};
+
+	void setUp() {
+		InitScalers(565);
+	}
+
+	void tearDown() {
+		DestroyScalers();
+	}
+
+	/**
+	 * Fill a 565 frame with horizontal runs of a few colors and some noise,
+	 * which gives the hq scalers both flat areas and edges.
+	 */
+	static void fillFrame(Common::Array<uint16> &frame, uint32 seed) {
+		uint16 color = 0;
+		for (uint i = 0; i < frame.size(); i++) {
+			seed = seed * 1103515245 + 12345;
+			if (((seed >> 16) & 15) == 0)
+				color = (seed >> 8) & 0xC718;
+			frame[i] = ((seed >> 20) & 7) ? color : (uint16)(seed >> 4);
+		}
+	}
+
+	void benchmark(int width, int height) {
+		static const Scaler scalers[] = {
+			{ "Normal1x", Normal1x, 1 },
+#ifdef USE_SCALERS
+			{ "Normal2x", Normal2x, 2 },
+			{ "Normal3x", Normal3x, 3 },
+			{ "2xSaI", _2xSaI, 2 },
+			{ "Super2xSaI", Super2xSaI, 2 },
+			{ "SuperEagle", SuperEagle, 2 },
+			{ "AdvMame2x", AdvMame2x, 2 },
+			{ "AdvMame3x", AdvMame3x, 3 },
+			{ "TV2x", TV2x, 2 },
+			{ "DotMatrix", DotMatrix, 2 },
+#ifdef USE_HQ_SCALERS
+			{ "HQ2x", HQ2x, 2 },
+			{ "HQ3x", HQ3x, 3 },
+#endif
+#endif
+		};
+
+		const uint32 srcPitch = (width + 2 * kBorder) * 2;
+		Common::Array<uint16> src((width + 2 * kBorder) * (height + 2 * kBorder));
+		fillFrame(src, width);
+		const uint8 *srcPtr = (const uint8 *)&src[kBorder * (width + 2 * kBorder) + kBorder];
+
+		Common::String trace = Common::String::format("%dx%d frame, us per frame:", width, height);
+		for (uint i = 0; i < ARRAYSIZE(scalers); i++) {
+			const uint32 dstPitch = width * scalers[i].scale * 2;
+			Common::Array<uint8> dst(dstPitch * height * scalers[i].scale);
+
+			const Benchmark::Timer timer;
+			for (int frame = 0; frame < kFrames; frame++)
+				scalers[i].proc(srcPtr, srcPitch, dst.begin(), dstPitch, width, height);
+			trace += Common::String::format(" %s %d", scalers[i].name, timer.elapsed() / kFrames);
+		}
+		TS_TRACE(trace.c_str());
+	}
+
+	void test_320x200() {
+		benchmark(320, 200);
+	}
+
+	void test_640x480() {
+		benchmark(640, 480);
+	}
+};
@@ -0,0 +1,186 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+public:
+	static void fillRandom(Graphics::Surface &surface, uint32 seed) {
+		for (int y = 0; y < surface.h; ++y) {
+			uint32 *row = (uint32 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; ++x) {
+				seed = seed * 1103515245 + 12345;
+				uint32 color = seed ^ (seed << 13);
+				// Plenty of fully transparent and fully opaque pixels
+				switch ((seed >> 28) & 3) {
+				case 0:
+					color &= 0xFFFFFF00;
+					break;
+				case 1:
+					color |= 0xFF;
+					break;
+				default:
+					break;
+				}
+				row[x] = color;
+			}
+		}
+	}
+
+	static uint32 channel(uint32 color, int shift) {
+		return (color >> shift) & 0xFF;
+	}
+
+	/** Alpha blending with color modulation, as the plain loops do it. */
+	static uint32 blend(uint32 in, uint32 out, uint32 color) {
+		const uint32 a = in & 0xFF;
+		uint32 result = 0xFF;
+
+		if (color == 0xFFFFFFFF) {
+			if (a == 0)
+				return out;
+			for (int shift = 8; shift <= 24; shift += 8)
+				result |= ((channel(in, shift) * a + channel(out, shift) * (255 - a)) >> 8) << shift;
+		} else {
+			const uint32 ina = a * (color >> 24) >> 8;
+			// The color modulation is ARGB, the pixels are RGBA
+			for (int shift = 8; shift <= 24; shift += 8) {
+				const uint32 mod = channel(color, shift - 8);
+				const uint32 value = (channel(out, shift) * (255 - ina) >> 8) + (channel(in, shift) * ina * mod >> 16);
+				result |= (value & 0xFF) << shift;
+			}
+		}
+
+		return result;
+	}
+
+	void checkBlit(Graphics::AlphaType alphaMode, uint color, int flipping) {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+
+		// Odd width, so that the last pixels of each row are blitted one by one
+		Graphics::TransparentSurface sprite;
+		sprite.create(23, 9, format);
+		fillRandom(sprite, 1);
+		sprite.setAlphaMode(alphaMode);
+
+		Graphics::Surface target, expected;
+		target.create(40, 20, format);
+		fillRandom(target, 2);
+		expected.copyFrom(target);
+
+		for (int y = 0; y < sprite.h; ++y) {
+			for (int x = 0; x < sprite.w; ++x) {
+				const int srcX = (flipping & Graphics::FLIP_H) ? sprite.w - 1 - x : x;
+				const uint32 in = *(const uint32 *)sprite.getBasePtr(srcX, y);
+				uint32 &out = *(uint32 *)expected.getBasePtr(x + 3, y + 5);
+
+				if (alphaMode == Graphics::ALPHA_OPAQUE && color == 0xFFFFFFFF)
+					out = in | 0xFF;
+				else if (alphaMode == Graphics::ALPHA_BINARY && color == 0xFFFFFFFF)
+					out = (in & 0xFF) ? (in | 0xFF) : out;
+				else
+					out = blend(in, out, color);
+			}
+		}
+
+		sprite.blit(target, 3, 5, flipping, nullptr, color);
+		TS_ASSERT_EQUALS(memcmp(target.getPixels(), expected.getPixels(), target.pitch * target.h), 0);
+
+		sprite.free();
+		target.free();
+		expected.free();
+	}
+
+	void test_blit() {
+		checkBlit(Graphics::ALPHA_OPAQUE, 0xFFFFFFFF, Graphics::FLIP_NONE);
+		checkBlit(Graphics::ALPHA_BINARY, 0xFFFFFFFF, Graphics::FLIP_NONE);
+		checkBlit(Graphics::ALPHA_BINARY, 0xFFFFFFFF, Graphics::FLIP_H);
+		checkBlit(Graphics::ALPHA_FULL, 0xFFFFFFFF, Graphics::FLIP_NONE);
+		checkBlit(Graphics::ALPHA_FULL, 0xFFFFFFFF, Graphics::FLIP_H);
+		checkBlit(Graphics::ALPHA_FULL, 0x80FFFFFF, Graphics::FLIP_NONE);
+		checkBlit(Graphics::ALPHA_FULL, 0xC0FF8020, Graphics::FLIP_NONE);
+		checkBlit(Graphics::ALPHA_FULL, 0xFF10E0FF, Graphics::FLIP_H);
+	}
+
+	void test_transform_cache() {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		Graphics::TransparentSurface sprite;
+		sprite.create(30, 20, format);
+		fillRandom(sprite, 3);
+
+		Graphics::TransformCache cache;
+		const Common::Rect part(5, 2, 25, 18);
+		const Graphics::TransformStruct transform;
+
+		Common::SharedPtr<const Graphics::TransparentSurface> scaled = cache.getTransformed(sprite, part, transform, 40, 24, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+		TS_ASSERT_EQUALS(scaled->w, 40);
+		TS_ASSERT_EQUALS(scaled->h, 24);
+
+		// Same as scaling the part directly
+		Graphics::TransparentSurface copy;
+		copy.create(part.width(), part.height(), format);
+		copy.copyRectToSurface(sprite, 0, 0, part);
+		Graphics::TransparentSurface *direct = copy.scaleT<Graphics::FILTER_BILINEAR>(40, 24);
+		TS_ASSERT_EQUALS(memcmp(scaled->getPixels(), direct->getPixels(), direct->pitch * direct->h), 0);
+		direct->free();
+		delete direct;
+		copy.free();
+
+		// The color modulation does not change the transformed image
+		Graphics::TransformStruct faded = transform;
+		faded._rgbaMod = 0x80FFFFFF;
+		TS_ASSERT_EQUALS(cache.getTransformed(sprite, part, faded, 40, 24, Graphics::FILTER_BILINEAR).get(), scaled.get());
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+
+		// Other sizes, filters and rotations are different images
+		Common::SharedPtr<const Graphics::TransparentSurface> rotated = cache.getTransformed(sprite, part, Graphics::TransformStruct(100, 100, 90), 0, 0, Graphics::FILTER_BILINEAR);
+		TS_ASSERT(rotated->h > rotated->w);
+		cache.getTransformed(sprite, part, transform, 40, 24, Graphics::FILTER_NEAREST);
+		TS_ASSERT_EQUALS(cache.getMisses(), 3u);
+
+		// With two entries, the least recently used one was dropped
+		cache.getTransformed(sprite, part, transform, 40, 24, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_EQUALS(cache.getMisses(), 4u);
+
+		cache.clear();
+		Common::SharedPtr<const Graphics::TransparentSurface> again = cache.getTransformed(sprite, part, transform, 40, 24, Graphics::FILTER_BILINEAR);
+		TS_ASSERT_EQUALS(cache.getMisses(), 5u);
+
+		// Images handed out stay valid after the cache dropped them
+		TS_ASSERT_DIFFERS(again.get(), scaled.get());
+		TS_ASSERT_EQUALS(memcmp(scaled->getPixels(), again->getPixels(), again->pitch * again->h), 0);
+
+		sprite.free();
+	}
+
+	void test_blit_with_cache() {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		Graphics::TransparentSurface sprite;
+		sprite.create(30, 20, format);
+		fillRandom(sprite, 4);
+
+		Graphics::Surface target, expected;
+		target.create(64, 48, format);
+		fillRandom(target, 5);
+		expected.copyFrom(target);
+
+		Common::Rect part(2, 3, 12, 13);
+		sprite.blit(expected, 4, 4, Graphics::FLIP_NONE, &part, 0xFFFFFFFF, 20, 30);
+
+		Graphics::TransformCache cache;
+		sprite.setTransformCache(&cache);
+		for (int i = 0; i < 2; i++) {
+			Graphics::Surface result;
+			result.copyFrom(target);
+			sprite.blit(result, 4, 4, Graphics::FLIP_NONE, &part, 0xFFFFFFFF, 20, 30);
+			TS_ASSERT_EQUALS(memcmp(result.getPixels(), expected.getPixels(), result.pitch * result.h), 0);
+			result.free();
+		}
+		TS_ASSERT_EQUALS(cache.getMisses(), 1u);
+		TS_ASSERT_EQUALS(cache.getHits(), 1u);
+
+		sprite.free();
+		target.free();
+		expected.free();
+	}
+};
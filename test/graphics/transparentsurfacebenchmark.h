@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "graphics/transparent_surface.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Draws frames resembling a Wintermute scene: an opaque background, alpha
+ * blended sprites, some of them faded through color modulation, and scaled
+ * actors, first scaling them on every blit and then through a TransformCache.
+ */
+class TransparentSurfaceBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kWidth = 800,
+		kHeight = 600,
+		kFrames = 10,
+		kSprites = 24,
+		kActors = 3
+	};
+
+	static void fillSprite(Graphics::Surface &surface, uint32 seed) {
+		for (int y = 0; y < surface.h; ++y) {
+			uint32 *row = (uint32 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; ++x) {
+				seed = seed * 1103515245 + 12345;
+				// Transparent corners and a soft edge around an opaque body
+				const int dx = 2 * x - surface.w, dy = 2 * y - surface.h;
+				const int distance = dx * dx * 100 / (surface.w * surface.w) + dy * dy * 100 / (surface.h * surface.h);
+				const uint32 alpha = distance > 100 ? 0 : (distance > 80 ? 128 : 255);
+				row[x] = (seed & 0xFFFFFF00) | alpha;
+			}
+		}
+	}
+
+	void drawFrames(Graphics::Surface &target, Graphics::TransparentSurface &background,
+			Common::Array<Graphics::TransparentSurface> &sprites, Common::Array<Graphics::TransparentSurface> &actors) {
+		for (int frame = 0; frame < kFrames; frame++) {
+			background.blit(target);
+
+			for (uint i = 0; i < sprites.size(); i++) {
+				const uint color = (i % 4 == 0) ? TS_ARGB(128 + frame * 8, 255, 255, 255) : TS_ARGB(255, 255, 255, 255);
+				sprites[i].blit(target, (i * 97 + frame * 3) % (kWidth - 64), (i * 53) % (kHeight - 96),
+					Graphics::FLIP_NONE, nullptr, color);
+			}
+
+			for (uint i = 0; i < actors.size(); i++)
+				actors[i].blit(target, 100 + i * 200 + frame, 300, Graphics::FLIP_NONE, nullptr, TS_ARGB(255, 255, 255, 255), 90, 150);
+		}
+	}
+
+	void test_scene() {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+
+		Graphics::TransparentSurface background;
+		background.create(kWidth, kHeight, format);
+		fillSprite(background, 1);
+		background.setAlphaMode(Graphics::ALPHA_OPAQUE);
+
+		Common::Array<Graphics::TransparentSurface> sprites(kSprites);
+		for (uint i = 0; i < sprites.size(); i++) {
+			sprites[i].create(64, 96, format);
+			fillSprite(sprites[i], i + 2);
+		}
+
+		Common::Array<Graphics::TransparentSurface> actors(kActors);
+		for (uint i = 0; i < actors.size(); i++) {
+			actors[i].create(120, 200, format);
+			fillSprite(actors[i], i + 100);
+		}
+
+		Graphics::Surface target, cachedTarget;
+		target.create(kWidth, kHeight, format);
+		cachedTarget.create(kWidth, kHeight, format);
+
+		Benchmark::Timer timer;
+		drawFrames(target, background, sprites, actors);
+		const uint32 uncached = timer.lap();
+
+		Common::Array<Graphics::TransformCache *> caches;
+		for (uint i = 0; i < actors.size(); i++) {
+			caches.push_back(new Graphics::TransformCache());
+			actors[i].setTransformCache(caches[i]);
+		}
+
+		timer.restart();
+		drawFrames(cachedTarget, background, sprites, actors);
+		const uint32 cached = timer.elapsed();
+
+		TS_ASSERT_EQUALS(memcmp(target.getPixels(), cachedTarget.getPixels(), target.pitch * target.h), 0);
+
+		Common::String trace = Common::String::format("%d frames of %dx%d with %d sprites and %d scaled actors in us: %d, with transform cache %d",
+			kFrames, kWidth, kHeight, kSprites, kActors, uncached, cached);
+		TS_TRACE(trace.c_str());
+
+		for (uint i = 0; i < actors.size(); i++) {
+			TS_ASSERT_EQUALS(caches[i]->getMisses(), 1u);
+			actors[i].setTransformCache(nullptr);
+			delete caches[i];
+			actors[i].free();
+		}
+		for (uint i = 0; i < sprites.size(); i++)
+			sprites[i].free();
+		background.free();
+		target.free();
+		cachedTarget.free();
+	}
+};
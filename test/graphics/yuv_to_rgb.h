@@ -0,0 +1,140 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+private:
+	// Straightforward version of the table based conversion
+	static uint32 referencePixel(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, byte y, byte u, byte v) {
+		const int16 cr = v - 128, cb = u - 128;
+		const int r = y + (int16)((0.419 / 0.299) * cr);
+		const int g = y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb);
+		const int b = y + (int16)((0.587 / 0.331) * cb);
+
+		return format.RGBToColor(scaleChannel(scale, r), scaleChannel(scale, g), scaleChannel(scale, b));
+	}
+
+	static byte scaleChannel(Graphics::YUVToRGBManager::LuminanceScale scale, int value) {
+		if (scale == Graphics::YUVToRGBManager::kScaleFull)
+			return CLIP(value, 0, 255);
+
+		return (CLIP(value, 16, 235) - 16) * 255 / 219;
+	}
+
+	static void fillPlane(byte *plane, int size, uint32 seed) {
+		for (int i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			plane[i] = (seed >> 16) & 0xFF;
+		}
+	}
+
+	static uint32 getPixel(const Graphics::Surface &surface, int x, int y) {
+		if (surface.format.bytesPerPixel == 2)
+			return *(const uint16 *)surface.getBasePtr(x, y);
+		return *(const uint32 *)surface.getBasePtr(x, y);
+	}
+
+	void checkConversion(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, bool yuv420) {
+		// Not a multiple of the vector size, so that the scalar tail is used
+		const int width = 302, height = 10;
+		const int yPitch = width + 6;
+		const int uvWidth = yuv420 ? width / 2 : width;
+		const int uvHeight = yuv420 ? height / 2 : height;
+		const int uvPitch = uvWidth + 3;
+
+		byte *y = new byte[yPitch * height];
+		byte *u = new byte[uvPitch * uvHeight];
+		byte *v = new byte[uvPitch * uvHeight];
+		fillPlane(y, yPitch * height, 1);
+		fillPlane(u, uvPitch * uvHeight, 2);
+		fillPlane(v, uvPitch * uvHeight, 3);
+
+		Graphics::Surface surface;
+		surface.create(width, height, format);
+
+		if (yuv420)
+			YUVToRGBMan.convert420(&surface, scale, y, u, v, width, height, yPitch, uvPitch);
+		else
+			YUVToRGBMan.convert444(&surface, scale, y, u, v, width, height, yPitch, uvPitch);
+
+		int mismatches = 0;
+		for (int py = 0; py < height; py++) {
+			for (int px = 0; px < width; px++) {
+				const int uvOffset = yuv420 ? (py / 2) * uvPitch + px / 2 : py * uvPitch + px;
+				if (getPixel(surface, px, py) != referencePixel(format, scale, y[py * yPitch + px], u[uvOffset], v[uvOffset]))
+					mismatches++;
+			}
+		}
+		TS_ASSERT_EQUALS(mismatches, 0);
+
+		surface.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+
+	void checkFormat(const Graphics::PixelFormat &format) {
+		// Check both the vectorized path and the lookup tables alone
+		for (int useSIMD = 1; useSIMD >= 0; useSIMD--) {
+			YUVToRGBMan.setUseSIMD(useSIMD != 0);
+			checkConversion(format, Graphics::YUVToRGBManager::kScaleFull, true);
+			checkConversion(format, Graphics::YUVToRGBManager::kScaleITU, true);
+			checkConversion(format, Graphics::YUVToRGBManager::kScaleFull, false);
+			checkConversion(format, Graphics::YUVToRGBManager::kScaleITU, false);
+		}
+	}
+
+public:
+	void test_rgb565() {
+		checkFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_argb1555() {
+		checkFormat(Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15));
+	}
+
+	void test_rgba8888() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+
+	void test_xrgb8888() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0));
+	}
+
+	void test_convert420_rows() {
+		const Graphics::PixelFormat format(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		const int width = 64, height = 16;
+
+		byte *y = new byte[width * height];
+		byte *u = new byte[width / 2 * height / 2];
+		byte *v = new byte[width / 2 * height / 2];
+		fillPlane(y, width * height, 4);
+		fillPlane(u, width / 2 * height / 2, 5);
+		fillPlane(v, width / 2 * height / 2, 6);
+
+		Graphics::Surface full, band;
+		full.create(width, height, format);
+		band.create(width, height, format);
+		memset(band.getPixels(), 0, band.pitch * height);
+
+		YUVToRGBMan.convert420(&full, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		YUVToRGBMan.convert420Rows(&band, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, width, width / 2, 6, 4);
+
+		// Only the requested rows are written, and match the full conversion
+		for (int row = 0; row < height; row++) {
+			if (row >= 6 && row < 10) {
+				TS_ASSERT_EQUALS(memcmp(full.getBasePtr(0, row), band.getBasePtr(0, row), width * 4), 0);
+			} else {
+				for (int x = 0; x < width; x++)
+					TS_ASSERT_EQUALS(getPixel(band, x, row), 0U);
+			}
+		}
+
+		full.free();
+		band.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+};
@@ -0,0 +1,162 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/str.h"
+#include "common/thread.h"
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+#include "test/benchmark.h"
+
+/**
+ * Times the RGB conversion of Bink video frames the way
+ * Video::BinkDecoder does it with setDecodeThreads(): the first row pair is
+ * converted up front, the rest in bands of row pairs on a WorkerPool. The
+ * banded results are checked against converting the whole frame at once.
+ */
+class YUVToRGBBenchmarkSuite : public CxxTest::TestSuite
+{
+	public:
+	enum {
+		kWidth = 640,
+		kHeight = 480,
+		kFrames = 30,
+		kMaxBands = 4
+	};
+
+	struct Frame {
+		Graphics::Surface *surface;
+		const byte *y, *u, *v;
+		int firstRow[kMaxBands];
+		int rowCount[kMaxBands];
+	};
+
+	static void convertRows(const Frame &frame, int firstRow, int rowCount) {
+		YUVToRGBMan.convert420Rows(frame.surface, Graphics::YUVToRGBManager::kScaleITU, frame.y, frame.u, frame.v,
+			kWidth, kWidth, kWidth / 2, firstRow, rowCount);
+	}
+
+	static void convertBand(void *arg, uint band) {
+		const Frame *frame = (const Frame *)arg;
+		convertRows(*frame, frame->firstRow[band], frame->rowCount[band]);
+	}
+
+	static void fillPlane(byte *plane, int size, uint32 seed) {
+		for (int i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			// Smooth gradients with some noise, like video
+			plane[i] = (byte)((i & 0xFF) + ((seed >> 16) & 0x0F));
+		}
+	}
+
+	void benchmarkFormat(const Graphics::PixelFormat &format) {
+		byte *y = new byte[kWidth * kHeight];
+		byte *u = new byte[kWidth * kHeight / 4];
+		byte *v = new byte[kWidth * kHeight / 4];
+		fillPlane(y, kWidth * kHeight, 1);
+		fillPlane(u, kWidth * kHeight / 4, 2);
+		fillPlane(v, kWidth * kHeight / 4, 3);
+
+		Graphics::Surface reference;
+		reference.create(kWidth, kHeight, format);
+		YUVToRGBMan.convert420(&reference, Graphics::YUVToRGBManager::kScaleITU, y, u, v, kWidth, kHeight, kWidth, kWidth / 2);
+
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, format);
+
+		Frame frame;
+		frame.surface = &surface;
+		frame.y = y;
+		frame.u = u;
+		frame.v = v;
+
+		Common::String trace = Common::String::format("%dx%d Bink frame, %d bpp, us per frame:", (int)kWidth, (int)kHeight, format.bytesPerPixel * 8);
+		Common::WorkerPool pool;
+		for (uint threads = 1; threads <= kMaxBands; threads *= 2) {
+			if (pool.setThreads(threads) != threads)
+				break;
+
+			const int rowPairs = kHeight / 2;
+			int row = 2;
+			for (uint i = 0; i < threads; i++) {
+				frame.firstRow[i] = row;
+				frame.rowCount[i] = ((rowPairs - 1) * (i + 1) / threads - (rowPairs - 1) * i / threads) * 2;
+				row += frame.rowCount[i];
+			}
+
+			memset(surface.getPixels(), 0, surface.pitch * surface.h);
+			const Benchmark::Timer timer;
+			for (int f = 0; f < kFrames; f++) {
+				convertRows(frame, 0, 2);
+				pool.run(convertBand, &frame, threads);
+			}
+			trace += Common::String::format(" %u threads %u", threads, timer.elapsed() / kFrames);
+
+			TS_ASSERT_EQUALS(memcmp(surface.getPixels(), reference.getPixels(), surface.pitch * surface.h), 0);
+		}
+		TS_TRACE(trace.c_str());
+
+		surface.free();
+		reference.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+
+	/**
+	 * Time whole frame YUV420 conversions with the lookup tables only and
+	 * with the vectorized path, and check that both give the same pixels.
+	 */
+	void compareSIMD(int width, int height, const Graphics::PixelFormat &format) {
+		byte *y = new byte[width * height];
+		byte *u = new byte[width * height / 4];
+		byte *v = new byte[width * height / 4];
+		fillPlane(y, width * height, 1);
+		fillPlane(u, width * height / 4, 2);
+		fillPlane(v, width * height / 4, 3);
+
+		Graphics::Surface table, simd;
+		table.create(width, height, format);
+		simd.create(width, height, format);
+
+		Benchmark::Timer timer;
+		YUVToRGBMan.setUseSIMD(false);
+		for (int f = 0; f < kFrames; f++)
+			YUVToRGBMan.convert420(&table, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		const uint32 tableTime = timer.lap();
+
+		YUVToRGBMan.setUseSIMD(true);
+		for (int f = 0; f < kFrames; f++)
+			YUVToRGBMan.convert420(&simd, Graphics::YUVToRGBManager::kScaleITU, y, u, v, width, height, width, width / 2);
+		const uint32 simdTime = timer.lap();
+
+		TS_ASSERT_EQUALS(memcmp(table.getPixels(), simd.getPixels(), table.pitch * table.h), 0);
+
+		Common::String trace = Common::String::format("%dx%d YUV420, %d bpp, tables / SIMD in us per frame: %u / %u",
+			width, height, format.bytesPerPixel * 8, tableTime / kFrames, simdTime / kFrames);
+		TS_TRACE(trace.c_str());
+
+		table.free();
+		simd.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+
+	void test_simd_640x480() {
+		compareSIMD(640, 480, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		compareSIMD(640, 480, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+
+	void test_simd_1280x720() {
+		compareSIMD(1280, 720, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		compareSIMD(1280, 720, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+
+	void test_bink_conversion_16bpp() {
+		benchmarkFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+	}
+
+	void test_bink_conversion_32bpp() {
+		benchmarkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
@@ -3,16 +3,30 @@
 # Use the 'test' target to run them.
 # Edit TESTS and TESTLIBS to add more tests.
 #
+# Test headers named *benchmark.h are timing benchmarks. They are left out
+# of the unit tests and get their own runner, run by the 'benchmark' target.
+#
+# The 'test-headless' target plays a game with the scummvm executable
+# itself, without a screen.
+#
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h
-TEST_LIBS    := audio/libaudio.a common/libcommon.a
+TESTS        := $(wildcard $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/backends/opengl/*.h)
+TEST_LIBS    := audio/libaudio.a graphics/libgraphics.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
-	TESTS += $(srcdir)/test/engines/wintermute/*.h
+	TESTS += $(wildcard $(srcdir)/test/engines/wintermute/*.h)
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+ifeq ($(ENABLE_SCI), STATIC_PLUGIN)
+	TESTS += $(wildcard $(srcdir)/test/engines/sci/*.h)
+	TEST_LIBS += engines/sci/libsci.a
+endif
+
+BENCHMARKS   := $(filter %benchmark.h,$(TESTS))
+TESTS        := $(filter-out %benchmark.h,$(TESTS))
+
 #
 TEST_FLAGS   := --runner=StdioPrinter --no-std --no-eh --include=$(srcdir)/test/cxxtest_mingw.h
 TEST_CFLAGS  := $(CFLAGS) -I$(srcdir)/test/cxxtest
@@ -42,8 +56,21 @@ test/runner.cpp: $(TESTS)
 	@mkdir -p test
 	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
 
+benchmark: test/benchmark_runner
+	./test/benchmark_runner
+test/benchmark_runner: test/benchmark_runner.cpp $(TEST_LIBS)
+	$(QUIET_CXX)$(CXX) $(TEST_CXXFLAGS) $(CPPFLAGS) $(TEST_CFLAGS) -o $@ $+ $(TEST_LDFLAGS)
+test/benchmark_runner.cpp: $(BENCHMARKS)
+	@mkdir -p test
+	$(srcdir)/test/cxxtest/cxxtestgen.py $(TEST_FLAGS) -o $@ $+
+
+ifeq ($(ENABLE_GLK), STATIC_PLUGIN)
+test-headless: $(EXECUTABLE)
+	$(srcdir)/test/engines/glk/headless_replay.py ./$(EXECUTABLE) $(srcdir)/dists/engine-data
+endif
+
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner
+	-$(RM) test/runner.cpp test/runner test/benchmark_runner.cpp test/benchmark_runner
 
-.PHONY: test clean-test
+.PHONY: test benchmark test-headless clean-test
@@ -63,6 +63,7 @@ namespace Video {
 
 BinkDecoder::BinkDecoder() {
 	_bink = 0;
+	_decodeThreads = 1;
 }
 
 BinkDecoder::~BinkDecoder() {
@@ -104,6 +105,7 @@ bool BinkDecoder::loadStream(Common::SeekableReadStream *stream) {
 	// BIKh and BIKi swap the chroma planes
 	addTrack(new BinkVideoTrack(width, height, getDefaultHighColorFormat(), frameCount,
 			Common::Rational(frameRateNum, frameRateDen), (id == kBIKhID || id == kBIKiID), videoFlags & kVideoFlagAlpha, id));
+	((BinkVideoTrack *)getTrack(0))->setDecodeThreads(_decodeThreads);
 
 	uint32 audioTrackCount = _bink->readUint32LE();
 
@@ -154,6 +156,14 @@ void BinkDecoder::close() {
 	_frames.clear();
 }
 
+void BinkDecoder::setDecodeThreads(uint threads) {
+	_decodeThreads = threads;
+
+	BinkVideoTrack *videoTrack = (BinkVideoTrack *)getTrack(0);
+	if (videoTrack)
+		videoTrack->setDecodeThreads(threads);
+}
+
 void BinkDecoder::readNextPacket() {
 	BinkVideoTrack *videoTrack = (BinkVideoTrack *)getTrack(0);
 
@@ -359,8 +369,7 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
 	assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-	YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
-			_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
+	convertToRGB();
 
 	// And swap the planes with the reference planes
 	for (int i = 0; i < 4; i++)
@@ -369,6 +378,49 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 	_curFrame++;
 }
 
+void BinkDecoder::BinkVideoTrack::setDecodeThreads(uint threads) {
+	// The workers are started here once and sleep between frames
+	_convertPool.setThreads(CLIP<uint>(threads, 1, kMaxDecodeThreads));
+}
+
+void BinkDecoder::BinkVideoTrack::convertToRGB() {
+	// The planes of a frame are decoded from a single bitstream, sharing
+	// the bundles between them, so only the conversion can be split up.
+	// Bands consist of whole row pairs, as two luma rows share a chroma row.
+	const int rowPairs = _surfaceHeight / 2;
+	const uint bandCount = MIN<uint>(_convertPool.getThreads(), rowPairs - 1);
+
+	if (bandCount <= 1) {
+		YUVToRGBMan.convert420(&_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
+				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
+		return;
+	}
+
+	// The manager sets up its lookup table for the surface format on
+	// demand, so convert the first row pair before the workers start.
+	convertRows(0, 2);
+
+	int y = 2;
+	for (uint i = 0; i < bandCount; i++) {
+		_bands[i].firstRow = y;
+		_bands[i].rowCount = ((rowPairs - 1) * (i + 1) / bandCount - (rowPairs - 1) * i / bandCount) * 2;
+		y += _bands[i].rowCount;
+	}
+
+	_convertPool.run(convertBand, this, bandCount);
+}
+
+void BinkDecoder::BinkVideoTrack::convertRows(int firstRow, int rowCount) {
+	YUVToRGBMan.convert420Rows(&_surface, Graphics::YUVToRGBManager::kScaleITU,
+			_curPlanes[0], _curPlanes[1], _curPlanes[2], _surfaceWidth,
+			_yBlockWidth * 8, _uvBlockWidth * 8, firstRow, rowCount);
+}
+
+void BinkDecoder::BinkVideoTrack::convertBand(void *track, uint band) {
+	BinkVideoTrack *t = (BinkVideoTrack *)track;
+	t->convertRows(t->_bands[band].firstRow, t->_bands[band].rowCount);
+}
+
 void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
 	uint32 blockWidth  = isChroma ? _uvBlockWidth  : _yBlockWidth;
 	uint32 blockHeight = isChroma ? _uvBlockHeight : _yBlockHeight;
@@ -1357,7 +1409,7 @@ void BinkDecoder::BinkVideoTrack::IDCTPut(DecodeContext &ctx, int32 *block) {
 BinkDecoder::BinkAudioTrack::BinkAudioTrack(BinkDecoder::AudioInfo &audio, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(&audio) {
-	_audioStream = Audio::makeQueuingAudioStream(_audioInfo->outSampleRate, _audioInfo->outChannels == 2);
+	_audioStream = Audio::makeLockFreeQueuingAudioStream(_audioInfo->outSampleRate, _audioInfo->outChannels == 2);
 }
 
 BinkDecoder::BinkAudioTrack::~BinkAudioTrack() {
@@ -34,6 +34,7 @@
 #include "common/array.h"
 #include "common/bitstream.h"
 #include "common/rational.h"
+#include "common/thread.h"
 
 #include "video/video_decoder.h"
 
@@ -73,6 +74,17 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	/**
+	 * Set the number of threads converting the decoded frames to RGB.
+	 *
+	 * With more than one thread, each frame is split into horizontal bands
+	 * which are converted in parallel by worker threads, which are started
+	 * when a video is loaded and sleep between frames. The default of 1
+	 * converts the frames on the calling thread only. The setting is kept
+	 * across videos.
+	 */
+	void setDecodeThreads(uint threads);
+
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
@@ -155,6 +167,9 @@ private:
 		/** Decode a video packet. */
 		void decodePacket(VideoFrame &frame);
 
+		/** Set the number of threads used by convertToRGB(). */
+		void setDecodeThreads(uint threads);
+
 	protected:
 		Common::Rational getFrameRate() const { return _frameRate; }
 
@@ -263,6 +278,24 @@ private:
 		byte *_curPlanes[4]; ///< The 4 color planes, YUVA, current frame.
 		byte *_oldPlanes[4]; ///< The 4 color planes, YUVA, last frame.
 
+		static const uint kMaxDecodeThreads = 4;
+
+		/** A horizontal band of the current frame to convert to RGB. */
+		struct ConvertBand {
+			int firstRow;
+			int rowCount;
+		};
+
+		ConvertBand _bands[kMaxDecodeThreads];
+		Common::WorkerPool _convertPool; ///< Threads converting a frame to RGB.
+
+		/** Convert the current planes into the surface, split into bands. */
+		void convertToRGB();
+		/** Convert the rows of a single band. */
+		void convertRows(int firstRow, int rowCount);
+		/** WorkerPool task converting _bands[band]. */
+		static void convertBand(void *track, uint band);
+
 		/** Initialize the bundles. */
 		void initBundles();
 		/** Deinitialize the bundles. */
@@ -358,6 +391,8 @@ private:
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
+	uint _decodeThreads; ///< Number of threads converting a frame to RGB.
+
 	void initAudioTrack(AudioInfo &audio);
 };
 
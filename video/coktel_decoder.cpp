@@ -1171,7 +1171,7 @@ bool IMDDecoder::assessAudioProperties() {
 		_soundEnabled = true;
 		_soundStage   = kSoundLoaded;
 
-		_audioStream = Audio::makeQueuingAudioStream(_soundFreq, false);
+		_audioStream = Audio::makeLockFreeQueuingAudioStream(_soundFreq, false);
 	}
 
 	return true;
@@ -1510,7 +1510,7 @@ bool IMDDecoder::initialSoundSlice(bool hasNextCmd) {
 	if (!_audioStream || (_soundStage == kSoundFinished)) {
 		delete _audioStream;
 
-		_audioStream = Audio::makeQueuingAudioStream(_soundFreq, false);
+		_audioStream = Audio::makeLockFreeQueuingAudioStream(_soundFreq, false);
 		_soundStage  = kSoundLoaded;
 	}
 
@@ -2643,7 +2643,7 @@ void VMDDecoder::filledSoundSlices(uint32 size, uint32 mask) {
 }
 
 void VMDDecoder::createAudioStream() {
-	_audioStream = Audio::makeQueuingAudioStream(_soundFreq, _soundStereo != 0);
+	_audioStream = Audio::makeLockFreeQueuingAudioStream(_soundFreq, _soundStereo != 0);
 	if (_soundStereo == 1) {
 		_oldStereoBuffer = new Common::MemoryReadWriteStream(DisposeAfterUse::YES);
 		_audioStream->queueAudioStream(new DPCMStream(_oldStereoBuffer, _soundFreq, 2, true));
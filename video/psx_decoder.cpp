@@ -316,7 +316,7 @@ PSXStreamDecoder::PSXAudioTrack::PSXAudioTrack(Common::SeekableReadStream *secto
 	byte format = sector->readByte();
 	bool stereo = (format & (1 << 0)) != 0;
 	uint rate = (format & (1 << 2)) ? 18900 : 37800;
-	_audStream = Audio::makeQueuingAudioStream(rate, stereo);
+	_audStream = Audio::makeLockFreeQueuingAudioStream(rate, stereo);
 
 	memset(&_adpcmStatus, 0, sizeof(_adpcmStatus));
 }
@@ -755,7 +755,7 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 SmackerDecoder::SmackerAudioTrack::SmackerAudioTrack(const AudioInfo &audioInfo, Audio::Mixer::SoundType soundType) :
 		AudioTrack(soundType),
 		_audioInfo(audioInfo) {
-	_audioStream = Audio::makeQueuingAudioStream(_audioInfo.sampleRate, _audioInfo.isStereo);
+	_audioStream = Audio::makeLockFreeQueuingAudioStream(_audioInfo.sampleRate, _audioInfo.isStereo);
 }
 
 SmackerDecoder::SmackerAudioTrack::~SmackerAudioTrack() {
@@ -764,7 +764,7 @@ SmackerDecoder::SmackerAudioTrack::~SmackerAudioTrack() {
 
 bool SmackerDecoder::SmackerAudioTrack::rewind() {
 	delete _audioStream;
-	_audioStream = Audio::makeQueuingAudioStream(_audioInfo.sampleRate, _audioInfo.isStereo);
+	_audioStream = Audio::makeLockFreeQueuingAudioStream(_audioInfo.sampleRate, _audioInfo.isStereo);
 	return true;
 }
 